@@ -64,7 +64,7 @@ static void bt_cli_command_carrier_rx(Cli* cli, string_t args, void* context) {
         while(!cli_cmd_interrupt_received(cli)) {
             osDelay(250);
             printf("RSSI: %6.1f dB\r", furi_hal_bt_get_rssi());
-            fflush(stdout);
+            cli_flush(cli);
         }
 
         furi_hal_bt_stop_packet_test();
@@ -138,7 +138,7 @@ static void bt_cli_command_packet_rx(Cli* cli, string_t args, void* context) {
             osDelay(250);
             rssi_raw = furi_hal_bt_get_rssi();
             printf("RSSI: %03.1f dB\r", rssi_raw);
-            fflush(stdout);
+            cli_flush(cli);
         }
         uint16_t packets_received = furi_hal_bt_stop_packet_test();
         printf("Received %hu packets", packets_received);
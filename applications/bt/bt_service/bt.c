@@ -24,6 +24,8 @@ static void bt_draw_statusbar_callback(Canvas* canvas, void* context) {
 
 static ViewPort* bt_statusbar_view_port_alloc(Bt* bt) {
     ViewPort* statusbar_view_port = view_port_alloc();
+    icon_pin(&I_Bluetooth_Idle_5x8);
+    icon_pin(&I_Bluetooth_Connected_16x8);
     view_port_set_width(statusbar_view_port, 5);
     view_port_draw_callback_set(statusbar_view_port, bt_draw_statusbar_callback, bt);
     view_port_enabled_set(statusbar_view_port, false);
@@ -157,6 +159,7 @@ static uint16_t bt_serial_event_callback(SerialServiceEvent event, void* context
         }
         ret = rpc_session_get_available_size(bt->rpc_session);
     } else if(event.event == SerialServiceEventTypeDataSent) {
+        bt_serial_tx_window_refill(&bt->tx_window);
         osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_BUFF_SENT);
     }
     return ret;
@@ -167,23 +170,58 @@ static void bt_rpc_send_bytes_callback(void* context, uint8_t* bytes, size_t byt
     furi_assert(context);
     Bt* bt = context;
 
-    osEventFlagsClear(bt->rpc_event, BT_RPC_EVENT_ALL);
+    uint32_t start_tick = osKernelGetTickCount();
+    bt_serial_tx_window_configure(
+        &bt->tx_window,
+        furi_hal_bt_serial_is_tx_notify_enabled(),
+        bt->max_packet_size,
+        bt->connection_interval);
+    // Keep window of packets queued in BLE stack instead of waiting for each one
     size_t bytes_sent = 0;
     while(bytes_sent < bytes_len) {
-        size_t bytes_remain = bytes_len - bytes_sent;
-        if(bytes_remain > bt->max_packet_size) {
-            furi_hal_bt_serial_tx(&bytes[bytes_sent], bt->max_packet_size);
-            bytes_sent += bt->max_packet_size;
+        if(bt_serial_tx_window_acquire(&bt->tx_window)) {
+            uint16_t packet_size = MIN(bytes_len - bytes_sent, bt->max_packet_size);
+            FuriHalBtSerialTxStatus status =
+                furi_hal_bt_serial_tx(&bytes[bytes_sent], packet_size);
+            if(status == SerialServiceTxStatusOk) {
+                bytes_sent += packet_size;
+                bt->tx_stats.bytes += packet_size;
+                bt->tx_stats.packets++;
+            } else if(status == SerialServiceTxStatusBusy) {
+                bt_serial_tx_window_stall(&bt->tx_window);
+                bt->tx_stats.stalls++;
+            } else {
+                FURI_LOG_E(TAG, "Failed to send %d bytes", bytes_len - bytes_sent);
+                break;
+            }
         } else {
-            furi_hal_bt_serial_tx(&bytes[bytes_sent], bytes_remain);
-            bytes_sent += bytes_remain;
-        }
-        uint32_t event_flag =
-            osEventFlagsWait(bt->rpc_event, BT_RPC_EVENT_ALL, osFlagsWaitAny, osWaitForever);
-        if(event_flag & BT_RPC_EVENT_DISCONNECTED) {
-            break;
+            uint32_t timeout = bt_serial_tx_window_get_timeout(&bt->tx_window);
+            uint32_t event_flag = osEventFlagsWait(
+                bt->rpc_event,
+                BT_RPC_EVENT_ALL,
+                osFlagsWaitAny,
+                timeout == BT_SERIAL_TX_WAIT_FOREVER ? osWaitForever : timeout);
+            if(event_flag == osFlagsErrorTimeout) {
+                bt_serial_tx_window_timeout(&bt->tx_window);
+            } else if(!(event_flag & osFlagsError) && (event_flag & BT_RPC_EVENT_DISCONNECTED)) {
+                break;
+            }
         }
     }
+    bt->tx_stats.time += osKernelGetTickCount() - start_tick;
+}
+
+static void bt_serial_tx_log_stats(Bt* bt) {
+    BtSerialTxStats* stats = &bt->tx_stats;
+    uint32_t time_ms = (uint64_t)stats->time * 1000 / osKernelGetTickFreq();
+    FURI_LOG_I(
+        TAG,
+        "TX: %lu bytes in %lu packets, %lu stalls, %lu B/s, window %d",
+        stats->bytes,
+        stats->packets,
+        stats->stalls,
+        time_ms ? (uint32_t)((uint64_t)stats->bytes * 1000 / time_ms) : 0,
+        bt->tx_window.size);
 }
 
 // Called from GAP thread
@@ -206,6 +244,9 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
                 rpc_session_set_buffer_is_empty_callback(
                     bt->rpc_session, furi_hal_bt_serial_notify_buffer_is_empty);
                 rpc_session_set_context(bt->rpc_session, bt);
+                osEventFlagsClear(bt->rpc_event, BT_RPC_EVENT_ALL);
+                memset(&bt->tx_stats, 0, sizeof(BtSerialTxStats));
+                bt_serial_tx_window_reset(&bt->tx_window);
                 furi_hal_bt_serial_set_event_callback(
                     RPC_BUFFER_SIZE, bt_serial_event_callback, bt);
             } else {
@@ -222,6 +263,7 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
     } else if(event.type == GapEventTypeDisconnected) {
         if(bt->profile == BtProfileSerial && bt->rpc_session) {
             FURI_LOG_I(TAG, "Close RPC connection");
+            bt_serial_tx_log_stats(bt);
             osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_DISCONNECTED);
             rpc_session_close(bt->rpc_session);
             furi_hal_bt_serial_set_event_callback(0, NULL, NULL);
@@ -248,6 +290,9 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
     } else if(event.type == GapEventTypeUpdateMTU) {
         bt->max_packet_size = event.data.max_packet_size;
         ret = true;
+    } else if(event.type == GapEventTypeUpdateConnectionInterval) {
+        bt->connection_interval = event.data.connection_interval;
+        ret = true;
     }
     return ret;
 }
@@ -284,6 +329,7 @@ static void bt_change_profile(Bt* bt, BtMessage* message) {
         bt_settings_load(&bt->bt_settings);
         if(bt->profile == BtProfileSerial && bt->rpc_session) {
             FURI_LOG_I(TAG, "Close RPC connection");
+            bt_serial_tx_log_stats(bt);
             osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_DISCONNECTED);
             rpc_session_close(bt->rpc_session);
             furi_hal_bt_serial_set_event_callback(0, NULL, NULL);
@@ -15,6 +15,7 @@
 #include <applications/notification/notification.h>
 
 #include "../bt_settings.h"
+#include "bt_serial_tx.h"
 
 #define BT_API_UNLOCK_EVENT (1UL << 0)
 
@@ -39,10 +40,20 @@ typedef struct {
     bool* result;
 } BtMessage;
 
+typedef struct {
+    uint32_t bytes; /**< Payload bytes queued in BLE stack */
+    uint32_t packets; /**< Packets queued in BLE stack */
+    uint32_t stalls; /**< Packets rejected because BLE stack was out of TX buffers */
+    uint32_t time; /**< Ticks spent in transmission */
+} BtSerialTxStats;
+
 struct Bt {
     uint8_t* bt_keys_addr_start;
     uint16_t bt_keys_size;
     uint16_t max_packet_size;
+    uint16_t connection_interval;
+    BtSerialTxWindow tx_window;
+    BtSerialTxStats tx_stats;
     BtSettings bt_settings;
     BtStatus status;
     BtProfile profile;
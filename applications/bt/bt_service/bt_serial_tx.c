@@ -0,0 +1,92 @@
+#include "bt_serial_tx.h"
+
+/* LL header, CRC, L2CAP and ATT headers */
+#define BT_SERIAL_TX_PACKET_OVERHEAD 17
+/* Two inter frame spaces and empty acknowledge packet from client */
+#define BT_SERIAL_TX_PACKET_EXCHANGE_US (150 + 80 + 150)
+/* 1M PHY, worst case */
+#define BT_SERIAL_TX_BYTE_US 8
+#define BT_SERIAL_TX_CONNECTION_INTERVAL_US(interval) ((uint32_t)(interval)*1250)
+
+static uint8_t bt_serial_tx_window_get_size(BtSerialTxWindow* window) {
+    if(!window->notify) {
+        return 1;
+    }
+    if(window->connection_interval == 0) {
+        return BT_SERIAL_TX_WINDOW_MIN;
+    }
+    uint32_t packet_us = (window->packet_size + BT_SERIAL_TX_PACKET_OVERHEAD) *
+                             BT_SERIAL_TX_BYTE_US +
+                         BT_SERIAL_TX_PACKET_EXCHANGE_US;
+    uint32_t size = BT_SERIAL_TX_CONNECTION_INTERVAL_US(window->connection_interval) / packet_us;
+    if(size < BT_SERIAL_TX_WINDOW_MIN) {
+        size = BT_SERIAL_TX_WINDOW_MIN;
+    } else if(size > BT_SERIAL_TX_WINDOW_MAX) {
+        size = BT_SERIAL_TX_WINDOW_MAX;
+    }
+    return size;
+}
+
+void bt_serial_tx_window_reset(BtSerialTxWindow* window) {
+    window->size = bt_serial_tx_window_get_size(window);
+    __atomic_store_n(&window->credits, window->size, __ATOMIC_RELAXED);
+}
+
+void bt_serial_tx_window_configure(
+    BtSerialTxWindow* window,
+    bool notify,
+    uint16_t packet_size,
+    uint16_t connection_interval) {
+    window->notify = notify;
+    window->packet_size = packet_size;
+    window->connection_interval = connection_interval;
+    uint8_t size = bt_serial_tx_window_get_size(window);
+    if(size != window->size) {
+        uint8_t in_flight = window->size - __atomic_load_n(&window->credits, __ATOMIC_RELAXED);
+        window->size = size;
+        __atomic_store_n(
+            &window->credits, (in_flight < size) ? (size - in_flight) : 0, __ATOMIC_RELAXED);
+    }
+}
+
+bool bt_serial_tx_window_acquire(BtSerialTxWindow* window) {
+    uint8_t credits = __atomic_load_n(&window->credits, __ATOMIC_RELAXED);
+    while(credits) {
+        if(__atomic_compare_exchange_n(
+               &window->credits,
+               &credits,
+               credits - 1,
+               false,
+               __ATOMIC_ACQUIRE,
+               __ATOMIC_RELAXED)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void bt_serial_tx_window_refill(BtSerialTxWindow* window) {
+    __atomic_store_n(&window->credits, window->size, __ATOMIC_RELEASE);
+}
+
+void bt_serial_tx_window_stall(BtSerialTxWindow* window) {
+    __atomic_store_n(&window->credits, 0, __ATOMIC_RELAXED);
+}
+
+void bt_serial_tx_window_timeout(BtSerialTxWindow* window) {
+    // Indications are only returned by client confirmation
+    if(window->notify) {
+        bt_serial_tx_window_refill(window);
+    }
+}
+
+uint32_t bt_serial_tx_window_get_timeout(BtSerialTxWindow* window) {
+    if(!window->notify) {
+        return BT_SERIAL_TX_WAIT_FOREVER;
+    }
+    if(window->connection_interval == 0) {
+        return 1;
+    }
+    // Round up to whole ms
+    return (BT_SERIAL_TX_CONNECTION_INTERVAL_US(window->connection_interval) + 999) / 1000;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Notifications kept queued in BLE stack, bounded by stack TX pool */
+#define BT_SERIAL_TX_WINDOW_MIN 2
+#define BT_SERIAL_TX_WINDOW_MAX 8
+
+/** Returned by bt_serial_tx_window_get_timeout() when only DataSent event can return credits */
+#define BT_SERIAL_TX_WAIT_FOREVER UINT32_MAX
+
+/** Credit window for serial service transmission
+ *
+ * With indications every packet has to be confirmed by client, so only one
+ * packet can be in flight. With notifications several packets are queued in
+ * BLE stack and sent within one connection event. Window is sized to what
+ * fits in one connection interval for the current packet size. Credits
+ * return when stack reports free TX buffers or after a connection interval,
+ * when queued packets are gone over the air.
+ *
+ * Credits are taken by sending thread and returned from GAP thread.
+ */
+typedef struct {
+    bool notify;
+    uint16_t packet_size;
+    uint16_t connection_interval;
+    uint8_t size;
+    uint8_t credits;
+} BtSerialTxWindow;
+
+/** Reset window, all credits are available
+ *
+ * @param window    BtSerialTxWindow instance
+ */
+void bt_serial_tx_window_reset(BtSerialTxWindow* window);
+
+/** Update link parameters, credits in use are preserved
+ *
+ * @param window                BtSerialTxWindow instance
+ * @param notify                true if client subscribed to notifications
+ * @param packet_size           payload size of single packet
+ * @param connection_interval   connection interval in 1.25 ms units, 0 if unknown
+ */
+void bt_serial_tx_window_configure(
+    BtSerialTxWindow* window,
+    bool notify,
+    uint16_t packet_size,
+    uint16_t connection_interval);
+
+/** Take credit for one packet
+ *
+ * @param window    BtSerialTxWindow instance
+ *
+ * @return          true if packet can be sent
+ */
+bool bt_serial_tx_window_acquire(BtSerialTxWindow* window);
+
+/** Return all credits, called on DataSent event
+ *
+ * @param window    BtSerialTxWindow instance
+ */
+void bt_serial_tx_window_refill(BtSerialTxWindow* window);
+
+/** Drop all credits, called when BLE stack has no free TX buffers
+ *
+ * @param window    BtSerialTxWindow instance
+ */
+void bt_serial_tx_window_stall(BtSerialTxWindow* window);
+
+/** Return credits if nothing happened during wait timeout
+ *
+ * @param window    BtSerialTxWindow instance
+ */
+void bt_serial_tx_window_timeout(BtSerialTxWindow* window);
+
+/** Get time to wait for DataSent event before credits are returned by timeout
+ *
+ * @param window    BtSerialTxWindow instance
+ *
+ * @return          timeout in ms or BT_SERIAL_TX_WAIT_FOREVER
+ */
+uint32_t bt_serial_tx_window_get_timeout(BtSerialTxWindow* window);
+
+#ifdef __cplusplus
+}
+#endif
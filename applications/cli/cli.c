@@ -29,38 +29,126 @@ void cli_free(Cli* cli) {
     free(cli);
 }
 
-void cli_putc(char c) {
-    furi_hal_vcp_tx((uint8_t*)&c, 1);
+static bool cli_is_owner(Cli* cli) {
+    return osThreadGetId() == cli->thread_id;
+}
+
+void cli_flush(Cli* cli) {
+    furi_assert(cli);
+    if(!cli_is_owner(cli)) {
+        return;
+    }
+    // Data left in stdio buffer goes through cli_buffered_stdout_callback
+    fflush(stdout);
+    if(cli->output_len) {
+        furi_hal_vcp_tx(cli->output, cli->output_len);
+        cli->output_len = 0;
+    }
+}
+
+static void cli_output(Cli* cli, const uint8_t* data, size_t size) {
+    if(cli->output_len + size > CLI_OUTPUT_BUFFER_SIZE) {
+        if(cli->output_len) {
+            furi_hal_vcp_tx(cli->output, cli->output_len);
+            cli->output_len = 0;
+        }
+        // Too big to coalesce, send as is
+        if(size > CLI_OUTPUT_BUFFER_SIZE) {
+            furi_hal_vcp_tx(data, size);
+            return;
+        }
+    }
+    memcpy(&cli->output[cli->output_len], data, size);
+    cli->output_len += size;
+}
+
+/* stdio never reports fflush here, buffered data is sent by cli_flush */
+static void cli_buffered_stdout_callback(void* context, const char* data, size_t size) {
+    furi_assert(context);
+    Cli* cli = context;
+    if(data) {
+        cli_output(cli, (const uint8_t*)data, size);
+    }
+}
+
+/* Take everything that is already received, wait for at least one byte
+ * only if nothing is there */
+static bool cli_input_fill(Cli* cli, uint32_t timeout) {
+    cli_flush(cli);
+    cli->input_pos = 0;
+    cli->input_len = furi_hal_vcp_rx_with_timeout(cli->input, CLI_INPUT_BUFFER_SIZE, 0);
+    if(cli->input_len == 0 && timeout) {
+        cli->input_len = furi_hal_vcp_rx_with_timeout(cli->input, 1, timeout);
+    }
+    return cli->input_len > 0;
+}
+
+static size_t cli_input_read(Cli* cli, uint8_t* buffer, size_t size) {
+    size_t len = cli->input_len - cli->input_pos;
+    if(len > size) {
+        len = size;
+    }
+    memcpy(buffer, &cli->input[cli->input_pos], len);
+    cli->input_pos += len;
+    return len;
+}
+
+void cli_putc(Cli* cli, char c) {
+    cli_output(cli, (uint8_t*)&c, 1);
 }
 
 char cli_getc(Cli* cli) {
     furi_assert(cli);
-    char c;
-    if(furi_hal_vcp_rx((uint8_t*)&c, 1) == 0) {
+    char c = 0;
+    if(cli->input_pos == cli->input_len && !cli_input_fill(cli, osWaitForever)) {
         cli_reset(cli);
+        return c;
     }
+    cli_input_read(cli, (uint8_t*)&c, 1);
     return c;
 }
 
 void cli_stdout_callback(void* _cookie, const char* data, size_t size) {
-    furi_hal_vcp_tx((const uint8_t*)data, size);
+    if(data) {
+        furi_hal_vcp_tx((const uint8_t*)data, size);
+    }
 }
 
 void cli_write(Cli* cli, const uint8_t* buffer, size_t size) {
-    return furi_hal_vcp_tx(buffer, size);
+    furi_assert(cli);
+    // Keep order with buffered output, other threads write directly
+    cli_flush(cli);
+    furi_hal_vcp_tx(buffer, size);
 }
 
 size_t cli_read(Cli* cli, uint8_t* buffer, size_t size) {
-    return furi_hal_vcp_rx(buffer, size);
+    furi_assert(cli);
+    size_t len = cli_input_read(cli, buffer, size);
+    if(len < size) {
+        cli_flush(cli);
+        len += furi_hal_vcp_rx(&buffer[len], size - len);
+    }
+    return len;
+}
+
+size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout) {
+    furi_assert(cli);
+    size_t len = cli_input_read(cli, buffer, size);
+    if(len == 0) {
+        cli_flush(cli);
+        len = furi_hal_vcp_rx_with_timeout(buffer, size, timeout);
+    }
+    return len;
 }
 
 bool cli_cmd_interrupt_received(Cli* cli) {
+    furi_assert(cli);
     char c = '\0';
-    if(furi_hal_vcp_rx_with_timeout((uint8_t*)&c, 1, 0) == 1) {
-        return c == CliSymbolAsciiETX;
-    } else {
+    if(cli->input_pos == cli->input_len && !cli_input_fill(cli, 0)) {
         return false;
     }
+    cli_input_read(cli, (uint8_t*)&c, 1);
+    return c == CliSymbolAsciiETX;
 }
 
 void cli_print_usage(const char* cmd, const char* usage, const char* arg) {
@@ -138,7 +226,7 @@ static void cli_handle_backspace(Cli* cli) {
 
         cli->cursor_position--;
     } else {
-        cli_putc(CliSymbolAsciiBell);
+        cli_putc(cli, CliSymbolAsciiBell);
     }
 }
 
@@ -209,7 +297,7 @@ static void cli_handle_enter(Cli* cli) {
         printf(
             "`%s` command not found, use `help` or `?` to list all available commands",
             string_get_cstr(command));
-        cli_putc(CliSymbolAsciiBell);
+        cli_putc(cli, CliSymbolAsciiBell);
     }
     furi_check(osMutexRelease(cli->mutex) == osOK);
 
@@ -301,7 +389,6 @@ static void cli_handle_escape(Cli* cli, char c) {
 
 void cli_process_input(Cli* cli) {
     char c = cli_getc(cli);
-    size_t r;
 
     if(c == CliSymbolAsciiTab) {
         cli_handle_autocomplete(cli);
@@ -315,12 +402,12 @@ void cli_process_input(Cli* cli) {
     } else if(c == CliSymbolAsciiEOT) {
         cli_reset(cli);
     } else if(c == CliSymbolAsciiEsc) {
-        r = furi_hal_vcp_rx((uint8_t*)&c, 1);
-        if(r && c == '[') {
-            furi_hal_vcp_rx((uint8_t*)&c, 1);
+        c = cli_getc(cli);
+        if(c == '[') {
+            c = cli_getc(cli);
             cli_handle_escape(cli, c);
         } else {
-            cli_putc(CliSymbolAsciiBell);
+            cli_putc(cli, CliSymbolAsciiBell);
         }
     } else if(c == CliSymbolAsciiBackspace || c == CliSymbolAsciiDel) {
         cli_handle_backspace(cli);
@@ -329,7 +416,7 @@ void cli_process_input(Cli* cli) {
     } else if(c >= 0x20 && c < 0x7F) {
         if(cli->cursor_position == string_size(cli->line)) {
             string_push_back(cli->line, c);
-            cli_putc(c);
+            cli_putc(cli, c);
         } else {
             // ToDo: better way?
             string_t temp;
@@ -349,7 +436,7 @@ void cli_process_input(Cli* cli) {
         }
         cli->cursor_position++;
     } else {
-        cli_putc(CliSymbolAsciiBell);
+        cli_putc(cli, CliSymbolAsciiBell);
     }
 }
 
@@ -405,7 +492,8 @@ int32_t cli_srv(void* p) {
 
     furi_record_create("cli", cli);
 
-    furi_stdglue_set_thread_stdout_callback(cli_stdout_callback);
+    cli->thread_id = osThreadGetId();
+    furi_stdglue_set_thread_stdout_callback(cli_buffered_stdout_callback, cli);
     while(1) {
         cli_process_input(cli);
     }
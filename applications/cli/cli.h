@@ -83,7 +83,22 @@ void cli_delete_command(Cli* cli, const char* name);
  */
 size_t cli_read(Cli* cli, uint8_t* buffer, size_t size);
 
+/** Read from terminal with timeout Do it only from inside of cli call.
+ * Returns as soon as no more data arrives within timeout, so it can be used
+ * by streaming commands to poll input without blocking. Command may hand
+ * reading over to its worker thread while it doesn't read input itself.
+ *
+ * @param      cli      Cli instance
+ * @param      buffer   pointer to buffer
+ * @param      size     size of buffer in bytes
+ * @param      timeout  rx timeout in ms, 0 to return only data already received
+ *
+ * @return     bytes read
+ */
+size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout);
+
 /** Not blocking check for interrupt command received
+ * Pending output is flushed to terminal.
  *
  * @param      cli   Cli instance
  *
@@ -99,6 +114,15 @@ bool cli_cmd_interrupt_received(Cli* cli);
  */
 void cli_write(Cli* cli, const uint8_t* buffer, size_t size);
 
+/** Send buffered output to terminal
+ * Output is flushed automatically before waiting for input and after command
+ * exits. fflush(stdout) only moves data to cli buffer, use this instead where
+ * partial output must be shown right away. Does nothing outside of cli thread.
+ *
+ * @param      cli   Cli instance
+ */
+void cli_flush(Cli* cli);
+
 /** Read character
  *
  * @param      cli   Cli instance
@@ -6,6 +6,7 @@
 #include <time.h>
 #include <notification/notification_messages.h>
 #include <loader/loader.h>
+#include <lib/toolbox/args.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -335,6 +336,175 @@ void cli_command_free_blocks(Cli* cli, string_t args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+static void cli_command_heap_print_usage() {
+    printf("Usage:\r\n");
+    printf("heap <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\tstats\t - allocation statistics of traced threads\r\n");
+    printf("\trate [ms]\t - allocation rate of traced threads over interval\r\n");
+    printf("\tevents\t - stream allocation events until CTRL+C\r\n");
+    printf("\tpools\t - object pools statistics\r\n");
+}
+
+static void cli_command_heap_stats() {
+    const uint8_t threads_num_max = 32;
+    osThreadId_t threads_id[threads_num_max];
+    uint8_t thread_num = osThreadEnumerate(threads_id, threads_num_max);
+    MemmgrHeapThreadStats stats;
+
+    printf("%-20s %-8s %-8s %-8s %-8s\r\n", "Name", "Live", "Peak", "Allocs", "Frees");
+    for(uint8_t i = 0; i < thread_num; i++) {
+        if(!memmgr_heap_get_thread_stats(threads_id[i], &stats)) continue;
+        printf(
+            "%-20s %-8d %-8d %-8ld %-8ld\r\n",
+            osThreadGetName(threads_id[i]),
+            stats.live,
+            stats.peak,
+            stats.alloc_count,
+            stats.free_count);
+        printf("  sizes:");
+        for(size_t size_class = 0; size_class < MEMMGR_HEAP_SIZE_CLASS_COUNT; size_class++) {
+            if(size_class == MEMMGR_HEAP_SIZE_CLASS_COUNT - 1) {
+                printf(" >%d:", memmgr_heap_get_size_class_limit(size_class - 1));
+            } else {
+                printf(" <=%d:", memmgr_heap_get_size_class_limit(size_class));
+            }
+            printf("%ld", stats.size_histogram[size_class]);
+        }
+        printf("\r\n");
+    }
+}
+
+static void cli_command_heap_rate(string_t args) {
+    int interval = 1000;
+    if(string_size(args) > 0 && (!args_read_int_and_trim(args, &interval) || interval <= 0)) {
+        cli_print_usage("heap rate", "[ms]", string_get_cstr(args));
+        return;
+    }
+
+    const uint8_t threads_num_max = 32;
+    osThreadId_t threads_id[threads_num_max];
+    MemmgrHeapThreadStats stats_before[threads_num_max];
+    MemmgrHeapThreadStats stats_after;
+    bool traced[threads_num_max];
+
+    uint8_t thread_num = osThreadEnumerate(threads_id, threads_num_max);
+    for(uint8_t i = 0; i < thread_num; i++) {
+        traced[i] = memmgr_heap_get_thread_stats(threads_id[i], &stats_before[i]);
+    }
+    uint32_t alloc_count = memmgr_heap_get_alloc_count();
+    osDelay(interval);
+    alloc_count = memmgr_heap_get_alloc_count() - alloc_count;
+
+    printf("Total allocs/s: %ld\r\n", alloc_count * 1000 / interval);
+    printf("%-20s %-10s %-10s %-10s\r\n", "Name", "Allocs/s", "Frees/s", "Bytes/s");
+    for(uint8_t i = 0; i < thread_num; i++) {
+        if(!traced[i] || !memmgr_heap_get_thread_stats(threads_id[i], &stats_after)) continue;
+        uint32_t allocs = stats_after.alloc_count - stats_before[i].alloc_count;
+        uint32_t frees = stats_after.free_count - stats_before[i].free_count;
+        int32_t bytes = (int32_t)(stats_after.live - stats_before[i].live);
+        printf(
+            "%-20s %-10ld %-10ld %-10ld\r\n",
+            osThreadGetName(threads_id[i]),
+            allocs * 1000 / interval,
+            frees * 1000 / interval,
+            bytes * 1000 / interval);
+    }
+}
+
+static void cli_command_heap_events(Cli* cli) {
+    const size_t events_count = 16;
+    MemmgrHeapTraceEvent events[events_count];
+    uint32_t cursor = 0;
+    uint32_t dropped = 0;
+
+    // Skip history, show only new events
+    while(memmgr_heap_trace_read_events(&cursor, events, events_count, NULL)) {
+    }
+
+    printf("Press CTRL+C to stop\r\n");
+    while(!cli_cmd_interrupt_received(cli)) {
+        size_t read = memmgr_heap_trace_read_events(&cursor, events, events_count, &dropped);
+        if(dropped) {
+            printf("Dropped: %ld\r\n", dropped);
+        }
+        for(size_t i = 0; i < read; i++) {
+            const char* name = events[i].thread_id ? osThreadGetName(events[i].thread_id) : "";
+            printf(
+                "%-10ld %-20s %c 0x%08lx %ld\r\n",
+                events[i].tick,
+                name ? name : "",
+                events[i].type == MemmgrHeapTraceEventTypeAlloc ? 'm' : 'f',
+                events[i].pointer,
+                events[i].size);
+        }
+        if(!read) osDelay(10);
+    }
+}
+
+static void cli_command_heap_pools() {
+    const size_t pools_count_max = 16;
+    FuriPoolStats stats[pools_count_max];
+    size_t pools_count = furi_pool_get_stats_all(stats, pools_count_max);
+
+    printf(
+        "%-20s %-6s %-6s %-6s %-6s %-10s %-10s\r\n",
+        "Name",
+        "Block",
+        "Size",
+        "Used",
+        "Peak",
+        "Hits",
+        "Misses");
+    for(size_t i = 0; i < pools_count; i++) {
+        printf(
+            "%-20s %-6d %-6d %-6d %-6d %-10ld %-10ld\r\n",
+            stats[i].name,
+            stats[i].block_size,
+            stats[i].capacity,
+            stats[i].used,
+            stats[i].peak,
+            stats[i].hits,
+            stats[i].misses);
+    }
+}
+
+void cli_command_heap(Cli* cli, string_t args, void* context) {
+    string_t cmd;
+    string_init(cmd);
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_heap_stats();
+            break;
+        }
+
+        if(string_cmp_str(cmd, "stats") == 0) {
+            cli_command_heap_stats();
+            break;
+        }
+
+        if(string_cmp_str(cmd, "rate") == 0) {
+            cli_command_heap_rate(args);
+            break;
+        }
+
+        if(string_cmp_str(cmd, "events") == 0) {
+            cli_command_heap_events(cli);
+            break;
+        }
+
+        if(string_cmp_str(cmd, "pools") == 0) {
+            cli_command_heap_pools();
+            break;
+        }
+
+        cli_command_heap_print_usage();
+    } while(false);
+
+    string_clear(cmd);
+}
+
 void cli_command_i2c(Cli* cli, string_t args, void* context) {
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_external);
     printf("Scanning external i2c on PC0(SCL)/PC1(SDA)\r\n"
@@ -354,6 +524,32 @@ void cli_command_i2c(Cli* cli, string_t args, void* context) {
     furi_hal_i2c_release(&furi_hal_i2c_handle_external);
 }
 
+static void cli_command_trace_write(const uint8_t* data, size_t size, void* context) {
+    cli_write(context, data, size);
+}
+
+void cli_command_trace(Cli* cli, string_t args, void* context) {
+    if(!furi_trace_is_available()) {
+        printf("Trace points are not compiled in, build firmware with FURI_TRACE=1");
+        return;
+    }
+
+    if(!string_cmp(args, "start")) {
+        furi_trace_clear();
+        furi_trace_set_enabled(true);
+    } else if(!string_cmp(args, "stop")) {
+        furi_trace_set_enabled(false);
+    } else if(!string_cmp(args, "dump")) {
+        // Binary dump, size is in header, decode with scripts/trace.py
+        bool enabled = furi_trace_is_enabled();
+        furi_trace_set_enabled(false);
+        furi_trace_dump(cli_command_trace_write, cli);
+        furi_trace_set_enabled(enabled);
+    } else {
+        cli_print_usage("trace", "<start|stop|dump>", string_get_cstr(args));
+    }
+}
+
 void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "!", CliCommandFlagParallelSafe, cli_command_device_info, NULL);
     cli_add_command(cli, "device_info", CliCommandFlagParallelSafe, cli_command_device_info, NULL);
@@ -367,6 +563,8 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "heap", CliCommandFlagParallelSafe, cli_command_heap, NULL);
+    cli_add_command(cli, "trace", CliCommandFlagParallelSafe, cli_command_trace, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
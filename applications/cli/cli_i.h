@@ -11,6 +11,8 @@
 
 #define CLI_LINE_SIZE_MAX
 #define CLI_COMMANDS_TREE_RANK 4
+#define CLI_INPUT_BUFFER_SIZE 64
+#define CLI_OUTPUT_BUFFER_SIZE 256
 
 typedef struct {
     CliCallback callback;
@@ -35,6 +37,14 @@ struct Cli {
     string_t line;
 
     size_t cursor_position;
+
+    // Owned by cli thread, other threads write to terminal directly
+    osThreadId_t thread_id;
+    uint8_t input[CLI_INPUT_BUFFER_SIZE];
+    size_t input_pos;
+    size_t input_len;
+    uint8_t output[CLI_OUTPUT_BUFFER_SIZE];
+    size_t output_len;
 };
 
 Cli* cli_alloc();
@@ -43,6 +53,6 @@ void cli_free(Cli* cli);
 
 void cli_reset(Cli* cli);
 
-void cli_putc(char c);
+void cli_putc(Cli* cli, char c);
 
 void cli_stdout_callback(void* _cookie, const char* data, size_t size);
@@ -50,7 +50,7 @@ void crypto_cli_encrypt(Cli* cli, string_t args) {
                 break;
             } else if(c >= 0x20 && c < 0x7F) {
                 putc(c, stdout);
-                fflush(stdout);
+                cli_flush(cli);
                 string_push_back(input, c);
             } else if(c == CliSymbolAsciiCR) {
                 printf("\r\n");
@@ -124,7 +124,7 @@ void crypto_cli_decrypt(Cli* cli, string_t args) {
                 break;
             } else if(c >= 0x20 && c < 0x7F) {
                 putc(c, stdout);
-                fflush(stdout);
+                cli_flush(cli);
                 string_push_back(hex_input, c);
             } else if(c == CliSymbolAsciiCR) {
                 printf("\r\n");
@@ -323,16 +323,18 @@ static bool animation_manager_is_valid_idle_animation(
     bool result = true;
 
     if(!strcmp(info->name, BAD_BATTERY_ANIMATION_NAME)) {
-        Power* power = furi_record_open("power");
+        FuriRecordHandle* power_record = FURI_RECORD_HANDLE("power");
+        Power* power = furi_record_open_handle(power_record);
         bool battery_is_well = power_is_battery_healthy(power);
-        furi_record_close("power");
+        furi_record_close_handle(power_record);
 
         result = !battery_is_well;
     }
     if(!strcmp(info->name, NO_SD_ANIMATION_NAME)) {
-        Storage* storage = furi_record_open("storage");
+        FuriRecordHandle* storage_record = FURI_RECORD_HANDLE("storage");
+        Storage* storage = furi_record_open_handle(storage_record);
         FS_Error sd_status = storage_sd_status(storage);
-        furi_record_close("storage");
+        furi_record_close_handle(storage_record);
 
         result = (sd_status == FSE_NOT_READY);
     }
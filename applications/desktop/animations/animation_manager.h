@@ -22,6 +22,9 @@ typedef struct FrameBubble {
     const struct FrameBubble* next_bubble;
 } FrameBubble;
 
+/** Window of frames streamed from SD card */
+typedef struct AnimationFrameStream AnimationFrameStream;
+
 typedef struct {
     const FrameBubble* const* frame_bubble_sequences;
     uint8_t frame_bubble_sequences_count;
@@ -32,6 +35,8 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    /* NULL if all frames are resident */
+    AnimationFrameStream* frame_stream;
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
@@ -5,6 +5,7 @@
 #include <furi/dangerous_defines.h>
 #include <storage/storage.h>
 #include <gui/icon_i.h>
+#include <furi_hal_compress.h>
 #include <m-string.h>
 
 #include "animation_manager.h"
@@ -14,13 +15,68 @@
 #include <assets_dolphin_blocking.h>
 
 #define ANIMATION_META_FILE "meta.txt"
+#define ANIMATION_BUNDLE_FILE "animation.bnd"
 #define ANIMATION_DIR "/ext/dolphin"
 #define ANIMATION_MANIFEST_FILE ANIMATION_DIR "/manifest.txt"
 #define TAG "AnimationStorage"
 
+#define ANIMATION_BUNDLE_MAGIC "FBAN"
+#define ANIMATION_BUNDLE_VERSION 1
+/* Decoded frames kept in memory for animation streamed from bundle:
+ * shown one, next one and first active one, plus spare to read into */
+#define ANIMATION_FRAME_WINDOW 3
+#define ANIMATION_FRAME_EMPTY (-1)
+
+/* Bundle layout: header, frames order, bubbles with text,
+ * frame offsets table (frame_count + 1), frames in icon format */
+typedef struct {
+    char magic[4];
+    uint8_t version;
+    uint8_t width;
+    uint8_t height;
+    uint8_t frame_count;
+    uint8_t passive_frames;
+    uint8_t active_frames;
+    uint8_t active_cycles;
+    uint8_t frame_rate;
+    uint16_t duration;
+    uint16_t active_cooldown;
+    uint8_t bubble_slots;
+    uint8_t bubbles_count;
+} __attribute__((packed)) AnimationBundleHeader;
+
+typedef struct {
+    uint8_t slot;
+    uint8_t x;
+    uint8_t y;
+    uint8_t align_h;
+    uint8_t align_v;
+    uint8_t start_frame;
+    uint8_t end_frame;
+    uint8_t text_size;
+} __attribute__((packed)) AnimationBundleBubble;
+
+typedef struct {
+    int16_t frame;
+    uint32_t last_used;
+    uint8_t* data;
+} AnimationFrameSlot;
+
+struct AnimationFrameStream {
+    Storage* storage;
+    File* file;
+    uint32_t* frame_offsets;
+    uint8_t* read_buffer;
+    size_t bitmap_size;
+    uint32_t clock;
+    AnimationFrameSlot slots[ANIMATION_FRAME_WINDOW];
+    AnimationFrameSlot spare; /**< prefetched frame, not visible to drawing */
+};
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation);
 static void animation_storage_free_frames(BubbleAnimation* animation);
 static void animation_storage_free_animation(BubbleAnimation** storage_animation);
+static void animation_storage_free_frame_stream(BubbleAnimation* animation);
 static BubbleAnimation* animation_storage_load_animation(const char* name);
 
 static bool animation_storage_load_single_manifest_info(
@@ -206,7 +262,11 @@ static void animation_storage_free_animation(BubbleAnimation** animation) {
 
     if(*animation) {
         animation_storage_free_bubbles(*animation);
-        animation_storage_free_frames(*animation);
+        if((*animation)->frame_stream) {
+            animation_storage_free_frame_stream(*animation);
+        } else {
+            animation_storage_free_frames(*animation);
+        }
         if((*animation)->frame_order) {
             free((void*)(*animation)->frame_order);
         }
@@ -427,7 +487,7 @@ static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFo
     return success;
 }
 
-static BubbleAnimation* animation_storage_load_animation(const char* name) {
+static BubbleAnimation* animation_storage_load_unpacked_animation(const char* name) {
     furi_assert(name);
     BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
 
@@ -509,6 +569,301 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     return animation;
 }
 
+static void animation_storage_free_frame_stream(BubbleAnimation* animation) {
+    AnimationFrameStream* stream = animation->frame_stream;
+
+    for(size_t i = 0; i < ANIMATION_FRAME_WINDOW; ++i) {
+        free(stream->slots[i].data);
+    }
+    free(stream->spare.data);
+    free(stream->read_buffer);
+    free(stream->frame_offsets);
+    storage_file_free(stream->file);
+    furi_record_close("storage");
+    free(stream);
+    animation->frame_stream = NULL;
+
+    /* frames point to window slots */
+    free((void*)animation->icon_animation.frames);
+}
+
+static AnimationFrameSlot*
+    animation_storage_find_slot(AnimationFrameStream* stream, uint8_t frame) {
+    for(size_t i = 0; i < ANIMATION_FRAME_WINDOW; ++i) {
+        if(stream->slots[i].frame == frame) {
+            return &stream->slots[i];
+        }
+    }
+    return NULL;
+}
+
+bool animation_storage_prefetch_frame(const BubbleAnimation* animation, uint8_t frame) {
+    furi_assert(animation);
+    furi_assert(frame < animation->icon_animation.frame_count);
+
+    AnimationFrameStream* stream = animation->frame_stream;
+    if(!stream || animation_storage_find_slot(stream, frame) || (stream->spare.frame == frame)) {
+        return true;
+    }
+
+    bool result = false;
+    AnimationFrameSlot* spare = &stream->spare;
+    spare->frame = ANIMATION_FRAME_EMPTY;
+    uint32_t size = stream->frame_offsets[frame + 1] - stream->frame_offsets[frame];
+    do {
+        if(!storage_file_seek(stream->file, stream->frame_offsets[frame], true)) break;
+        if(storage_file_read(stream->file, stream->read_buffer, size) != size) break;
+        /* keep frame decoded, so it is drawn without decompression */
+        spare->data[0] = 0x00;
+        if(!furi_hal_compress_icon_decode_buffer(
+               stream->read_buffer, size, &spare->data[1], stream->bitmap_size))
+            break;
+        result = true;
+    } while(0);
+
+    if(result) {
+        spare->frame = frame;
+    } else {
+        /* frame is skipped, previous one stays on screen */
+        FURI_LOG_E(TAG, "Failed to load frame %d", frame);
+    }
+
+    return result;
+}
+
+bool animation_storage_publish_frame(
+    const BubbleAnimation* animation,
+    uint8_t frame,
+    uint8_t keep_frame) {
+    furi_assert(animation);
+    furi_assert(frame < animation->icon_animation.frame_count);
+
+    AnimationFrameStream* stream = animation->frame_stream;
+    if(!stream) {
+        return true;
+    }
+
+    AnimationFrameSlot* slot = animation_storage_find_slot(stream, frame);
+    if(!slot) {
+        if(stream->spare.frame != frame) {
+            return false;
+        }
+        /* least recently used frame goes away, shown one stays */
+        for(size_t i = 0; i < ANIMATION_FRAME_WINDOW; ++i) {
+            AnimationFrameSlot* candidate = &stream->slots[i];
+            if((candidate->frame != keep_frame) &&
+               (!slot || (candidate->last_used < slot->last_used))) {
+                slot = candidate;
+            }
+        }
+        furi_assert(slot);
+
+        const uint8_t** frames = (const uint8_t**)animation->icon_animation.frames;
+        if(slot->frame != ANIMATION_FRAME_EMPTY) {
+            frames[slot->frame] = NULL;
+        }
+        uint8_t* data = slot->data;
+        slot->data = stream->spare.data;
+        slot->frame = frame;
+        stream->spare.data = data;
+        stream->spare.frame = ANIMATION_FRAME_EMPTY;
+        frames[frame] = slot->data;
+    }
+    slot->last_used = ++stream->clock;
+
+    return true;
+}
+
+static bool animation_storage_load_bundle_bubbles(
+    BubbleAnimation* animation,
+    File* file,
+    const AnimationBundleHeader* header) {
+    bool success = false;
+    furi_assert(!animation->frame_bubble_sequences);
+
+    do {
+        if(header->bubble_slots > 20) break;
+        animation->frame_bubble_sequences_count = header->bubble_slots;
+        if(animation->frame_bubble_sequences_count == 0) {
+            success = (header->bubbles_count == 0);
+            break;
+        }
+        animation->frame_bubble_sequences =
+            malloc(sizeof(FrameBubble*) * animation->frame_bubble_sequences_count);
+
+        FrameBubble* bubble = NULL;
+        int16_t index = -1;
+        uint8_t i = 0;
+        for(; i < header->bubbles_count; ++i) {
+            AnimationBundleBubble record;
+            if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+
+            if(record.slot == index) {
+                bubble->next_bubble = malloc(sizeof(FrameBubble));
+                bubble = (FrameBubble*)bubble->next_bubble;
+            } else if(record.slot == index + 1) {
+                /* slots have to start from 0, be ascending sorted, and
+                 * have exact number of slots as specified in header */
+                if(++index >= animation->frame_bubble_sequences_count) break;
+                bubble = malloc(sizeof(FrameBubble));
+                FURI_CONST_ASSIGN_PTR(animation->frame_bubble_sequences[index], bubble);
+            } else {
+                break;
+            }
+
+            if((record.align_h > AlignCenter) || (record.align_v > AlignCenter)) break;
+            if(record.text_size > 100) break;
+
+            bubble->bubble.x = record.x;
+            bubble->bubble.y = record.y;
+            bubble->bubble.align_h = record.align_h;
+            bubble->bubble.align_v = record.align_v;
+            bubble->start_frame = record.start_frame;
+            bubble->end_frame = record.end_frame;
+
+            char* text = malloc(record.text_size + 1);
+            bubble->bubble.text = text;
+            if(storage_file_read(file, text, record.text_size) != record.text_size) break;
+            text[record.text_size] = '\0';
+        }
+        success = (i == header->bubbles_count) &&
+                  ((index + 1) == animation->frame_bubble_sequences_count);
+    } while(0);
+
+    if(!success) {
+        if(animation->frame_bubble_sequences) {
+            FURI_LOG_E(TAG, "Failed to load animation bubbles");
+            animation_storage_free_bubbles(animation);
+        }
+    }
+
+    return success;
+}
+
+static BubbleAnimation* animation_storage_load_bundle_animation(const char* name) {
+    furi_assert(name);
+
+    BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
+    AnimationFrameStream* stream = malloc(sizeof(AnimationFrameStream));
+    animation->frame_stream = stream;
+    stream->storage = furi_record_open("storage");
+    stream->file = storage_file_alloc(stream->storage);
+    string_t path;
+    string_init_printf(path, ANIMATION_DIR "/%s/" ANIMATION_BUNDLE_FILE, name);
+
+    bool success = false;
+    do {
+        AnimationBundleHeader header;
+
+        if(FSE_OK != storage_sd_status(stream->storage)) break;
+        if(!storage_file_open(stream->file, string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(stream->file, &header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(header.magic, ANIMATION_BUNDLE_MAGIC, sizeof(header.magic)) ||
+           (header.version != ANIMATION_BUNDLE_VERSION)) {
+            FURI_LOG_E(TAG, "Unsupported bundle: \'%s\'", string_get_cstr(path));
+            break;
+        }
+
+        uint16_t frames = header.passive_frames + header.active_frames;
+        if(!frames || !header.frame_count || !header.frame_rate) break;
+        animation->frame_order = malloc(frames);
+        if(storage_file_read(stream->file, (void*)animation->frame_order, frames) != frames)
+            break;
+        bool frame_order_ok = true;
+        for(int i = 0; i < frames; ++i) {
+            frame_order_ok &= (animation->frame_order[i] < header.frame_count);
+        }
+        if(!frame_order_ok) break;
+
+        animation->passive_frames = header.passive_frames;
+        animation->active_frames = header.active_frames;
+        animation->active_cycles = header.active_cycles;
+        animation->duration = header.duration;
+        animation->active_cooldown = header.active_cooldown;
+
+        if(!animation_storage_load_bundle_bubbles(animation, stream->file, &header)) break;
+
+        size_t offsets_size = sizeof(uint32_t) * (header.frame_count + 1);
+        stream->frame_offsets = malloc(offsets_size);
+        if(storage_file_read(stream->file, stream->frame_offsets, offsets_size) != offsets_size)
+            break;
+
+        /* icon bitmap is either compressed or not, so it's never
+         * bigger than uncompressed bitmap + 1 byte of header */
+        stream->bitmap_size = ROUND_UP_TO(header.width, 8) * header.height;
+        bool offsets_ok = true;
+        for(int i = 0; i < header.frame_count; ++i) {
+            offsets_ok &= (stream->frame_offsets[i] < stream->frame_offsets[i + 1]) &&
+                          (stream->frame_offsets[i + 1] - stream->frame_offsets[i] <=
+                           stream->bitmap_size + 1);
+        }
+        if(!offsets_ok) {
+            FURI_LOG_E(TAG, "Invalid frames in \'%s\'", string_get_cstr(path));
+            break;
+        }
+
+        stream->read_buffer = malloc(stream->bitmap_size + 1);
+        for(size_t i = 0; i < ANIMATION_FRAME_WINDOW; ++i) {
+            stream->slots[i].frame = ANIMATION_FRAME_EMPTY;
+            stream->slots[i].data = malloc(stream->bitmap_size + 1);
+        }
+        stream->spare.frame = ANIMATION_FRAME_EMPTY;
+        stream->spare.data = malloc(stream->bitmap_size + 1);
+
+        Icon* icon = (Icon*)&animation->icon_animation;
+        FURI_CONST_ASSIGN(icon->frame_count, header.frame_count);
+        FURI_CONST_ASSIGN(icon->frame_rate, header.frame_rate);
+        FURI_CONST_ASSIGN(icon->height, header.height);
+        FURI_CONST_ASSIGN(icon->width, header.width);
+        icon->frames = malloc(sizeof(const uint8_t*) * icon->frame_count);
+
+        /* first passive frame is shown right away */
+        uint8_t first_frame = animation->frame_order[0];
+        success = animation_storage_prefetch_frame(animation, first_frame) &&
+                  animation_storage_publish_frame(animation, first_frame, first_frame);
+    } while(0);
+
+    string_clear(path);
+
+    if(!success) {
+        animation_storage_free_bubbles(animation);
+        animation_storage_free_frame_stream(animation);
+        if(animation->frame_order) {
+            free((void*)animation->frame_order);
+        }
+        free(animation);
+        animation = NULL;
+    }
+
+    return animation;
+}
+
+static BubbleAnimation* animation_storage_load_animation(const char* name) {
+    furi_assert(name);
+
+    uint32_t start_tick = osKernelGetTickCount();
+    size_t heap_before = memmgr_get_free_heap();
+
+    /* Bundle is preferred, separate frame files are supported for older resources */
+    BubbleAnimation* animation = animation_storage_load_bundle_animation(name);
+    if(!animation) {
+        animation = animation_storage_load_unpacked_animation(name);
+    }
+
+    if(animation) {
+        FURI_LOG_I(
+            TAG,
+            "Loaded \'%s\' (%s) in %lums, resident %d bytes",
+            name,
+            animation->frame_stream ? "bundle" : "frames",
+            osKernelGetTickCount() - start_tick,
+            heap_before - memmgr_get_free_heap());
+    }
+
+    return animation;
+}
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation) {
     if(!animation->frame_bubble_sequences) return;
 
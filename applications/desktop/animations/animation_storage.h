@@ -55,6 +55,34 @@ const BubbleAnimation* animation_storage_get_bubble_animation(StorageAnimation*
  */
 void animation_storage_cache_animation(StorageAnimation* storage_animation);
 
+/**
+ * Read and decode frame from SD card into spare buffer, so it can be
+ * published later. Doesn't touch frames visible to drawing, so it is called
+ * without view model lock, but only by one thread at a time.
+ * Does nothing for fully loaded animations.
+ *
+ * @animation   bubble animation
+ * @frame       index of icon frame
+ * @return      true if frame is prefetched or already published
+ */
+bool animation_storage_prefetch_frame(const BubbleAnimation* animation, uint8_t frame);
+
+/**
+ * Make prefetched frame visible in icon frames. Animations from SD card
+ * bundle keep only small window of decoded frames, least recently used
+ * frame pointer is NULL-ed. Only pointers are swapped, call it under
+ * view model lock.
+ *
+ * @animation   bubble animation
+ * @frame       index of icon frame
+ * @keep_frame  index of icon frame being shown, it is never evicted
+ * @return      true if frame is available
+ */
+bool animation_storage_publish_frame(
+    const BubbleAnimation* animation,
+    uint8_t frame,
+    uint8_t keep_frame);
+
 /**
  * Find animation by name.
  * Search through the inner flash, and SD-card if has.
@@ -15,8 +15,13 @@
 #include <timers.h>
 #include <furi/dangerous_defines.h>
 
+#define TAG "BubbleAnimation"
 #define ACTIVE_SHIFT 2
 
+/* Loader thread flags */
+#define BUBBLE_ANIMATION_LOADER_EVENT_LOAD (1UL << 0)
+#define BUBBLE_ANIMATION_LOADER_EVENT_EXIT (1UL << 1)
+
 typedef struct {
     const BubbleAnimation* current;
     const FrameBubble* current_bubble;
@@ -32,12 +37,15 @@ typedef struct {
 struct BubbleAnimationView {
     View* view;
     osTimerId_t timer;
+    FuriThread* loader;
+    osMutexId_t loader_mutex; /**< held while loader uses current animation */
     BubbleAnimationInteractCallback interact_callback;
     void* interact_callback_context;
 };
 
 static void bubble_animation_activate(BubbleAnimationView* view, bool force);
 static void bubble_animation_activate_right_now(BubbleAnimationView* view);
+static void bubble_animation_next_frame(BubbleAnimationViewModel* model);
 
 static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
     furi_assert(model);
@@ -56,6 +64,68 @@ static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model)
     return animation->frame_order[icon_index];
 }
 
+/* Icon frame to be shown on next timer tick, model stays untouched */
+static uint8_t bubble_animation_get_next_frame_index(BubbleAnimationViewModel* model) {
+    BubbleAnimationViewModel next = *model;
+    bubble_animation_next_frame(&next);
+    return bubble_animation_get_frame_index(&next);
+}
+
+static bool bubble_animation_is_frame_ready(const BubbleAnimation* animation, uint8_t index) {
+    return animation->icon_animation.frames[index] != NULL;
+}
+
+static void bubble_animation_request_load(BubbleAnimationView* view) {
+    osThreadFlagsSet(
+        furi_thread_get_thread_id(view->loader), BUBBLE_ANIMATION_LOADER_EVENT_LOAD);
+}
+
+/* Frames of animation streamed from SD card are read by loader thread
+ * ahead of time, timer and drawing only see frames that are ready */
+static void bubble_animation_load_frames(BubbleAnimationView* view) {
+    furi_check(osMutexAcquire(view->loader_mutex, osWaitForever) == osOK);
+
+    uint8_t frames[3];
+    size_t frames_count = 0;
+    BubbleAnimationViewModel* model = view_get_model(view->view);
+    const BubbleAnimation* animation = model->current;
+    if(animation && animation->frame_stream) {
+        frames[frames_count++] = bubble_animation_get_frame_index(model);
+        frames[frames_count++] = bubble_animation_get_next_frame_index(model);
+        if(animation->active_frames && (model->current_frame < animation->passive_frames)) {
+            frames[frames_count++] = animation->frame_order[animation->passive_frames];
+        }
+    }
+    view_commit_model(view->view, false);
+
+    for(size_t i = 0; i < frames_count; ++i) {
+        if(!animation_storage_prefetch_frame(animation, frames[i])) continue;
+        model = view_get_model(view->view);
+        animation_storage_publish_frame(
+            animation, frames[i], bubble_animation_get_frame_index(model));
+        view_commit_model(view->view, false);
+    }
+
+    furi_check(osMutexRelease(view->loader_mutex) == osOK);
+}
+
+static int32_t bubble_animation_loader_thread(void* context) {
+    furi_assert(context);
+    BubbleAnimationView* view = context;
+
+    while(1) {
+        uint32_t flags = osThreadFlagsWait(
+            BUBBLE_ANIMATION_LOADER_EVENT_LOAD | BUBBLE_ANIMATION_LOADER_EVENT_EXIT,
+            osFlagsWaitAny,
+            osWaitForever);
+        furi_check(!(flags & osFlagsError));
+        if(flags & BUBBLE_ANIMATION_LOADER_EVENT_EXIT) break;
+        bubble_animation_load_frames(view);
+    }
+
+    return 0;
+}
+
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     furi_assert(model_);
     furi_assert(canvas);
@@ -79,8 +149,10 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    const uint8_t* frame = animation->icon_animation.frames[index];
+    if(frame) {
+        canvas_draw_bitmap(canvas, 0, y_offset, width, height, frame);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -181,15 +253,27 @@ static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
     furi_assert(view);
 
     uint8_t frame_rate = 0;
+    bool load = false;
 
     BubbleAnimationViewModel* model = view_get_model(view->view);
     if(model->current && (model->current->active_frames > 0) && (!model->freeze_frame)) {
-        model->current_frame = model->current->passive_frames;
-        model->current_bubble = bubble_animation_pick_bubble(model, true);
-        frame_rate = model->current->icon_animation.frame_rate;
+        const BubbleAnimation* animation = model->current;
+        if(bubble_animation_is_frame_ready(
+               animation, animation->frame_order[animation->passive_frames])) {
+            model->current_frame = animation->passive_frames;
+            model->current_bubble = bubble_animation_pick_bubble(model, true);
+            frame_rate = animation->icon_animation.frame_rate;
+        } else {
+            /* try again on next tick, when loader has first active frame */
+            model->active_shift = 1;
+            load = true;
+        }
     }
     view_commit_model(view->view, true);
 
+    if(load) {
+        bubble_animation_request_load(view);
+    }
     if(frame_rate) {
         osTimerStart(view->timer, 1000 / frame_rate);
     }
@@ -229,6 +313,7 @@ static void bubble_animation_timer_callback(void* context) {
     furi_assert(context);
     BubbleAnimationView* view = context;
     bool activate = false;
+    bool load = false;
 
     BubbleAnimationViewModel* model = view_get_model(view->view);
 
@@ -236,12 +321,23 @@ static void bubble_animation_timer_callback(void* context) {
         activate = (--model->active_shift == 0);
     }
 
-    if(!model->freeze_frame && !activate) {
-        bubble_animation_next_frame(model);
+    if(!model->freeze_frame && !activate && model->current) {
+        /* frame streamed from SD card which is not loaded yet
+         * is skipped by showing current one for one more tick */
+        BubbleAnimationViewModel next = *model;
+        bubble_animation_next_frame(&next);
+        uint8_t next_index = bubble_animation_get_frame_index(&next);
+        if(bubble_animation_is_frame_ready(model->current, next_index)) {
+            *model = next;
+        }
+        load = (model->current->frame_stream != NULL);
     }
 
     view_commit_model(view->view, !activate);
 
+    if(load) {
+        bubble_animation_request_load(view);
+    }
     if(activate) {
         bubble_animation_activate_right_now(view);
     }
@@ -249,12 +345,11 @@ static void bubble_animation_timer_callback(void* context) {
 
 /* always freeze first passive frame, because
  * animation is always activated at unfreezing and played
- * passive frame first, and 2 frames after - active
+ * passive frame first, and 2 frames after - active.
+ * Frame is blank if it is NULL.
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
+static Icon* bubble_animation_clone_frame(const Icon* icon_orig, const uint8_t* frame) {
     furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -267,7 +362,9 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
     FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    if(frame) {
+        memcpy((void*)icon_clone->frames[0], frame, max_bitmap_size);
+    }
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -308,6 +405,14 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
     view->view = view_alloc();
     view->interact_callback = NULL;
     view->timer = osTimerNew(bubble_animation_timer_callback, osTimerPeriodic, view, NULL);
+    view->loader_mutex = osMutexNew(NULL);
+    furi_check(view->loader_mutex);
+    view->loader = furi_thread_alloc();
+    furi_thread_set_name(view->loader, "BubbleLoader");
+    furi_thread_set_stack_size(view->loader, 1024);
+    furi_thread_set_context(view->loader, view);
+    furi_thread_set_callback(view->loader, bubble_animation_loader_thread);
+    furi_thread_start(view->loader);
 
     view_allocate_model(view->view, ViewModelTypeLocking, sizeof(BubbleAnimationViewModel));
     view_set_context(view->view, view);
@@ -322,6 +427,14 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
 void bubble_animation_view_free(BubbleAnimationView* view) {
     furi_assert(view);
 
+    osTimerStop(view->timer);
+    osTimerDelete(view->timer);
+    osThreadFlagsSet(
+        furi_thread_get_thread_id(view->loader), BUBBLE_ANIMATION_LOADER_EVENT_EXIT);
+    furi_thread_join(view->loader);
+    furi_thread_free(view->loader);
+    osMutexDelete(view->loader_mutex);
+
     view_set_draw_callback(view->view, NULL);
     view_set_input_callback(view->view, NULL);
     view_set_context(view->view, NULL);
@@ -347,6 +460,8 @@ void bubble_animation_view_set_animation(
     furi_assert(view);
     furi_assert(new_animation);
 
+    /* loader is done with previous animation before it is freed */
+    furi_check(osMutexAcquire(view->loader_mutex, osWaitForever) == osOK);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model);
     model->current = new_animation;
@@ -367,20 +482,45 @@ void bubble_animation_view_set_animation(
     model->current_frame = 0;
     model->active_cycle = 0;
     view_commit_model(view->view, true);
+    furi_check(osMutexRelease(view->loader_mutex) == osOK);
 
+    if(new_animation->frame_stream) {
+        bubble_animation_request_load(view);
+    }
     osTimerStart(view->timer, 1000 / new_animation->icon_animation.frame_rate);
 }
 
 void bubble_animation_freeze(BubbleAnimationView* view) {
     furi_assert(view);
 
+    osTimerStop(view->timer);
+    /* loader is done with animation before it is freed */
+    furi_check(osMutexAcquire(view->loader_mutex, osWaitForever) == osOK);
+
     BubbleAnimationViewModel* model = view_get_model(view->view);
-    furi_assert(model->current);
+    const BubbleAnimation* animation = model->current;
+    furi_assert(animation);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    view_commit_model(view->view, false);
+
+    /* SD card is read without model lock */
+    bool loaded = animation_storage_prefetch_frame(animation, 0);
+
+    model = view_get_model(view->view);
+    const uint8_t* const* frames = animation->icon_animation.frames;
+    uint8_t shown = bubble_animation_get_frame_index(model);
+    const uint8_t* frame = NULL;
+    if(loaded && animation_storage_publish_frame(animation, 0, shown)) {
+        frame = frames[0];
+    } else {
+        FURI_LOG_W(TAG, "First frame is not available, freezing shown one");
+        frame = frames[shown];
+    }
+    model->freeze_frame = bubble_animation_clone_frame(&animation->icon_animation, frame);
     model->current = NULL;
     view_commit_model(view->view, false);
-    osTimerStop(view->timer);
+
+    furi_check(osMutexRelease(view->loader_mutex) == osOK);
 }
 
 void bubble_animation_unfreeze(BubbleAnimationView* view) {
@@ -23,11 +23,12 @@ typedef enum {
     DolphinPubsubEventUpdate,
 } DolphinPubsubEvent;
 
-#define DOLPHIN_DEED(deed)                                        \
-    do {                                                          \
-        Dolphin* dolphin = (Dolphin*)furi_record_open("dolphin"); \
-        dolphin_deed(dolphin, deed);                              \
-        furi_record_close("dolphin");                             \
+#define DOLPHIN_DEED(deed)                                                   \
+    do {                                                                     \
+        FuriRecordHandle* dolphin_record = FURI_RECORD_HANDLE("dolphin");    \
+        Dolphin* dolphin = (Dolphin*)furi_record_open_handle(dolphin_record); \
+        dolphin_deed(dolphin, deed);                                         \
+        furi_record_close_handle(dolphin_record);                            \
     } while(0)
 
 /** Deed complete notification. Call it on deed completion.
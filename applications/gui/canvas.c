@@ -5,6 +5,7 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include <stdint.h>
+#include <string.h>
 #include <u8g2_glue.h>
 
 const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
@@ -20,13 +21,18 @@ Canvas* canvas_init() {
     furi_hal_power_insomnia_enter();
 
     // Setup u8g2
-    u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
+    u8g2_Setup_st756x_flipper(
+        &canvas->fb, U8G2_R0, u8x8_hw_spi_stm32_async, u8g2_gpio_and_delay_stm32_async);
     canvas->orientation = CanvasOrientationHorizontal;
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
     u8g2_SetPowerSave(&canvas->fb, 0);
 
+    // Shadow of display RAM, full buffer is sent on first commit
+    canvas->fb_shadow = malloc(canvas_get_buffer_size(canvas));
+    canvas->commits_till_full = 0;
+
     // Clear buffer and send to device
     canvas_clear(canvas);
     canvas_commit(canvas);
@@ -38,6 +44,8 @@ Canvas* canvas_init() {
 
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
+    u8x8_hw_spi_stm32_async_flush();
+    free(canvas->fb_shadow);
     free(canvas);
 }
 
@@ -51,9 +59,51 @@ void canvas_reset(Canvas* canvas) {
     canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
 }
 
-void canvas_commit(Canvas* canvas) {
+CanvasDirtyTiles
+    canvas_find_dirty_tiles(const uint8_t* buffer, const uint8_t* shadow, uint8_t tile_width) {
+    CanvasDirtyTiles dirty = {.first = 0, .count = 0};
+    uint8_t last = 0;
+
+    for(uint8_t tile = 0; tile < tile_width; tile++) {
+        if(memcmp(&buffer[tile * 8], &shadow[tile * 8], 8) != 0) {
+            if(dirty.count == 0) dirty.first = tile;
+            last = tile;
+            dirty.count = last - dirty.first + 1;
+        }
+    }
+
+    return dirty;
+}
+
+size_t canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    size_t buffer_size = canvas_get_buffer_size(canvas);
+    size_t bytes_sent = 0;
+
+    if(canvas->commits_till_full == 0) {
+        u8g2_SendBuffer(&canvas->fb);
+        canvas->commits_till_full = CANVAS_FULL_COMMIT_PERIOD;
+        bytes_sent = buffer_size;
+    } else {
+        // Send only changed part of every page
+        const uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+        const uint8_t tile_height = u8g2_GetBufferTileHeight(&canvas->fb);
+        const size_t page_size = tile_width * 8;
+        for(uint8_t page = 0; page < tile_height; page++) {
+            CanvasDirtyTiles dirty = canvas_find_dirty_tiles(
+                &buffer[page * page_size], &canvas->fb_shadow[page * page_size], tile_width);
+            if(dirty.count) {
+                u8g2_UpdateDisplayArea(&canvas->fb, dirty.first, page, dirty.count, 1);
+                bytes_sent += dirty.count * 8;
+            }
+        }
+        canvas->commits_till_full--;
+    }
+
+    memcpy(canvas->fb_shadow, buffer, buffer_size);
+
+    return bytes_sent;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
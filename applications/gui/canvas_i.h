@@ -8,6 +8,9 @@
 #include "canvas.h"
 #include <u8g2.h>
 
+/** Full buffer is sent to display every N commits to recover display RAM */
+#define CANVAS_FULL_COMMIT_PERIOD 128
+
 /** Canvas structure
  */
 struct Canvas {
@@ -17,8 +20,17 @@ struct Canvas {
     uint8_t offset_y;
     uint8_t width;
     uint8_t height;
+    uint8_t* fb_shadow;
+    uint8_t commits_till_full;
 };
 
+/** Range of changed tiles in one 8 pixel row page
+ */
+typedef struct {
+    uint8_t first;
+    uint8_t count;
+} CanvasDirtyTiles;
+
 /** Allocate memory and initialize canvas
  *
  * @return     Canvas instance
@@ -37,11 +49,26 @@ void canvas_free(Canvas* canvas);
  */
 void canvas_reset(Canvas* canvas);
 
-/** Commit canvas. Send buffer to display
+/** Commit canvas. Send changed tiles of buffer to display
  *
  * @param      canvas  Canvas instance
+ *
+ * @return     amount of framebuffer bytes sent to display
+ */
+size_t canvas_commit(Canvas* canvas);
+
+/** Find changed tiles in page
+ *
+ * Tile is 8x8 pixels, 8 bytes in framebuffer. Page is a row of tiles.
+ *
+ * @param      buffer      page of current framebuffer
+ * @param      shadow      page of framebuffer sent to display
+ * @param      tile_width  amount of tiles in page
+ *
+ * @return     range of changed tiles, count is 0 if page is not changed
  */
-void canvas_commit(Canvas* canvas);
+CanvasDirtyTiles
+    canvas_find_dirty_tiles(const uint8_t* buffer, const uint8_t* shadow, uint8_t tile_width);
 
 /** Get canvas buffer.
  *
@@ -1,6 +1,8 @@
 #include "gui/canvas.h"
 #include "gui_i.h"
 
+#include <furi_hal.h>
+
 #define TAG "GuiSrv"
 
 ViewPort* gui_view_port_find_enabled(ViewPortArray_t array) {
@@ -193,6 +195,9 @@ void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
 
+    uint32_t frame_start = DWT->CYCCNT;
+    FURI_TRACE_BEGIN(FuriTraceEventGuiRedraw, 0);
+
     canvas_reset(gui->canvas);
 
     if(gui->lockdown) {
@@ -210,7 +215,16 @@ void gui_redraw(Gui* gui) {
         }
     }
 
-    canvas_commit(gui->canvas);
+    size_t bytes_sent = canvas_commit(gui->canvas);
+    FURI_TRACE_END(FuriTraceEventGuiRedraw, bytes_sent);
+
+    uint32_t frame_time = (DWT->CYCCNT - frame_start) / (SystemCoreClock / 1000000);
+    gui->stats.frames++;
+    gui->stats.frame_time_last = frame_time;
+    if(frame_time > gui->stats.frame_time_max) gui->stats.frame_time_max = frame_time;
+    gui->stats.bytes_last = bytes_sent;
+    gui->stats.bytes_total += bytes_sent;
+
     for
         M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
             p->callback(
@@ -427,6 +441,14 @@ size_t gui_get_framebuffer_size(Gui* gui) {
     return canvas_get_buffer_size(gui->canvas);
 }
 
+void gui_get_stats(Gui* gui, GuiStats* stats) {
+    furi_assert(gui);
+    furi_assert(stats);
+    gui_lock(gui);
+    *stats = gui->stats;
+    gui_unlock(gui);
+}
+
 void gui_set_lockdown(Gui* gui, bool lockdown) {
     furi_assert(gui);
     gui_lock(gui);
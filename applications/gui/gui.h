@@ -31,6 +31,15 @@ typedef void (*GuiCanvasCommitCallback)(uint8_t* data, size_t size, void* contex
 
 typedef struct Gui Gui;
 
+/** Gui rendering statistics */
+typedef struct {
+    uint32_t frames; /**< amount of redraws */
+    uint32_t frame_time_last; /**< last redraw and commit time, us */
+    uint32_t frame_time_max; /**< longest redraw and commit time, us */
+    uint32_t bytes_last; /**< framebuffer bytes sent to display by last redraw */
+    uint32_t bytes_total; /**< framebuffer bytes sent to display since start */
+} GuiStats;
+
 /** Add view_port to view_port tree
  *
  * @remark     thread safe
@@ -104,6 +113,13 @@ size_t gui_get_framebuffer_size(Gui* gui);
  */
 void gui_set_lockdown(Gui* gui, bool lockdown);
 
+/** Get rendering statistics
+ *
+ * @param      gui    Gui instance
+ * @param      stats  pointer to GuiStats to fill
+ */
+void gui_get_stats(Gui* gui, GuiStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
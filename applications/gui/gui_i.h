@@ -71,6 +71,9 @@ struct Gui {
     FuriPubSub* input_events;
     uint8_t ongoing_input;
     ViewPort* ongoing_input_view_port;
+
+    // Statistics
+    GuiStats stats;
 };
 
 ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
@@ -1,5 +1,7 @@
 #include "icon_i.h"
 
+#include <furi_hal_compress.h>
+
 uint8_t icon_get_width(const Icon* instance) {
     return instance->width;
 }
@@ -10,4 +12,10 @@ uint8_t icon_get_height(const Icon* instance) {
 
 const uint8_t* icon_get_data(const Icon* instance) {
     return instance->frames[0];
+}
+
+void icon_pin(const Icon* instance) {
+    for(uint8_t i = 0; i < instance->frame_count; i++) {
+        furi_hal_compress_icon_pin(instance->frames[i]);
+    }
 }
\ No newline at end of file
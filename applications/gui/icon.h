@@ -37,6 +37,14 @@ uint8_t icon_get_height(const Icon* instance);
  */
 const uint8_t* icon_get_data(const Icon* instance);
 
+/** Keep decoded Icon frames in decoder cache permanently
+ *
+ * Use for small compressed icons drawn on every frame, like status bar ones.
+ *
+ * @param[in]  instance  pointer to Icon data
+ */
+void icon_pin(const Icon* instance);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
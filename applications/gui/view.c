@@ -1,5 +1,7 @@
 #include "view_i.h"
 
+#include <string.h>
+
 View* view_alloc() {
     View* view = malloc(sizeof(View));
     view->orientation = ViewOrientationHorizontal;
@@ -53,6 +55,8 @@ void view_set_exit_callback(View* view, ViewCallback callback) {
 void view_set_update_callback(View* view, ViewUpdateCallback callback) {
     furi_assert(view);
     view->update_callback = callback;
+    // Update emitted to previous owner may never be drawn
+    __atomic_store_n(&view->update_pending, false, __ATOMIC_SEQ_CST);
 }
 
 void view_set_update_callback_context(View* view, void* context) {
@@ -85,6 +89,19 @@ void view_allocate_model(View* view, ViewModelType type, size_t size) {
         furi_check(model->mutex);
         model->data = malloc(size);
         view->model = model;
+    } else if(view->model_type == ViewModelTypeSnapshot) {
+        ViewModelSnapshot* model = malloc(sizeof(ViewModelSnapshot));
+        model->mutex = osMutexNew(NULL);
+        furi_check(model->mutex);
+        model->size = size;
+        model->data = malloc(size);
+        for(size_t i = 0; i < COUNT_OF(model->buffers); i++) {
+            model->buffers[i] = malloc(size);
+        }
+        model->back = 0;
+        model->middle = 1;
+        model->front = 2;
+        view->model = model;
     } else {
         furi_assert(false);
     }
@@ -102,29 +119,82 @@ void view_free_model(View* view) {
         free(model->data);
         free(model);
         view->model = NULL;
+    } else if(view->model_type == ViewModelTypeSnapshot) {
+        ViewModelSnapshot* model = view->model;
+        furi_check(osMutexDelete(model->mutex) == osOK);
+        for(size_t i = 0; i < COUNT_OF(model->buffers); i++) {
+            free(model->buffers[i]);
+        }
+        free(model->data);
+        free(model);
+        view->model = NULL;
     } else {
         furi_assert(false);
     }
 }
 
+static void view_lock_model(View* view, osMutexId_t mutex) {
+    if(osMutexAcquire(mutex, 0) != osOK) {
+        __atomic_add_fetch(&view->stats.contended, 1, __ATOMIC_RELAXED);
+        furi_check(osMutexAcquire(mutex, osWaitForever) == osOK);
+    }
+}
+
 void* view_get_model(View* view) {
     furi_assert(view);
     if(view->model_type == ViewModelTypeLocking) {
         ViewModelLocking* model = (ViewModelLocking*)(view->model);
-        furi_check(osMutexAcquire(model->mutex, osWaitForever) == osOK);
+        view_lock_model(view, model->mutex);
+        return model->data;
+    } else if(view->model_type == ViewModelTypeSnapshot) {
+        ViewModelSnapshot* model = (ViewModelSnapshot*)(view->model);
+        view_lock_model(view, model->mutex);
         return model->data;
     }
     return view->model;
 }
 
+/* Called with model mutex held */
+static void view_publish_model(ViewModelSnapshot* model) {
+    memcpy(model->buffers[model->back], model->data, model->size);
+    uint8_t back = model->back | VIEW_MODEL_SNAPSHOT_FRESH;
+    back = __atomic_exchange_n(&model->middle, back, __ATOMIC_ACQ_REL);
+    model->back = back & VIEW_MODEL_SNAPSHOT_INDEX;
+}
+
+/* Gui thread only */
+static void* view_take_model_snapshot(ViewModelSnapshot* model) {
+    if(__atomic_load_n(&model->middle, __ATOMIC_ACQUIRE) & VIEW_MODEL_SNAPSHOT_FRESH) {
+        uint8_t middle = __atomic_exchange_n(&model->middle, model->front, __ATOMIC_ACQ_REL);
+        model->front = middle & VIEW_MODEL_SNAPSHOT_INDEX;
+    }
+    return model->buffers[model->front];
+}
+
 void view_commit_model(View* view, bool update) {
     furi_assert(view);
+    if(view->model_type == ViewModelTypeSnapshot) {
+        view_publish_model((ViewModelSnapshot*)(view->model));
+    }
     view_unlock_model(view);
-    if(update && view->update_callback) {
+    __atomic_add_fetch(&view->stats.commits, 1, __ATOMIC_RELAXED);
+    // Draw clears pending flag before reading model, so it sees this commit
+    if(update && view->update_callback &&
+       !__atomic_exchange_n(&view->update_pending, true, __ATOMIC_SEQ_CST)) {
+        __atomic_add_fetch(&view->stats.updates, 1, __ATOMIC_RELAXED);
         view->update_callback(view, view->update_callback_context);
     }
 }
 
+void view_get_stats(View* view, ViewStats* stats) {
+    furi_assert(view);
+    furi_assert(stats);
+    stats->commits = __atomic_load_n(&view->stats.commits, __ATOMIC_RELAXED);
+    stats->updates = __atomic_load_n(&view->stats.updates, __ATOMIC_RELAXED);
+    stats->draws = __atomic_load_n(&view->stats.draws, __ATOMIC_RELAXED);
+    stats->contended = __atomic_load_n(&view->stats.contended, __ATOMIC_RELAXED);
+}
+
 void view_icon_animation_callback(IconAnimation* instance, void* context) {
     furi_assert(context);
     View* view = context;
@@ -138,15 +208,25 @@ void view_unlock_model(View* view) {
     if(view->model_type == ViewModelTypeLocking) {
         ViewModelLocking* model = (ViewModelLocking*)(view->model);
         furi_check(osMutexRelease(model->mutex) == osOK);
+    } else if(view->model_type == ViewModelTypeSnapshot) {
+        ViewModelSnapshot* model = (ViewModelSnapshot*)(view->model);
+        furi_check(osMutexRelease(model->mutex) == osOK);
     }
 }
 
 void view_draw(View* view, Canvas* canvas) {
     furi_assert(view);
+    __atomic_store_n(&view->update_pending, false, __ATOMIC_SEQ_CST);
     if(view->draw_callback) {
-        void* data = view_get_model(view);
-        view->draw_callback(canvas, data);
-        view_unlock_model(view);
+        __atomic_add_fetch(&view->stats.draws, 1, __ATOMIC_RELAXED);
+        if(view->model_type == ViewModelTypeSnapshot) {
+            void* data = view_take_model_snapshot((ViewModelSnapshot*)(view->model));
+            view->draw_callback(canvas, data);
+        } else {
+            void* data = view_get_model(view);
+            view->draw_callback(canvas, data);
+            view_unlock_model(view);
+        }
     }
 }
 
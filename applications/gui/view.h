@@ -86,8 +86,20 @@ typedef enum {
      * Locking gui thread.
      */
     ViewModelTypeLocking,
+    /** Model access is guarded with mutex, draw uses copy made on commit.
+     * Gui thread is never locked. Model must be plain data: copy is shallow.
+     */
+    ViewModelTypeSnapshot,
 } ViewModelType;
 
+/** View counters, for profiling */
+typedef struct {
+    uint32_t commits; /**< model commits */
+    uint32_t updates; /**< update requests passed to gui, after coalescing */
+    uint32_t draws; /**< draw calls */
+    uint32_t contended; /**< model accesses that had to wait for other thread */
+} ViewStats;
+
 /** Allocate and init View
  * @return View instance
  */
@@ -200,12 +212,22 @@ void view_free_model(View* view);
 void* view_get_model(View* view);
 
 /** Commit view model
+ *
+ * Update requests are coalesced: while previous update is not drawn yet,
+ * commit doesn't emit new one.
  *
  * @param      view    View instance
  * @param      update  true if you want to emit view update, false otherwise
  */
 void view_commit_model(View* view, bool update);
 
+/** Get view counters
+ *
+ * @param      view   View instance
+ * @param      stats  pointer to ViewStats to fill
+ */
+void view_get_stats(View* view, ViewStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,6 +13,24 @@ typedef struct {
     osMutexId_t mutex;
 } ViewModelLocking;
 
+/** Triple buffered model: writers modify data under mutex and publish copy,
+ * gui thread draws latest published copy without waiting for writers.
+ * Buffer index in middle is exchanged atomically, FRESH bit is set when
+ * middle buffer was published and not yet taken by reader.
+ */
+#define VIEW_MODEL_SNAPSHOT_FRESH (0x80)
+#define VIEW_MODEL_SNAPSHOT_INDEX (0x7F)
+
+typedef struct {
+    void* data;
+    osMutexId_t mutex;
+    size_t size;
+    void* buffers[3];
+    uint8_t back; /**< writer side, guarded with mutex */
+    uint8_t middle; /**< exchanged by writer and reader */
+    uint8_t front; /**< reader side, gui thread only */
+} ViewModelSnapshot;
+
 struct View {
     ViewDrawCallback draw_callback;
     ViewInputCallback input_callback;
@@ -29,6 +47,9 @@ struct View {
 
     void* model;
     void* context;
+
+    bool update_pending;
+    ViewStats stats;
 };
 
 /** IconAnimation tie callback */
@@ -69,6 +69,15 @@ static void infrared_cli_start_ir_rx(Cli* cli, string_t args) {
         delay(50);
     }
 
+    InfraredWorkerRxStats stats;
+    infrared_worker_rx_get_stats(worker, &stats);
+    printf(
+        "Edges: %lu, blocks: %lu, overruns: %lu, max latency: %luus\r\n",
+        stats.edges,
+        stats.blocks,
+        stats.overruns,
+        stats.latency_max_us);
+
     infrared_worker_rx_stop(worker);
     infrared_worker_free(worker);
 }
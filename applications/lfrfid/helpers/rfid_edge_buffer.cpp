@@ -0,0 +1,63 @@
+#include "rfid_edge_buffer.h"
+#include <string.h>
+
+static_assert((RfidEdgeBuffer::size & (RfidEdgeBuffer::size - 1)) == 0, "size must be power of 2");
+
+RfidEdgeBuffer::RfidEdgeBuffer() {
+    reset();
+}
+
+void RfidEdgeBuffer::reset() {
+    head = 0;
+    tail = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool RfidEdgeBuffer::push(uint32_t timestamp, bool polarity) {
+    uint32_t head_value = head.load(std::memory_order_relaxed);
+    uint32_t fill = head_value - tail.load(std::memory_order_acquire);
+    if(fill >= size) {
+        stats.overruns++;
+        return false;
+    }
+
+    edges[head_value % size] = get_timestamp(timestamp) | polarity;
+    // edge has to be visible before consumer sees it stored
+    head.store(head_value + 1, std::memory_order_release);
+
+    fill++;
+    stats.edges++;
+    if(fill > stats.fill_max) {
+        stats.fill_max = fill;
+    }
+
+    return (fill % batch_size) == 0;
+}
+
+uint32_t RfidEdgeBuffer::pop(uint32_t* _edges, uint32_t max) {
+    uint32_t tail_value = tail.load(std::memory_order_relaxed);
+    uint32_t count = head.load(std::memory_order_acquire) - tail_value;
+    if(count > max) {
+        count = max;
+    }
+
+    for(uint32_t i = 0; i < count; i++) {
+        _edges[i] = edges[(tail_value + i) % size];
+    }
+    // edges have to be copied before producer reuses them
+    tail.store(tail_value + count, std::memory_order_release);
+
+    if(count) {
+        stats.batches++;
+    }
+
+    return count;
+}
+
+void RfidEdgeBuffer::drop() {
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+const RfidEdgeBuffer::Stats& RfidEdgeBuffer::get_stats() const {
+    return stats;
+}
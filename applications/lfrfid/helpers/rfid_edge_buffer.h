@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * @brief Ring of comparator edges between capture interrupt (single producer)
+ * and decoding thread (single consumer). Edge is a CPU cycle timestamp with
+ * polarity in the lowest bit.
+ */
+class RfidEdgeBuffer {
+public:
+    struct Stats {
+        uint32_t edges; /**< edges stored */
+        uint32_t batches; /**< non-empty pops */
+        uint32_t overruns; /**< edges dropped because consumer was late */
+        uint32_t fill_max; /**< max edges waiting in ring */
+    };
+
+    /** Edges in ring, power of 2 */
+    static const uint32_t size = 512;
+    /** Consumer is woken up once per batch of edges */
+    static const uint32_t batch_size = 64;
+
+    RfidEdgeBuffer();
+
+    /**
+     * @brief Drop stored edges and statistics, both sides have to be stopped
+     */
+    void reset();
+
+    /**
+     * @brief Store edge, called by producer
+     *
+     * @param timestamp edge time in CPU cycles
+     * @param polarity edge polarity
+     * @return true - batch is ready, consumer should be woken up
+     */
+    bool push(uint32_t timestamp, bool polarity);
+
+    /**
+     * @brief Take oldest edges, called by consumer
+     *
+     * @param edges edges destination
+     * @param max edges destination size
+     * @return edges taken
+     */
+    uint32_t pop(uint32_t* edges, uint32_t max);
+
+    /**
+     * @brief Drop stored edges, called by consumer
+     */
+    void drop();
+
+    const Stats& get_stats() const;
+
+    static uint32_t get_timestamp(uint32_t edge) {
+        return edge & ~1UL;
+    }
+
+    static bool get_polarity(uint32_t edge) {
+        return edge & 1;
+    }
+
+private:
+    uint32_t edges[size];
+    std::atomic<uint32_t> head; /**< written by producer */
+    std::atomic<uint32_t> tail; /**< written by consumer */
+    Stats stats;
+};
@@ -7,21 +7,78 @@
  * @brief private violation assistant for RfidReader
  */
 struct RfidReaderAccessor {
-    static void decode(RfidReader& rfid_reader, bool polarity) {
-        rfid_reader.decode(polarity);
+    static void push_edge(RfidReader& rfid_reader, bool polarity) {
+        rfid_reader.push_edge(polarity);
+    }
+
+    static int32_t decode_edges(RfidReader& rfid_reader) {
+        return rfid_reader.decode_edges();
     }
 };
 
-void RfidReader::decode(bool polarity) {
-    uint32_t current_dwt_value = DWT->CYCCNT;
-    uint32_t period = current_dwt_value - last_dwt_value;
-    last_dwt_value = current_dwt_value;
+#define RFID_READER_EVENT_EDGES (1UL << 0)
+#define RFID_READER_EVENT_STOP (1UL << 1)
+#define RFID_READER_EVENT_RESTART (1UL << 2)
+#define RFID_READER_EVENTS_ALL \
+    (RFID_READER_EVENT_EDGES | RFID_READER_EVENT_STOP | RFID_READER_EVENT_RESTART)
+/** Slow signals don't fill a batch quickly, decode them at least that often */
+#define RFID_READER_DECODE_TIMEOUT 10
+
+void RfidReader::push_edge(bool polarity) {
+    if(edge_buffer->push(DWT->CYCCNT, polarity)) {
+        osThreadFlagsSet(furi_thread_get_thread_id(decode_thread), RFID_READER_EVENT_EDGES);
+    }
+}
+
+int32_t RfidReader::decode_edges() {
+    uint32_t edges[RfidEdgeBuffer::batch_size];
+
+    while(true) {
+        uint32_t events = osThreadFlagsWait(
+            RFID_READER_EVENTS_ALL, osFlagsWaitAny, RFID_READER_DECODE_TIMEOUT);
+        if((events & osFlagsError) == 0) {
+            if(events & RFID_READER_EVENT_STOP) break;
+            if(events & RFID_READER_EVENT_RESTART) {
+                // Edges captured with previous read config are dropped
+                edge_buffer->drop();
+                decode_reset(type, DWT->CYCCNT);
+            }
+        }
+
+        uint32_t count;
+        while((count = edge_buffer->pop(edges, RfidEdgeBuffer::batch_size))) {
+            decode_batch(edges, count);
+        }
+    }
+
+    return 0;
+}
 
+void RfidReader::decode_restart() {
+    if(decode_thread) {
+        osThreadFlagsSet(furi_thread_get_thread_id(decode_thread), RFID_READER_EVENT_RESTART);
+    }
+}
+
+void RfidReader::decode_reset(RfidReader::Type _type, uint32_t timestamp) {
+    decode_type = _type;
+    last_dwt_value = timestamp;
+}
+
+void RfidReader::decode_batch(const uint32_t* edges, uint32_t count) {
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t timestamp = RfidEdgeBuffer::get_timestamp(edges[i]);
+        decode(RfidEdgeBuffer::get_polarity(edges[i]), timestamp - last_dwt_value);
+        last_dwt_value = timestamp;
+    }
+}
+
+void RfidReader::decode(bool polarity, uint32_t period) {
 #ifdef RFID_GPIO_DEBUG
     decoder_gpio_out.process_front(polarity, period);
 #endif
 
-    switch(type) {
+    switch(decode_type) {
     case Type::Normal:
         decoder_em.process_front(polarity, period);
         decoder_hid26.process_front(polarity, period);
@@ -57,13 +114,20 @@ void RfidReader::switch_mode() {
         break;
     }
 
+    decode_restart();
     switch_timer_reset();
 }
 
 static void comparator_trigger_callback(bool level, void* comp_ctx) {
     RfidReader* _this = static_cast<RfidReader*>(comp_ctx);
 
-    RfidReaderAccessor::decode(*_this, !level);
+    RfidReaderAccessor::push_edge(*_this, !level);
+}
+
+static int32_t decode_thread_callback(void* context) {
+    RfidReader* _this = static_cast<RfidReader*>(context);
+
+    return RfidReaderAccessor::decode_edges(*_this);
 }
 
 RfidReader::RfidReader() {
@@ -72,10 +136,21 @@ RfidReader::RfidReader() {
 void RfidReader::start() {
     type = Type::Normal;
 
+    if(!decode_thread) {
+        edge_buffer = new RfidEdgeBuffer();
+        decode_thread = furi_thread_alloc();
+        furi_thread_set_name(decode_thread, "RfidDecoder");
+        furi_thread_set_stack_size(decode_thread, 1024);
+        furi_thread_set_context(decode_thread, this);
+        furi_thread_set_callback(decode_thread, decode_thread_callback);
+        furi_thread_start(decode_thread);
+    }
+
     furi_hal_rfid_pins_read();
     furi_hal_rfid_tim_read(125000, 0.5);
     furi_hal_rfid_tim_read_start();
     start_comparator();
+    decode_restart();
 
     switch_timer_reset();
     last_readed_count = 0;
@@ -93,6 +168,15 @@ void RfidReader::stop() {
     furi_hal_rfid_tim_read_stop();
     furi_hal_rfid_tim_reset();
     stop_comparator();
+
+    if(decode_thread) {
+        osThreadFlagsSet(furi_thread_get_thread_id(decode_thread), RFID_READER_EVENT_STOP);
+        furi_thread_join(decode_thread);
+        furi_thread_free(decode_thread);
+        decode_thread = nullptr;
+        delete edge_buffer;
+        edge_buffer = nullptr;
+    }
 }
 
 bool RfidReader::read(LfrfidKeyType* _type, uint8_t* data, uint8_t data_size, bool switch_enable) {
@@ -155,10 +239,13 @@ bool RfidReader::any_read() {
     return last_readed_count > 0;
 }
 
+RfidEdgeBuffer::Stats RfidReader::get_stats() {
+    furi_assert(edge_buffer);
+    return edge_buffer->get_stats();
+}
+
 void RfidReader::start_comparator(void) {
     furi_hal_rfid_comp_set_callback(comparator_trigger_callback, this);
-    last_dwt_value = DWT->CYCCNT;
-
     furi_hal_rfid_comp_start();
 }
 
@@ -5,6 +5,8 @@
 #include "decoder_hid26.h"
 #include "decoder_indala.h"
 #include "key_info.h"
+#include "rfid_edge_buffer.h"
+#include <furi.h>
 
 //#define RFID_GPIO_DEBUG 1
 
@@ -24,6 +26,23 @@ public:
     bool detect();
     bool any_read();
 
+    /**
+     * @brief Get edge capture statistics, valid between start and stop
+     */
+    RfidEdgeBuffer::Stats get_stats();
+
+    /**
+     * @brief Restart edge decoding in given mode, edges are measured from timestamp.
+     * Called by decode thread, or by edge dump replay when reader is stopped.
+     */
+    void decode_reset(RfidReader::Type type, uint32_t timestamp);
+
+    /**
+     * @brief Feed edges taken from edge buffer to decoders of current mode.
+     * Called by decode thread, or by edge dump replay when reader is stopped.
+     */
+    void decode_batch(const uint32_t* edges, uint32_t count);
+
 private:
     friend struct RfidReaderAccessor;
 
@@ -35,12 +54,20 @@ private:
     DecoderHID26 decoder_hid26;
     DecoderIndala decoder_indala;
 
+    // Comparator interrupt only timestamps edges, decoders run on thread
+    RfidEdgeBuffer* edge_buffer = nullptr;
+    FuriThread* decode_thread = nullptr;
+    // Owned by decode thread, app thread requests restart with decode_restart
     uint32_t last_dwt_value;
+    Type decode_type = Type::Normal;
 
     void start_comparator(void);
     void stop_comparator(void);
 
-    void decode(bool polarity);
+    void push_edge(bool polarity);
+    int32_t decode_edges();
+    void decode_restart();
+    void decode(bool polarity, uint32_t period);
 
     uint32_t detect_ticks;
 
@@ -91,6 +91,14 @@ void lfrfid_cli_read(Cli* cli, string_t args) {
         delay(100);
     }
 
+    RfidEdgeBuffer::Stats stats = reader.get_stats();
+    printf(
+        "Edges: %lu, batches: %lu, overruns: %lu, max fill: %lu\r\n",
+        stats.edges,
+        stats.batches,
+        stats.overruns,
+        stats.fill_max);
+
     printf("Reading stopped\r\n");
     reader.stop();
 
@@ -4,6 +4,86 @@
 static const char* nfc_resources_header = "Flipper EMV resources";
 static const uint32_t nfc_resources_file_version = 1;
 
+/* Index compiled from the text resource by `assets.py emv`: header, entries
+ * sorted by key, names. Entry starts with key length and key padded to key
+ * size, so it is compared with memcmp as is. */
+#define NFC_EMV_INDEX_MAGIC "FEMV"
+#define NFC_EMV_INDEX_VERSION 1
+#define NFC_EMV_INDEX_KEY_SIZE_MAX 16
+#define NFC_EMV_INDEX_ENTRY_SIZE_MAX (1 + NFC_EMV_INDEX_KEY_SIZE_MAX + 3)
+
+#define NFC_EMV_CACHE_SIZE 4
+#define NFC_EMV_CACHE_NAME_SIZE 32
+
+typedef struct {
+    char magic[4];
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t count;
+} __attribute__((packed)) NfcEmvIndexHeader;
+
+typedef enum {
+    NfcEmvResourceAid,
+    NfcEmvResourceCountry,
+    NfcEmvResourceCurrency,
+} NfcEmvResource;
+
+typedef struct {
+    const char* text;
+    const char* index;
+} NfcEmvResourceFiles;
+
+static const NfcEmvResourceFiles nfc_emv_resource_files[] = {
+    [NfcEmvResourceAid] =
+        {
+            .text = "/ext/nfc/assets/aid.nfc",
+            .index = "/ext/nfc/assets/aid.idx",
+        },
+    [NfcEmvResourceCountry] =
+        {
+            .text = "/ext/nfc/assets/country_code.nfc",
+            .index = "/ext/nfc/assets/country_code.idx",
+        },
+    [NfcEmvResourceCurrency] =
+        {
+            .text = "/ext/nfc/assets/currency_code.nfc",
+            .index = "/ext/nfc/assets/currency_code.idx",
+        },
+};
+
+/* Card screens look up the same few keys every time they are shown */
+typedef struct {
+    bool valid;
+    NfcEmvResource resource;
+    uint8_t key[1 + NFC_EMV_INDEX_KEY_SIZE_MAX];
+    char name[NFC_EMV_CACHE_NAME_SIZE];
+} NfcEmvCacheEntry;
+
+static NfcEmvCacheEntry nfc_emv_cache[NFC_EMV_CACHE_SIZE];
+static uint8_t nfc_emv_cache_next;
+
+static bool nfc_emv_cache_get(NfcEmvResource resource, const uint8_t* key, string_t name) {
+    for(size_t i = 0; i < NFC_EMV_CACHE_SIZE; i++) {
+        NfcEmvCacheEntry* entry = &nfc_emv_cache[i];
+        if(entry->valid && entry->resource == resource &&
+           memcmp(entry->key, key, 1 + key[0]) == 0) {
+            string_set_str(name, entry->name);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void nfc_emv_cache_put(NfcEmvResource resource, const uint8_t* key, string_t name) {
+    if(string_size(name) >= NFC_EMV_CACHE_NAME_SIZE) return;
+    NfcEmvCacheEntry* entry = &nfc_emv_cache[nfc_emv_cache_next];
+    nfc_emv_cache_next = (nfc_emv_cache_next + 1) % NFC_EMV_CACHE_SIZE;
+    entry->valid = true;
+    entry->resource = resource;
+    memcpy(entry->key, key, 1 + key[0]);
+    strcpy(entry->name, string_get_cstr(name));
+}
+
 static bool nfc_emv_parser_search_data(
     Storage* storage,
     const char* file_name,
@@ -32,50 +112,132 @@ static bool nfc_emv_parser_search_data(
     return parsed;
 }
 
+static bool nfc_emv_parser_read_name(File* file, uint32_t offset, uint8_t size, string_t name) {
+    if(!storage_file_seek(file, offset, true)) return false;
+    string_reset(name);
+    uint8_t buffer[32];
+    while(size) {
+        uint16_t chunk = MIN(size, sizeof(buffer));
+        if(storage_file_read(file, buffer, chunk) != chunk) return false;
+        for(uint16_t i = 0; i < chunk; i++) {
+            string_push_back(name, buffer[i]);
+        }
+        size -= chunk;
+    }
+    return true;
+}
+
+/* Binary search over index entries, reads only the probed ones
+ * @return true if index was usable, result tells if key was found */
+static bool nfc_emv_parser_search_index(
+    Storage* storage,
+    const char* file_name,
+    const uint8_t* key,
+    string_t data,
+    bool* result) {
+    bool index_valid = false;
+    File* file = storage_file_alloc(storage);
+    *result = false;
+
+    do {
+        if(!storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        NfcEmvIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(header.magic, NFC_EMV_INDEX_MAGIC, sizeof(header.magic)) ||
+           (header.version != NFC_EMV_INDEX_VERSION) ||
+           (header.key_size > NFC_EMV_INDEX_KEY_SIZE_MAX)) {
+            break;
+        }
+        index_valid = true;
+        // Key is longer than any key in the index
+        if(key[0] > header.key_size) break;
+
+        uint8_t probe[1 + NFC_EMV_INDEX_KEY_SIZE_MAX] = {0};
+        memcpy(probe, key, 1 + key[0]);
+        const size_t compare_size = 1 + header.key_size;
+        const size_t entry_size = compare_size + 3;
+        const uint32_t names = sizeof(header) + header.count * entry_size;
+
+        uint8_t entry[NFC_EMV_INDEX_ENTRY_SIZE_MAX];
+        size_t low = 0;
+        size_t high = header.count;
+        while(low < high) {
+            size_t middle = (low + high) / 2;
+            if(!storage_file_seek(file, sizeof(header) + middle * entry_size, true)) break;
+            if(storage_file_read(file, entry, entry_size) != entry_size) break;
+            int compare = memcmp(entry, probe, compare_size);
+            if(compare == 0) {
+                uint16_t name_offset = entry[compare_size] | (entry[compare_size + 1] << 8);
+                uint8_t name_size = entry[compare_size + 2];
+                *result = nfc_emv_parser_read_name(file, names + name_offset, name_size, data);
+                break;
+            } else if(compare < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return index_valid;
+}
+
+/* Key is length followed by key bytes */
+static bool nfc_emv_parser_get_name(
+    Storage* storage,
+    NfcEmvResource resource,
+    const uint8_t* key,
+    string_t name) {
+    furi_assert(key[0] <= NFC_EMV_INDEX_KEY_SIZE_MAX);
+    if(nfc_emv_cache_get(resource, key, name)) return true;
+
+    bool parsed = false;
+    const NfcEmvResourceFiles* files = &nfc_emv_resource_files[resource];
+    bool indexed = nfc_emv_parser_search_index(storage, files->index, key, name, &parsed);
+    if(!indexed || !parsed) {
+        // No index on SD card or key added to text resource after index was built
+        string_t key_str;
+        string_init(key_str);
+        for(uint8_t i = 0; i < key[0]; i++) {
+            string_cat_printf(key_str, "%02X", key[1 + i]);
+        }
+        parsed = nfc_emv_parser_search_data(storage, files->text, key_str, name);
+        string_clear(key_str);
+    }
+
+    if(parsed) {
+        nfc_emv_cache_put(resource, key, name);
+    }
+    return parsed;
+}
+
 bool nfc_emv_parser_get_aid_name(
     Storage* storage,
     uint8_t* aid,
     uint8_t aid_len,
     string_t aid_name) {
     furi_assert(storage);
-    bool parsed = false;
-    string_t key;
-    string_init(key);
-    for(uint8_t i = 0; i < aid_len; i++) {
-        string_cat_printf(key, "%02X", aid[i]);
-    }
-    if(nfc_emv_parser_search_data(storage, "/ext/nfc/assets/aid.nfc", key, aid_name)) {
-        parsed = true;
-    }
-    string_clear(key);
-    return parsed;
+    if(aid_len > NFC_EMV_INDEX_KEY_SIZE_MAX) return false;
+    uint8_t key[1 + NFC_EMV_INDEX_KEY_SIZE_MAX];
+    key[0] = aid_len;
+    memcpy(&key[1], aid, aid_len);
+    return nfc_emv_parser_get_name(storage, NfcEmvResourceAid, key, aid_name);
 }
 
 bool nfc_emv_parser_get_country_name(
     Storage* storage,
     uint16_t country_code,
     string_t country_name) {
-    bool parsed = false;
-    string_t key;
-    string_init_printf(key, "%04X", country_code);
-    if(nfc_emv_parser_search_data(storage, "/ext/nfc/assets/country_code.nfc", key, country_name)) {
-        parsed = true;
-    }
-    string_clear(key);
-    return parsed;
+    uint8_t key[] = {2, country_code >> 8, country_code & 0xFF};
+    return nfc_emv_parser_get_name(storage, NfcEmvResourceCountry, key, country_name);
 }
 
 bool nfc_emv_parser_get_currency_name(
     Storage* storage,
     uint16_t currency_code,
     string_t currency_name) {
-    bool parsed = false;
-    string_t key;
-    string_init_printf(key, "%04X", currency_code);
-    if(nfc_emv_parser_search_data(
-           storage, "/ext/nfc/assets/currency_code.nfc", key, currency_name)) {
-        parsed = true;
-    }
-    string_clear(key);
-    return parsed;
+    uint8_t key[] = {2, currency_code >> 8, currency_code & 0xFF};
+    return nfc_emv_parser_get_name(storage, NfcEmvResourceCurrency, key, currency_name);
 }
@@ -5,7 +5,9 @@
 #include <flipper_format/flipper_format.h>
 
 static const char* nfc_file_header = "Flipper NFC device";
-static const uint32_t nfc_file_version = 2;
+static const uint32_t nfc_file_version = 3;
+// Version 2 files store Mifare Ultralight pages as one "Page N" key each
+static const uint32_t nfc_file_version_page_keys = 2;
 
 NfcDevice* nfc_device_alloc() {
     NfcDevice* nfc_dev = malloc(sizeof(NfcDevice));
@@ -101,18 +103,10 @@ static bool nfc_device_save_mifare_ul_data(FlipperFormat* file, NfcDevice* dev)
             }
         }
         if(!counters_saved) break;
-        // Write pages data
+        // Write pages data in one block
         uint32_t pages_total = data->data_size / 4;
         if(!flipper_format_write_uint32(file, "Pages total", &pages_total, 1)) break;
-        bool pages_saved = true;
-        for(uint16_t i = 0; i < data->data_size; i += 4) {
-            string_printf(temp_str, "Page %d", i / 4);
-            if(!flipper_format_write_hex(file, string_get_cstr(temp_str), &data->data[i], 4)) {
-                pages_saved = false;
-                break;
-            }
-        }
-        if(!pages_saved) break;
+        if(!flipper_format_write_hex(file, "Pages data", data->data, data->data_size)) break;
         saved = true;
     } while(false);
 
@@ -120,7 +114,7 @@ static bool nfc_device_save_mifare_ul_data(FlipperFormat* file, NfcDevice* dev)
     return saved;
 }
 
-bool nfc_device_load_mifare_ul_data(FlipperFormat* file, NfcDevice* dev) {
+bool nfc_device_load_mifare_ul_data(FlipperFormat* file, NfcDevice* dev, uint32_t version) {
     bool parsed = false;
     MifareUlData* data = &dev->dev_data.mf_ul_data;
     string_t temp_str;
@@ -152,16 +146,22 @@ bool nfc_device_load_mifare_ul_data(FlipperFormat* file, NfcDevice* dev) {
         // Read pages
         uint32_t pages = 0;
         if(!flipper_format_read_uint32(file, "Pages total", &pages, 1)) break;
+        if(pages * 4 > sizeof(data->data)) break;
         data->data_size = pages * 4;
-        bool pages_parsed = true;
-        for(uint16_t i = 0; i < pages; i++) {
-            string_printf(temp_str, "Page %d", i);
-            if(!flipper_format_read_hex(file, string_get_cstr(temp_str), &data->data[i * 4], 4)) {
-                pages_parsed = false;
-                break;
+        if(version == nfc_file_version_page_keys) {
+            bool pages_parsed = true;
+            for(uint16_t i = 0; i < pages; i++) {
+                string_printf(temp_str, "Page %d", i);
+                if(!flipper_format_read_hex(
+                       file, string_get_cstr(temp_str), &data->data[i * 4], 4)) {
+                    pages_parsed = false;
+                    break;
+                }
             }
+            if(!pages_parsed) break;
+        } else {
+            if(!flipper_format_read_hex(file, "Pages data", data->data, data->data_size)) break;
         }
-        if(!pages_parsed) break;
         parsed = true;
     } while(false);
 
@@ -780,7 +780,8 @@ static bool nfc_device_load_data(NfcDevice* dev, string_t path) {
         // Read and verify file header
         uint32_t version = 0;
         if(!flipper_format_read_header(file, temp_str, &version)) break;
-        if(string_cmp_str(temp_str, nfc_file_header) || (version != nfc_file_version)) {
+        if(string_cmp_str(temp_str, nfc_file_header) ||
+           (version != nfc_file_version && version != nfc_file_version_page_keys)) {
             depricated_version = true;
             break;
         }
@@ -795,7 +796,7 @@ static bool nfc_device_load_data(NfcDevice* dev, string_t path) {
         if(!flipper_format_read_hex(file, "SAK", &data->sak, 1)) break;
         // Parse other data
         if(dev->format == NfcDeviceSaveFormatMifareUl) {
-            if(!nfc_device_load_mifare_ul_data(file, dev)) break;
+            if(!nfc_device_load_mifare_ul_data(file, dev, version)) break;
         } else if(dev->format == NfcDeviceSaveFormatMifareClassic) {
             if(!nfc_device_load_mifare_classic_data(file, dev)) break;
         } else if(dev->format == NfcDeviceSaveFormatMifareDesfire) {
@@ -87,6 +87,7 @@ int32_t nfc_worker_task(void* context) {
 
     furi_hal_power_insomnia_enter();
     furi_hal_nfc_exit_sleep();
+    FURI_TRACE_BEGIN(FuriTraceEventNfcWorker, nfc_worker->state);
 
     if(nfc_worker->state == NfcWorkerStateDetect) {
         nfc_worker_detect(nfc_worker);
@@ -109,6 +110,7 @@ int32_t nfc_worker_task(void* context) {
     } else if(nfc_worker->state == NfcWorkerStateField) {
         nfc_worker_field(nfc_worker);
     }
+    FURI_TRACE_END(FuriTraceEventNfcWorker, nfc_worker->state);
     furi_hal_nfc_deactivate();
     nfc_worker_change_state(nfc_worker, NfcWorkerStateReady);
     furi_hal_power_insomnia_exit();
@@ -124,7 +126,10 @@ void nfc_worker_detect(NfcWorker* nfc_worker) {
     NfcDeviceCommonData* result = &nfc_worker->dev_data->nfc_data;
 
     while(nfc_worker->state == NfcWorkerStateDetect) {
-        if(furi_hal_nfc_detect(&dev_list, &dev_cnt, 1000, true)) {
+        FURI_TRACE_BEGIN(FuriTraceEventNfcDetect, 0);
+        bool detected = furi_hal_nfc_detect(&dev_list, &dev_cnt, 1000, true);
+        FURI_TRACE_END(FuriTraceEventNfcDetect, detected);
+        if(detected) {
             // Process first found device
             dev = &dev_list[0];
             result->uid_len = dev->nfcidLen;
@@ -539,13 +544,13 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
     uint16_t tx_len = 0;
     uint8_t* rx_buff;
     uint16_t* rx_len;
-    MifareUlDevice mf_ul_read;
+    MifareUlDevice* mf_ul_read = malloc(sizeof(MifareUlDevice));
     NfcDeviceData* result = nfc_worker->dev_data;
     nfc_device_data_clear(result);
 
     while(nfc_worker->state == NfcWorkerStateReadMifareUl) {
         furi_hal_nfc_deactivate();
-        memset(&mf_ul_read, 0, sizeof(mf_ul_read));
+        memset(mf_ul_read, 0, sizeof(MifareUlDevice));
         if(furi_hal_nfc_detect(&dev_list, &dev_cnt, 300, false)) {
             if(dev_list[0].type == RFAL_NFC_LISTEN_TYPE_NFCA &&
                mf_ul_check_card_type(
@@ -557,26 +562,26 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
                 tx_len = mf_ul_prepare_get_version(tx_buff);
                 err = furi_hal_nfc_data_exchange(tx_buff, tx_len, &rx_buff, &rx_len, false);
                 if(err == ERR_NONE) {
-                    mf_ul_parse_get_version_response(rx_buff, &mf_ul_read);
+                    mf_ul_parse_get_version_response(rx_buff, mf_ul_read);
                     FURI_LOG_D(
                         TAG,
                         "Mifare Ultralight Type: %d, Pages: %d",
-                        mf_ul_read.data.type,
-                        mf_ul_read.pages_to_read);
+                        mf_ul_read->data.type,
+                        mf_ul_read->pages_to_read);
                     FURI_LOG_D(TAG, "Reading signature ...");
                     tx_len = mf_ul_prepare_read_signature(tx_buff);
                     if(furi_hal_nfc_data_exchange(tx_buff, tx_len, &rx_buff, &rx_len, false)) {
                         FURI_LOG_D(TAG, "Failed reading signature");
-                        memset(mf_ul_read.data.signature, 0, sizeof(mf_ul_read.data.signature));
+                        memset(mf_ul_read->data.signature, 0, sizeof(mf_ul_read->data.signature));
                     } else {
-                        mf_ul_parse_read_signature_response(rx_buff, &mf_ul_read);
+                        mf_ul_parse_read_signature_response(rx_buff, mf_ul_read);
                     }
                 } else if(err == ERR_TIMEOUT) {
                     FURI_LOG_D(
                         TAG,
                         "Card doesn't respond to GET VERSION command. Setting default read parameters");
                     err = ERR_NONE;
-                    mf_ul_set_default_version(&mf_ul_read);
+                    mf_ul_set_default_version(mf_ul_read);
                     // Reinit device
                     furi_hal_nfc_deactivate();
                     if(!furi_hal_nfc_detect(&dev_list, &dev_cnt, 300, false)) {
@@ -589,15 +594,15 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
                     continue;
                 }
 
-                if(mf_ul_read.support_fast_read) {
+                if(mf_ul_read->support_fast_read) {
                     FURI_LOG_D(TAG, "Reading pages ...");
-                    tx_len = mf_ul_prepare_fast_read(tx_buff, 0x00, mf_ul_read.pages_to_read - 1);
+                    tx_len = mf_ul_prepare_fast_read(tx_buff, 0x00, mf_ul_read->pages_to_read - 1);
                     if(furi_hal_nfc_data_exchange(tx_buff, tx_len, &rx_buff, &rx_len, false)) {
                         FURI_LOG_D(TAG, "Failed reading pages");
                         continue;
                     } else {
                         mf_ul_parse_fast_read_response(
-                            rx_buff, 0x00, mf_ul_read.pages_to_read - 1, &mf_ul_read);
+                            rx_buff, 0x00, mf_ul_read->pages_to_read - 1, mf_ul_read);
                     }
 
                     FURI_LOG_D(TAG, "Reading 3 counters ...");
@@ -605,9 +610,9 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
                         tx_len = mf_ul_prepare_read_cnt(tx_buff, i);
                         if(furi_hal_nfc_data_exchange(tx_buff, tx_len, &rx_buff, &rx_len, false)) {
                             FURI_LOG_W(TAG, "Failed reading Counter %d", i);
-                            mf_ul_read.data.counter[i] = 0;
+                            mf_ul_read->data.counter[i] = 0;
                         } else {
-                            mf_ul_parse_read_cnt_response(rx_buff, i, &mf_ul_read);
+                            mf_ul_parse_read_cnt_response(rx_buff, i, mf_ul_read);
                         }
                     }
 
@@ -616,21 +621,21 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
                         tx_len = mf_ul_prepare_check_tearing(tx_buff, i);
                         if(furi_hal_nfc_data_exchange(tx_buff, tx_len, &rx_buff, &rx_len, false)) {
                             FURI_LOG_D(TAG, "Error checking tearing flag %d", i);
-                            mf_ul_read.data.tearing[i] = MF_UL_TEARING_FLAG_DEFAULT;
+                            mf_ul_read->data.tearing[i] = MF_UL_TEARING_FLAG_DEFAULT;
                         } else {
-                            mf_ul_parse_check_tearing_response(rx_buff, i, &mf_ul_read);
+                            mf_ul_parse_check_tearing_response(rx_buff, i, mf_ul_read);
                         }
                     }
                 } else {
                     // READ card with READ command (4 pages at a time)
-                    for(uint8_t page = 0; page < mf_ul_read.pages_to_read; page += 4) {
+                    for(uint8_t page = 0; page < mf_ul_read->pages_to_read; page += 4) {
                         FURI_LOG_D(TAG, "Reading pages %d - %d ...", page, page + 3);
                         tx_len = mf_ul_prepare_read(tx_buff, page);
                         if(furi_hal_nfc_data_exchange(tx_buff, tx_len, &rx_buff, &rx_len, false)) {
                             FURI_LOG_D(TAG, "Read pages %d - %d failed", page, page + 3);
                             continue;
                         } else {
-                            mf_ul_parse_read_response(rx_buff, page, &mf_ul_read);
+                            mf_ul_parse_read_response(rx_buff, page, mf_ul_read);
                         }
                     }
                 }
@@ -643,7 +648,7 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
                 result->nfc_data.protocol = NfcDeviceProtocolMifareUl;
                 memcpy(
                     result->nfc_data.uid, dev_list[0].dev.nfca.nfcId1, result->nfc_data.uid_len);
-                result->mf_ul_data = mf_ul_read.data;
+                result->mf_ul_data = mf_ul_read->data;
 
                 // Notify caller and exit
                 if(nfc_worker->callback) {
@@ -658,12 +663,13 @@ void nfc_worker_read_mifare_ul(NfcWorker* nfc_worker) {
         }
         osDelay(100);
     }
+    free(mf_ul_read);
 }
 
 void nfc_worker_emulate_mifare_ul(NfcWorker* nfc_worker) {
     NfcDeviceCommonData* nfc_common = &nfc_worker->dev_data->nfc_data;
-    MifareUlDevice mf_ul_emulate;
-    mf_ul_prepare_emulation(&mf_ul_emulate, &nfc_worker->dev_data->mf_ul_data);
+    MifareUlDevice* mf_ul_emulate = malloc(sizeof(MifareUlDevice));
+    mf_ul_prepare_emulation(mf_ul_emulate, &nfc_worker->dev_data->mf_ul_data);
     while(nfc_worker->state == NfcWorkerStateEmulateMifareUl) {
         furi_hal_nfc_emulate_nfca(
             nfc_common->uid,
@@ -671,17 +677,18 @@ void nfc_worker_emulate_mifare_ul(NfcWorker* nfc_worker) {
             nfc_common->atqa,
             nfc_common->sak,
             mf_ul_prepare_emulation_response,
-            &mf_ul_emulate,
+            mf_ul_emulate,
             5000);
         // Check if data was modified
-        if(mf_ul_emulate.data_changed) {
-            nfc_worker->dev_data->mf_ul_data = mf_ul_emulate.data;
+        if(mf_ul_emulate->data_changed) {
+            nfc_worker->dev_data->mf_ul_data = mf_ul_emulate->data;
             if(nfc_worker->callback) {
                 nfc_worker->callback(NfcWorkerEventSuccess, nfc_worker->context);
             }
-            mf_ul_emulate.data_changed = false;
+            mf_ul_emulate->data_changed = false;
         }
     }
+    free(mf_ul_emulate);
 }
 
 void nfc_worker_mifare_classic_dict_attack(NfcWorker* nfc_worker) {
@@ -20,6 +20,27 @@ void power_cli_reboot2dfu(Cli* cli, string_t args) {
     power_reboot(PowerBootModeDfu);
 }
 
+void power_cli_info(Cli* cli, string_t args) {
+    Power* power = furi_record_open("power");
+    PowerInfo info;
+    power_get_info(power, &info);
+    furi_record_close("power");
+
+    printf("charge: %d%%\r\n", info.charge);
+    printf("health: %d%%\r\n", info.health);
+    printf("charging: %s\r\n", info.charging ? "yes" : "no");
+    printf("capacity_remaining: %lumAh\r\n", info.capacity_remaining);
+    printf("capacity_full: %lumAh\r\n", info.capacity_full);
+    printf("voltage_charger: %.2fV\r\n", info.voltage_charger);
+    printf("voltage_gauge: %.2fV\r\n", info.voltage_gauge);
+    printf("voltage_vbus: %.2fV\r\n", info.voltage_vbus);
+    printf("current_charger: %.3fA\r\n", info.current_charger);
+    printf("current_gauge: %.3fA\r\n", info.current_gauge);
+    printf("temperature_charger: %.1fC\r\n", info.temperature_charger);
+    printf("temperature_gauge: %.1fC\r\n", info.temperature_gauge);
+    printf("age: %lums\r\n", osKernelGetTickCount() - info.timestamp);
+}
+
 void power_cli_debug(Cli* cli, string_t args) {
     furi_hal_power_dump_state();
 }
@@ -52,6 +73,7 @@ static void power_cli_command_print_usage() {
     printf("\toff\t - shutdown power\r\n");
     printf("\treboot\t - reboot\r\n");
     printf("\treboot2dfu\t - reboot to dfu bootloader\r\n");
+    printf("\tinfo\t - show cached power info\r\n");
     printf("\tdebug\t - show debug information\r\n");
     printf("\t5v <0 or 1>\t - enable or disable 5v ext\r\n");
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
@@ -84,6 +106,11 @@ void power_cli(Cli* cli, string_t args, void* context) {
             break;
         }
 
+        if(string_cmp_str(cmd, "info") == 0) {
+            power_cli_info(cli, args);
+            break;
+        }
+
         if(string_cmp_str(cmd, "debug") == 0) {
             power_cli_debug(cli, args);
             break;
@@ -6,7 +6,7 @@
 #include <gui/view_port.h>
 #include <gui/view.h>
 
-#define POWER_OFF_TIMEOUT 90
+#define POWER_OFF_TIMEOUT 90 /**< seconds */
 
 void power_draw_battery_callback(Canvas* canvas, void* context) {
     furi_assert(context);
@@ -25,6 +25,9 @@ void power_draw_battery_callback(Canvas* canvas, void* context) {
 
 static ViewPort* power_battery_view_port_alloc(Power* power) {
     ViewPort* battery_view_port = view_port_alloc();
+    icon_pin(&I_Battery_26x8);
+    icon_pin(&I_Charging_lightning_mask_9x10);
+    icon_pin(&I_Charging_lightning_9x10);
     view_port_set_width(battery_view_port, icon_get_width(&I_Battery_26x8));
     view_port_draw_callback_set(battery_view_port, power_draw_battery_callback, power);
     gui_add_view_port(power->gui, battery_view_port, GuiLayerStatusBarRight);
@@ -44,7 +47,7 @@ Power* power_alloc() {
     // State initialization
     power->state = PowerStateNotCharging;
     power->battery_low = false;
-    power->power_off_timeout = POWER_OFF_TIMEOUT;
+    power->info_refresh_period = POWER_INFO_REFRESH_PERIOD_DEFAULT;
     power->api_mtx = osMutexNew(NULL);
 
     // Gui
@@ -90,7 +93,7 @@ void power_free(Power* power) {
 }
 
 static void power_check_charging_state(Power* power) {
-    if(furi_hal_power_is_charging()) {
+    if(power->info.charging) {
         if(power->info.charge == 100) {
             if(power->state != PowerStateCharged) {
                 notification_internal_message(power->notification, &sequence_charged);
@@ -118,18 +121,27 @@ static void power_check_charging_state(Power* power) {
 
 static bool power_update_info(Power* power) {
     PowerInfo info;
+    FuriHalPowerTelemetry telemetry;
 
-    info.charge = furi_hal_power_get_pct();
-    info.health = furi_hal_power_get_bat_health_pct();
-    info.capacity_remaining = furi_hal_power_get_battery_remaining_capacity();
-    info.capacity_full = furi_hal_power_get_battery_full_capacity();
-    info.current_charger = furi_hal_power_get_battery_current(FuriHalPowerICCharger);
-    info.current_gauge = furi_hal_power_get_battery_current(FuriHalPowerICFuelGauge);
-    info.voltage_charger = furi_hal_power_get_battery_voltage(FuriHalPowerICCharger);
-    info.voltage_gauge = furi_hal_power_get_battery_voltage(FuriHalPowerICFuelGauge);
-    info.voltage_vbus = furi_hal_power_get_usb_voltage();
-    info.temperature_charger = furi_hal_power_get_battery_temperature(FuriHalPowerICCharger);
-    info.temperature_gauge = furi_hal_power_get_battery_temperature(FuriHalPowerICFuelGauge);
+    // Single bus transaction per IC register block instead of one per value
+    if(!furi_hal_power_get_telemetry(&telemetry)) {
+        // Keep the last good snapshot, its timestamp tells it is stale
+        return false;
+    }
+
+    info.charge = telemetry.charge;
+    info.health = telemetry.health;
+    info.capacity_remaining = telemetry.capacity_remaining;
+    info.capacity_full = telemetry.capacity_full;
+    info.current_charger = telemetry.current_charger;
+    info.current_gauge = telemetry.current_gauge;
+    info.voltage_charger = telemetry.voltage_charger;
+    info.voltage_gauge = telemetry.voltage_gauge;
+    info.voltage_vbus = telemetry.voltage_vbus;
+    info.temperature_charger = telemetry.temperature_charger;
+    info.temperature_gauge = telemetry.temperature_gauge;
+    info.charging = telemetry.charging;
+    info.timestamp = osKernelGetTickCount();
 
     osMutexAcquire(power->api_mtx, osWaitForever);
     bool need_refresh = power->info.charge != info.charge;
@@ -146,19 +158,22 @@ static void power_check_low_battery(Power* power) {
         if(!power->battery_low) {
             view_dispatcher_send_to_front(power->view_dispatcher);
             view_dispatcher_switch_to_view(power->view_dispatcher, PowerViewOff);
+            power->power_off_tick = osKernelGetTickCount();
         }
         power->battery_low = true;
     } else {
         if(power->battery_low) {
             view_dispatcher_switch_to_view(power->view_dispatcher, VIEW_NONE);
-            power->power_off_timeout = POWER_OFF_TIMEOUT;
         }
         power->battery_low = false;
     }
     // If battery low, update view and switch off power after timeout
+    // Count real time: refresh period is not fixed
     if(power->battery_low) {
-        if(power->power_off_timeout) {
-            power_off_set_time_left(power->power_off, power->power_off_timeout--);
+        uint32_t elapsed =
+            (osKernelGetTickCount() - power->power_off_tick) / osKernelGetTickFreq();
+        if(elapsed < POWER_OFF_TIMEOUT) {
+            power_off_set_time_left(power->power_off, POWER_OFF_TIMEOUT - elapsed);
         } else {
             power_off(power);
         }
@@ -201,7 +216,10 @@ int32_t power_srv(void* p) {
             furi_hal_power_check_otg_status();
         }
 
-        osDelay(1000);
+        osMutexAcquire(power->api_mtx, osWaitForever);
+        uint32_t refresh_period = power->info_refresh_period;
+        osMutexRelease(power->api_mtx);
+        osDelay(refresh_period);
     }
 
     power_free(power);
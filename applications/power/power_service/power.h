@@ -6,6 +6,10 @@
 
 typedef struct Power Power;
 
+#define POWER_INFO_REFRESH_PERIOD_DEFAULT 1000
+#define POWER_INFO_REFRESH_PERIOD_MIN 100
+#define POWER_INFO_REFRESH_PERIOD_MAX 10000
+
 typedef enum {
     PowerBootModeNormal,
     PowerBootModeDfu,
@@ -43,6 +47,9 @@ typedef struct {
 
     uint8_t charge;
     uint8_t health;
+
+    bool charging;
+    uint32_t timestamp; /**< system tick of the snapshot */
 } PowerInfo;
 
 /** Power off device
@@ -56,12 +63,25 @@ void power_off(Power* power);
 void power_reboot(PowerBootMode mode);
 
 /** Get power info
+ *
+ * Info is a snapshot cached by power service, reading it doesn't touch the
+ * power ICs. Check timestamp to know how old it is.
  *
  * @param power     Power instance
  * @param info      PowerInfo instance
  */
 void power_get_info(Power* power, PowerInfo* info);
 
+/** Set power info refresh period
+ *
+ * Clamped to POWER_INFO_REFRESH_PERIOD_MIN..POWER_INFO_REFRESH_PERIOD_MAX,
+ * applied after the next refresh.
+ *
+ * @param power     Power instance
+ * @param period    refresh period in ms
+ */
+void power_set_info_refresh_period(Power* power, uint32_t period);
+
 /** Get power event pubsub handler
  *
  * @param power     Power instance
@@ -31,6 +31,15 @@ void power_get_info(Power* power, PowerInfo* info) {
     osMutexRelease(power->api_mtx);
 }
 
+void power_set_info_refresh_period(Power* power, uint32_t period) {
+    furi_assert(power);
+    period = MAX(period, (uint32_t)POWER_INFO_REFRESH_PERIOD_MIN);
+    period = MIN(period, (uint32_t)POWER_INFO_REFRESH_PERIOD_MAX);
+    osMutexAcquire(power->api_mtx, osWaitForever);
+    power->info_refresh_period = period;
+    osMutexRelease(power->api_mtx);
+}
+
 FuriPubSub* power_get_pubsub(Power* power) {
     furi_assert(power);
     return power->event_pubsub;
@@ -36,7 +36,8 @@ struct Power {
     bool battery_low;
     bool show_low_bat_level_message;
     uint8_t battery_level;
-    uint8_t power_off_timeout;
+    uint32_t power_off_tick;
+    uint32_t info_refresh_period;
 
     osMutexId_t api_mtx;
 };
@@ -19,6 +19,11 @@
 
 #define TAG "RpcSrv"
 
+/* Encode buffer fits screen frame and storage chunk responses */
+#define RPC_TX_BLOCK_SIZE (1024 + 64)
+/* Session worker and GUI screen stream may send at the same time */
+#define RPC_TX_IN_FLIGHT 2
+
 typedef enum {
     RpcEvtNewData = (1 << 0),
     RpcEvtDisconnect = (1 << 1),
@@ -64,6 +69,7 @@ struct RpcSession {
     bool terminate;
     void** system_contexts;
     bool decode_error;
+    FuriPool* tx_pool;
 
     osMutexId_t callbacks_mutex;
     RpcSendBytesCallback send_bytes_callback;
@@ -326,12 +332,18 @@ void rpc_print_message(const PB_Main* message) {
     }
     case PB_Main_gui_start_screen_stream_request_tag:
         string_cat_printf(str, "\tstart_screen_stream {\r\n");
+        string_cat_printf(
+            str,
+            "\t\tencoding: %d\r\n",
+            message->content.gui_start_screen_stream_request.encoding);
         break;
     case PB_Main_gui_stop_screen_stream_request_tag:
         string_cat_printf(str, "\tstop_screen_stream {\r\n");
         break;
     case PB_Main_gui_screen_frame_tag:
         string_cat_printf(str, "\tscreen_frame {\r\n");
+        string_cat_printf(
+            str, "\t\tencoding: %d\r\n", message->content.gui_screen_frame.encoding);
         break;
     case PB_Main_gui_send_input_event_request_tag:
         string_cat_printf(str, "\tsend_input_event {\r\n");
@@ -580,6 +592,7 @@ static void rpc_session_free_callback(FuriThreadState thread_state, void* contex
         }
         free(session->system_contexts);
         free(session->decoded_message);
+        furi_pool_free(session->tx_pool);
         RpcHandlerDict_clear(session->handlers);
         vStreamBufferDelete(session->stream);
 
@@ -604,6 +617,7 @@ RpcSession* rpc_session_open(Rpc* rpc) {
     session->rpc = rpc;
     session->terminate = false;
     session->decode_error = false;
+    session->tx_pool = furi_pool_alloc("rpc_tx", RPC_TX_BLOCK_SIZE, RPC_TX_IN_FLIGHT);
     RpcHandlerDict_init(session->handlers);
 
     session->decoded_message = malloc(sizeof(PB_Main));
@@ -680,7 +694,13 @@ void rpc_send(RpcSession* session, PB_Main* message) {
     bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
     furi_check(result && ostream.bytes_written);
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
+    size_t size = ostream.bytes_written;
+    uint8_t* buffer = NULL;
+    if(size <= RPC_TX_BLOCK_SIZE) {
+        buffer = furi_pool_acquire(session->tx_pool);
+    } else {
+        buffer = malloc(size);
+    }
     ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
 
     pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
@@ -695,7 +715,11 @@ void rpc_send(RpcSession* session, PB_Main* message) {
     }
     osMutexRelease(session->callbacks_mutex);
 
-    free(buffer);
+    if(size <= RPC_TX_BLOCK_SIZE) {
+        furi_pool_release(session->tx_pool, buffer);
+    } else {
+        free(buffer);
+    }
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -1,7 +1,9 @@
 #include "flipper.pb.h"
 #include "rpc_i.h"
 #include "gui.pb.h"
+#include "rpc_gui_frame.h"
 #include <gui/gui_i.h>
+#include <furi_hal.h>
 
 #define TAG "RpcGui"
 
@@ -12,6 +14,21 @@ typedef enum {
 
 #define RpcGuiWorkerFlagAny (RpcGuiWorkerFlagTransmit | RpcGuiWorkerFlagExit)
 
+/* Keyframe doesn't depend on previous frame and is sent at least this often,
+ * even if screen is unchanged */
+#define RPC_GUI_KEYFRAME_INTERVAL_MS 1000
+
+typedef struct {
+    uint32_t frames_sent;
+    uint32_t frames_skipped; /* unchanged frames that were not sent */
+    uint32_t frames_coalesced; /* frames replaced by newer one before transmit */
+    uint32_t bytes_sent; /* encoded frame data */
+    uint32_t bytes_raw; /* frame data as if it was sent uncompressed */
+    uint32_t latency_total; /* us, from gui commit to transmit completion */
+    uint32_t latency_max;
+    uint32_t start_tick;
+} RpcGuiStreamStats;
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -23,6 +40,16 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    size_t frame_size;
+    PB_Gui_ScreenFrameEncoding stream_encoding;
+    uint8_t* stream_frame; /* latest frame taken from pending one */
+    uint8_t* sent_frame; /* frame client has after last transmit */
+    osMutexId_t pending_frame_mutex;
+    uint8_t* pending_frame;
+    bool pending_frame_ready;
+    uint32_t pending_frame_timestamp;
+    uint32_t keyframe_tick;
+    RpcGuiStreamStats stream_stats;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -34,16 +61,103 @@ static void
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    furi_assert(size == rpc_gui->frame_size);
 
-    memcpy(buffer, data, size);
+    // GUI thread never waits for transmission, only latest frame is kept
+    furi_check(osMutexAcquire(rpc_gui->pending_frame_mutex, osWaitForever) == osOK);
+    if(rpc_gui->pending_frame_ready) {
+        rpc_gui->stream_stats.frames_coalesced++;
+    }
+    memcpy(rpc_gui->pending_frame, data, size);
+    rpc_gui->pending_frame_ready = true;
+    rpc_gui->pending_frame_timestamp = DWT->CYCCNT;
+    furi_check(osMutexRelease(rpc_gui->pending_frame_mutex) == osOK);
 
     osThreadFlagsSet(
         furi_thread_get_thread_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
+/* Encode stream_frame with the best encoding client accepts. Compressed frame
+ * is used only if it is smaller than raw one, otherwise frame goes out raw. */
+static void rpc_system_gui_screen_stream_frame_encode(RpcGuiSystem* rpc_gui, bool keyframe) {
+    PB_Gui_ScreenFrame* screen_frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    pb_bytes_array_t* frame_data = screen_frame->data;
+    size_t size = rpc_gui->frame_size;
+    size_t encoded_size = 0;
+
+    screen_frame->encoding = PB_Gui_ScreenFrameEncoding_RAW;
+    if(!keyframe && rpc_gui->stream_encoding >= PB_Gui_ScreenFrameEncoding_XOR_RLE) {
+        encoded_size = rpc_gui_frame_encode(
+            rpc_gui->stream_frame, rpc_gui->sent_frame, size, frame_data->bytes, size - 1);
+        if(encoded_size) {
+            screen_frame->encoding = PB_Gui_ScreenFrameEncoding_XOR_RLE;
+        }
+    }
+    if(!encoded_size && rpc_gui->stream_encoding >= PB_Gui_ScreenFrameEncoding_RLE) {
+        encoded_size =
+            rpc_gui_frame_encode(rpc_gui->stream_frame, NULL, size, frame_data->bytes, size - 1);
+        if(encoded_size) {
+            screen_frame->encoding = PB_Gui_ScreenFrameEncoding_RLE;
+        }
+    }
+    if(encoded_size) {
+        frame_data->size = encoded_size;
+    } else {
+        memcpy(frame_data->bytes, rpc_gui->stream_frame, size);
+        frame_data->size = size;
+    }
+
+    // Next delta is taken against this frame
+    uint8_t* sent_frame = rpc_gui->sent_frame;
+    rpc_gui->sent_frame = rpc_gui->stream_frame;
+    rpc_gui->stream_frame = sent_frame;
+}
+
+static void rpc_system_gui_screen_stream_frame_transmit(RpcGuiSystem* rpc_gui) {
+    bool transmit = false;
+    bool keyframe = false;
+    uint32_t timestamp = 0;
+
+    furi_check(osMutexAcquire(rpc_gui->pending_frame_mutex, osWaitForever) == osOK);
+    if(rpc_gui->pending_frame_ready) {
+        rpc_gui->pending_frame_ready = false;
+        timestamp = rpc_gui->pending_frame_timestamp;
+        memcpy(rpc_gui->stream_frame, rpc_gui->pending_frame, rpc_gui->frame_size);
+        transmit = true;
+    }
+    furi_check(osMutexRelease(rpc_gui->pending_frame_mutex) == osOK);
+
+    if(transmit) {
+        keyframe = (osKernelGetTickCount() - rpc_gui->keyframe_tick) >=
+                   RPC_GUI_KEYFRAME_INTERVAL_MS;
+        bool changed =
+            memcmp(rpc_gui->stream_frame, rpc_gui->sent_frame, rpc_gui->frame_size) != 0;
+        if(!keyframe && !changed) {
+            rpc_gui->stream_stats.frames_skipped++;
+            transmit = false;
+        }
+    }
+
+    if(transmit) {
+        rpc_system_gui_screen_stream_frame_encode(rpc_gui, keyframe);
+        rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
+        if(keyframe) {
+            rpc_gui->keyframe_tick = osKernelGetTickCount();
+        }
+
+        uint32_t latency = (DWT->CYCCNT - timestamp) / (SystemCoreClock / 1000000);
+        rpc_gui->stream_stats.frames_sent++;
+        rpc_gui->stream_stats.bytes_sent +=
+            rpc_gui->transmit_frame->content.gui_screen_frame.data->size;
+        rpc_gui->stream_stats.bytes_raw += rpc_gui->frame_size;
+        rpc_gui->stream_stats.latency_total += latency;
+        if(latency > rpc_gui->stream_stats.latency_max) {
+            rpc_gui->stream_stats.latency_max = latency;
+        }
+    }
+}
+
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
@@ -52,7 +166,7 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
     while(true) {
         uint32_t flags = osThreadFlagsWait(RpcGuiWorkerFlagAny, osFlagsWaitAny, osWaitForever);
         if(flags & RpcGuiWorkerFlagTransmit) {
-            rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
+            rpc_system_gui_screen_stream_frame_transmit(rpc_gui);
         }
         if(flags & RpcGuiWorkerFlagExit) {
             break;
@@ -62,6 +176,43 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
     return 0;
 }
 
+static void rpc_system_gui_screen_stream_stop(RpcGuiSystem* rpc_gui) {
+    furi_assert(rpc_gui->is_streaming);
+    rpc_gui->is_streaming = false;
+    // Remove GUI framebuffer callback
+    gui_remove_framebuffer_callback(
+        rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, rpc_gui);
+    // Stop and release worker thread
+    osThreadFlagsSet(furi_thread_get_thread_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
+    furi_thread_join(rpc_gui->transmit_thread);
+    furi_thread_free(rpc_gui->transmit_thread);
+    // Release frames
+    pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
+    free(rpc_gui->transmit_frame);
+    rpc_gui->transmit_frame = NULL;
+    free(rpc_gui->pending_frame);
+    rpc_gui->pending_frame = NULL;
+    free(rpc_gui->stream_frame);
+    rpc_gui->stream_frame = NULL;
+    free(rpc_gui->sent_frame);
+    rpc_gui->sent_frame = NULL;
+    osMutexDelete(rpc_gui->pending_frame_mutex);
+
+    RpcGuiStreamStats* stats = &rpc_gui->stream_stats;
+    uint32_t duration = MAX(osKernelGetTickCount() - stats->start_tick, 1UL);
+    FURI_LOG_I(
+        TAG,
+        "Stream: sent %lu, skipped %lu, coalesced %lu, "
+        "%lu bytes/s (raw %lu), latency avg %luus max %luus",
+        stats->frames_sent,
+        stats->frames_skipped,
+        stats->frames_coalesced,
+        (uint32_t)((uint64_t)stats->bytes_sent * 1000 / duration),
+        (uint32_t)((uint64_t)stats->bytes_raw * 1000 / duration),
+        stats->frames_sent ? stats->latency_total / stats->frames_sent : 0,
+        stats->latency_max);
+}
+
 static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -75,13 +226,29 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
 
     rpc_gui->is_streaming = true;
     size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
-    // Reusable Frame
+    rpc_gui->frame_size = framebuffer_size;
+    // Client that doesn't know about encodings gets raw frames
+    rpc_gui->stream_encoding = MIN(
+        request->content.gui_start_screen_stream_request.encoding,
+        _PB_Gui_ScreenFrameEncoding_MAX);
+    // Reusable Frame, encoded frame never exceeds raw one
     rpc_gui->transmit_frame = malloc(sizeof(PB_Main));
     rpc_gui->transmit_frame->which_content = PB_Main_gui_screen_frame_tag;
     rpc_gui->transmit_frame->command_status = PB_CommandStatus_OK;
     rpc_gui->transmit_frame->content.gui_screen_frame.data =
         malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
     rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+    // Frame written by GUI, picked up by transmission thread
+    rpc_gui->pending_frame = malloc(framebuffer_size);
+    rpc_gui->stream_frame = malloc(framebuffer_size);
+    rpc_gui->sent_frame = malloc(framebuffer_size);
+    rpc_gui->pending_frame_ready = false;
+    rpc_gui->pending_frame_mutex = osMutexNew(NULL);
+    furi_check(rpc_gui->pending_frame_mutex);
+    // First frame is always sent
+    memset(&rpc_gui->stream_stats, 0, sizeof(RpcGuiStreamStats));
+    rpc_gui->stream_stats.start_tick = osKernelGetTickCount();
+    rpc_gui->keyframe_tick = rpc_gui->stream_stats.start_tick - RPC_GUI_KEYFRAME_INTERVAL_MS;
     // Transmission thread for async TX
     rpc_gui->transmit_thread = furi_thread_alloc();
     furi_thread_set_name(rpc_gui->transmit_thread, "GuiRpcWorker");
@@ -104,19 +271,7 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
     furi_assert(session);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        osThreadFlagsSet(
-            furi_thread_get_thread_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_stop(rpc_gui);
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -212,6 +367,33 @@ static void rpc_system_gui_virtual_display_render_callback(Canvas* canvas, void*
     canvas_draw_xbm(canvas, 0, 0, canvas->width, canvas->height, rpc_gui->virtual_display_buffer);
 }
 
+/* Delta frame is applied to whatever is on virtual display now. Broken frame may
+ * leave display partially updated, next keyframe from client fixes it. */
+static bool rpc_system_gui_virtual_display_frame_load(
+    RpcGuiSystem* rpc_gui,
+    const PB_Gui_ScreenFrame* frame) {
+    size_t buffer_size = canvas_get_buffer_size(rpc_gui->gui->canvas);
+    const pb_bytes_array_t* data = frame->data;
+    if(!data) return false;
+
+    switch(frame->encoding) {
+    case PB_Gui_ScreenFrameEncoding_RAW:
+        if(data->size != buffer_size) return false;
+        memcpy(rpc_gui->virtual_display_buffer, data->bytes, buffer_size);
+        return true;
+    case PB_Gui_ScreenFrameEncoding_RLE:
+    case PB_Gui_ScreenFrameEncoding_XOR_RLE:
+        return rpc_gui_frame_decode(
+            data->bytes,
+            data->size,
+            rpc_gui->virtual_display_buffer,
+            buffer_size,
+            frame->encoding == PB_Gui_ScreenFrameEncoding_XOR_RLE);
+    default:
+        return false;
+    }
+}
+
 static void rpc_system_gui_start_virtual_display_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -233,12 +415,8 @@ static void rpc_system_gui_start_virtual_display_process(const PB_Main* request,
     rpc_gui->virtual_display_buffer = malloc(buffer_size);
 
     if(request->content.gui_start_virtual_display_request.has_first_frame) {
-        size_t buffer_size = canvas_get_buffer_size(rpc_gui->gui->canvas);
-        memcpy(
-            rpc_gui->virtual_display_buffer,
-            request->content.gui_start_virtual_display_request.first_frame.data->bytes,
-            buffer_size);
-        rpc_gui->virtual_display_not_empty = true;
+        rpc_gui->virtual_display_not_empty = rpc_system_gui_virtual_display_frame_load(
+            rpc_gui, &request->content.gui_start_virtual_display_request.first_frame);
     }
 
     rpc_gui->virtual_display_view_port = view_port_alloc();
@@ -287,11 +465,10 @@ static void rpc_system_gui_virtual_display_frame_process(const PB_Main* request,
         return;
     }
 
-    size_t buffer_size = canvas_get_buffer_size(rpc_gui->gui->canvas);
-    memcpy(
-        rpc_gui->virtual_display_buffer,
-        request->content.gui_screen_frame.data->bytes,
-        buffer_size);
+    if(!rpc_system_gui_virtual_display_frame_load(rpc_gui, &request->content.gui_screen_frame)) {
+        FURI_LOG_W(TAG, "Virtual display frame can't be decoded, ignoring it");
+        return;
+    }
     rpc_gui->virtual_display_not_empty = true;
     view_port_update(rpc_gui->virtual_display_view_port);
 
@@ -346,8 +523,7 @@ void rpc_system_gui_free(void* context) {
     }
 
     if(rpc_gui->is_streaming) {
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
+        rpc_system_gui_screen_stream_stop(rpc_gui);
     }
     furi_record_close("gui");
     free(rpc_gui);
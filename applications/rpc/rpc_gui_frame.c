@@ -0,0 +1,90 @@
+#include "rpc_gui_frame.h"
+
+#define RPC_GUI_FRAME_RUN_FLAG (0x80)
+#define RPC_GUI_FRAME_RUN_MIN (3)
+#define RPC_GUI_FRAME_RUN_MAX (0x7F + RPC_GUI_FRAME_RUN_MIN)
+#define RPC_GUI_FRAME_LITERAL_MAX (0x7F + 1)
+
+static inline uint8_t
+    rpc_gui_frame_byte(const uint8_t* frame, const uint8_t* reference, size_t i) {
+    return reference ? frame[i] ^ reference[i] : frame[i];
+}
+
+size_t rpc_gui_frame_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* out,
+    size_t out_size) {
+    size_t out_pos = 0;
+    size_t literal = 0;
+    size_t pos = 0;
+
+    while(true) {
+        size_t run = 0;
+        if(pos < size) {
+            uint8_t value = rpc_gui_frame_byte(frame, reference, pos);
+            run = 1;
+            while(pos + run < size && run < RPC_GUI_FRAME_RUN_MAX &&
+                  rpc_gui_frame_byte(frame, reference, pos + run) == value) {
+                run++;
+            }
+        }
+
+        // Pending literals end at frame end, before a run or when block is full
+        bool flush = (pos == size) || (run >= RPC_GUI_FRAME_RUN_MIN) ||
+                     (pos - literal == RPC_GUI_FRAME_LITERAL_MAX);
+        if(flush && pos > literal) {
+            size_t count = pos - literal;
+            if(out_pos + 1 + count > out_size) return 0;
+            out[out_pos++] = count - 1;
+            for(; literal < pos; literal++) {
+                out[out_pos++] = rpc_gui_frame_byte(frame, reference, literal);
+            }
+        }
+
+        if(pos == size) break;
+
+        if(run >= RPC_GUI_FRAME_RUN_MIN) {
+            if(out_pos + 2 > out_size) return 0;
+            out[out_pos++] = RPC_GUI_FRAME_RUN_FLAG | (run - RPC_GUI_FRAME_RUN_MIN);
+            out[out_pos++] = rpc_gui_frame_byte(frame, reference, pos);
+            pos += run;
+            literal = pos;
+        } else {
+            pos++;
+        }
+    }
+
+    return out_pos;
+}
+
+bool rpc_gui_frame_decode(
+    const uint8_t* data,
+    size_t data_size,
+    uint8_t* frame,
+    size_t size,
+    bool delta) {
+    size_t in = 0;
+    size_t pos = 0;
+
+    while(in < data_size) {
+        uint8_t control = data[in++];
+        if(control & RPC_GUI_FRAME_RUN_FLAG) {
+            size_t count = (control & ~RPC_GUI_FRAME_RUN_FLAG) + RPC_GUI_FRAME_RUN_MIN;
+            if(in >= data_size || pos + count > size) return false;
+            uint8_t value = data[in++];
+            for(size_t i = 0; i < count; i++, pos++) {
+                frame[pos] = delta ? frame[pos] ^ value : value;
+            }
+        } else {
+            size_t count = control + 1;
+            if(in + count > data_size || pos + count > size) return false;
+            for(size_t i = 0; i < count; i++, pos++, in++) {
+                frame[pos] = delta ? frame[pos] ^ data[in] : data[in];
+            }
+        }
+    }
+
+    return pos == size;
+}
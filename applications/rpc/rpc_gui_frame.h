@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Screen frame run length encoding
+ *
+ * Stream of blocks, each starting with control byte:
+ * 0x00..0x7F - (control + 1) literal bytes follow
+ * 0x80..0xFF - next byte is repeated ((control & 0x7F) + 3) times
+ *
+ * Delta frames are encoded the same way, over XOR with previous frame,
+ * so unchanged areas turn into long zero runs.
+ */
+
+/** Encode frame
+ *
+ * @param   frame       frame to encode
+ * @param   reference   previous frame for delta encoding, NULL for keyframe
+ * @param   size        frame size, same for reference
+ * @param   out         output buffer
+ * @param   out_size    output buffer size
+ * @return              encoded size, 0 if result doesn't fit into out_size
+ */
+size_t rpc_gui_frame_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* out,
+    size_t out_size);
+
+/** Decode frame
+ *
+ * Frame content is undefined if decoding fails.
+ *
+ * @param   data        encoded data
+ * @param   data_size   encoded data size
+ * @param   frame       output frame, holds previous frame for delta decoding
+ * @param   size        frame size
+ * @param   delta       data is XOR against previous frame
+ * @return              true if data decoded into exactly size bytes
+ */
+bool rpc_gui_frame_decode(
+    const uint8_t* data,
+    size_t data_size,
+    uint8_t* frame,
+    size_t size,
+    bool delta);
@@ -1,6 +1,7 @@
 #include "flipper.pb.h"
 #include "furi/common_defines.h"
 #include "furi/memmgr.h"
+#include "furi/pool.h"
 #include "furi/record.h"
 #include "pb_decode.h"
 #include "rpc/rpc.h"
@@ -14,6 +15,9 @@
 #define RPC_TAG "RPC_STORAGE"
 #define MAX_NAME_LENGTH 255
 #define MAX_DATA_SIZE 512
+/* Read responses are sent one by one from session worker, handlers are
+ * serialized with busy mutex, so one chunk is in flight per session */
+#define READ_CHUNK_POOL_SIZE 1
 
 typedef enum {
     RpcStorageStateIdle = 0,
@@ -22,10 +26,12 @@ typedef enum {
 
 typedef struct {
     RpcSession* session;
+    FuriRecordHandle* storage_record;
     Storage* api;
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    FuriPool* read_chunk_pool;
 } RpcStorageSystem;
 
 void rpc_print_message(const PB_Main* message);
@@ -47,7 +53,7 @@ static void rpc_system_storage_reset_state(
         if(rpc_storage->state == RpcStorageStateWriting) {
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
-            furi_record_close("storage");
+            furi_record_close_handle(rpc_storage->storage_record);
         }
 
         rpc_storage->state = RpcStorageStateIdle;
@@ -113,7 +119,7 @@ static void rpc_system_storage_info_process(const PB_Main* request, void* contex
     PB_Main* response = malloc(sizeof(PB_Main));
     response->command_id = request->command_id;
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
 
     FS_Error error = storage_common_fs_info(
         fs_api,
@@ -130,7 +136,7 @@ static void rpc_system_storage_info_process(const PB_Main* request, void* contex
 
     rpc_send_and_release(session, response);
     free(response);
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
 }
 
 static void rpc_system_storage_stat_process(const PB_Main* request, void* context) {
@@ -147,7 +153,7 @@ static void rpc_system_storage_stat_process(const PB_Main* request, void* contex
     PB_Main* response = malloc(sizeof(PB_Main));
     response->command_id = request->command_id;
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
 
     const char* path = request->content.storage_stat_request.path;
     FileInfo fileinfo;
@@ -167,7 +173,7 @@ static void rpc_system_storage_stat_process(const PB_Main* request, void* contex
 
     rpc_send_and_release(session, response);
     free(response);
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
 }
 
 static void rpc_system_storage_list_root(const PB_Main* request, void* context) {
@@ -214,7 +220,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
         return;
     }
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
     File* dir = storage_file_alloc(fs_api);
 
     PB_Main response = {
@@ -263,7 +269,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     storage_dir_close(dir);
     storage_file_free(dir);
 
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
 }
 
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
@@ -280,7 +286,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     /* use same message memory to send reponse */
     PB_Main* response = malloc(sizeof(PB_Main));
     const char* path = request->content.storage_read_request.path;
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
     File* file = storage_file_alloc(fs_api);
     bool result = false;
 
@@ -292,7 +298,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
             response->command_status = PB_CommandStatus_OK;
             response->content.storage_read_response.has_file = true;
             response->content.storage_read_response.file.data =
-                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, MAX_DATA_SIZE)));
+                furi_pool_acquire(rpc_storage->read_chunk_pool);
             uint8_t* buffer = response->content.storage_read_response.file.data->bytes;
             uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
 
@@ -303,8 +309,13 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
             if(result) {
                 response->has_next = (size_left > 0);
-                rpc_send_and_release(session, response);
+                rpc_send(session, response);
             }
+
+            /* chunk buffer is reused, so it is not released with message */
+            furi_pool_release(
+                rpc_storage->read_chunk_pool, response->content.storage_read_response.file.data);
+            response->content.storage_read_response.file.data = NULL;
         } while((size_left != 0) && result);
 
         if(!result) {
@@ -320,7 +331,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     storage_file_close(file);
     storage_file_free(file);
 
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
 }
 
 static void rpc_system_storage_write_process(const PB_Main* request, void* context) {
@@ -340,7 +351,7 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
     }
 
     if(rpc_storage->state != RpcStorageStateWriting) {
-        rpc_storage->api = furi_record_open("storage");
+        rpc_storage->api = furi_record_open_handle(rpc_storage->storage_record);
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
@@ -400,7 +411,7 @@ static void rpc_system_storage_delete_process(const PB_Main* request, void* cont
     PB_CommandStatus status = PB_CommandStatus_ERROR;
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
 
     char* path = request->content.storage_delete_request.path;
     if(!path) {
@@ -423,7 +434,7 @@ static void rpc_system_storage_delete_process(const PB_Main* request, void* cont
         }
     }
 
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
     rpc_send_and_release_empty(session, request->command_id, status);
 }
 
@@ -438,7 +449,7 @@ static void rpc_system_storage_mkdir_process(const PB_Main* request, void* conte
     PB_CommandStatus status;
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
     char* path = request->content.storage_mkdir_request.path;
     if(path) {
         FS_Error error = storage_common_mkdir(fs_api, path);
@@ -446,7 +457,7 @@ static void rpc_system_storage_mkdir_process(const PB_Main* request, void* conte
     } else {
         status = PB_CommandStatus_ERROR_INVALID_PARAMETERS;
     }
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
     rpc_send_and_release_empty(session, request->command_id, status);
 }
 
@@ -467,7 +478,7 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
         return;
     }
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
     File* file = storage_file_alloc(fs_api);
 
     if(storage_file_open(file, filename, FSAM_READ, FSOM_OPEN_EXISTING)) {
@@ -512,7 +523,7 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
 
     storage_file_free(file);
 
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
 }
 
 static void rpc_system_storage_rename_process(const PB_Main* request, void* context) {
@@ -526,7 +537,7 @@ static void rpc_system_storage_rename_process(const PB_Main* request, void* cont
     PB_CommandStatus status;
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    Storage* fs_api = furi_record_open("storage");
+    Storage* fs_api = furi_record_open_handle(rpc_storage->storage_record);
 
     FS_Error error = storage_common_rename(
         fs_api,
@@ -534,7 +545,7 @@ static void rpc_system_storage_rename_process(const PB_Main* request, void* cont
         request->content.storage_rename_request.new_path);
     status = rpc_system_storage_get_error(error);
 
-    furi_record_close("storage");
+    furi_record_close_handle(rpc_storage->storage_record);
     rpc_send_and_release_empty(session, request->command_id, status);
 }
 
@@ -542,9 +553,12 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     furi_assert(session);
 
     RpcStorageSystem* rpc_storage = malloc(sizeof(RpcStorageSystem));
-    rpc_storage->api = furi_record_open("storage");
+    rpc_storage->storage_record = furi_record_get_handle("storage");
+    rpc_storage->api = furi_record_open_handle(rpc_storage->storage_record);
     rpc_storage->session = session;
     rpc_storage->state = RpcStorageStateIdle;
+    rpc_storage->read_chunk_pool = furi_pool_alloc(
+        "rpc_storage_read", PB_BYTES_ARRAY_T_ALLOCSIZE(MAX_DATA_SIZE), READ_CHUNK_POOL_SIZE);
 
     RpcHandler rpc_handler = {
         .message_handler = NULL,
@@ -588,5 +602,6 @@ void rpc_system_storage_free(void* context) {
     furi_assert(session);
 
     rpc_system_storage_reset_state(rpc_storage, session, false);
+    furi_pool_free(rpc_storage->read_chunk_pool);
     free(rpc_storage);
 }
@@ -79,6 +79,59 @@ static void rpc_system_system_device_info_callback(
     rpc_send_and_release(ctx->session, ctx->response);
 }
 
+static void rpc_system_system_device_info_hal_callback(
+    const char* key,
+    const char* value,
+    bool last,
+    void* context) {
+    // Heap info follows HAL info
+    (void)last;
+    rpc_system_system_device_info_callback(key, value, false, context);
+}
+
+static void rpc_system_system_device_info_heap(RpcSystemSystemDeviceInfoContext* ctx) {
+    string_t key;
+    string_t value;
+    string_init(key);
+    string_init(value);
+
+    const uint8_t threads_num_max = 32;
+    osThreadId_t threads_id[threads_num_max];
+    uint8_t thread_num = osThreadEnumerate(threads_id, threads_num_max);
+    MemmgrHeapThreadStats stats;
+    for(uint8_t i = 0; i < thread_num; i++) {
+        if(!memmgr_heap_get_thread_stats(threads_id[i], &stats)) continue;
+        const char* name = osThreadGetName(threads_id[i]);
+
+        string_printf(key, "heap_thread_%s_live", name);
+        string_printf(value, "%u", stats.live);
+        rpc_system_system_device_info_callback(
+            string_get_cstr(key), string_get_cstr(value), false, ctx);
+        string_printf(key, "heap_thread_%s_peak", name);
+        string_printf(value, "%u", stats.peak);
+        rpc_system_system_device_info_callback(
+            string_get_cstr(key), string_get_cstr(value), false, ctx);
+        string_printf(key, "heap_thread_%s_allocs", name);
+        string_printf(value, "%lu", stats.alloc_count);
+        rpc_system_system_device_info_callback(
+            string_get_cstr(key), string_get_cstr(value), false, ctx);
+        string_printf(key, "heap_thread_%s_frees", name);
+        string_printf(value, "%lu", stats.free_count);
+        rpc_system_system_device_info_callback(
+            string_get_cstr(key), string_get_cstr(value), false, ctx);
+    }
+
+    string_printf(value, "%u", memmgr_get_minimum_free_heap());
+    rpc_system_system_device_info_callback("heap_free_min", string_get_cstr(value), false, ctx);
+    string_printf(value, "%u", memmgr_heap_get_max_free_block());
+    rpc_system_system_device_info_callback("heap_max_block", string_get_cstr(value), false, ctx);
+    string_printf(value, "%u", memmgr_get_free_heap());
+    rpc_system_system_device_info_callback("heap_free", string_get_cstr(value), true, ctx);
+
+    string_clear(value);
+    string_clear(key);
+}
+
 static void rpc_system_system_device_info_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_system_device_info_request_tag);
@@ -95,7 +148,8 @@ static void rpc_system_system_device_info_process(const PB_Main* request, void*
         .session = session,
         .response = response,
     };
-    furi_hal_info_get(rpc_system_system_device_info_callback, &device_info_context);
+    furi_hal_info_get(rpc_system_system_device_info_hal_callback, &device_info_context);
+    rpc_system_system_device_info_heap(&device_info_context);
 
     free(response);
 }
@@ -33,6 +33,8 @@ Storage* storage_app_alloc() {
     Storage* app = malloc(sizeof(Storage));
     app->message_queue = osMessageQueueNew(8, sizeof(StorageMessage), NULL);
     app->pubsub = furi_pubsub_alloc();
+    app->semaphore_pool = furi_pool_alloc_typed(
+        "storage_api", osSemaphoreId_t, STORAGE_API_SEMAPHORE_POOL_SIZE);
 
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
         storage_data_init(&app->storage[i]);
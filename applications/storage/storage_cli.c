@@ -141,7 +141,7 @@ static void storage_cli_read(Cli* cli, string_t path) {
     File* file = storage_file_alloc(api);
 
     if(storage_file_open(file, string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
-        const uint16_t read_size = 128;
+        const uint16_t read_size = 512;
         uint16_t readed_size = 0;
         uint8_t* data = malloc(read_size);
 
@@ -149,9 +149,7 @@ static void storage_cli_read(Cli* cli, string_t path) {
 
         do {
             readed_size = storage_file_read(file, data, read_size);
-            for(uint16_t i = 0; i < readed_size; i++) {
-                printf("%c", data[i]);
-            }
+            cli_write(cli, data, readed_size);
         } while(readed_size > 0);
         printf("\r\n");
 
@@ -196,7 +194,7 @@ static void storage_cli_write(Cli* cli, string_t path) {
 
             buffer[readed_index % buffer_size] = symbol;
             printf("%c", buffer[readed_index % buffer_size]);
-            fflush(stdout);
+            cli_flush(cli);
             readed_index++;
 
             if(((readed_index % buffer_size) == 0)) {
@@ -240,9 +238,7 @@ static void storage_cli_read_chunks(Cli* cli, string_t path, string_t args) {
             cli_getc(cli);
 
             uint16_t readed_size = storage_file_read(file, data, buffer_size);
-            for(uint16_t i = 0; i < readed_size; i++) {
-                putchar(data[i]);
-            }
+            cli_write(cli, data, readed_size);
             file_size -= readed_size;
         }
         printf("\r\n");
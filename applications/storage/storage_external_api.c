@@ -6,9 +6,9 @@
 
 #define MAX_NAME_LENGTH 256
 
-#define S_API_PROLOGUE                                      \
-    osSemaphoreId_t semaphore = osSemaphoreNew(1, 0, NULL); \
-    furi_check(semaphore != NULL);
+#define S_API_PROLOGUE                                                         \
+    osSemaphoreId_t* semaphore_block = storage_api_semaphore_acquire(storage); \
+    osSemaphoreId_t semaphore = *semaphore_block;
 
 #define S_FILE_API_PROLOGUE           \
     Storage* storage = file->storage; \
@@ -17,7 +17,7 @@
 #define S_API_EPILOGUE                                                                         \
     furi_check(osMessageQueuePut(storage->message_queue, &message, 0, osWaitForever) == osOK); \
     osSemaphoreAcquire(semaphore, osWaitForever);                                              \
-    osSemaphoreDelete(semaphore);
+    storage_api_semaphore_release(storage, semaphore_block);
 
 #define S_API_MESSAGE(_command)      \
     SAReturn return_data;            \
@@ -49,6 +49,23 @@
 #define FILE_OPENED 1
 #define FILE_CLOSED 0
 
+/* Api call semaphores are created once and kept in pool between calls */
+static osSemaphoreId_t* storage_api_semaphore_acquire(Storage* storage) {
+    osSemaphoreId_t* semaphore_block = furi_pool_acquire(storage->semaphore_pool);
+    if(*semaphore_block == NULL) {
+        *semaphore_block = osSemaphoreNew(1, 0, NULL);
+        furi_check(*semaphore_block != NULL);
+    }
+    return semaphore_block;
+}
+
+static void storage_api_semaphore_release(Storage* storage, osSemaphoreId_t* semaphore_block) {
+    if(!furi_pool_contains(storage->semaphore_pool, semaphore_block)) {
+        osSemaphoreDelete(*semaphore_block);
+    }
+    furi_pool_release(storage->semaphore_pool, semaphore_block);
+}
+
 /****************** FILE ******************/
 
 bool storage_file_open(
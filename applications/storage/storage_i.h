@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 #define STORAGE_COUNT (ST_INT + 1)
+#define STORAGE_API_SEMAPHORE_POOL_SIZE 8
 
 typedef struct {
     ViewPort* view_port;
@@ -22,6 +23,7 @@ struct Storage {
     StorageStatus prev_ext_storage_status;
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    FuriPool* semaphore_pool;
 };
 
 #ifdef __cplusplus
@@ -1,5 +1,6 @@
 #pragma once
 #include "../subghz_i.h"
+#include <cli/cli.h>
 
 typedef struct SubGhzChatWorker SubGhzChatWorker;
 
@@ -17,7 +18,7 @@ typedef struct {
     char c;
 } SubGhzChatEvent;
 
-SubGhzChatWorker* subghz_chat_worker_alloc();
+SubGhzChatWorker* subghz_chat_worker_alloc(Cli* cli);
 void subghz_chat_worker_free(SubGhzChatWorker* instance);
 bool subghz_chat_worker_start(SubGhzChatWorker* instance, uint32_t frequency);
 void subghz_chat_worker_stop(SubGhzChatWorker* instance);
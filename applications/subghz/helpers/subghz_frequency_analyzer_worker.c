@@ -1,10 +1,18 @@
 #include "subghz_frequency_analyzer_worker.h"
+#include "subghz_frequency_sweep.h"
 #include <lib/drivers/cc1101_regs.h>
 
 #include <furi.h>
 
 #include "../subghz_i.h"
 
+#define TAG "SubGhzFrequencyAnalyzerWorker"
+
+/* RSSI settle time after RX start in ticks, narrow filter responds slower.
+ * osDelay(n) returns after n - 1 to n ticks, so one tick is added on top */
+#define SUBGHZ_FREQUENCY_ANALYZER_SETTLE_WIDE_TICKS (1 + 1)
+#define SUBGHZ_FREQUENCY_ANALYZER_SETTLE_NARROW_TICKS (2 + 1)
+
 static const uint8_t subghz_preset_ook_58khz[][2] = {
     {CC1101_FIFOTHR, 0x47}, // The only important bit is ADC_RETENTION, FIFO Tx=33 Rx=32
     {CC1101_MDMCFG4, 0xF5}, // Rx BW filter is 58.035714kHz
@@ -29,6 +37,8 @@ struct SubGhzFrequencyAnalyzerWorker {
     volatile bool worker_running;
     uint8_t count_repet;
     FrequencyRSSI frequency_rssi_buf;
+    SubGhzFrequencySweepFilter filter;
+    FuriHalSubGhzHop* hops; /**< calibrated coarse pass frequencies */
 
     float filVal;
 
@@ -52,6 +62,50 @@ static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     return (uint32_t)instance->filVal;
 }
 
+static FuriHalSubGhzHop* subghz_frequency_analyzer_worker_get_hop(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint32_t frequency) {
+    for(size_t i = 0; i < subghz_frequencies_count; i++) {
+        if(subghz_frequencies[i] == frequency) return &instance->hops[i];
+    }
+    return NULL;
+}
+
+static bool subghz_frequency_analyzer_worker_measure(
+    void* context,
+    uint32_t* frequency,
+    SubGhzFrequencySweepFilter filter,
+    float* rssi) {
+    SubGhzFrequencyAnalyzerWorker* instance = context;
+    if(!furi_hal_subghz_is_frequency_valid(*frequency)) {
+        return false;
+    }
+
+    furi_hal_subghz_idle();
+    // Filter registers are reloaded only when sweep switches pass
+    if(instance->filter != filter) {
+        if(filter == SubGhzFrequencySweepFilterWide) {
+            furi_hal_subghz_load_registers(subghz_preset_ook_650khz);
+        } else {
+            furi_hal_subghz_load_registers(subghz_preset_ook_58khz);
+        }
+        instance->filter = filter;
+    }
+    // Coarse pass frequencies are calibrated once, refinement ones on every hop
+    FuriHalSubGhzHop* hop = subghz_frequency_analyzer_worker_get_hop(instance, *frequency);
+    if(hop) {
+        *frequency = furi_hal_subghz_hop(hop);
+    } else {
+        *frequency = furi_hal_subghz_set_frequency(*frequency);
+    }
+    furi_hal_subghz_rx();
+    osDelay(
+        filter == SubGhzFrequencySweepFilterWide ? SUBGHZ_FREQUENCY_ANALYZER_SETTLE_WIDE_TICKS :
+                                                   SUBGHZ_FREQUENCY_ANALYZER_SETTLE_NARROW_TICKS);
+    *rssi = furi_hal_subghz_get_rssi();
+    return true;
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -61,9 +115,13 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     SubGhzFrequencyAnalyzerWorker* instance = context;
 
     FrequencyRSSI frequency_rssi = {.frequency = 0, .rssi = 0};
-    float rssi;
-    uint32_t frequency;
-    uint32_t frequency_start;
+    SubGhzFrequencySweep* sweep = subghz_frequency_sweep_alloc(
+        subghz_frequencies,
+        subghz_frequencies_count,
+        subghz_frequency_analyzer_worker_measure,
+        instance);
+    SubGhzFrequencySweepStats stats_last = {0};
+    uint32_t stats_tick = osKernelGetTickCount();
 
     //Start CC1101
     furi_hal_subghz_reset();
@@ -71,49 +129,22 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     furi_hal_subghz_set_frequency(433920000);
     furi_hal_subghz_flush_rx();
     furi_hal_subghz_rx();
+    furi_hal_subghz_idle();
+    furi_hal_subghz_load_registers(subghz_preset_ook_650khz);
+    instance->filter = SubGhzFrequencySweepFilterWide;
 
-    while(instance->worker_running) {
-        osDelay(10);
-        frequency_rssi.rssi = -127.0f;
-        furi_hal_subghz_idle();
-        furi_hal_subghz_load_registers(subghz_preset_ook_650khz);
-        for(size_t i = 0; i < subghz_frequencies_count; i++) {
-            if(furi_hal_subghz_is_frequency_valid(subghz_frequencies[i])) {
-                furi_hal_subghz_idle();
-                frequency = furi_hal_subghz_set_frequency(subghz_frequencies[i]);
-                furi_hal_subghz_rx();
-                osDelay(3);
-                rssi = furi_hal_subghz_get_rssi();
-                if(frequency_rssi.rssi < rssi) {
-                    frequency_rssi.rssi = rssi;
-                    frequency_rssi.frequency = frequency;
-                }
-            }
+    instance->hops = malloc(sizeof(FuriHalSubGhzHop) * subghz_frequencies_count);
+    for(size_t i = 0; i < subghz_frequencies_count; i++) {
+        if(furi_hal_subghz_is_frequency_valid(subghz_frequencies[i])) {
+            furi_hal_subghz_hop_prepare(&instance->hops[i], subghz_frequencies[i]);
         }
+    }
 
-        if(frequency_rssi.rssi > -90.0) {
-            //  -0.5 ... 433.92 ... +0.5
-            frequency_start = frequency_rssi.frequency - 250000;
-            //step 10KHz
-            frequency_rssi.rssi = -127.0;
-            furi_hal_subghz_idle();
-            furi_hal_subghz_load_registers(subghz_preset_ook_58khz);
-            for(uint32_t i = frequency_start; i < frequency_start + 500000; i += 10000) {
-                if(furi_hal_subghz_is_frequency_valid(i)) {
-                    furi_hal_subghz_idle();
-                    frequency = furi_hal_subghz_set_frequency(i);
-                    furi_hal_subghz_rx();
-                    osDelay(3);
-                    rssi = furi_hal_subghz_get_rssi();
-                    if(frequency_rssi.rssi < rssi) {
-                        frequency_rssi.rssi = rssi;
-                        frequency_rssi.frequency = frequency;
-                    }
-                }
-            }
-        }
+    while(instance->worker_running) {
+        // Sweep doesn't measure anything when all frequencies are outside of region
+        osDelay(1);
 
-        if(frequency_rssi.rssi > -90.0) {
+        if(subghz_frequency_sweep_run(sweep, &frequency_rssi.frequency, &frequency_rssi.rssi)) {
             instance->count_repet = 20;
             if(instance->filVal) {
                 frequency_rssi.frequency =
@@ -132,12 +163,29 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
                 if(instance->pair_callback) instance->pair_callback(instance->context, 0, 0);
             }
         }
+
+        uint32_t tick = osKernelGetTickCount();
+        if(tick - stats_tick >= osKernelGetTickFreq()) {
+            SubGhzFrequencySweepStats stats;
+            subghz_frequency_sweep_get_stats(sweep, &stats);
+            FURI_LOG_D(
+                TAG,
+                "%lu sweeps/s, %lu measurements/s",
+                stats.sweeps - stats_last.sweeps,
+                stats.measurements - stats_last.measurements);
+            stats_last = stats;
+            stats_tick = tick;
+        }
     }
 
     //Stop CC1101
     furi_hal_subghz_idle();
     furi_hal_subghz_sleep();
 
+    subghz_frequency_sweep_free(sweep);
+    free(instance->hops);
+    instance->hops = NULL;
+
     return 0;
 }
 
@@ -0,0 +1,224 @@
+#include "subghz_frequency_sweep.h"
+
+#include <furi.h>
+
+#define SUBGHZ_FREQUENCY_SWEEP_THRESHOLD (-90.0f)
+/* Channel stays hot while its decayed peak RSSI is above this */
+#define SUBGHZ_FREQUENCY_SWEEP_HOT (-95.0f)
+#define SUBGHZ_FREQUENCY_SWEEP_DECAY (2.0f)
+#define SUBGHZ_FREQUENCY_SWEEP_COLD_PER_SWEEP 8
+#define SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN (-127.0f)
+
+/* Refinement: grid over +-250 kHz, then search around best grid point */
+#define SUBGHZ_FREQUENCY_SWEEP_SPAN 250000
+#define SUBGHZ_FREQUENCY_SWEEP_GRID_STEP 50000
+#define SUBGHZ_FREQUENCY_SWEEP_TOLERANCE 2000
+
+#define SUBGHZ_FREQUENCY_SWEEP_GOLDEN (0.618034f)
+
+typedef struct {
+    uint32_t frequency;
+    float score; /**< peak RSSI, decays on every measurement */
+} SubGhzFrequencySweepChannel;
+
+typedef struct {
+    uint32_t frequency;
+    float rssi;
+} SubGhzFrequencySweepPoint;
+
+struct SubGhzFrequencySweep {
+    SubGhzFrequencySweepMeasure measure;
+    void* context;
+    SubGhzFrequencySweepRefine refine;
+
+    SubGhzFrequencySweepChannel* channels;
+    size_t channels_count;
+    size_t cold_cursor;
+
+    SubGhzFrequencySweepPoint best;
+    SubGhzFrequencySweepStats stats;
+};
+
+SubGhzFrequencySweep* subghz_frequency_sweep_alloc(
+    const uint32_t* frequencies,
+    size_t count,
+    SubGhzFrequencySweepMeasure measure,
+    void* context) {
+    furi_assert(frequencies);
+    furi_assert(measure);
+    SubGhzFrequencySweep* instance = malloc(sizeof(SubGhzFrequencySweep));
+    instance->measure = measure;
+    instance->context = context;
+    instance->refine = SubGhzFrequencySweepRefineGolden;
+
+    instance->channels = malloc(sizeof(SubGhzFrequencySweepChannel) * count);
+    instance->channels_count = count;
+    for(size_t i = 0; i < count; i++) {
+        instance->channels[i].frequency = frequencies[i];
+        instance->channels[i].score = SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN;
+    }
+
+    return instance;
+}
+
+void subghz_frequency_sweep_free(SubGhzFrequencySweep* instance) {
+    furi_assert(instance);
+    free(instance->channels);
+    free(instance);
+}
+
+void subghz_frequency_sweep_set_refine(
+    SubGhzFrequencySweep* instance,
+    SubGhzFrequencySweepRefine refine) {
+    furi_assert(instance);
+    instance->refine = refine;
+}
+
+void subghz_frequency_sweep_get_stats(
+    SubGhzFrequencySweep* instance,
+    SubGhzFrequencySweepStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    *stats = instance->stats;
+}
+
+/* Measure and track best point of current pass */
+static float subghz_frequency_sweep_measure(
+    SubGhzFrequencySweep* instance,
+    uint32_t frequency,
+    SubGhzFrequencySweepFilter filter) {
+    float rssi = SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN;
+    if(!instance->measure(instance->context, &frequency, filter, &rssi)) {
+        return SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN;
+    }
+    instance->stats.measurements++;
+    if(rssi > instance->best.rssi) {
+        instance->best.rssi = rssi;
+        instance->best.frequency = frequency;
+    }
+    return rssi;
+}
+
+static void subghz_frequency_sweep_measure_channel(
+    SubGhzFrequencySweep* instance,
+    SubGhzFrequencySweepChannel* channel) {
+    float rssi = subghz_frequency_sweep_measure(
+        instance, channel->frequency, SubGhzFrequencySweepFilterWide);
+    channel->score = MAX(rssi, channel->score - SUBGHZ_FREQUENCY_SWEEP_DECAY);
+}
+
+static void subghz_frequency_sweep_coarse(SubGhzFrequencySweep* instance) {
+    // Hot channels on every sweep
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        if(instance->channels[i].score > SUBGHZ_FREQUENCY_SWEEP_HOT) {
+            subghz_frequency_sweep_measure_channel(instance, &instance->channels[i]);
+        }
+    }
+
+    // Few cold channels in turn
+    size_t cold = 0;
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        if(cold == SUBGHZ_FREQUENCY_SWEEP_COLD_PER_SWEEP) break;
+        SubGhzFrequencySweepChannel* channel = &instance->channels[instance->cold_cursor];
+        instance->cold_cursor = (instance->cold_cursor + 1) % instance->channels_count;
+        if(channel->score <= SUBGHZ_FREQUENCY_SWEEP_HOT) {
+            subghz_frequency_sweep_measure_channel(instance, channel);
+            cold++;
+        }
+    }
+}
+
+static void subghz_frequency_sweep_refine_golden(
+    SubGhzFrequencySweep* instance,
+    uint32_t start,
+    uint32_t end) {
+    const SubGhzFrequencySweepFilter filter = SubGhzFrequencySweepFilterNarrow;
+    float a = start;
+    float b = end;
+    float c = b - (b - a) * SUBGHZ_FREQUENCY_SWEEP_GOLDEN;
+    float d = a + (b - a) * SUBGHZ_FREQUENCY_SWEEP_GOLDEN;
+    float fc = subghz_frequency_sweep_measure(instance, c, filter);
+    float fd = subghz_frequency_sweep_measure(instance, d, filter);
+
+    while(b - a > SUBGHZ_FREQUENCY_SWEEP_TOLERANCE) {
+        if(fc > fd) {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - (b - a) * SUBGHZ_FREQUENCY_SWEEP_GOLDEN;
+            fc = subghz_frequency_sweep_measure(instance, c, filter);
+        } else {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + (b - a) * SUBGHZ_FREQUENCY_SWEEP_GOLDEN;
+            fd = subghz_frequency_sweep_measure(instance, d, filter);
+        }
+    }
+}
+
+/* Probes at quarters, so 0.5 dB RSSI steps still tell slopes apart near the peak */
+static void subghz_frequency_sweep_refine_binary(
+    SubGhzFrequencySweep* instance,
+    uint32_t start,
+    uint32_t end) {
+    const SubGhzFrequencySweepFilter filter = SubGhzFrequencySweepFilterNarrow;
+    while(end - start > SUBGHZ_FREQUENCY_SWEEP_TOLERANCE) {
+        uint32_t quarter = (end - start) / 4;
+        uint32_t left = start + quarter;
+        uint32_t right = end - quarter;
+        float rssi_left = subghz_frequency_sweep_measure(instance, left, filter);
+        float rssi_right = subghz_frequency_sweep_measure(instance, right, filter);
+        if(rssi_left > rssi_right) {
+            end = right;
+        } else if(rssi_right > rssi_left) {
+            start = left;
+        } else {
+            start = left;
+            end = right;
+        }
+    }
+}
+
+static void subghz_frequency_sweep_fine(SubGhzFrequencySweep* instance) {
+    uint32_t center = instance->best.frequency;
+    instance->best.rssi = SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN;
+
+    // Grid is dense enough for narrow filter to see the carrier between points
+    for(uint32_t frequency = center - SUBGHZ_FREQUENCY_SWEEP_SPAN;
+        frequency <= center + SUBGHZ_FREQUENCY_SWEEP_SPAN;
+        frequency += SUBGHZ_FREQUENCY_SWEEP_GRID_STEP) {
+        subghz_frequency_sweep_measure(instance, frequency, SubGhzFrequencySweepFilterNarrow);
+    }
+    if(instance->best.rssi == SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN) {
+        return;
+    }
+
+    uint32_t start = instance->best.frequency - SUBGHZ_FREQUENCY_SWEEP_GRID_STEP;
+    uint32_t end = instance->best.frequency + SUBGHZ_FREQUENCY_SWEEP_GRID_STEP;
+    if(instance->refine == SubGhzFrequencySweepRefineGolden) {
+        subghz_frequency_sweep_refine_golden(instance, start, end);
+    } else {
+        subghz_frequency_sweep_refine_binary(instance, start, end);
+    }
+}
+
+bool subghz_frequency_sweep_run(SubGhzFrequencySweep* instance, uint32_t* frequency, float* rssi) {
+    furi_assert(instance);
+    furi_assert(frequency);
+    furi_assert(rssi);
+
+    instance->best.frequency = 0;
+    instance->best.rssi = SUBGHZ_FREQUENCY_SWEEP_RSSI_MIN;
+
+    // Filter is switched twice per sweep at most: all wide, then all narrow
+    subghz_frequency_sweep_coarse(instance);
+    if(instance->best.rssi > SUBGHZ_FREQUENCY_SWEEP_THRESHOLD) {
+        subghz_frequency_sweep_fine(instance);
+    }
+    instance->stats.sweeps++;
+
+    *frequency = instance->best.frequency;
+    *rssi = instance->best.rssi;
+    return instance->best.rssi > SUBGHZ_FREQUENCY_SWEEP_THRESHOLD;
+}
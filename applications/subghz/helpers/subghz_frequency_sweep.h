@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/** Sweep engine for frequency analyzer: coarse pass over known frequencies
+ * with wide filter, then peak refinement around the best one with narrow
+ * filter. Hardware access is done by measure callback, so engine can be fed
+ * with a model.
+ */
+typedef struct SubGhzFrequencySweep SubGhzFrequencySweep;
+
+typedef enum {
+    SubGhzFrequencySweepFilterWide, /**< coarse pass, 650 kHz */
+    SubGhzFrequencySweepFilterNarrow, /**< refinement, 58 kHz */
+} SubGhzFrequencySweepFilter;
+
+typedef enum {
+    SubGhzFrequencySweepRefineGolden, /**< golden-section search, one measure per step */
+    SubGhzFrequencySweepRefineBinary, /**< dichotomous search, two measures per step */
+} SubGhzFrequencySweepRefine;
+
+typedef struct {
+    uint32_t sweeps;
+    uint32_t measurements;
+} SubGhzFrequencySweepStats;
+
+/** Measure callback
+ *
+ * @param context   - context
+ * @param frequency - frequency to tune, set to real frequency on return
+ * @param filter    - SubGhzFrequencySweepFilter
+ * @param rssi      - measured RSSI, dBm
+ * @return false if frequency can't be tuned
+ */
+typedef bool (*SubGhzFrequencySweepMeasure)(
+    void* context,
+    uint32_t* frequency,
+    SubGhzFrequencySweepFilter filter,
+    float* rssi);
+
+/** Allocate SubGhzFrequencySweep
+ *
+ * @param frequencies - coarse pass frequencies, Hz
+ * @param count       - amount of frequencies
+ * @param measure     - SubGhzFrequencySweepMeasure callback
+ * @param context     - callback context
+ * @return SubGhzFrequencySweep*
+ */
+SubGhzFrequencySweep* subghz_frequency_sweep_alloc(
+    const uint32_t* frequencies,
+    size_t count,
+    SubGhzFrequencySweepMeasure measure,
+    void* context);
+
+/** Free SubGhzFrequencySweep
+ *
+ * @param instance - SubGhzFrequencySweep instance
+ */
+void subghz_frequency_sweep_free(SubGhzFrequencySweep* instance);
+
+/** Set peak refinement method
+ *
+ * @param instance - SubGhzFrequencySweep instance
+ * @param refine   - SubGhzFrequencySweepRefine
+ */
+void subghz_frequency_sweep_set_refine(
+    SubGhzFrequencySweep* instance,
+    SubGhzFrequencySweepRefine refine);
+
+/** Run one sweep
+ *
+ * Frequencies where signal was seen recently are measured on every sweep,
+ * the rest are measured few per sweep in turn.
+ *
+ * @param instance  - SubGhzFrequencySweep instance
+ * @param frequency - frequency of the peak, Hz
+ * @param rssi      - RSSI of the peak, dBm
+ * @return true if signal was found
+ */
+bool subghz_frequency_sweep_run(SubGhzFrequencySweep* instance, uint32_t* frequency, float* rssi);
+
+/** Get sweep counters
+ *
+ * @param instance - SubGhzFrequencySweep instance
+ * @param stats    - SubGhzFrequencySweepStats to fill
+ */
+void subghz_frequency_sweep_get_stats(
+    SubGhzFrequencySweep* instance,
+    SubGhzFrequencySweepStats* stats);
@@ -2,6 +2,8 @@
 #include "../helpers/subghz_custom_event.h"
 #include <dolphin/dolphin.h>
 
+#define TAG "SubGhzSceneReceiverInfo"
+
 void subghz_scene_receiver_info_callback(GuiButtonType result, InputType type, void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
@@ -23,17 +25,23 @@ static bool subghz_scene_receiver_info_update_parser(void* context) {
     subghz->txrx->decoder_result = subghz_receiver_search_decoder_base_by_name(
         subghz->txrx->receiver,
         subghz_history_get_protocol_name(subghz->txrx->history, subghz->txrx->idx_menu_chosen));
-    if(subghz->txrx->decoder_result) {
-        subghz_protocol_decoder_base_deserialize(
-            subghz->txrx->decoder_result,
-            subghz_history_get_raw_data(subghz->txrx->history, subghz->txrx->idx_menu_chosen));
+    if(!subghz->txrx->decoder_result) {
+        return false;
+    }
+
+    // Receiver may be adding records, so record is unpacked into own buffer
+    FlipperFormat* raw = flipper_format_string_alloc();
+    bool result =
+        subghz_history_get_raw_data(subghz->txrx->history, subghz->txrx->idx_menu_chosen, raw);
+    if(result) {
+        subghz_protocol_decoder_base_deserialize(subghz->txrx->decoder_result, raw);
         subghz->txrx->frequency =
             subghz_history_get_frequency(subghz->txrx->history, subghz->txrx->idx_menu_chosen);
         subghz->txrx->preset =
             subghz_history_get_preset(subghz->txrx->history, subghz->txrx->idx_menu_chosen);
-        return true;
     }
-    return false;
+    flipper_format_free(raw);
+    return result;
 }
 
 void subghz_scene_receiver_info_on_enter(void* context) {
@@ -120,14 +128,16 @@ bool subghz_scene_receiver_info_on_event(void* context, SceneManagerEvent event)
             }
             if(subghz->txrx->txrx_state == SubGhzTxRxStateIDLE ||
                subghz->txrx->txrx_state == SubGhzTxRxStateSleep) {
-                if(!subghz_tx_start(
-                       subghz,
-                       subghz_history_get_raw_data(
-                           subghz->txrx->history, subghz->txrx->idx_menu_chosen))) {
+                FlipperFormat* raw = flipper_format_string_alloc();
+                if(!subghz_history_get_raw_data(
+                       subghz->txrx->history, subghz->txrx->idx_menu_chosen, raw)) {
+                    FURI_LOG_E(TAG, "Unable to unpack history record");
+                } else if(!subghz_tx_start(subghz, raw)) {
                     scene_manager_next_scene(subghz->scene_manager, SubGhzSceneShowOnlyRx);
                 } else {
                     subghz->state_notifications = SubGhzNotificationStateTX;
                 }
+                flipper_format_free(raw);
             }
             return true;
         } else if(event.event == SubGhzCustomEventSceneReceiverInfoTxStop) {
@@ -72,11 +72,12 @@ bool subghz_scene_save_name_on_event(void* context, SceneManagerEvent event) {
                             SubGhzSceneSetType,
                             SubGhzCustomEventManagerNoSet);
                     } else {
-                        subghz_save_protocol_to_file(
-                            subghz,
-                            subghz_history_get_raw_data(
-                                subghz->txrx->history, subghz->txrx->idx_menu_chosen),
-                            subghz->file_name);
+                        FlipperFormat* raw = flipper_format_string_alloc();
+                        if(subghz_history_get_raw_data(
+                               subghz->txrx->history, subghz->txrx->idx_menu_chosen, raw)) {
+                            subghz_save_protocol_to_file(subghz, raw, subghz->file_name);
+                        }
+                        flipper_format_free(raw);
                     }
                 }
 
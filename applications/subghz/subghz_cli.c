@@ -92,7 +92,7 @@ void subghz_cli_command_rx_carrier(Cli* cli, string_t args, void* context) {
     while(!cli_cmd_interrupt_received(cli)) {
         osDelay(250);
         printf("RSSI: %03.1fdbm\r", furi_hal_subghz_get_rssi());
-        fflush(stdout);
+        cli_flush(cli);
     }
 
     furi_hal_power_suppress_charge_exit();
@@ -167,7 +167,7 @@ void subghz_cli_command_tx(Cli* cli, string_t args, void* context) {
 
     while(!(furi_hal_subghz_is_async_tx_complete() || cli_cmd_interrupt_received(cli))) {
         printf(".");
-        fflush(stdout);
+        cli_flush(cli);
         osDelay(333);
     }
     furi_hal_subghz_stop_async_tx();
@@ -419,7 +419,7 @@ static void subghz_cli_command_chat(Cli* cli, string_t args) {
         return;
     }
 
-    SubGhzChatWorker* subghz_chat = subghz_chat_worker_alloc();
+    SubGhzChatWorker* subghz_chat = subghz_chat_worker_alloc(cli);
     if(!subghz_chat_worker_start(subghz_chat, frequency)) {
         printf("Startup error SubGhzChatWorker\r\n");
 
@@ -453,7 +453,7 @@ static void subghz_cli_command_chat(Cli* cli, string_t args) {
     string_printf(name, "\033[0;33m%s\033[0m: ", furi_hal_version_get_name_ptr());
     string_set(input, name);
     printf("%s", string_get_cstr(input));
-    fflush(stdout);
+    cli_flush(cli);
 
     while(!exit) {
         chat_event = subghz_chat_worker_get_event_chat(subghz_chat);
@@ -469,7 +469,7 @@ static void subghz_cli_command_chat(Cli* cli, string_t args) {
                 size_t len = string_length_u(input);
                 if(len > string_length_u(name)) {
                     printf("%s", "\e[D\e[1P");
-                    fflush(stdout);
+                    cli_flush(cli);
                     //delete 1 char UTF
                     const char* str = string_get_cstr(input);
                     size_t size = 0;
@@ -500,12 +500,12 @@ static void subghz_cli_command_chat(Cli* cli, string_t args) {
 
                 string_printf(input, "%s", string_get_cstr(name));
                 printf("%s", string_get_cstr(input));
-                fflush(stdout);
+                cli_flush(cli);
             } else if(chat_event.c == CliSymbolAsciiLF) {
                 //cut out the symbol \n
             } else {
                 putc(chat_event.c, stdout);
-                fflush(stdout);
+                cli_flush(cli);
                 string_push_back(input, chat_event.c);
                 break;
             case SubGhzChatEventRXData:
@@ -521,7 +521,7 @@ static void subghz_cli_command_chat(Cli* cli, string_t args) {
                             }
                             printf("\r %s", string_get_cstr(output));
                             printf("%s", string_get_cstr(input));
-                            fflush(stdout);
+                            cli_flush(cli);
                             string_reset(output);
                         }
                     }
@@ -1,82 +1,118 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
-#include <lib/subghz/protocols/came.h>
+#include <lib/subghz/protocols/registry.h>
+#include <lib/subghz/blocks/generic.h>
+#include <lib/toolbox/stream/stream.h>
 
 #include <furi.h>
 #include <m-string.h>
 
-#define SUBGHZ_HISTORY_MAX 50
+/* Capacity is derived from free heap at allocation time */
+#define SUBGHZ_HISTORY_MIN 16
+#define SUBGHZ_HISTORY_MAX 500
+#define SUBGHZ_HISTORY_HEAP_RESERVE (24 * 1024)
+#define SUBGHZ_HISTORY_HEAP_SHARE 4
+/* Expected protocol specific text per record, like "TE: 400\n" */
+#define SUBGHZ_HISTORY_EXTRA_AVERAGE 16
+#define SUBGHZ_HISTORY_EXTRA_MAX UINT8_MAX
+/* Record with its average share of extra pool and receiver menu item */
+#define SUBGHZ_HISTORY_RECORD_COST                                \
+    (sizeof(SubGhzHistoryRecord) + SUBGHZ_HISTORY_EXTRA_AVERAGE + \
+     SUBGHZ_HISTORY_MENU_ITEM_SIZE)
+/* Same parcel is decoded several times per button press */
+#define SUBGHZ_HISTORY_REPEAT_TIMEOUT 500
+
+#define SUBGHZ_HISTORY_MANUFACTURE "Manufacture: "
 #define TAG "SubGhzHistory"
 
+/* Packed record, everything besides generic key data is kept as text lines
+ * that protocol serializer wrote after Key, and is appended back on export */
 typedef struct {
-    string_t item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    FuriHalSubGhzPreset preset;
+    uint64_t key;
     uint32_t frequency;
-} SubGhzHistoryItem;
-
-ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
+    uint32_t timestamp; /**< last capture, ms */
+    uint16_t repeat; /**< captures folded into this record */
+    uint16_t extra_offset; /**< protocol specific lines in extra pool */
+    uint8_t extra_size;
+    uint8_t protocol; /**< index in protocol registry */
+    uint8_t preset; /**< FuriHalSubGhzPreset */
+    uint8_t bits;
+} SubGhzHistoryRecord;
 
-#define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
-
-typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+_Static_assert(sizeof(SubGhzHistoryRecord) == 24, "SubGhzHistoryRecord is not packed");
 
 struct SubGhzHistory {
     uint32_t last_update_timestamp;
     uint16_t last_index_write;
     uint8_t code_last_hash_data;
     string_t tmp_string;
-    SubGhzHistoryStruct* history;
+    FlipperFormat* flipper_string;
+
+    uint16_t capacity;
+    SubGhzHistoryRecord* records;
+    char* extra;
+    size_t extra_size;
+    size_t extra_used;
 };
 
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
     string_init(instance->tmp_string);
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
+    instance->flipper_string = flipper_format_string_alloc();
+
+    size_t free_heap = memmgr_get_free_heap();
+    size_t budget = 0;
+    if(free_heap > SUBGHZ_HISTORY_HEAP_RESERVE) {
+        budget = (free_heap - SUBGHZ_HISTORY_HEAP_RESERVE) / SUBGHZ_HISTORY_HEAP_SHARE;
+    }
+    size_t capacity = budget / SUBGHZ_HISTORY_RECORD_COST;
+    instance->capacity = CLAMP(capacity, SUBGHZ_HISTORY_MAX, SUBGHZ_HISTORY_MIN);
+    instance->records = malloc(sizeof(SubGhzHistoryRecord) * instance->capacity);
+    instance->extra_size = SUBGHZ_HISTORY_EXTRA_AVERAGE * instance->capacity;
+    instance->extra = malloc(instance->extra_size);
+
+    FURI_LOG_D(
+        TAG,
+        "Capacity %d, %d bytes per record with menu item",
+        instance->capacity,
+        SUBGHZ_HISTORY_RECORD_COST);
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
     string_clear(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            string_clear(item->item_str);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    flipper_format_free(instance->flipper_string);
+    free(instance->records);
+    free(instance->extra);
     free(instance);
 }
 
+static SubGhzHistoryRecord* subghz_history_get_record(SubGhzHistory* instance, uint16_t idx) {
+    furi_check(idx < instance->last_index_write);
+    return &instance->records[idx];
+}
+
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->frequency;
+    return subghz_history_get_record(instance, idx)->frequency;
 }
 
 FuriHalSubGhzPreset subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    return subghz_history_get_record(instance, idx)->preset;
+}
+
+uint16_t subghz_history_get_repeat(SubGhzHistory* instance, uint16_t idx) {
+    furi_assert(instance);
+    return subghz_history_get_record(instance, idx)->repeat;
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
     string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            string_clear(item->item_str);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
     instance->last_index_write = 0;
+    instance->extra_used = 0;
     instance->code_last_hash_data = 0;
 }
 
@@ -85,46 +121,166 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance) {
     return instance->last_index_write;
 }
 
+uint16_t subghz_history_get_capacity(SubGhzHistory* instance) {
+    furi_assert(instance);
+    return instance->capacity;
+}
+
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    return subghz_protocol_registry_get_by_index(record->protocol)->type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        string_reset(instance->tmp_string);
-    }
-    return string_get_cstr(instance->tmp_string);
+    SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    return subghz_protocol_registry_get_by_index(record->protocol)->name;
 }
 
-FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
+bool subghz_history_get_raw_data(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FlipperFormat* flipper_format) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
+    furi_assert(flipper_format);
+    SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+
+    SubGhzBlockGeneric generic = {
+        .protocol_name = subghz_history_get_protocol_name(instance, idx),
+        .data = record->key,
+        .data_count_bit = record->bits,
+    };
+    if(!subghz_block_generic_serialize(
+           &generic, flipper_format, record->frequency, record->preset)) {
+        return false;
     }
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    stream_seek(stream, 0, StreamOffsetFromEnd);
+    stream_write(
+        stream, (const uint8_t*)&instance->extra[record->extra_offset], record->extra_size);
+    return flipper_format_rewind(flipper_format);
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, string_t output) {
     furi_assert(instance);
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    if(instance->last_index_write == instance->capacity) {
         if(output != NULL) string_printf(output, "Memory is FULL");
         return true;
     }
     if(output != NULL)
-        string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+        string_printf(output, "%02u/%02u", instance->last_index_write, instance->capacity);
+    return false;
+}
+
+/* Get value of "Manufacture" from protocol specific lines */
+static bool subghz_history_get_manufacture(
+    SubGhzHistory* instance,
+    SubGhzHistoryRecord* record,
+    string_t output) {
+    const char* extra = &instance->extra[record->extra_offset];
+    const size_t prefix_size = strlen(SUBGHZ_HISTORY_MANUFACTURE);
+
+    size_t line = 0;
+    while(line < record->extra_size) {
+        size_t end = line;
+        while(end < record->extra_size && extra[end] != '\n') end++;
+        if(end - line > prefix_size &&
+           !strncmp(&extra[line], SUBGHZ_HISTORY_MANUFACTURE, prefix_size)) {
+            string_set_strn(output, &extra[line + prefix_size], end - line - prefix_size);
+            string_strim(output);
+            return true;
+        }
+        line = end + 1;
+    }
     return false;
 }
 
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, string_t output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    string_set(output, item->item_str);
+    furi_assert(instance);
+    SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    const char* name = subghz_history_get_protocol_name(instance, idx);
+
+    // tmp_string belongs to receiver callback, menu is built on GUI thread
+    string_t manufacture;
+    string_init(manufacture);
+    if(!strcmp(name, "KeeLoq")) {
+        string_set_str(output, "KL ");
+        subghz_history_get_manufacture(instance, record, manufacture);
+    } else if(!strcmp(name, "Star Line")) {
+        string_set_str(output, "SL ");
+        subghz_history_get_manufacture(instance, record, manufacture);
+    } else {
+        string_set_str(output, name);
+    }
+    string_cat(output, manufacture);
+    string_clear(manufacture);
+
+    if(!(uint32_t)(record->key >> 32)) {
+        string_cat_printf(output, " %lX", (uint32_t)(record->key & 0xFFFFFFFF));
+    } else {
+        string_cat_printf(
+            output,
+            " %lX%08lX",
+            (uint32_t)(record->key >> 32),
+            (uint32_t)(record->key & 0xFFFFFFFF));
+    }
+}
+
+/* Parse generic data and protocol specific lines serialized by decoder */
+static bool subghz_history_parse(SubGhzHistory* instance, SubGhzHistoryRecord* record) {
+    FlipperFormat* flipper_format = instance->flipper_string;
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+
+    if(!flipper_format_rewind(flipper_format)) {
+        FURI_LOG_E(TAG, "Rewind error");
+        return false;
+    }
+    uint32_t bits = 0;
+    if(!flipper_format_read_uint32(flipper_format, "Bit", &bits, 1)) {
+        FURI_LOG_E(TAG, "Missing Bit");
+        return false;
+    }
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    if(!flipper_format_read_hex(flipper_format, "Key", key_data, sizeof(uint64_t))) {
+        FURI_LOG_E(TAG, "Missing Key");
+        return false;
+    }
+    record->bits = bits;
+    record->key = 0;
+    for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+        record->key = (record->key << 8) | key_data[i];
+    }
+
+    // Everything after Key line is protocol specific
+    stream_rewind(stream);
+    bool key_found = false;
+    while(!key_found && stream_read_line(stream, instance->tmp_string)) {
+        key_found = string_start_with_str_p(instance->tmp_string, "Key:");
+    }
+    size_t extra_size = stream_size(stream) - stream_tell(stream);
+    if(!key_found || extra_size > SUBGHZ_HISTORY_EXTRA_MAX) {
+        FURI_LOG_E(TAG, "Unexpected format");
+        return false;
+    }
+    if(instance->extra_used + extra_size > instance->extra_size) {
+        FURI_LOG_W(TAG, "Extra pool is full");
+        return false;
+    }
+    record->extra_offset = instance->extra_used;
+    record->extra_size = extra_size;
+    stream_read(stream, (uint8_t*)&instance->extra[instance->extra_used], extra_size);
+    return true;
+}
+
+static size_t subghz_history_get_protocol_index(const SubGhzProtocol* protocol) {
+    for(size_t i = 0; i < subghz_protocol_registry_count(); i++) {
+        if(subghz_protocol_registry_get_by_index(i) == protocol) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
 }
 
 bool subghz_history_add_to_history(
@@ -135,12 +291,12 @@ bool subghz_history_add_to_history(
     furi_assert(instance);
     furi_assert(context);
 
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    if(instance->last_index_write >= instance->capacity) return false;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
     if((instance->code_last_hash_data ==
         subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((millis() - instance->last_update_timestamp) < 500)) {
+       ((millis() - instance->last_update_timestamp) < SUBGHZ_HISTORY_REPEAT_TIMEOUT)) {
         instance->last_update_timestamp = millis();
         return false;
     }
@@ -148,71 +304,37 @@ bool subghz_history_add_to_history(
     instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
     instance->last_update_timestamp = millis();
 
-    string_t text;
-    string_init(text);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->type = decoder_base->protocol->type;
-    item->frequency = frequency;
-    item->preset = preset;
-
-    string_init(item->item_str);
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, frequency, preset);
-
-    do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            string_cat(instance->tmp_string, text);
-        } else if(!strcmp(string_get_cstr(instance->tmp_string), "Star Line")) {
-            string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            string_cat(instance->tmp_string, text);
-        }
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
-            FURI_LOG_E(TAG, "Missing Key");
-            break;
-        }
-        uint64_t data = 0;
-        for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
-        }
-        if(!(uint32_t)(data >> 32)) {
-            string_printf(
-                item->item_str,
-                "%s %lX",
-                string_get_cstr(instance->tmp_string),
-                (uint32_t)(data & 0xFFFFFFFF));
-        } else {
-            string_printf(
-                item->item_str,
-                "%s %lX%08lX",
-                string_get_cstr(instance->tmp_string),
-                (uint32_t)(data >> 32),
-                (uint32_t)(data & 0xFFFFFFFF));
+    size_t protocol = subghz_history_get_protocol_index(decoder_base->protocol);
+    if(protocol == SIZE_MAX) {
+        FURI_LOG_E(TAG, "Unknown protocol");
+        return false;
+    }
+
+    SubGhzHistoryRecord* record = &instance->records[instance->last_index_write];
+    record->protocol = protocol;
+    record->frequency = frequency;
+    record->preset = preset;
+    record->timestamp = instance->last_update_timestamp;
+    record->repeat = 1;
+
+    if(!subghz_protocol_decoder_base_serialize(
+           decoder_base, instance->flipper_string, frequency, preset) ||
+       !subghz_history_parse(instance, record)) {
+        return false;
+    }
+
+    // Fold repeated capture of the same key into existing record
+    for(size_t i = instance->last_index_write; i-- > 0;) {
+        SubGhzHistoryRecord* item = &instance->records[i];
+        if(item->key == record->key && item->protocol == record->protocol &&
+           item->bits == record->bits && item->frequency == record->frequency) {
+            if(item->repeat < UINT16_MAX) item->repeat++;
+            item->timestamp = record->timestamp;
+            return false;
         }
-    } while(false);
+    }
 
-    string_clear(text);
+    instance->extra_used += record->extra_size;
     instance->last_index_write++;
     return true;
 }
@@ -6,6 +6,10 @@
 #include <furi_hal.h>
 #include <lib/flipper_format/flipper_format.h>
 
+/** Heap taken by receiver menu item of one record: item in array that grows
+ * by doubling and its own copy of menu text. Counted in history capacity. */
+#define SUBGHZ_HISTORY_MENU_ITEM_SIZE 64
+
 typedef struct SubGhzHistory SubGhzHistory;
 
 /** Allocate SubGhzHistory
@@ -49,6 +53,21 @@ FuriHalSubGhzPreset subghz_history_get_preset(SubGhzHistory* instance, uint16_t
  */
 uint16_t subghz_history_get_item(SubGhzHistory* instance);
 
+/** Get maximum amount of records, derived from free heap on allocation
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @return capacity - maximum amount of records
+ */
+uint16_t subghz_history_get_capacity(SubGhzHistory* instance);
+
+/** Get amount of captures folded into history[idx]
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index
+ * @return repeat   - how many times the same key was received
+ */
+uint16_t subghz_history_get_repeat(SubGhzHistory* instance, uint16_t idx);
+
 /** Get type protocol to history[idx]
  * 
  * @param instance  - SubGhzHistory instance
@@ -82,6 +101,9 @@ void subghz_history_get_text_item_menu(SubGhzHistory* instance, string_t output,
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, string_t output);
 
 /** Add protocol to history
+ * 
+ * Capture of a key that is already in history only increments its repeat
+ * counter.
  * 
  * @param instance  - SubGhzHistory instance
  * @param context    - SubGhzProtocolCommon context
@@ -95,10 +117,17 @@ bool subghz_history_add_to_history(
     uint32_t frequency,
     FuriHalSubGhzPreset preset);
 
-/** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+/** Get record data to load into the protocol decoder
  * 
- * @param instance  - SubGhzHistory instance
- * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * Data is unpacked from packed record into caller owned FlipperFormat, so it
+ * can be used while receiver keeps adding records.
+ * 
+ * @param instance       - SubGhzHistory instance
+ * @param idx            - record index
+ * @param flipper_format - string FlipperFormat to write record data to
+ * @return bool - true on success
  */
-FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
+bool subghz_history_get_raw_data(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FlipperFormat* flipper_format);
@@ -8,6 +8,8 @@
 #include <m-string.h>
 #include <m-array.h>
 
+#define TAG "SubGhzViewReceiver"
+
 #define FRAME_HEIGHT 12
 #define MAX_LEN_PX 100
 #define MENU_ITEMS 4
@@ -38,6 +40,8 @@ struct SubGhzViewReceiver {
     View* view;
     SubGhzViewReceiverCallback callback;
     void* context;
+    uint32_t enter_tick;
+    ViewStats enter_stats;
 };
 
 typedef struct {
@@ -218,12 +222,29 @@ bool subghz_view_receiver_input(InputEvent* event, void* context) {
 
 void subghz_view_receiver_enter(void* context) {
     furi_assert(context);
-    //SubGhzViewReceiver* subghz_receiver = context;
+    SubGhzViewReceiver* subghz_receiver = context;
+    subghz_receiver->enter_tick = osKernelGetTickCount();
+    view_get_stats(subghz_receiver->view, &subghz_receiver->enter_stats);
 }
 
 void subghz_view_receiver_exit(void* context) {
     furi_assert(context);
     SubGhzViewReceiver* subghz_receiver = context;
+
+    ViewStats stats;
+    view_get_stats(subghz_receiver->view, &stats);
+    uint32_t duration = osKernelGetTickCount() - subghz_receiver->enter_tick;
+    uint32_t draws = stats.draws - subghz_receiver->enter_stats.draws;
+    FURI_LOG_D(
+        TAG,
+        "%lu ms: %lu commits, %lu updates, %lu draws (%lu/s), %lu contended",
+        duration,
+        stats.commits - subghz_receiver->enter_stats.commits,
+        stats.updates - subghz_receiver->enter_stats.updates,
+        draws,
+        duration ? draws * osKernelGetTickFreq() / duration : 0,
+        stats.contended - subghz_receiver->enter_stats.contended);
+
     with_view_model(
         subghz_receiver->view, (SubGhzViewReceiverModel * model) {
             string_reset(model->frequency_str);
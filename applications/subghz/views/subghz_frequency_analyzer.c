@@ -139,7 +139,7 @@ SubGhzFrequencyAnalyzer* subghz_frequency_analyzer_alloc() {
     // View allocation and configuration
     instance->view = view_alloc();
     view_allocate_model(
-        instance->view, ViewModelTypeLocking, sizeof(SubGhzFrequencyAnalyzerModel));
+        instance->view, ViewModelTypeSnapshot, sizeof(SubGhzFrequencyAnalyzerModel));
     view_set_context(instance->view, instance);
     view_set_draw_callback(instance->view, (ViewDrawCallback)subghz_frequency_analyzer_draw);
     view_set_input_callback(instance->view, subghz_frequency_analyzer_input);
@@ -0,0 +1,217 @@
+#include <furi.h>
+#include <furi_hal_bt_serial.h>
+#include <string.h>
+#include <bt/bt_service/bt_serial_tx.h>
+#include "../minunit.h"
+
+#define BT_TEST_FILE_SIZE (64 * 1024)
+// Storage read response: 512 bytes of data and protobuf framing
+#define BT_TEST_RPC_FRAME_SIZE 520
+#define BT_TEST_STACK_TX_POOL 6
+#define BT_TEST_PACKET_OVERHEAD_US ((17 * 8) + 380)
+#define BT_TEST_EVENT_RESERVED_US 1000
+
+#define TAG "BtTest"
+
+/* Serial service transport model on a microsecond timeline:
+ * notifications are queued in stack TX pool and a connection event sends
+ * as many as fit into the interval, stack reports pool availability after
+ * it was exhausted. Indication is sent in one connection event and is
+ * confirmed by client in the next one. */
+typedef struct {
+    BtSerialTxWindow window;
+    bool notify;
+    uint16_t packet_size;
+    uint32_t interval_us;
+    uint32_t event_packets;
+    uint32_t now_us;
+    uint32_t next_event_us;
+    uint8_t pool;
+    bool pool_exhausted;
+    bool indication_queued;
+    bool indication_sent;
+    bool data_sent;
+    uint32_t packets;
+    uint32_t stalls;
+    uint32_t errors;
+} BtTestLink;
+
+static void
+    bt_test_link_init(BtTestLink* link, bool notify, uint16_t packet_size, uint16_t interval) {
+    memset(link, 0, sizeof(BtTestLink));
+    link->notify = notify;
+    link->packet_size = packet_size;
+    link->interval_us = interval * 1250;
+    link->next_event_us = link->interval_us;
+    uint32_t packet_us = packet_size * 8 + BT_TEST_PACKET_OVERHEAD_US;
+    link->event_packets =
+        MAX((uint32_t)1, (link->interval_us - BT_TEST_EVENT_RESERVED_US) / packet_us);
+    bt_serial_tx_window_configure(&link->window, notify, packet_size, interval);
+    bt_serial_tx_window_reset(&link->window);
+}
+
+static FuriHalBtSerialTxStatus bt_test_link_tx(BtTestLink* link) {
+    if(link->notify) {
+        if(link->pool == BT_TEST_STACK_TX_POOL) {
+            link->pool_exhausted = true;
+            return SerialServiceTxStatusBusy;
+        }
+        link->pool++;
+    } else {
+        if(link->indication_queued || link->indication_sent) {
+            link->errors++;
+            return SerialServiceTxStatusError;
+        }
+        link->indication_queued = true;
+    }
+    link->packets++;
+    return SerialServiceTxStatusOk;
+}
+
+// Same as DataSent event handling in bt service
+static void bt_test_link_data_sent(BtTestLink* link) {
+    bt_serial_tx_window_refill(&link->window);
+    link->data_sent = true;
+}
+
+static void bt_test_link_connection_event(BtTestLink* link) {
+    link->now_us = link->next_event_us;
+    link->next_event_us += link->interval_us;
+    if(link->notify) {
+        uint32_t sent = MIN(link->event_packets, link->pool);
+        link->pool -= sent;
+        if(sent && link->pool_exhausted) {
+            link->pool_exhausted = false;
+            bt_test_link_data_sent(link);
+        }
+    } else {
+        if(link->indication_sent) {
+            link->indication_sent = false;
+            bt_test_link_data_sent(link);
+        }
+        if(link->indication_queued) {
+            link->indication_queued = false;
+            link->indication_sent = true;
+        }
+    }
+}
+
+static bool bt_test_link_is_idle(BtTestLink* link) {
+    return !link->pool && !link->indication_queued && !link->indication_sent;
+}
+
+// Same as RPC send bytes callback in bt service
+static void bt_test_link_send_frame(BtTestLink* link, size_t bytes_len) {
+    size_t bytes_sent = 0;
+    while(bytes_sent < bytes_len) {
+        if(bt_serial_tx_window_acquire(&link->window)) {
+            FuriHalBtSerialTxStatus status = bt_test_link_tx(link);
+            if(status == SerialServiceTxStatusOk) {
+                bytes_sent += MIN(bytes_len - bytes_sent, link->packet_size);
+            } else if(status == SerialServiceTxStatusBusy) {
+                bt_serial_tx_window_stall(&link->window);
+                link->stalls++;
+            } else {
+                break;
+            }
+        } else {
+            uint32_t timeout = bt_serial_tx_window_get_timeout(&link->window);
+            uint32_t deadline = (timeout == BT_SERIAL_TX_WAIT_FOREVER) ?
+                                    UINT32_MAX :
+                                    link->now_us + timeout * 1000;
+            while(!link->data_sent && link->next_event_us <= deadline) {
+                bt_test_link_connection_event(link);
+            }
+            if(link->data_sent) {
+                link->data_sent = false;
+            } else {
+                link->now_us = deadline;
+                bt_serial_tx_window_timeout(&link->window);
+            }
+        }
+    }
+}
+
+// File transfer throughput in bytes per second
+static uint32_t bt_test_file_transfer(BtTestLink* link) {
+    for(size_t sent = 0; sent < BT_TEST_FILE_SIZE; sent += BT_TEST_RPC_FRAME_SIZE) {
+        bt_test_link_send_frame(link, BT_TEST_RPC_FRAME_SIZE);
+    }
+    while(!bt_test_link_is_idle(link)) {
+        bt_test_link_connection_event(link);
+    }
+    return (uint64_t)BT_TEST_FILE_SIZE * 1000000 / link->now_us;
+}
+
+MU_TEST(bt_serial_tx_window_test) {
+    BtSerialTxWindow window = {0};
+    bt_serial_tx_window_configure(&window, false, 244, 24);
+    bt_serial_tx_window_reset(&window);
+    mu_assert_int_eq(1, window.size);
+    mu_assert_int_eq(BT_SERIAL_TX_WAIT_FOREVER, bt_serial_tx_window_get_timeout(&window));
+    mu_check(bt_serial_tx_window_acquire(&window));
+    mu_check(!bt_serial_tx_window_acquire(&window));
+    // Indication is returned only by confirmation
+    bt_serial_tx_window_timeout(&window);
+    mu_check(!bt_serial_tx_window_acquire(&window));
+
+    // Client subscribes to notifications with one indication in flight
+    bt_serial_tx_window_configure(&window, true, 244, 24);
+    mu_check(window.size > 1);
+    mu_check(window.size <= BT_SERIAL_TX_WINDOW_MAX);
+    mu_assert_int_eq(window.size - 1, window.credits);
+    mu_assert_int_eq(30, bt_serial_tx_window_get_timeout(&window));
+
+    // Longer interval and smaller packets fit more into connection event
+    uint8_t size = window.size;
+    bt_serial_tx_window_configure(&window, true, 20, 24);
+    mu_check(window.size >= size);
+    bt_serial_tx_window_configure(&window, true, 244, 6);
+    mu_check(window.size <= size);
+    mu_check(window.size >= BT_SERIAL_TX_WINDOW_MIN);
+
+    bt_serial_tx_window_stall(&window);
+    mu_check(!bt_serial_tx_window_acquire(&window));
+    bt_serial_tx_window_timeout(&window);
+    mu_check(bt_serial_tx_window_acquire(&window));
+}
+
+MU_TEST(bt_serial_tx_transfer_test) {
+    const uint16_t intervals[] = {12, 24, 40};
+    const uint16_t packet_sizes[] = {20, 244};
+    BtTestLink* link = malloc(sizeof(BtTestLink));
+
+    for(size_t i = 0; i < COUNT_OF(intervals); i++) {
+        for(size_t j = 0; j < COUNT_OF(packet_sizes); j++) {
+            bt_test_link_init(link, false, packet_sizes[j], intervals[i]);
+            uint32_t indicate_speed = bt_test_file_transfer(link);
+            mu_assert_int_eq(0, link->errors);
+
+            bt_test_link_init(link, true, packet_sizes[j], intervals[i]);
+            uint32_t notify_speed = bt_test_file_transfer(link);
+            mu_assert_int_eq(0, link->errors);
+
+            FURI_LOG_I(
+                TAG,
+                "Interval %dms, packet %d: indication %lu B/s, notification %lu B/s, window %d",
+                intervals[i] * 5 / 4,
+                packet_sizes[j],
+                indicate_speed,
+                notify_speed,
+                link->window.size);
+            mu_assert(notify_speed > indicate_speed * 2, "windowed transfer is not faster");
+        }
+    }
+
+    free(link);
+}
+
+MU_TEST_SUITE(bt_serial_tx_suite) {
+    MU_RUN_TEST(bt_serial_tx_window_test);
+    MU_RUN_TEST(bt_serial_tx_transfer_test);
+}
+
+int run_minunit_test_bt() {
+    MU_RUN_SUITE(bt_serial_tx_suite);
+    return MU_EXIT_CODE;
+}
@@ -4,6 +4,8 @@
 #include <toolbox/stream/stream.h>
 #include "../minunit.h"
 
+#define TAG "FlipperFormatTest"
+
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME "/ext/unit_tests_tmp"
 
@@ -437,6 +439,73 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+/* NTAG216 dump size: one block vs 4 byte page per key */
+#define TEST_HEX_BLOCK_SIZE 924
+#define TEST_HEX_PAGE_SIZE 4
+
+static bool test_write_hex_block(const char* file_name, const uint8_t* data, size_t page_size) {
+    Storage* storage = furi_record_open("storage");
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    string_t key;
+    string_init(key);
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, test_filetype, test_version)) break;
+
+        bool error = false;
+        for(size_t i = 0; i < TEST_HEX_BLOCK_SIZE; i += page_size) {
+            string_printf(key, "Page %d", i / page_size);
+            if(!flipper_format_write_hex(file, string_get_cstr(key), &data[i], page_size)) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    string_clear(key);
+    flipper_format_free(file);
+    furi_record_close("storage");
+
+    return result;
+}
+
+static bool test_read_hex_block(const char* file_name, uint8_t* data, size_t page_size) {
+    Storage* storage = furi_record_open("storage");
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    string_t key;
+    string_init(key);
+    uint32_t version;
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_header(file, key, &version)) break;
+
+        bool error = false;
+        for(size_t i = 0; i < TEST_HEX_BLOCK_SIZE; i += page_size) {
+            string_printf(key, "Page %d", i / page_size);
+            if(!flipper_format_read_hex(file, string_get_cstr(key), &data[i], page_size)) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    string_clear(key);
+    flipper_format_free(file);
+    furi_record_close("storage");
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -503,6 +572,46 @@ MU_TEST(flipper_format_multikey_test) {
     mu_assert(test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error");
 }
 
+MU_TEST(flipper_format_hex_block_test) {
+    uint8_t* data = malloc(TEST_HEX_BLOCK_SIZE);
+    uint8_t* read_data = malloc(TEST_HEX_BLOCK_SIZE);
+    for(size_t i = 0; i < TEST_HEX_BLOCK_SIZE; i++) {
+        data[i] = i * 13;
+    }
+
+    uint32_t start = osKernelGetTickCount();
+    mu_check(test_write_hex_block(TEST_DIR "ff_block.test", data, TEST_HEX_BLOCK_SIZE));
+    uint32_t block_write = osKernelGetTickCount() - start;
+    start = osKernelGetTickCount();
+    mu_check(test_read_hex_block(TEST_DIR "ff_block.test", read_data, TEST_HEX_BLOCK_SIZE));
+    uint32_t block_read = osKernelGetTickCount() - start;
+    mu_check(memcmp(data, read_data, TEST_HEX_BLOCK_SIZE) == 0);
+
+    memset(read_data, 0, TEST_HEX_BLOCK_SIZE);
+    start = osKernelGetTickCount();
+    mu_check(test_write_hex_block(TEST_DIR "ff_pages.test", data, TEST_HEX_PAGE_SIZE));
+    uint32_t pages_write = osKernelGetTickCount() - start;
+    start = osKernelGetTickCount();
+    mu_check(test_read_hex_block(TEST_DIR "ff_pages.test", read_data, TEST_HEX_PAGE_SIZE));
+    uint32_t pages_read = osKernelGetTickCount() - start;
+    mu_check(memcmp(data, read_data, TEST_HEX_BLOCK_SIZE) == 0);
+
+    // Asking for more values than line has must fail
+    mu_check(!test_read_hex_block(TEST_DIR "ff_pages.test", read_data, TEST_HEX_PAGE_SIZE * 2));
+
+    FURI_LOG_I(
+        TAG,
+        "%d bytes block: write %lums read %lums, by pages: write %lums read %lums",
+        TEST_HEX_BLOCK_SIZE,
+        block_write,
+        block_read,
+        pages_write,
+        pages_read);
+
+    free(read_data);
+    free(data);
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -516,6 +625,7 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_test);
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
+    MU_RUN_TEST(flipper_format_hex_block_test);
     tests_teardown();
 }
 
@@ -0,0 +1,80 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+
+#define TAG "FuriHalPowerTest"
+
+/* ADC values move between reads, allow a few LSB */
+#define POWER_TEST_VOLTAGE_TOLERANCE 0.1f
+#define POWER_TEST_TEMPERATURE_TOLERANCE 2.0f
+
+static bool power_test_near(float a, float b, float tolerance) {
+    return (a > b ? a - b : b - a) <= tolerance;
+}
+
+MU_TEST(power_telemetry_test) {
+    FuriHalPowerTelemetry telemetry;
+    mu_check(furi_hal_power_get_telemetry(&telemetry));
+
+    // Same values as individual getters return
+    mu_assert_int_eq(furi_hal_power_get_pct(), telemetry.charge);
+    mu_assert_int_eq(furi_hal_power_get_bat_health_pct(), telemetry.health);
+    mu_assert_int_eq(furi_hal_power_get_battery_full_capacity(), telemetry.capacity_full);
+    mu_check(power_test_near(
+        furi_hal_power_get_battery_voltage(FuriHalPowerICFuelGauge),
+        telemetry.voltage_gauge,
+        POWER_TEST_VOLTAGE_TOLERANCE));
+    mu_check(power_test_near(
+        furi_hal_power_get_battery_voltage(FuriHalPowerICCharger),
+        telemetry.voltage_charger,
+        POWER_TEST_VOLTAGE_TOLERANCE));
+    mu_check(power_test_near(
+        furi_hal_power_get_usb_voltage(), telemetry.voltage_vbus, POWER_TEST_VOLTAGE_TOLERANCE));
+    mu_check(power_test_near(
+        furi_hal_power_get_battery_temperature(FuriHalPowerICFuelGauge),
+        telemetry.temperature_gauge,
+        POWER_TEST_TEMPERATURE_TOLERANCE));
+}
+
+MU_TEST(power_telemetry_speed_test) {
+    FuriHalPowerTelemetry telemetry;
+
+    uint32_t start = DWT->CYCCNT;
+    mu_check(furi_hal_power_get_telemetry(&telemetry));
+    uint32_t cycles_snapshot = DWT->CYCCNT - start;
+
+    // What power service used to do every second
+    start = DWT->CYCCNT;
+    furi_hal_power_is_charging();
+    furi_hal_power_get_pct();
+    furi_hal_power_get_bat_health_pct();
+    furi_hal_power_get_battery_remaining_capacity();
+    furi_hal_power_get_battery_full_capacity();
+    furi_hal_power_get_battery_current(FuriHalPowerICCharger);
+    furi_hal_power_get_battery_current(FuriHalPowerICFuelGauge);
+    furi_hal_power_get_battery_voltage(FuriHalPowerICCharger);
+    furi_hal_power_get_battery_voltage(FuriHalPowerICFuelGauge);
+    furi_hal_power_get_usb_voltage();
+    furi_hal_power_get_battery_temperature(FuriHalPowerICCharger);
+    furi_hal_power_get_battery_temperature(FuriHalPowerICFuelGauge);
+    uint32_t cycles_getters = DWT->CYCCNT - start;
+
+    mu_check(cycles_snapshot < cycles_getters);
+
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    FURI_LOG_I(
+        TAG,
+        "Snapshot %luus, getters %luus",
+        cycles_snapshot / cycles_per_us,
+        cycles_getters / cycles_per_us);
+}
+
+MU_TEST_SUITE(furi_hal_power_suite) {
+    MU_RUN_TEST(power_telemetry_test);
+    MU_RUN_TEST(power_telemetry_speed_test);
+}
+
+int run_minunit_test_furi_hal_power() {
+    MU_RUN_SUITE(furi_hal_power_suite);
+    return MU_EXIT_CODE;
+}
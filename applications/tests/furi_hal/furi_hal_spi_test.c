@@ -0,0 +1,345 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+#include "../minunit.h"
+
+/* Queue runs on a mock bus: handles log CS changes, DMA logs transfers,
+ * loops tx to rx and completes only when test says so. Log letters:
+ * H/N/L - CS low for high/normal/low priority handle, lowercase - CS high,
+ * s - transfer setup, t - DMA start, x - DMA abort, c - job callback.
+ * Next job starts before callback of finished one. Bus activation while
+ * DMA runs is counted as a failure. */
+#define SPI_TEST_LOG_SIZE 64
+
+static char spi_test_log[SPI_TEST_LOG_SIZE];
+static size_t spi_test_log_size;
+static volatile bool spi_test_dma_running;
+static size_t spi_test_activate_busy;
+
+static void spi_test_log_push(char event) {
+    if(spi_test_log_size < SPI_TEST_LOG_SIZE - 1) {
+        spi_test_log[spi_test_log_size++] = event;
+        spi_test_log[spi_test_log_size] = '\0';
+    }
+}
+
+static void spi_test_log_reset() {
+    spi_test_log_size = 0;
+    spi_test_log[0] = '\0';
+}
+
+static void spi_test_dma_start(FuriHalSpiBus* bus, const FuriHalSpiTransfer* transfer) {
+    furi_check(!spi_test_dma_running);
+    spi_test_dma_running = true;
+    if(transfer->rx_buffer) {
+        if(transfer->tx_buffer) {
+            memcpy(transfer->rx_buffer, transfer->tx_buffer, transfer->size);
+        } else {
+            memset(transfer->rx_buffer, 0xFF, transfer->size);
+        }
+    }
+    spi_test_log_push('t');
+}
+
+static void spi_test_dma_stop(FuriHalSpiBus* bus) {
+    spi_test_dma_running = false;
+    spi_test_log_push('x');
+}
+
+static const FuriHalSpiBusDma spi_test_dma = {
+    .start = spi_test_dma_start,
+    .stop = spi_test_dma_stop,
+};
+
+static void spi_test_bus_callback(FuriHalSpiBus* bus, FuriHalSpiBusEvent event) {
+    if(event == FuriHalSpiBusEventInit) {
+        bus->current_handle = NULL;
+    } else if(event == FuriHalSpiBusEventActivate && spi_test_dma_running) {
+        spi_test_activate_busy++;
+    }
+}
+
+static FuriHalSpiBus spi_test_bus = {
+    .spi = NULL,
+    .callback = spi_test_bus_callback,
+    .dma = &spi_test_dma,
+};
+
+static void spi_test_handle_callback(
+    FuriHalSpiBusHandle* handle,
+    FuriHalSpiBusHandleEvent event,
+    char name) {
+    if(event == FuriHalSpiBusHandleEventActivate) {
+        spi_test_log_push(name);
+    } else if(event == FuriHalSpiBusHandleEventDeactivate) {
+        spi_test_log_push(name - 'A' + 'a');
+    }
+}
+
+static void spi_test_handle_high_callback(
+    FuriHalSpiBusHandle* handle,
+    FuriHalSpiBusHandleEvent event) {
+    spi_test_handle_callback(handle, event, 'H');
+}
+
+static void spi_test_handle_normal_callback(
+    FuriHalSpiBusHandle* handle,
+    FuriHalSpiBusHandleEvent event) {
+    spi_test_handle_callback(handle, event, 'N');
+}
+
+static void spi_test_handle_low_callback(
+    FuriHalSpiBusHandle* handle,
+    FuriHalSpiBusHandleEvent event) {
+    spi_test_handle_callback(handle, event, 'L');
+}
+
+static FuriHalSpiBusHandle spi_test_handle_high = {
+    .bus = &spi_test_bus,
+    .callback = spi_test_handle_high_callback,
+    .priority = FuriHalSpiPriorityHigh,
+};
+
+static FuriHalSpiBusHandle spi_test_handle_normal = {
+    .bus = &spi_test_bus,
+    .callback = spi_test_handle_normal_callback,
+    .priority = FuriHalSpiPriorityNormal,
+};
+
+static FuriHalSpiBusHandle spi_test_handle_low = {
+    .bus = &spi_test_bus,
+    .callback = spi_test_handle_low_callback,
+    .priority = FuriHalSpiPriorityLow,
+};
+
+static void spi_test_setup(const FuriHalSpiTransfer* transfer) {
+    spi_test_log_push('s');
+}
+
+static void spi_test_job_callback(FuriHalSpiJob* job, void* context) {
+    size_t* count = context;
+    (*count)++;
+    spi_test_log_push('c');
+}
+
+static void spi_test_job_init(
+    FuriHalSpiJob* job,
+    FuriHalSpiBusHandle* handle,
+    const FuriHalSpiTransfer* transfers,
+    size_t count,
+    size_t* callbacks) {
+    memset(job, 0, sizeof(FuriHalSpiJob));
+    job->handle = handle;
+    job->transfers = transfers;
+    job->transfers_count = count;
+    job->callback = spi_test_job_callback;
+    job->context = callbacks;
+}
+
+/* Complete transfer in progress like DMA interrupt does */
+static void spi_test_complete() {
+    furi_check(spi_test_dma_running);
+    spi_test_dma_running = false;
+    furi_hal_spi_bus_dma_complete(&spi_test_bus);
+}
+
+static void spi_test_before() {
+    spi_test_log_reset();
+    spi_test_dma_running = false;
+    spi_test_activate_busy = 0;
+    furi_hal_spi_bus_init(&spi_test_bus);
+}
+
+static void spi_test_after() {
+    furi_hal_spi_bus_deinit(&spi_test_bus);
+}
+
+MU_TEST(spi_queue_priority_test) {
+    const uint8_t data[] = {0x01, 0x02, 0x03};
+    const FuriHalSpiTransfer transfer = {.tx_buffer = data, .size = sizeof(data)};
+    FuriHalSpiJob jobs[4];
+    size_t callbacks = 0;
+    spi_test_job_init(&jobs[0], &spi_test_handle_low, &transfer, 1, &callbacks);
+    spi_test_job_init(&jobs[1], &spi_test_handle_high, &transfer, 1, &callbacks);
+    spi_test_job_init(&jobs[2], &spi_test_handle_normal, &transfer, 1, &callbacks);
+    spi_test_job_init(&jobs[3], &spi_test_handle_high, &transfer, 1, &callbacks);
+
+    // Jobs wait while bus is acquired
+    furi_hal_spi_acquire(&spi_test_handle_normal);
+    spi_test_log_reset();
+    for(size_t i = 0; i < COUNT_OF(jobs); i++) {
+        furi_hal_spi_job_submit(&jobs[i]);
+        mu_assert_int_eq(FuriHalSpiJobStatePending, jobs[i].state);
+    }
+    mu_check(!spi_test_dma_running);
+    furi_hal_spi_release(&spi_test_handle_normal);
+
+    // Released bus starts them by priority, same priority in submit order
+    mu_assert_string_eq("nHt", spi_test_log);
+    spi_test_log_reset();
+    const size_t order[] = {1, 3, 2, 0};
+    for(size_t i = 0; i < COUNT_OF(order); i++) {
+        mu_assert_int_eq(FuriHalSpiJobStateActive, jobs[order[i]].state);
+        spi_test_complete();
+        mu_assert_int_eq(FuriHalSpiJobStateDone, jobs[order[i]].state);
+    }
+    mu_assert_string_eq("hHtchNtcnLtclc", spi_test_log);
+    mu_assert_int_eq(COUNT_OF(jobs), callbacks);
+    mu_check(!spi_test_dma_running);
+}
+
+MU_TEST(spi_queue_chip_select_test) {
+    const uint8_t command[] = {0xB0, 0x10, 0x00};
+    uint8_t data[16];
+    uint8_t rx_command[sizeof(command)];
+    uint8_t rx_data[sizeof(data)];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i * 7;
+    }
+    const FuriHalSpiTransfer transfers[] = {
+        {.tx_buffer = command, .rx_buffer = rx_command, .size = sizeof(command)},
+        {.tx_buffer = data, .rx_buffer = rx_data, .size = sizeof(data), .setup = spi_test_setup},
+        {.tx_buffer = NULL, .rx_buffer = NULL, .size = 4, .setup = spi_test_setup},
+    };
+    FuriHalSpiJob jobs[2];
+    size_t callbacks = 0;
+    spi_test_job_init(&jobs[0], &spi_test_handle_normal, transfers, 3, &callbacks);
+    spi_test_job_init(&jobs[1], &spi_test_handle_normal, transfers, 1, &callbacks);
+
+    // CS is held over all transfers of a job and released between jobs
+    furi_hal_spi_job_submit(&jobs[0]);
+    furi_hal_spi_job_submit(&jobs[1]);
+    mu_check(spi_test_bus.current_handle == &spi_test_handle_normal);
+    spi_test_complete();
+    spi_test_complete();
+    spi_test_complete();
+    spi_test_complete();
+    mu_assert_string_eq("NtststnNtcnc", spi_test_log);
+    mu_assert_int_eq(2, callbacks);
+    mu_check(spi_test_bus.current_handle == NULL);
+    mu_check(memcmp(command, rx_command, sizeof(command)) == 0);
+    mu_check(memcmp(data, rx_data, sizeof(data)) == 0);
+
+    // Done job can be submitted again
+    spi_test_log_reset();
+    furi_hal_spi_job_submit(&jobs[1]);
+    spi_test_complete();
+    mu_assert_string_eq("Ntnc", spi_test_log);
+}
+
+MU_TEST(spi_queue_cancel_test) {
+    uint8_t data[8] = {0};
+    const FuriHalSpiTransfer transfers[] = {
+        {.tx_buffer = data, .size = sizeof(data)},
+        {.tx_buffer = data, .size = sizeof(data)},
+    };
+    FuriHalSpiJob jobs[3];
+    size_t callbacks = 0;
+    spi_test_job_init(&jobs[0], &spi_test_handle_low, transfers, 2, &callbacks);
+    spi_test_job_init(&jobs[1], &spi_test_handle_normal, transfers, 1, &callbacks);
+    spi_test_job_init(&jobs[2], &spi_test_handle_high, transfers, 1, &callbacks);
+
+    furi_hal_spi_job_submit(&jobs[0]);
+    furi_hal_spi_job_submit(&jobs[1]);
+    furi_hal_spi_job_submit(&jobs[2]);
+    mu_assert_int_eq(FuriHalSpiJobStateActive, jobs[0].state);
+
+    // Pending job is just removed
+    mu_check(furi_hal_spi_job_cancel(&jobs[2]));
+    mu_assert_int_eq(FuriHalSpiJobStateCanceled, jobs[2].state);
+    mu_assert_int_eq(1, callbacks);
+
+    // Active job is aborted in the middle, CS released and next job started
+    spi_test_complete();
+    mu_check(furi_hal_spi_job_cancel(&jobs[0]));
+    mu_assert_int_eq(FuriHalSpiJobStateCanceled, jobs[0].state);
+    mu_assert_int_eq(FuriHalSpiJobStateActive, jobs[1].state);
+    mu_assert_int_eq(2, callbacks);
+
+    spi_test_complete();
+    mu_assert_int_eq(FuriHalSpiJobStateDone, jobs[1].state);
+    mu_assert_string_eq("LtctxlNtcnc", spi_test_log);
+
+    // Nothing to cancel in finished jobs
+    mu_check(!furi_hal_spi_job_cancel(&jobs[1]));
+    mu_check(!furi_hal_spi_job_cancel(&jobs[2]));
+    mu_assert_int_eq(3, callbacks);
+    mu_check(spi_test_bus.current_handle == NULL);
+}
+
+/* Display-like job, submitted again from its callback while count lasts */
+static void spi_test_job_resubmit_callback(FuriHalSpiJob* job, void* context) {
+    size_t* count = context;
+    if(*count > 0) {
+        (*count)--;
+        furi_hal_spi_job_submit(job);
+    }
+}
+
+static volatile bool spi_test_completer_run;
+
+/* Completes transfers from a higher priority thread, preempting bus holder like DMA interrupt */
+static int32_t spi_test_completer(void* context) {
+    while(spi_test_completer_run) {
+        if(spi_test_dma_running) {
+            spi_test_complete();
+        }
+        osDelay(1);
+    }
+    return 0;
+}
+
+MU_TEST(spi_queue_acquire_back_to_back_test) {
+    uint8_t data[32] = {0};
+    const FuriHalSpiTransfer transfers[] = {
+        {.tx_buffer = data, .size = sizeof(data)},
+        {.tx_buffer = data, .size = sizeof(data)},
+    };
+    FuriHalSpiJob job;
+    size_t resubmits = 1000;
+    spi_test_job_init(&job, &spi_test_handle_low, transfers, 2, &resubmits);
+    job.callback = spi_test_job_resubmit_callback;
+
+    FuriThread* completer = furi_thread_alloc();
+    furi_thread_set_name(completer, "SpiTestDma");
+    furi_thread_set_stack_size(completer, 1024);
+    furi_thread_set_callback(completer, spi_test_completer);
+    spi_test_completer_run = true;
+    furi_thread_start(completer);
+    osThreadSetPriority(furi_thread_get_thread_id(completer), osPriorityHigh);
+
+    furi_hal_spi_job_submit(&job);
+    for(size_t i = 0; i < 16; i++) {
+        osDelay(i % 4 + 1);
+        // Holder gets bus only when queue is idle, not when some job finished
+        furi_hal_spi_acquire(&spi_test_handle_high);
+        mu_check(spi_test_bus.queue_active == NULL);
+        mu_check(!spi_test_dma_running);
+        osDelay(2);
+        // Job resubmitted from callback waits for holder
+        mu_check(!spi_test_dma_running);
+        furi_hal_spi_release(&spi_test_handle_high);
+    }
+
+    spi_test_completer_run = false;
+    furi_thread_join(completer);
+    furi_thread_free(completer);
+    resubmits = 0;
+    furi_hal_spi_job_cancel(&job);
+
+    mu_assert_int_eq(0, spi_test_activate_busy);
+    mu_check(spi_test_bus.current_handle == NULL);
+}
+
+MU_TEST_SUITE(furi_hal_spi_suite) {
+    MU_SUITE_CONFIGURE(&spi_test_before, &spi_test_after);
+    MU_RUN_TEST(spi_queue_priority_test);
+    MU_RUN_TEST(spi_queue_chip_select_test);
+    MU_RUN_TEST(spi_queue_cancel_test);
+    MU_RUN_TEST(spi_queue_acquire_back_to_back_test);
+}
+
+int run_minunit_test_furi_hal_spi() {
+    MU_RUN_SUITE(furi_hal_spi_suite);
+    return MU_EXIT_CODE;
+}
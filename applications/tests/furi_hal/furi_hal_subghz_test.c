@@ -0,0 +1,195 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/drivers/cc1101.h>
+#include <string.h>
+#include "../minunit.h"
+
+#define TAG "FuriHalSubGhzTest"
+
+static const uint8_t subghz_test_preset_ook[][2] = {
+    {CC1101_IOCFG0, 0x0D},
+    {CC1101_FIFOTHR, 0x47},
+    {CC1101_PKTCTRL0, 0x32},
+    {CC1101_FSCTRL1, 0x06},
+    {CC1101_MDMCFG0, 0x00},
+    {CC1101_MDMCFG1, 0x00},
+    {CC1101_MDMCFG2, 0x30},
+    {CC1101_MDMCFG3, 0x32},
+    {CC1101_MDMCFG4, 0x67},
+    {CC1101_MCSM0, 0x18},
+    {CC1101_FOCCFG, 0x18},
+    {CC1101_AGCCTRL0, 0x40},
+    {CC1101_AGCCTRL1, 0x00},
+    {CC1101_AGCCTRL2, 0x03},
+    {CC1101_WORCTRL, 0xFB},
+    {CC1101_FREND0, 0x11},
+    {CC1101_FREND1, 0xB6},
+    {0, 0},
+};
+
+/* Same as above with wide filter and AGC tuned for it */
+static const uint8_t subghz_test_preset_ook_wide[][2] = {
+    {CC1101_IOCFG0, 0x0D},
+    {CC1101_FIFOTHR, 0x07},
+    {CC1101_PKTCTRL0, 0x32},
+    {CC1101_FSCTRL1, 0x06},
+    {CC1101_MDMCFG0, 0x00},
+    {CC1101_MDMCFG1, 0x00},
+    {CC1101_MDMCFG2, 0x30},
+    {CC1101_MDMCFG3, 0x32},
+    {CC1101_MDMCFG4, 0x17},
+    {CC1101_MCSM0, 0x18},
+    {CC1101_FOCCFG, 0x18},
+    {CC1101_AGCCTRL0, 0x91},
+    {CC1101_AGCCTRL1, 0x00},
+    {CC1101_AGCCTRL2, 0x07},
+    {CC1101_WORCTRL, 0xFB},
+    {CC1101_FREND0, 0x11},
+    {CC1101_FREND1, 0xB6},
+    {0, 0},
+};
+
+static size_t subghz_test_build_image(const uint8_t preset[][2], uint8_t* image) {
+    size_t count = 0;
+    memcpy(image, cc1101_reset_values, CC1101_CONFIG_SIZE);
+    while(preset[count][0]) {
+        image[preset[count][0]] = preset[count][1];
+        count++;
+    }
+    return count;
+}
+
+static void subghz_test_read_registers(uint8_t* registers) {
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    cc1101_read_burst(&furi_hal_spi_bus_handle_subghz, 0, registers, CC1101_CONFIG_SIZE);
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+}
+
+MU_TEST(subghz_cc1101_write_changed_test) {
+    uint8_t* shadow = malloc(CC1101_CONFIG_SIZE);
+    uint8_t* image = malloc(CC1101_CONFIG_SIZE);
+    uint8_t* registers = malloc(CC1101_CONFIG_SIZE);
+    FuriHalSpiBusHandle* handle = &furi_hal_spi_bus_handle_subghz;
+
+    furi_hal_subghz_reset();
+    furi_hal_spi_acquire(handle);
+    cc1101_reset(handle);
+    memcpy(shadow, cc1101_reset_values, CC1101_CONFIG_SIZE);
+    cc1101_read_burst(handle, 0, registers, CC1101_CONFIG_SIZE);
+    mu_check(memcmp(cc1101_reset_values, registers, CC1101_CONFIG_SIZE) == 0);
+
+    // Load after reset: register per transaction before, bursts now
+    size_t legacy = 1 + subghz_test_build_image(subghz_test_preset_ook, image);
+    size_t transactions = 1 + cc1101_write_changed(handle, shadow, image);
+    cc1101_read_burst(handle, 0, registers, CC1101_CONFIG_SIZE);
+    mu_check(memcmp(image, registers, CC1101_CONFIG_SIZE) == 0);
+    mu_check(memcmp(image, shadow, CC1101_CONFIG_SIZE) == 0);
+    mu_check(transactions < legacy);
+    FURI_LOG_I(TAG, "Preset load: %d transactions, was %d", transactions, legacy);
+
+    // Switch: only changed registers
+    legacy = 1 + subghz_test_build_image(subghz_test_preset_ook_wide, image);
+    transactions = cc1101_write_changed(handle, shadow, image);
+    cc1101_read_burst(handle, 0, registers, CC1101_CONFIG_SIZE);
+    mu_check(memcmp(image, registers, CC1101_CONFIG_SIZE) == 0);
+    mu_check(transactions > 0);
+    mu_check(transactions <= 4);
+    FURI_LOG_I(TAG, "Preset switch: %d transactions, was %d", transactions, legacy);
+
+    // Same preset again: nothing to write
+    mu_assert_int_eq(0, cc1101_write_changed(handle, shadow, image));
+
+    furi_hal_spi_release(handle);
+    // Driver was used behind HAL back, let it resync
+    furi_hal_subghz_reset();
+    furi_hal_subghz_sleep();
+
+    free(registers);
+    free(image);
+    free(shadow);
+}
+
+MU_TEST(subghz_load_registers_test) {
+    uint8_t* expected = malloc(CC1101_CONFIG_SIZE);
+    uint8_t* registers = malloc(CC1101_CONFIG_SIZE);
+
+    // Chip is reset when it comes from sleep
+    furi_hal_subghz_reset();
+    furi_hal_subghz_sleep();
+    furi_hal_subghz_load_registers(subghz_test_preset_ook);
+    subghz_test_build_image(subghz_test_preset_ook, expected);
+    subghz_test_read_registers(registers);
+    mu_check(memcmp(expected, registers, CC1101_CONFIG_SIZE) == 0);
+
+    // Switching without reset must end up with the same registers as reset does
+    furi_hal_subghz_load_registers(subghz_test_preset_ook_wide);
+    subghz_test_build_image(subghz_test_preset_ook_wide, expected);
+    subghz_test_read_registers(registers);
+    mu_check(memcmp(expected, registers, CC1101_CONFIG_SIZE) == 0);
+
+    furi_hal_subghz_set_frequency(433920000);
+    furi_hal_subghz_set_path(FuriHalSubGhzPath433);
+    furi_hal_subghz_load_registers(subghz_test_preset_ook);
+    subghz_test_build_image(subghz_test_preset_ook, expected);
+    subghz_test_read_registers(registers);
+    mu_check(memcmp(expected, registers, CC1101_CONFIG_SIZE) == 0);
+
+    furi_hal_subghz_sleep();
+
+    free(registers);
+    free(expected);
+}
+
+MU_TEST(subghz_hop_test) {
+    const uint32_t frequencies[] = {315000000, 433920000, 868350000};
+    FuriHalSubGhzHop hops[COUNT_OF(frequencies)];
+    uint8_t freq[3];
+    uint8_t fscal[3];
+
+    furi_hal_subghz_reset();
+    furi_hal_subghz_load_registers(subghz_test_preset_ook_wide);
+    for(size_t i = 0; i < COUNT_OF(frequencies); i++) {
+        uint32_t real_frequency = furi_hal_subghz_hop_prepare(&hops[i], frequencies[i]);
+        mu_assert_int_eq(furi_hal_subghz_set_frequency(frequencies[i]), real_frequency);
+    }
+
+    uint32_t cycles_hop = 0;
+    uint32_t cycles_set = 0;
+    for(size_t i = 0; i < COUNT_OF(frequencies); i++) {
+        uint32_t start = DWT->CYCCNT;
+        mu_assert_int_eq(hops[i].frequency, furi_hal_subghz_hop(&hops[i]));
+        cycles_hop += DWT->CYCCNT - start;
+
+        furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+        cc1101_read_burst(&furi_hal_spi_bus_handle_subghz, CC1101_FREQ2, freq, sizeof(freq));
+        cc1101_read_burst(&furi_hal_spi_bus_handle_subghz, CC1101_FSCAL3, fscal, sizeof(fscal));
+        furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+        mu_check(memcmp(hops[i].freq, freq, sizeof(freq)) == 0);
+        mu_check(memcmp(hops[i].fscal, fscal, sizeof(fscal)) == 0);
+
+        start = DWT->CYCCNT;
+        furi_hal_subghz_set_frequency(frequencies[i]);
+        cycles_set += DWT->CYCCNT - start;
+    }
+    mu_check(cycles_hop < cycles_set);
+
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    FURI_LOG_I(
+        TAG,
+        "Hop %luus, set frequency %luus",
+        cycles_hop / COUNT_OF(frequencies) / cycles_per_us,
+        cycles_set / COUNT_OF(frequencies) / cycles_per_us);
+
+    furi_hal_subghz_sleep();
+}
+
+MU_TEST_SUITE(furi_hal_subghz_suite) {
+    MU_RUN_TEST(subghz_cc1101_write_changed_test);
+    MU_RUN_TEST(subghz_load_registers_test);
+    MU_RUN_TEST(subghz_hop_test);
+}
+
+int run_minunit_test_furi_hal_subghz() {
+    MU_RUN_SUITE(furi_hal_subghz_suite);
+    return MU_EXIT_CODE;
+}
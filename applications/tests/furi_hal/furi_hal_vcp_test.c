@@ -0,0 +1,153 @@
+#include <furi.h>
+#include <furi_hal_vcp_buffer.h>
+#include <string.h>
+#include "../minunit.h"
+
+static uint8_t vcp_test_pattern(size_t index) {
+    return (index * 7 + 3) & 0xFF;
+}
+
+MU_TEST(vcp_rx_buffer_test) {
+    VcpRxBuffer* buffer = malloc(sizeof(VcpRxBuffer));
+    vcp_rx_buffer_reset(buffer);
+    mu_check(vcp_rx_buffer_is_empty(buffer));
+
+    // Fill all slots with packets of different length, zero length packets take no slot
+    size_t written = 0;
+    for(size_t i = 0; i < VCP_RX_BUFFER_SLOTS; i++) {
+        uint8_t* slot = vcp_rx_buffer_get_slot(buffer);
+        mu_check(slot != NULL);
+        vcp_rx_buffer_commit(buffer, 0);
+        size_t len = (i % 2) ? VCP_BUFFER_PKT_LEN : (i % VCP_BUFFER_PKT_LEN) + 1;
+        for(size_t j = 0; j < len; j++) {
+            slot[j] = vcp_test_pattern(written + j);
+        }
+        vcp_rx_buffer_commit(buffer, len);
+        written += len;
+    }
+    mu_check(vcp_rx_buffer_get_slot(buffer) == NULL);
+
+    // Reads are not aligned to packets, slot is freed once consumed
+    uint8_t data[13];
+    size_t read = 0;
+    size_t len = vcp_rx_buffer_read(buffer, data, 1);
+    mu_assert_int_eq(1, len);
+    mu_assert_int_eq(vcp_test_pattern(0), data[0]);
+    read += len;
+    mu_check(vcp_rx_buffer_get_slot(buffer) != NULL);
+
+    while((len = vcp_rx_buffer_read(buffer, data, sizeof(data))) > 0) {
+        for(size_t i = 0; i < len; i++) {
+            mu_assert_int_eq(vcp_test_pattern(read + i), data[i]);
+        }
+        read += len;
+    }
+    mu_assert_int_eq(written, read);
+    mu_check(vcp_rx_buffer_is_empty(buffer));
+
+    free(buffer);
+}
+
+static size_t vcp_test_tx_transfer(VcpTxBuffer* buffer, size_t* packets, size_t* zlps) {
+    const uint8_t* data;
+    size_t len;
+    size_t sent = 0;
+    while(vcp_tx_buffer_get_packet(buffer, &data, &len)) {
+        mu_check(len <= VCP_BUFFER_PKT_LEN);
+        if(len == 0) {
+            (*zlps)++;
+        } else {
+            (*packets)++;
+        }
+        vcp_tx_buffer_release(buffer, len);
+        sent += len;
+    }
+    return sent;
+}
+
+MU_TEST(vcp_tx_buffer_framing_test) {
+    VcpTxBuffer* buffer = malloc(sizeof(VcpTxBuffer));
+    uint8_t* data = malloc(FURI_HAL_VCP_TX_BUF_SIZE);
+    size_t packets = 0;
+    size_t zlps = 0;
+    vcp_tx_buffer_reset(buffer);
+
+    // Transfer of whole packets is terminated with zero length packet
+    mu_assert_int_eq(
+        VCP_BUFFER_PKT_LEN * 3, vcp_tx_buffer_write(buffer, data, VCP_BUFFER_PKT_LEN * 3));
+    mu_assert_int_eq(VCP_BUFFER_PKT_LEN * 3, vcp_test_tx_transfer(buffer, &packets, &zlps));
+    mu_assert_int_eq(3, packets);
+    mu_assert_int_eq(1, zlps);
+
+    // Short packet terminates transfer by itself
+    packets = 0;
+    zlps = 0;
+    mu_assert_int_eq(100, vcp_tx_buffer_write(buffer, data, 100));
+    mu_assert_int_eq(100, vcp_test_tx_transfer(buffer, &packets, &zlps));
+    mu_assert_int_eq(2, packets);
+    mu_assert_int_eq(0, zlps);
+
+    // Nothing to send in idle state
+    const uint8_t* packet;
+    size_t len;
+    mu_check(!vcp_tx_buffer_get_packet(buffer, &packet, &len));
+
+    free(data);
+    free(buffer);
+}
+
+MU_TEST(vcp_tx_buffer_wrap_test) {
+    VcpTxBuffer* buffer = malloc(sizeof(VcpTxBuffer));
+    uint8_t* data = malloc(FURI_HAL_VCP_TX_BUF_SIZE);
+    for(size_t i = 0; i < FURI_HAL_VCP_TX_BUF_SIZE; i++) {
+        data[i] = vcp_test_pattern(i);
+    }
+    vcp_tx_buffer_reset(buffer);
+
+    // Buffer accepts only as much as it can hold
+    mu_assert_int_eq(
+        FURI_HAL_VCP_TX_BUF_SIZE - 10,
+        vcp_tx_buffer_write(buffer, data, FURI_HAL_VCP_TX_BUF_SIZE - 10));
+    mu_assert_int_eq(10, vcp_tx_buffer_write(buffer, data, FURI_HAL_VCP_TX_BUF_SIZE));
+    mu_assert_int_eq(0, vcp_tx_buffer_write(buffer, data, 1));
+
+    // Drop everything and continue from the middle of the buffer
+    vcp_tx_buffer_flush(buffer);
+    const uint8_t* packet;
+    size_t len;
+    mu_check(!vcp_tx_buffer_get_packet(buffer, &packet, &len));
+    mu_assert_int_eq(100, vcp_tx_buffer_write(buffer, data, 100));
+    size_t packets = 0;
+    size_t zlps = 0;
+    mu_assert_int_eq(100, vcp_test_tx_transfer(buffer, &packets, &zlps));
+
+    // Data written across the end comes out in order, packet is cut at wrap
+    size_t total = FURI_HAL_VCP_TX_BUF_SIZE - 1;
+    mu_assert_int_eq(total, vcp_tx_buffer_write(buffer, data, total));
+    size_t sent = 0;
+    size_t short_packets = 0;
+    while(vcp_tx_buffer_get_packet(buffer, &packet, &len) && len) {
+        mu_assert(memcmp(packet, &data[sent], len) == 0, "packet data mismatch");
+        if(len < VCP_BUFFER_PKT_LEN) {
+            short_packets++;
+        }
+        vcp_tx_buffer_release(buffer, len);
+        sent += len;
+    }
+    mu_assert_int_eq(total, sent);
+    mu_check(short_packets <= 2);
+
+    free(data);
+    free(buffer);
+}
+
+MU_TEST_SUITE(furi_hal_vcp_suite) {
+    MU_RUN_TEST(vcp_rx_buffer_test);
+    MU_RUN_TEST(vcp_tx_buffer_framing_test);
+    MU_RUN_TEST(vcp_tx_buffer_wrap_test);
+}
+
+int run_minunit_test_furi_hal_vcp() {
+    MU_RUN_SUITE(furi_hal_vcp_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include "minunit.h"
+
+#define TAG "LogTest"
+#define LOG_TEST_LINES 256
+
+static uint32_t log_test_lines = 0;
+
+static void log_test_puts(const char* data) {
+    if(strstr(data, TAG)) {
+        log_test_lines++;
+    }
+}
+
+void test_furi_log() {
+    FuriLogStats before;
+    FuriLogStats after;
+    FuriLogLevel level = furi_log_get_level();
+    uint32_t cycles_total = 0;
+    uint32_t cycles_max = 0;
+
+    furi_log_set_level(FuriLogLevelDebug);
+    log_test_lines = 0;
+    furi_log_get_stats(&before);
+    furi_log_set_puts(log_test_puts);
+
+    // Caller runs faster than log thread, so queue overflows and lines are dropped
+    for(size_t i = 0; i < LOG_TEST_LINES; i++) {
+        uint32_t start = DWT->CYCCNT;
+        FURI_LOG_D(TAG, "line %d of %d, value %08lX", i, LOG_TEST_LINES, start);
+        uint32_t cycles = DWT->CYCCNT - start;
+        cycles_total += cycles;
+        cycles_max = MAX(cycles_max, cycles);
+    }
+
+    for(size_t i = 0; i < 1000; i++) {
+        furi_log_get_stats(&after);
+        if(after.pending == 0) break;
+        osDelay(1);
+    }
+
+    furi_log_set_puts(furi_hal_console_puts);
+    furi_log_set_level(level);
+
+    mu_assert_int_eq(0, after.pending);
+    mu_check(log_test_lines > 0);
+    mu_check(log_test_lines <= LOG_TEST_LINES);
+    mu_check(log_test_lines + (after.dropped - before.dropped) >= LOG_TEST_LINES);
+    // Caller never waits for console, 1ms is enough for several lines at 230400 baud
+    mu_assert(cycles_max < SystemCoreClock / 1000, "log call blocked");
+
+    FURI_LOG_I(
+        TAG,
+        "Call: avg %lu, max %lu cycles, printed %lu, dropped %lu",
+        cycles_total / LOG_TEST_LINES,
+        cycles_max,
+        log_test_lines,
+        after.dropped - before.dropped);
+}
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include "minunit.h"
+
+#define POOL_TEST_CAPACITY 4
+
+typedef struct {
+    uint32_t value;
+    uint8_t data[13];
+} PoolTestItem;
+
+void test_furi_pool() {
+    FuriPoolStats stats;
+    PoolTestItem* items[POOL_TEST_CAPACITY];
+
+    // alloc pool case
+    FuriPool* pool = furi_pool_alloc_typed("test", PoolTestItem, POOL_TEST_CAPACITY);
+    mu_assert_pointers_not_eq(pool, NULL);
+    furi_pool_get_stats(pool, &stats);
+    mu_assert(stats.block_size >= sizeof(PoolTestItem), "block is smaller than type");
+    mu_assert_int_eq(stats.capacity, POOL_TEST_CAPACITY);
+
+    // acquire whole pool case
+    for(size_t i = 0; i < POOL_TEST_CAPACITY; i++) {
+        items[i] = furi_pool_acquire(pool);
+        mu_assert_pointers_not_eq(items[i], NULL);
+        mu_assert(furi_pool_contains(pool, items[i]), "block is not from pool");
+        mu_assert_int_eq(items[i]->value, 0);
+        items[i]->value = i + 1;
+    }
+
+    // exhausted pool case
+    PoolTestItem* heap_item = furi_pool_acquire(pool);
+    mu_assert_pointers_not_eq(heap_item, NULL);
+    mu_assert(!furi_pool_contains(pool, heap_item), "block is from pool");
+    furi_pool_release(pool, heap_item);
+
+    furi_pool_get_stats(pool, &stats);
+    mu_assert_int_eq(stats.used, POOL_TEST_CAPACITY);
+    mu_assert_int_eq(stats.peak, POOL_TEST_CAPACITY);
+    mu_assert_int_eq(stats.hits, POOL_TEST_CAPACITY);
+    mu_assert_int_eq(stats.misses, 1);
+
+    // content is preserved between release and acquire
+    furi_pool_release(pool, items[1]);
+    PoolTestItem* item = furi_pool_acquire(pool);
+    mu_assert_pointers_eq(item, items[1]);
+    mu_assert_int_eq(item->value, 2);
+
+    // release all case
+    for(size_t i = 0; i < POOL_TEST_CAPACITY; i++) {
+        furi_pool_release(pool, items[i]);
+    }
+    furi_pool_get_stats(pool, &stats);
+    mu_assert_int_eq(stats.used, 0);
+
+    // free pool case
+    furi_pool_free(pool);
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <furi.h>
+#include <furi_hal.h>
 #include "minunit.h"
 
 const uint32_t context_value = 0xdeadbeef;
@@ -42,4 +43,93 @@ void test_furi_pubsub() {
 
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
-}
\ No newline at end of file
+}
+
+#define PUBSUB_BENCH_TAG "PubSubBench"
+#define PUBSUB_BENCH_PUBLISHES 256
+#define PUBSUB_BENCH_SUBSCRIBERS_MAX 32
+
+/* Mutex and linked list pubsub for comparison */
+typedef struct PubSubBenchItem {
+    FuriPubSubCallback callback;
+    void* callback_context;
+    struct PubSubBenchItem* next;
+} PubSubBenchItem;
+
+typedef struct {
+    PubSubBenchItem* items;
+    osMutexId_t mutex;
+} PubSubBenchLocked;
+
+static void pubsub_bench_locked_publish(PubSubBenchLocked* pubsub, void* message) {
+    furi_check(osMutexAcquire(pubsub->mutex, osWaitForever) == osOK);
+    for(const PubSubBenchItem* item = pubsub->items; item; item = item->next) {
+        item->callback(message, item->callback_context);
+    }
+    furi_check(osMutexRelease(pubsub->mutex) == osOK);
+}
+
+static void pubsub_bench_handler(const void* arg, void* ctx) {
+    (*(uint32_t*)ctx) += *(const uint32_t*)arg;
+}
+
+void test_furi_pubsub_benchmark() {
+    const size_t subscribers[] = {1, 2, 4, 8, 16, PUBSUB_BENCH_SUBSCRIBERS_MAX};
+    FuriPubSubSubscription* subscriptions[PUBSUB_BENCH_SUBSCRIBERS_MAX];
+    PubSubBenchItem* items = malloc(sizeof(PubSubBenchItem) * PUBSUB_BENCH_SUBSCRIBERS_MAX);
+    uint32_t* messages = malloc(sizeof(uint32_t) * PUBSUB_BENCH_PUBLISHES);
+    for(size_t i = 0; i < PUBSUB_BENCH_PUBLISHES; i++) {
+        messages[i] = 1;
+    }
+
+    for(size_t s = 0; s < COUNT_OF(subscribers); s++) {
+        size_t count = subscribers[s];
+        uint32_t received = 0;
+
+        FuriPubSub* pubsub = furi_pubsub_alloc();
+        PubSubBenchLocked locked = {.items = NULL, .mutex = osMutexNew(NULL)};
+        for(size_t i = 0; i < count; i++) {
+            subscriptions[i] = furi_pubsub_subscribe(pubsub, pubsub_bench_handler, &received);
+            items[i].callback = pubsub_bench_handler;
+            items[i].callback_context = &received;
+            items[i].next = locked.items;
+            locked.items = &items[i];
+        }
+
+        uint32_t start = DWT->CYCCNT;
+        for(size_t i = 0; i < PUBSUB_BENCH_PUBLISHES; i++) {
+            furi_pubsub_publish(pubsub, &messages[i]);
+        }
+        uint32_t lock_free_cycles = (DWT->CYCCNT - start) / PUBSUB_BENCH_PUBLISHES;
+
+        start = DWT->CYCCNT;
+        for(size_t i = 0; i < PUBSUB_BENCH_PUBLISHES; i++) {
+            pubsub_bench_locked_publish(&locked, &messages[i]);
+        }
+        uint32_t locked_cycles = (DWT->CYCCNT - start) / PUBSUB_BENCH_PUBLISHES;
+
+        start = DWT->CYCCNT;
+        furi_pubsub_publish_batch(pubsub, messages, sizeof(uint32_t), PUBSUB_BENCH_PUBLISHES);
+        uint32_t batch_cycles = (DWT->CYCCNT - start) / PUBSUB_BENCH_PUBLISHES;
+
+        // every subscriber got every message once per run
+        mu_assert_int_eq(count * PUBSUB_BENCH_PUBLISHES * 3, received);
+
+        FURI_LOG_I(
+            PUBSUB_BENCH_TAG,
+            "%d subscribers, cycles per publish: lock-free %lu, mutex %lu, batch %lu",
+            count,
+            lock_free_cycles,
+            locked_cycles,
+            batch_cycles);
+
+        for(size_t i = 0; i < count; i++) {
+            furi_pubsub_unsubscribe(pubsub, subscriptions[i]);
+        }
+        furi_pubsub_free(pubsub);
+        osMutexDelete(locked.mutex);
+    }
+
+    free(messages);
+    free(items);
+}
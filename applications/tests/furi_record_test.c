@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <furi.h>
+#include <furi_hal.h>
 #include "minunit.h"
 
 void test_furi_create_open() {
@@ -18,3 +19,53 @@ void test_furi_create_open() {
     // 4. Clean up
     furi_record_destroy("test/holding");
 }
+
+#define RECORD_BENCH_TAG "RecordBench"
+#define RECORD_BENCH_CYCLES 1000
+
+void test_furi_record_handle() {
+    uint8_t test_data = 0;
+    FuriRecordHandle* handle = furi_record_get_handle("test/handle");
+    mu_assert_pointers_not_eq(handle, NULL);
+    mu_check(!furi_record_exists("test/handle"));
+
+    // Handle is the same before and after record is created
+    furi_record_create("test/handle", (void*)&test_data);
+    mu_assert_pointers_eq(handle, furi_record_get_handle("test/handle"));
+    mu_assert_pointers_eq(furi_record_open_handle(handle), &test_data);
+
+    // Record is held by handle, string API sees it
+    mu_check(!furi_record_destroy("test/handle"));
+    furi_record_close_handle(handle);
+
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < RECORD_BENCH_CYCLES; i++) {
+        furi_record_open("test/handle");
+        furi_record_close("test/handle");
+    }
+    uint32_t string_cycles = (DWT->CYCCNT - start) / RECORD_BENCH_CYCLES;
+
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < RECORD_BENCH_CYCLES; i++) {
+        furi_record_open_handle(handle);
+        furi_record_close_handle(handle);
+    }
+    uint32_t handle_cycles = (DWT->CYCCNT - start) / RECORD_BENCH_CYCLES;
+
+    FURI_LOG_I(
+        RECORD_BENCH_TAG,
+        "cycles per open/close: string %lu, handle %lu",
+        string_cycles,
+        handle_cycles);
+    mu_check(handle_cycles <= string_cycles);
+
+    // Handle survives destroy and points to new data after recreate
+    mu_check(furi_record_destroy("test/handle"));
+    mu_check(!furi_record_exists("test/handle"));
+    uint8_t new_data = 0;
+    furi_record_create("test/handle", (void*)&new_data);
+    mu_assert_pointers_eq(FURI_RECORD_HANDLE("test/handle"), handle);
+    mu_assert_pointers_eq(furi_record_open_handle(handle), &new_data);
+    furi_record_close_handle(handle);
+    mu_check(furi_record_destroy("test/handle"));
+}
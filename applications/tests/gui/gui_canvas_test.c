@@ -0,0 +1,224 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+#include <gui/canvas_i.h>
+#include <gui/gui_i.h>
+#include <gui/icon_i.h>
+#include <u8g2_glue.h>
+#include "../minunit.h"
+
+#define GUI_TEST_TILE_WIDTH 16
+#define GUI_TEST_TILE_HEIGHT 8
+#define GUI_TEST_PAGE_SIZE (GUI_TEST_TILE_WIDTH * 8)
+#define GUI_TEST_BUFFER_SIZE (GUI_TEST_PAGE_SIZE * GUI_TEST_TILE_HEIGHT)
+#define GUI_TEST_FRAMES 256
+#define GUI_TEST_ICON_REDRAWS 8
+
+#define TAG "GuiTest"
+
+// Display RAM emulated from SPI traffic of the real st756x driver
+typedef struct {
+    uint8_t ram[GUI_TEST_BUFFER_SIZE];
+    uint8_t column;
+    uint8_t page;
+    bool data_mode;
+    size_t pages_sent;
+    size_t bytes_sent;
+} GuiCanvasTestDisplay;
+
+static GuiCanvasTestDisplay* gui_canvas_test_display;
+
+static void gui_canvas_test_display_byte(GuiCanvasTestDisplay* display, uint8_t byte) {
+    if(display->data_mode) {
+        display->ram[display->page * GUI_TEST_PAGE_SIZE + display->column++] = byte;
+        display->bytes_sent++;
+    } else if((byte & 0xF0) == 0xB0) {
+        display->page = byte & 0x0F;
+        display->pages_sent++;
+    } else if((byte & 0xF0) == 0x10) {
+        display->column = (display->column & 0x0F) | ((byte & 0x0F) << 4);
+    } else if((byte & 0xF0) == 0x00) {
+        display->column = (display->column & 0xF0) | (byte & 0x0F);
+    }
+}
+
+static uint8_t gui_canvas_test_byte_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    GuiCanvasTestDisplay* display = gui_canvas_test_display;
+    if(msg == U8X8_MSG_BYTE_SET_DC) {
+        display->data_mode = arg_int;
+    } else if(msg == U8X8_MSG_BYTE_SEND) {
+        const uint8_t* bytes = arg_ptr;
+        for(uint8_t i = 0; i < arg_int; i++) {
+            gui_canvas_test_display_byte(display, bytes[i]);
+        }
+    }
+    return 1;
+}
+
+static uint8_t gui_canvas_test_gpio_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    return 1;
+}
+
+// Canvas on top of the flipper st756x driver, with own buffer instead of the shared static one
+static Canvas* gui_canvas_test_alloc() {
+    Canvas* canvas = malloc(sizeof(Canvas));
+    u8g2_Setup_st756x_flipper(
+        &canvas->fb, U8G2_R0, gui_canvas_test_byte_cb, gui_canvas_test_gpio_cb);
+    u8g2_SetupBuffer(
+        &canvas->fb,
+        malloc(GUI_TEST_BUFFER_SIZE),
+        GUI_TEST_TILE_HEIGHT,
+        u8g2_ll_hvline_vertical_top_lsb,
+        U8G2_R0);
+    canvas->fb_shadow = malloc(GUI_TEST_BUFFER_SIZE);
+    canvas->commits_till_full = 0;
+    return canvas;
+}
+
+static void gui_canvas_test_free(Canvas* canvas) {
+    free(u8g2_GetBufferPtr(&canvas->fb));
+    free(canvas->fb_shadow);
+    free(canvas);
+}
+
+static size_t gui_canvas_test_commit(Canvas* canvas) {
+    gui_canvas_test_display->pages_sent = 0;
+    gui_canvas_test_display->bytes_sent = 0;
+    return canvas_commit(canvas);
+}
+
+MU_TEST(gui_canvas_dirty_tiles_test) {
+    uint8_t buffer[GUI_TEST_PAGE_SIZE] = {0};
+    uint8_t shadow[GUI_TEST_PAGE_SIZE] = {0};
+
+    CanvasDirtyTiles dirty = canvas_find_dirty_tiles(buffer, shadow, GUI_TEST_TILE_WIDTH);
+    mu_assert_int_eq(0, dirty.count);
+
+    buffer[3 * 8 + 7] = 0x80;
+    dirty = canvas_find_dirty_tiles(buffer, shadow, GUI_TEST_TILE_WIDTH);
+    mu_assert_int_eq(3, dirty.first);
+    mu_assert_int_eq(1, dirty.count);
+
+    buffer[GUI_TEST_PAGE_SIZE - 1] = 0x01;
+    dirty = canvas_find_dirty_tiles(buffer, shadow, GUI_TEST_TILE_WIDTH);
+    mu_assert_int_eq(3, dirty.first);
+    mu_assert_int_eq(GUI_TEST_TILE_WIDTH - 3, dirty.count);
+
+    buffer[0] = 0x01;
+    dirty = canvas_find_dirty_tiles(buffer, shadow, GUI_TEST_TILE_WIDTH);
+    mu_assert_int_eq(0, dirty.first);
+    mu_assert_int_eq(GUI_TEST_TILE_WIDTH, dirty.count);
+}
+
+MU_TEST(gui_canvas_partial_commit_test) {
+    gui_canvas_test_display = malloc(sizeof(GuiCanvasTestDisplay));
+    Canvas* canvas = gui_canvas_test_alloc();
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    size_t bytes_total = 0;
+
+    // First commit sends whole buffer
+    canvas_clear(canvas);
+    mu_assert_int_eq(GUI_TEST_BUFFER_SIZE, gui_canvas_test_commit(canvas));
+    mu_assert_int_eq(GUI_TEST_TILE_HEIGHT, gui_canvas_test_display->pages_sent);
+    mu_assert_int_eq(GUI_TEST_BUFFER_SIZE, gui_canvas_test_display->bytes_sent);
+
+    // Nothing changed: nothing sent
+    mu_assert_int_eq(0, gui_canvas_test_commit(canvas));
+    mu_assert_int_eq(0, gui_canvas_test_display->pages_sent);
+    mu_assert_int_eq(0, gui_canvas_test_display->bytes_sent);
+
+    // One pixel: one tile of one page
+    canvas_set_color(canvas, ColorBlack);
+    canvas_draw_dot(canvas, 29, 20);
+    mu_assert_int_eq(8, gui_canvas_test_commit(canvas));
+    mu_assert_int_eq(1, gui_canvas_test_display->pages_sent);
+    mu_assert_int_eq(8, gui_canvas_test_display->bytes_sent);
+    mu_check(memcmp(buffer, gui_canvas_test_display->ram, GUI_TEST_BUFFER_SIZE) == 0);
+
+    for(size_t frame = 0; frame < GUI_TEST_FRAMES; frame++) {
+        // Small random damage: blinking pixels and short lines
+        uint32_t random = furi_hal_random_get();
+        uint8_t x = random % (GUI_TEST_TILE_WIDTH * 8);
+        uint8_t y = (random >> 8) % (GUI_TEST_TILE_HEIGHT * 8);
+        uint8_t length = (random >> 16) % 24;
+        canvas_set_color(canvas, ((random >> 24) & 1) ? ColorBlack : ColorWhite);
+        for(uint8_t i = 0; i < length && (x + i) < GUI_TEST_TILE_WIDTH * 8; i++) {
+            canvas_draw_dot(canvas, x + i, y);
+        }
+
+        size_t bytes_sent = gui_canvas_test_commit(canvas);
+        mu_assert_int_eq(bytes_sent, gui_canvas_test_display->bytes_sent);
+        mu_check(gui_canvas_test_display->pages_sent <= GUI_TEST_TILE_HEIGHT);
+        mu_assert(
+            memcmp(buffer, gui_canvas_test_display->ram, GUI_TEST_BUFFER_SIZE) == 0,
+            "display content differs from framebuffer");
+        bytes_total += bytes_sent;
+    }
+
+    // Partial commit must be cheaper than full buffer transfer
+    mu_assert(
+        bytes_total < GUI_TEST_FRAMES * GUI_TEST_BUFFER_SIZE, "no savings on partial commit");
+
+    gui_canvas_test_free(canvas);
+    free(gui_canvas_test_display);
+    gui_canvas_test_display = NULL;
+}
+
+MU_TEST(gui_icon_cache_test) {
+    // Desktop animation loop: every frame is redrawn several times before it changes
+    const Icon* icon = &A_Levelup1_128x64;
+    const size_t frame_size = (icon->width + 7) / 8 * icon->height;
+    uint8_t* reference = malloc(frame_size);
+    uint32_t first_cycles = 0;
+    uint32_t cached_cycles = 0;
+    FuriHalCompressIconStats stats_before, stats_after;
+
+    // Cached data must not be touched by GUI thread while we compare it
+    Gui* gui = furi_record_open("gui");
+    gui_lock(gui);
+    furi_hal_compress_icon_get_stats(&stats_before);
+
+    for(uint8_t frame = 0; frame < icon->frame_count; frame++) {
+        uint8_t* decoded = NULL;
+        uint32_t start = DWT->CYCCNT;
+        furi_hal_compress_icon_decode(icon->frames[frame], &decoded);
+        first_cycles += DWT->CYCCNT - start;
+        memcpy(reference, decoded, frame_size);
+
+        for(uint8_t redraw = 0; redraw < GUI_TEST_ICON_REDRAWS; redraw++) {
+            start = DWT->CYCCNT;
+            furi_hal_compress_icon_decode(icon->frames[frame], &decoded);
+            cached_cycles += DWT->CYCCNT - start;
+            mu_assert(memcmp(reference, decoded, frame_size) == 0, "cached frame differs");
+        }
+    }
+
+    furi_hal_compress_icon_get_stats(&stats_after);
+    gui_unlock(gui);
+    furi_record_close("gui");
+
+    mu_assert(
+        stats_after.hits - stats_before.hits >= icon->frame_count * GUI_TEST_ICON_REDRAWS,
+        "cache is not hit on redraw");
+    mu_assert(stats_after.cache_used <= stats_after.cache_size, "cache overflow");
+
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    FURI_LOG_I(
+        TAG,
+        "Icon decode: first %luus, cached %luus",
+        first_cycles / icon->frame_count / cycles_per_us,
+        cached_cycles / (icon->frame_count * GUI_TEST_ICON_REDRAWS) / cycles_per_us);
+
+    free(reference);
+}
+
+MU_TEST_SUITE(gui_canvas_suite) {
+    MU_RUN_TEST(gui_canvas_dirty_tiles_test);
+    MU_RUN_TEST(gui_canvas_partial_commit_test);
+    MU_RUN_TEST(gui_icon_cache_test);
+}
+
+int run_minunit_test_gui() {
+    MU_RUN_SUITE(gui_canvas_suite);
+    return MU_EXIT_CODE;
+}
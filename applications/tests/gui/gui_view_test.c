@@ -0,0 +1,120 @@
+#include <furi.h>
+#include <string.h>
+#include <gui/view_i.h>
+#include "../minunit.h"
+
+typedef struct {
+    uint32_t value;
+    uint32_t check;
+} GuiViewTestModel;
+
+typedef struct {
+    uint32_t updates;
+    uint32_t drawn_value;
+    bool consistent;
+} GuiViewTestContext;
+
+static GuiViewTestContext gui_view_test_context;
+
+static void gui_view_test_update(View* view, void* context) {
+    GuiViewTestContext* test_context = context;
+    test_context->updates++;
+}
+
+static void gui_view_test_draw(Canvas* canvas, void* _model) {
+    GuiViewTestModel* model = _model;
+    gui_view_test_context.drawn_value = model->value;
+    gui_view_test_context.consistent = (model->check == ~model->value);
+}
+
+static void gui_view_test_set(View* view, uint32_t value, bool redraw) {
+    with_view_model(
+        view, (GuiViewTestModel * model) {
+            model->value = value;
+            model->check = ~value;
+            return redraw;
+        });
+}
+
+static View* gui_view_test_alloc(ViewModelType type) {
+    memset(&gui_view_test_context, 0, sizeof(GuiViewTestContext));
+    View* view = view_alloc();
+    view_allocate_model(view, type, sizeof(GuiViewTestModel));
+    view_set_draw_callback(view, gui_view_test_draw);
+    view_set_update_callback(view, gui_view_test_update);
+    view_set_update_callback_context(view, &gui_view_test_context);
+    return view;
+}
+
+MU_TEST(gui_view_update_coalescing_test) {
+    View* view = gui_view_test_alloc(ViewModelTypeLocking);
+
+    // Commits between draws emit one update
+    for(uint32_t i = 0; i < 10; i++) {
+        gui_view_test_set(view, i, true);
+    }
+    mu_assert_int_eq(1, gui_view_test_context.updates);
+    view_draw(view, NULL);
+    mu_assert_int_eq(9, gui_view_test_context.drawn_value);
+
+    // Commit without update doesn't block next one
+    gui_view_test_set(view, 10, false);
+    mu_assert_int_eq(1, gui_view_test_context.updates);
+    gui_view_test_set(view, 11, true);
+    mu_assert_int_eq(2, gui_view_test_context.updates);
+
+    // New owner gets update even if previous one didn't draw
+    view_set_update_callback(view, gui_view_test_update);
+    gui_view_test_set(view, 12, true);
+    mu_assert_int_eq(3, gui_view_test_context.updates);
+
+    ViewStats stats;
+    view_get_stats(view, &stats);
+    mu_assert_int_eq(13, stats.commits);
+    mu_assert_int_eq(3, stats.updates);
+    mu_assert_int_eq(1, stats.draws);
+
+    view_free(view);
+}
+
+MU_TEST(gui_view_snapshot_test) {
+    View* view = gui_view_test_alloc(ViewModelTypeSnapshot);
+    gui_view_test_set(view, 1, true);
+
+    // Draw doesn't wait for writer and sees last committed model
+    GuiViewTestModel* model = view_get_model(view);
+    model->value = 2;
+    view_draw(view, NULL);
+    mu_assert_int_eq(1, gui_view_test_context.drawn_value);
+    mu_check(gui_view_test_context.consistent);
+    model->check = ~model->value;
+    view_commit_model(view, true);
+
+    view_draw(view, NULL);
+    mu_assert_int_eq(2, gui_view_test_context.drawn_value);
+    mu_check(gui_view_test_context.consistent);
+
+    // Nothing new published, same snapshot is drawn again
+    view_draw(view, NULL);
+    mu_assert_int_eq(2, gui_view_test_context.drawn_value);
+
+    // Only latest of many commits is drawn
+    for(uint32_t i = 3; i < 100; i++) {
+        gui_view_test_set(view, i, true);
+    }
+    view_draw(view, NULL);
+    mu_assert_int_eq(99, gui_view_test_context.drawn_value);
+    mu_check(gui_view_test_context.consistent);
+
+    view_free(view);
+}
+
+MU_TEST_SUITE(gui_view_suite) {
+    MU_RUN_TEST(gui_view_update_coalescing_test);
+    MU_RUN_TEST(gui_view_snapshot_test);
+}
+
+int run_minunit_test_gui_view() {
+    MU_RUN_SUITE(gui_view_suite);
+    return MU_EXIT_CODE;
+}
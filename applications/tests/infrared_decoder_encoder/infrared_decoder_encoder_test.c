@@ -2,6 +2,7 @@
 #include "../minunit.h"
 #include "infrared.h"
 #include "common/infrared_common_i.h"
+#include "infrared_capture_buffer.h"
 #include "test_data/infrared_nec_test_data.srcdata"
 #include "test_data/infrared_necext_test_data.srcdata"
 #include "test_data/infrared_samsung_test_data.srcdata"
@@ -17,6 +18,12 @@
 
 #define RUN_ENCODER_DECODER(data) run_encoder_decoder((data), COUNT_OF(data))
 
+#define RUN_CAPTURE(data, expected, worker_delay) \
+    run_capture((data), COUNT_OF(data), (expected), COUNT_OF(expected), (worker_delay))
+
+/* Worker which is never woken up before the end of input */
+#define CAPTURE_WORKER_STALLED UINT32_MAX
+
 static InfraredDecoderHandler* decoder_handler;
 static InfraredEncoderHandler* encoder_handler;
 
@@ -294,6 +301,160 @@ MU_TEST(test_encoder_rc6) {
     RUN_ENCODER(test_encoder_rc6_input1, test_encoder_rc6_expected1);
 }
 
+/* Model of capture ISR and worker thread on a common timeline in microseconds:
+ * ISR pushes edge when it ends, idle timeout flushes buffer, worker thread
+ * reads all committed blocks worker_delay after it has been notified. */
+typedef struct {
+    InfraredCaptureBuffer buffer;
+    uint32_t worker_delay;
+    bool wake_pending;
+    bool wake_timeout;
+    uint32_t wake_at;
+    bool level;
+    const InfraredMessage* expected;
+    uint32_t expected_len;
+    uint32_t decoded;
+} CaptureModel;
+
+static void capture_model_check(CaptureModel* model, const InfraredMessage* message) {
+    if(message && model->expected) {
+        mu_assert(model->decoded < model->expected_len, "decoded more than expected");
+        compare_message_results(message, &model->expected[model->decoded]);
+        ++model->decoded;
+    }
+}
+
+static void capture_model_notify(CaptureModel* model, uint32_t now, bool timeout) {
+    if(model->worker_delay == CAPTURE_WORKER_STALLED) {
+        return;
+    }
+    if(!model->wake_pending) {
+        model->wake_pending = true;
+        model->wake_at = now + model->worker_delay;
+    }
+    model->wake_timeout |= timeout;
+}
+
+static void capture_model_run_worker(CaptureModel* model, uint32_t now) {
+    if(!model->wake_pending || (model->wake_at > now)) {
+        return;
+    }
+    model->wake_pending = false;
+
+    const LevelDuration* edges = NULL;
+    size_t edges_cnt = 0;
+    while((edges_cnt = infrared_capture_buffer_read(&model->buffer, &edges, model->wake_at))) {
+        for(size_t i = 0; i < edges_cnt; ++i) {
+            capture_model_check(
+                model,
+                infrared_decode(
+                    decoder_handler,
+                    level_duration_get_level(edges[i]),
+                    level_duration_get_duration(edges[i])));
+        }
+        infrared_capture_buffer_release(&model->buffer);
+    }
+
+    if(model->wake_timeout) {
+        model->wake_timeout = false;
+        capture_model_check(model, infrared_check_decoder_ready(decoder_handler));
+    }
+}
+
+static void capture_model_timeout(CaptureModel* model, uint32_t now) {
+    capture_model_run_worker(model, now);
+    infrared_capture_buffer_flush(&model->buffer);
+    capture_model_notify(model, now, true);
+}
+
+static void run_capture(
+    const uint32_t* input_delays,
+    uint32_t input_delays_len,
+    const InfraredMessage* message_expected,
+    uint32_t message_expected_len,
+    uint32_t worker_delay) {
+    CaptureModel* model = malloc(sizeof(CaptureModel));
+    infrared_capture_buffer_reset(&model->buffer);
+    model->worker_delay = worker_delay;
+    /* with dropped edges decoded messages are unpredictable */
+    model->expected = (worker_delay == CAPTURE_WORKER_STALLED) ? NULL : message_expected;
+    model->expected_len = message_expected_len;
+    uint32_t now = 0;
+
+    for(uint32_t i = 0; i < input_delays_len; ++i) {
+        if(input_delays[i] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+            capture_model_timeout(model, now + INFRARED_RAW_RX_TIMING_DELAY_US);
+        }
+        now += input_delays[i];
+        capture_model_run_worker(model, now);
+
+        InfraredCaptureBufferPushResult result = infrared_capture_buffer_push(
+            &model->buffer, level_duration_make(model->level, input_delays[i]), now);
+        if(result == InfraredCaptureBufferPushBlockReady) {
+            capture_model_notify(model, now, false);
+        }
+        model->level = !model->level;
+    }
+    now += INFRARED_RAW_RX_TIMING_DELAY_US;
+    capture_model_timeout(model, now);
+    if(worker_delay == CAPTURE_WORKER_STALLED) {
+        model->worker_delay = 0;
+        capture_model_notify(model, now, true);
+    }
+    capture_model_run_worker(model, UINT32_MAX);
+
+    const InfraredCaptureBufferStats* stats = &model->buffer.stats;
+    mu_assert_int_eq(input_delays_len, stats->edges + stats->overruns);
+    if(worker_delay == CAPTURE_WORKER_STALLED) {
+        mu_assert_int_eq(INFRARED_CAPTURE_BLOCKS, stats->blocks);
+        mu_check(stats->overruns > 0);
+    } else {
+        mu_assert_int_eq(0, stats->overruns);
+        mu_assert_int_eq(message_expected_len, model->decoded);
+    }
+
+    free(model);
+}
+
+MU_TEST(test_capture_buffer_block_boundary) {
+    InfraredCaptureBuffer* buffer = malloc(sizeof(InfraredCaptureBuffer));
+    infrared_capture_buffer_reset(buffer);
+    const LevelDuration* edges = NULL;
+
+    /* full block is committed at once, nothing is left for idle timeout */
+    for(uint32_t i = 0; i < INFRARED_CAPTURE_BLOCK_SIZE - 1; ++i) {
+        mu_check(
+            infrared_capture_buffer_push(buffer, level_duration_make(i % 2, 500), i) ==
+            InfraredCaptureBufferPushOk);
+    }
+    mu_assert_int_eq(0, infrared_capture_buffer_read(buffer, &edges, 0));
+    mu_check(
+        infrared_capture_buffer_push(buffer, level_duration_make(true, 500), 100) ==
+        InfraredCaptureBufferPushBlockReady);
+    mu_check(!infrared_capture_buffer_flush(buffer));
+    mu_assert_int_eq(
+        INFRARED_CAPTURE_BLOCK_SIZE, infrared_capture_buffer_read(buffer, &edges, 150));
+    mu_assert_int_eq(150, buffer->stats.latency_max);
+    infrared_capture_buffer_release(buffer);
+
+    /* single edge is passed on idle timeout */
+    infrared_capture_buffer_push(buffer, level_duration_make(false, 700), 200);
+    mu_check(infrared_capture_buffer_flush(buffer));
+    mu_assert_int_eq(1, infrared_capture_buffer_read(buffer, &edges, 250));
+    mu_assert_int_eq(700, level_duration_get_duration(edges[0]));
+    infrared_capture_buffer_release(buffer);
+    mu_assert_int_eq(0, infrared_capture_buffer_read(buffer, &edges, 300));
+
+    free(buffer);
+}
+
+MU_TEST(test_capture_buffer) {
+    RUN_CAPTURE(test_decoder_nec_input1, test_decoder_nec_expected1, 0);
+    RUN_CAPTURE(test_decoder_nec_input1, test_decoder_nec_expected1, 5000);
+    RUN_CAPTURE(test_decoder_nec_input2, test_decoder_nec_expected2, 20000);
+    RUN_CAPTURE(test_decoder_nec_input2, test_decoder_nec_expected2, CAPTURE_WORKER_STALLED);
+}
+
 MU_TEST(test_encoder_decoder_all) {
     RUN_ENCODER_DECODER(test_nec);
     RUN_ENCODER_DECODER(test_necext);
@@ -322,6 +483,8 @@ MU_TEST_SUITE(test_infrared_decoder_encoder) {
     MU_RUN_TEST(test_decoder_necext1);
     MU_RUN_TEST(test_mix);
     MU_RUN_TEST(test_encoder_decoder_all);
+    MU_RUN_TEST(test_capture_buffer_block_boundary);
+    MU_RUN_TEST(test_capture_buffer);
 }
 
 int run_minunit_test_infrared_decoder_encoder() {
@@ -0,0 +1,228 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+#include <lfrfid/helpers/rfid_edge_buffer.h>
+#include <lfrfid/helpers/rfid_reader.h>
+#include <lfrfid/helpers/encoder_emmarin.h>
+#include <lfrfid/helpers/encoder_hid_h10301.h>
+#include <lfrfid/helpers/protocols/protocol_indala_40134.h>
+#include <lfrfid/helpers/key_info.h>
+#include "../minunit.h"
+
+#define TAG "LfRfidDecoderTest"
+
+/* Edge dumps are replayed the way reader sees them: comparator interrupt
+ * pushes CPU cycle timestamps into edge buffer, decode thread pops batches
+ * and passes them to RfidReader. Dumps are made of encoder output, one
+ * carrier clock is 8us. */
+constexpr uint32_t clock_cycles = 8 * 64;
+constexpr uint32_t frames = 4;
+/* Start close to DWT counter wrap */
+constexpr uint32_t start_timestamp = 0xFFF00000;
+
+struct LfRfidTestDump {
+    uint32_t* edges;
+    uint32_t count;
+    uint32_t max;
+    uint32_t timestamp;
+    bool level;
+};
+
+static void lfrfid_test_dump_init(LfRfidTestDump* dump, uint32_t max) {
+    dump->edges = static_cast<uint32_t*>(malloc(max * sizeof(uint32_t)));
+    dump->count = 0;
+    dump->max = max;
+    dump->timestamp = start_timestamp;
+    dump->level = false;
+}
+
+static void lfrfid_test_dump_free(LfRfidTestDump* dump) {
+    free(dump->edges);
+}
+
+/* Edge polarity is the level it starts, as reader passes it to decoders */
+static void lfrfid_test_dump_level(LfRfidTestDump* dump, bool level, uint32_t clocks) {
+    if(level != dump->level) {
+        furi_check(dump->count < dump->max);
+        dump->edges[dump->count++] = RfidEdgeBuffer::get_timestamp(dump->timestamp) | level;
+        dump->level = level;
+    }
+    dump->timestamp += clocks * clock_cycles;
+}
+
+static void lfrfid_test_dump_encoder(LfRfidTestDump* dump, EncoderGeneric* encoder, uint32_t count) {
+    for(uint32_t i = 0; i < count; i++) {
+        bool polarity;
+        uint16_t period;
+        uint16_t pulse;
+        encoder->get_next(&polarity, &period, &pulse);
+        lfrfid_test_dump_level(dump, polarity, pulse);
+        lfrfid_test_dump_level(dump, !polarity, period - pulse);
+    }
+}
+
+struct LfRfidTestResult {
+    uint32_t reads; /**< reads of expected key */
+    uint32_t wrong_reads; /**< reads of other type or data */
+    bool validated; /**< reader confirmed key with repeated reads */
+};
+
+/* Replay dump through edge buffer and reader's batch decoding, like decode
+ * thread does, and poll reader like application does */
+static uint32_t lfrfid_test_replay(
+    RfidReader* reader,
+    RfidReader::Type mode,
+    LfrfidKeyType type,
+    const uint8_t* data,
+    const LfRfidTestDump* dump,
+    LfRfidTestResult* result,
+    RfidEdgeBuffer::Stats* stats) {
+    RfidEdgeBuffer* buffer = new RfidEdgeBuffer();
+    uint32_t batch[RfidEdgeBuffer::batch_size];
+    uint32_t cycles = 0;
+    uint8_t key_size = lfrfid_key_get_type_data_count(type);
+    reader->decode_reset(mode, start_timestamp);
+
+    for(uint32_t i = 0; i < dump->count; i++) {
+        uint32_t edge = dump->edges[i];
+        bool batch_ready = buffer->push(RfidEdgeBuffer::get_timestamp(edge), edge & 1);
+        if(!batch_ready && i + 1 < dump->count) continue;
+
+        uint32_t start = DWT->CYCCNT;
+        uint32_t count;
+        while((count = buffer->pop(batch, RfidEdgeBuffer::batch_size))) {
+            reader->decode_batch(batch, count);
+        }
+        cycles += DWT->CYCCNT - start;
+
+        // Reader only touches outputs when some decoder has a key
+        LfrfidKeyType read_type = type;
+        uint8_t read_data[LFRFID_KEY_SIZE] = {0};
+        result->validated |= reader->read(&read_type, read_data, LFRFID_KEY_SIZE, false);
+        bool something_read = false;
+        for(size_t j = 0; j < LFRFID_KEY_SIZE; j++) {
+            something_read |= (read_data[j] != 0);
+        }
+        if(something_read) {
+            if(read_type == type && memcmp(read_data, data, key_size) == 0) {
+                result->reads++;
+            } else {
+                result->wrong_reads++;
+            }
+        }
+    }
+
+    *stats = buffer->get_stats();
+    delete buffer;
+    return cycles;
+}
+
+static void lfrfid_test_check(
+    RfidReader::Type mode,
+    LfrfidKeyType type,
+    const uint8_t* data,
+    LfRfidTestDump* dump) {
+    RfidReader* reader = new RfidReader();
+    RfidEdgeBuffer::Stats stats;
+    LfRfidTestResult result = {};
+    uint32_t cycles = lfrfid_test_replay(reader, mode, type, data, dump, &result, &stats);
+    mu_assert_int_eq(0, stats.overruns);
+    mu_assert_int_eq(dump->count, stats.edges);
+    mu_check(result.reads > 0);
+    mu_assert_int_eq(0, result.wrong_reads);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu edges, %lu cycles per edge, %lu reads%s",
+        lfrfid_key_get_type_string(type),
+        dump->count,
+        cycles / dump->count,
+        result.reads,
+        result.validated ? ", validated" : "");
+    delete reader;
+}
+
+MU_TEST(lfrfid_decoder_em4100_test) {
+    const uint8_t data[] = {0x58, 0x00, 0x85, 0x64, 0x02};
+    EncoderEM encoder;
+    encoder.init(data, sizeof(data));
+
+    LfRfidTestDump dump;
+    lfrfid_test_dump_init(&dump, 64 * 2 * frames + 1);
+    lfrfid_test_dump_encoder(&dump, &encoder, 64 * frames);
+    lfrfid_test_check(RfidReader::Type::Normal, LfrfidKeyType::KeyEM4100, data, &dump);
+    lfrfid_test_dump_free(&dump);
+}
+
+MU_TEST(lfrfid_decoder_h10301_test) {
+    const uint8_t data[] = {0xED, 0x87, 0x70};
+    EncoderHID_H10301 encoder;
+    encoder.init(data, sizeof(data));
+
+    // 96 raw bits, 50 clocks each, 8 or 10 clocks per FSK period
+    const uint32_t periods = 96 * 50 / 8 * frames;
+    LfRfidTestDump dump;
+    lfrfid_test_dump_init(&dump, periods * 2 + 1);
+    lfrfid_test_dump_encoder(&dump, &encoder, periods);
+    lfrfid_test_check(RfidReader::Type::Normal, LfrfidKeyType::KeyH10301, data, &dump);
+    lfrfid_test_dump_free(&dump);
+}
+
+MU_TEST(lfrfid_decoder_i40134_test) {
+    const uint8_t data[] = {0x1D, 0x30, 0x7F};
+    ProtocolIndala40134 indala;
+    uint64_t card_data;
+    indala.encode(data, sizeof(data), reinterpret_cast<uint8_t*>(&card_data), sizeof(card_data));
+
+    // Reader sees demodulated PSK, 32 clocks per bit
+    LfRfidTestDump dump;
+    lfrfid_test_dump_init(&dump, 64 * frames + 1);
+    for(uint32_t i = 0; i < 64 * frames; i++) {
+        lfrfid_test_dump_level(&dump, (card_data >> (63 - i % 64)) & 1, 32);
+    }
+    lfrfid_test_check(RfidReader::Type::Indala, LfrfidKeyType::KeyI40134, data, &dump);
+    lfrfid_test_dump_free(&dump);
+}
+
+MU_TEST(lfrfid_edge_buffer_overrun_test) {
+    RfidEdgeBuffer* buffer = new RfidEdgeBuffer();
+    uint32_t batches = 0;
+
+    // Consumer is late, edges that don't fit are counted and dropped
+    for(uint32_t i = 0; i < RfidEdgeBuffer::size + 10; i++) {
+        if(buffer->push(i * 2, i & 1)) batches++;
+    }
+    mu_assert_int_eq(RfidEdgeBuffer::size / RfidEdgeBuffer::batch_size, batches);
+    mu_assert_int_eq(RfidEdgeBuffer::size, buffer->get_stats().edges);
+    mu_assert_int_eq(10, buffer->get_stats().overruns);
+    mu_assert_int_eq(RfidEdgeBuffer::size, buffer->get_stats().fill_max);
+
+    // Stored edges come out in order
+    uint32_t edges[RfidEdgeBuffer::batch_size];
+    for(uint32_t i = 0; i < RfidEdgeBuffer::size; i += RfidEdgeBuffer::batch_size) {
+        mu_assert_int_eq(
+            RfidEdgeBuffer::batch_size, buffer->pop(edges, RfidEdgeBuffer::batch_size));
+        for(uint32_t j = 0; j < RfidEdgeBuffer::batch_size; j++) {
+            mu_assert_int_eq((i + j) * 2, RfidEdgeBuffer::get_timestamp(edges[j]));
+            mu_assert_int_eq((i + j) & 1, RfidEdgeBuffer::get_polarity(edges[j]));
+        }
+    }
+    mu_assert_int_eq(0, buffer->pop(edges, RfidEdgeBuffer::batch_size));
+
+    // And there is room again
+    mu_check(!buffer->push(0, false));
+    mu_assert_int_eq(10, buffer->get_stats().overruns);
+    delete buffer;
+}
+
+MU_TEST_SUITE(lfrfid_decoder_suite) {
+    MU_RUN_TEST(lfrfid_decoder_em4100_test);
+    MU_RUN_TEST(lfrfid_decoder_h10301_test);
+    MU_RUN_TEST(lfrfid_decoder_i40134_test);
+    MU_RUN_TEST(lfrfid_edge_buffer_overrun_test);
+}
+
+extern "C" int run_minunit_test_lfrfid_decoder() {
+    MU_RUN_SUITE(lfrfid_decoder_suite);
+    return MU_EXIT_CODE;
+}
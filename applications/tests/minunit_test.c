@@ -4,9 +4,13 @@
 
 // v2 tests
 void test_furi_create_open();
+void test_furi_record_handle();
 void test_furi_valuemutex();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_pubsub_benchmark();
+void test_furi_pool();
+void test_furi_log();
 
 void test_furi_memmgr();
 
@@ -29,6 +33,10 @@ MU_TEST(mu_test_furi_create_open) {
     test_furi_create_open();
 }
 
+MU_TEST(mu_test_furi_record_handle) {
+    test_furi_record_handle();
+}
+
 MU_TEST(mu_test_furi_valuemutex) {
     test_furi_valuemutex();
 }
@@ -41,6 +49,18 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_benchmark) {
+    test_furi_pubsub_benchmark();
+}
+
+MU_TEST(mu_test_furi_pool) {
+    test_furi_pool();
+}
+
+MU_TEST(mu_test_furi_log) {
+    test_furi_log();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
@@ -54,9 +74,13 @@ MU_TEST_SUITE(test_suite) {
 
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
+    MU_RUN_TEST(mu_test_furi_record_handle);
     MU_RUN_TEST(mu_test_furi_valuemutex);
     MU_RUN_TEST(mu_test_furi_concurrent_access);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_benchmark);
+    MU_RUN_TEST(mu_test_furi_pool);
+    MU_RUN_TEST(mu_test_furi_log);
     MU_RUN_TEST(mu_test_furi_memmgr);
 }
 
@@ -0,0 +1,198 @@
+#include <furi.h>
+#include <m-string.h>
+#include <nfc/nfc_device.h>
+#include <flipper_format/flipper_format.h>
+#include "../minunit.h"
+
+#define TAG "NfcDeviceTest"
+
+#define NFC_TEST_DEV_NAME "unit_test_nfc_dev"
+#define NFC_TEST_DEV_PATH NFC_APP_FOLDER "/" NFC_TEST_DEV_NAME NFC_APP_EXTENSION
+
+/* NTAG216 dump */
+#define NFC_TEST_UL_PAGES (231)
+
+/* DESFire EV1 8K worth of standard data files in one application */
+#define NFC_TEST_DF_FILES (7)
+#define NFC_TEST_DF_FILE_SIZE (1024)
+
+static uint8_t nfc_test_byte(size_t i, uint8_t seed) {
+    return i * 13 + seed;
+}
+
+static bool nfc_test_write_ul_v2_file(const char* path) {
+    string_t text;
+    string_init_printf(
+        text,
+        "Filetype: Flipper NFC device\n"
+        "Version: 2\n"
+        "Device type: NTAG216\n"
+        "UID: 04 11 22 33 44 55 66\n"
+        "ATQA: 00 44\n"
+        "SAK: 00\n"
+        "Signature:");
+    for(int i = 0; i < 32; i++) {
+        string_cat_printf(text, " %02X", nfc_test_byte(i, 1));
+    }
+    string_cat_printf(text, "\nMifare version: 00 04 04 02 01 00 13 03\n");
+    for(int i = 0; i < 3; i++) {
+        string_cat_printf(text, "Counter %d: %d\nTearing %d: BD\n", i, i + 10, i);
+    }
+    string_cat_printf(text, "Pages total: %d\n", NFC_TEST_UL_PAGES);
+    for(int page = 0; page < NFC_TEST_UL_PAGES; page++) {
+        string_cat_printf(text, "Page %d:", page);
+        for(int i = page * 4; i < page * 4 + 4; i++) {
+            string_cat_printf(text, " %02X", nfc_test_byte(i, 0));
+        }
+        string_cat_printf(text, "\n");
+    }
+
+    Storage* storage = furi_record_open("storage");
+    File* file = storage_file_alloc(storage);
+    bool result = false;
+    if(storage_simply_mkdir(storage, NFC_APP_FOLDER) &&
+       storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        result = storage_file_write(file, string_get_cstr(text), string_size(text)) ==
+                 string_size(text);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close("storage");
+    string_clear(text);
+
+    return result;
+}
+
+static bool nfc_test_check_ul_data(MifareUlData* data) {
+    if(data->type != MfUltralightTypeNTAG216) return false;
+    if(data->data_size != NFC_TEST_UL_PAGES * 4) return false;
+    for(size_t i = 0; i < sizeof(data->signature); i++) {
+        if(data->signature[i] != nfc_test_byte(i, 1)) return false;
+    }
+    for(size_t i = 0; i < 3; i++) {
+        if(data->counter[i] != i + 10 || data->tearing[i] != 0xBD) return false;
+    }
+    for(size_t i = 0; i < data->data_size; i++) {
+        if(data->data[i] != nfc_test_byte(i, 0)) return false;
+    }
+    return true;
+}
+
+static bool nfc_test_read_header(const char* path, bool* has_pages_block, uint32_t* version) {
+    Storage* storage = furi_record_open("storage");
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    string_t filetype;
+    string_init(filetype);
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(file, path)) break;
+        if(!flipper_format_read_header(file, filetype, version)) break;
+        *has_pages_block = flipper_format_key_exist(file, "Pages data");
+        result = true;
+    } while(false);
+
+    string_clear(filetype);
+    flipper_format_free(file);
+    furi_record_close("storage");
+
+    return result;
+}
+
+static void nfc_test_fill_df(MifareDesfireData* data) {
+    data->master_key_settings = malloc(sizeof(MifareDesfireKeySettings));
+    MifareDesfireApplication* app = malloc(sizeof(MifareDesfireApplication));
+    app->id[2] = 0x01;
+    app->key_settings = malloc(sizeof(MifareDesfireKeySettings));
+    MifareDesfireFile** file_head = &app->file_head;
+    for(size_t i = 0; i < NFC_TEST_DF_FILES; i++) {
+        MifareDesfireFile* f = malloc(sizeof(MifareDesfireFile));
+        f->id = i;
+        f->type = MifareDesfireFileTypeStandard;
+        f->settings.data.size = NFC_TEST_DF_FILE_SIZE;
+        f->contents = malloc(NFC_TEST_DF_FILE_SIZE);
+        for(size_t j = 0; j < NFC_TEST_DF_FILE_SIZE; j++) {
+            f->contents[j] = nfc_test_byte(j, i);
+        }
+        *file_head = f;
+        file_head = &f->next;
+    }
+    data->app_head = app;
+}
+
+static bool nfc_test_check_df(MifareDesfireData* data) {
+    MifareDesfireApplication* app = data->app_head;
+    if(!app || app->next) return false;
+    size_t files = 0;
+    for(MifareDesfireFile* f = app->file_head; f; f = f->next) {
+        if(f->id != files || f->settings.data.size != NFC_TEST_DF_FILE_SIZE) return false;
+        if(!f->contents) return false;
+        for(size_t j = 0; j < NFC_TEST_DF_FILE_SIZE; j++) {
+            if(f->contents[j] != nfc_test_byte(j, files)) return false;
+        }
+        files++;
+    }
+    return files == NFC_TEST_DF_FILES;
+}
+
+MU_TEST(nfc_device_ul_legacy_test) {
+    NfcDevice* dev = nfc_device_alloc();
+    bool has_pages_block = true;
+    uint32_t version = 0;
+
+    mu_check(nfc_test_write_ul_v2_file(NFC_TEST_DEV_PATH));
+    mu_check(nfc_device_load(dev, NFC_TEST_DEV_PATH));
+    mu_check(nfc_test_check_ul_data(&dev->dev_data.mf_ul_data));
+
+    // Saving upgrades the file to the pages block layout
+    mu_check(nfc_device_save(dev, NFC_TEST_DEV_NAME));
+    mu_check(nfc_test_read_header(NFC_TEST_DEV_PATH, &has_pages_block, &version));
+    mu_assert_int_eq(3, version);
+    mu_check(has_pages_block);
+
+    nfc_device_clear(dev);
+    mu_check(nfc_device_load(dev, NFC_TEST_DEV_PATH));
+    mu_check(nfc_test_check_ul_data(&dev->dev_data.mf_ul_data));
+
+    mu_check(nfc_device_delete(dev));
+    nfc_device_free(dev);
+}
+
+MU_TEST(nfc_device_df_bench) {
+    NfcDevice* dev = nfc_device_alloc();
+    dev->format = NfcDeviceSaveFormatMifareDesfire;
+    dev->dev_data.nfc_data.protocol = NfcDeviceProtocolMifareDesfire;
+    dev->dev_data.nfc_data.uid_len = 7;
+    nfc_test_fill_df(&dev->dev_data.mf_df_data);
+
+    uint32_t start = osKernelGetTickCount();
+    mu_check(nfc_device_save(dev, NFC_TEST_DEV_NAME));
+    uint32_t save = osKernelGetTickCount() - start;
+
+    nfc_device_clear(dev);
+    start = osKernelGetTickCount();
+    mu_check(nfc_device_load(dev, NFC_TEST_DEV_PATH));
+    uint32_t load = osKernelGetTickCount() - start;
+    mu_check(nfc_test_check_df(&dev->dev_data.mf_df_data));
+
+    FURI_LOG_I(
+        TAG,
+        "DESFire %d x %d bytes files: save %lums load %lums",
+        NFC_TEST_DF_FILES,
+        NFC_TEST_DF_FILE_SIZE,
+        save,
+        load);
+
+    mu_check(nfc_device_delete(dev));
+    nfc_device_free(dev);
+}
+
+MU_TEST_SUITE(nfc_device_suite) {
+    MU_RUN_TEST(nfc_device_ul_legacy_test);
+    MU_RUN_TEST(nfc_device_df_bench);
+}
+
+int run_minunit_test_nfc_device() {
+    MU_RUN_SUITE(nfc_device_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,203 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+#include <lib/nfc_protocols/mifare_ultralight.h>
+#include "../minunit.h"
+
+#define TAG "MfUlEmulationTest"
+
+/* Tag has to answer within ISO14443-3 frame delay time, 1172 / fc is ~86us */
+#define MF_UL_TEST_RESPONSE_BUDGET_US (86)
+#define MF_UL_TEST_PAGES (45)
+#define MF_UL_TEST_PWD_PAGE (MF_UL_TEST_PAGES - 2)
+#define MF_UL_TEST_PACK_PAGE (MF_UL_TEST_PAGES - 1)
+
+#define MF_UL_TEST_ACK (0x0A)
+#define MF_UL_TEST_NACK (0x00)
+
+static MifareUlData* mf_ul_test_data;
+static MifareUlDevice* mf_ul_test_device;
+static uint8_t mf_ul_test_tx[256];
+static uint16_t mf_ul_test_tx_bits;
+static uint32_t mf_ul_test_data_type;
+static uint32_t mf_ul_test_frames;
+static uint32_t mf_ul_test_frames_over_budget;
+static uint32_t mf_ul_test_cycles_max;
+
+static void mf_ul_test_setup() {
+    mf_ul_test_data = malloc(sizeof(MifareUlData));
+    mf_ul_test_device = malloc(sizeof(MifareUlDevice));
+    mf_ul_test_frames = 0;
+    mf_ul_test_frames_over_budget = 0;
+    mf_ul_test_cycles_max = 0;
+
+    // NTAG213 with password and PACK set
+    mf_ul_test_data->version = (MfUltralightVersion){
+        .header = 0x00,
+        .vendor_id = 0x04,
+        .prod_type = 0x04,
+        .prod_subtype = 0x02,
+        .prod_ver_major = 0x01,
+        .prod_ver_minor = 0x00,
+        .storage_size = 0x0F,
+        .protocol_type = 0x03,
+    };
+    for(size_t i = 0; i < sizeof(mf_ul_test_data->signature); i++) {
+        mf_ul_test_data->signature[i] = 0xA0 + i;
+    }
+    mf_ul_test_data->counter[0] = 0x000102;
+    mf_ul_test_data->data_size = MF_UL_TEST_PAGES * 4;
+    for(size_t i = 0; i < mf_ul_test_data->data_size; i++) {
+        mf_ul_test_data->data[i] = i + 1;
+    }
+    mf_ul_prepare_emulation(mf_ul_test_device, mf_ul_test_data);
+}
+
+static void mf_ul_test_teardown() {
+    free(mf_ul_test_device);
+    free(mf_ul_test_data);
+}
+
+/* Feed one reader frame, response is left in mf_ul_test_tx */
+static void mf_ul_test_frame(const uint8_t* rx, uint16_t rx_len) {
+    uint8_t buff_rx[16];
+    memcpy(buff_rx, rx, rx_len);
+    memset(mf_ul_test_tx, 0xFF, sizeof(mf_ul_test_tx));
+
+    uint32_t start = DWT->CYCCNT;
+    mf_ul_prepare_emulation_response(
+        buff_rx,
+        rx_len,
+        mf_ul_test_tx,
+        &mf_ul_test_tx_bits,
+        &mf_ul_test_data_type,
+        mf_ul_test_device);
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    mf_ul_test_frames++;
+    mf_ul_test_cycles_max = MAX(mf_ul_test_cycles_max, cycles);
+    if(cycles > MF_UL_TEST_RESPONSE_BUDGET_US * (SystemCoreClock / 1000000)) {
+        mf_ul_test_frames_over_budget++;
+    }
+}
+
+/* Expected READ and FAST_READ answer: pages with roll-over, password and PACK hidden */
+static void mf_ul_test_expected_pages(uint8_t* expected, uint8_t start_page, uint8_t count) {
+    for(uint8_t i = 0; i < count; i++) {
+        uint8_t page = (start_page + i) % MF_UL_TEST_PAGES;
+        memcpy(&expected[i * 4], &mf_ul_test_data->data[page * 4], 4);
+        if(page == MF_UL_TEST_PWD_PAGE) {
+            memset(&expected[i * 4], 0, 4);
+        } else if(page == MF_UL_TEST_PACK_PAGE) {
+            memset(&expected[i * 4], 0, 2);
+        }
+    }
+}
+
+static bool mf_ul_test_check_read(uint8_t start_page) {
+    const uint8_t rx[] = {MF_UL_READ_CMD, start_page};
+    uint8_t expected[16];
+    mf_ul_test_frame(rx, sizeof(rx));
+    mf_ul_test_expected_pages(expected, start_page, 4);
+    return (mf_ul_test_tx_bits == 16 * 8) &&
+           (mf_ul_test_data_type == FURI_HAL_NFC_TXRX_DEFAULT) &&
+           (memcmp(mf_ul_test_tx, expected, sizeof(expected)) == 0);
+}
+
+static bool mf_ul_test_check_ack() {
+    return (mf_ul_test_tx_bits == 4) && (mf_ul_test_tx[0] == MF_UL_TEST_ACK) &&
+           (mf_ul_test_data_type == FURI_HAL_NFC_TXRX_RAW);
+}
+
+MU_TEST(mf_ul_emulation_read_test) {
+    const uint8_t get_version[] = {MF_UL_GET_VERSION_CMD};
+    mf_ul_test_frame(get_version, sizeof(get_version));
+    mu_assert_int_eq(sizeof(MfUltralightVersion) * 8, mf_ul_test_tx_bits);
+    mu_check(memcmp(mf_ul_test_tx, &mf_ul_test_data->version, sizeof(MfUltralightVersion)) == 0);
+
+    const uint8_t read_sig[] = {MF_UL_READ_SIG, 0x00};
+    mf_ul_test_frame(read_sig, sizeof(read_sig));
+    mu_assert_int_eq(sizeof(mf_ul_test_data->signature) * 8, mf_ul_test_tx_bits);
+    mu_check(memcmp(mf_ul_test_tx, mf_ul_test_data->signature, 32) == 0);
+
+    // Every start page, including roll-over and protected pages
+    for(uint8_t page = 0; page < MF_UL_TEST_PAGES; page++) {
+        mu_check(mf_ul_test_check_read(page));
+    }
+
+    const uint8_t fast_read[] = {MF_UL_FAST_READ_CMD, 40, MF_UL_TEST_PAGES - 1};
+    uint8_t expected[(MF_UL_TEST_PAGES - 40) * 4];
+    mf_ul_test_frame(fast_read, sizeof(fast_read));
+    mf_ul_test_expected_pages(expected, 40, MF_UL_TEST_PAGES - 40);
+    mu_assert_int_eq(sizeof(expected) * 8, mf_ul_test_tx_bits);
+    mu_check(memcmp(mf_ul_test_tx, expected, sizeof(expected)) == 0);
+
+    const uint8_t read_out_of_range[] = {MF_UL_READ_CMD, MF_UL_TEST_PAGES};
+    mf_ul_test_frame(read_out_of_range, sizeof(read_out_of_range));
+    mu_assert_int_eq(4, mf_ul_test_tx_bits);
+    mu_assert_int_eq(MF_UL_TEST_NACK, mf_ul_test_tx[0]);
+}
+
+MU_TEST(mf_ul_emulation_write_test) {
+    // Page 2 is also sent on roll-over from the last pages
+    const uint8_t write[] = {MF_UL_WRITE, 2, 0x11, 0x22, 0x33, 0x44};
+    mf_ul_test_frame(write, sizeof(write));
+    mu_check(mf_ul_test_check_ack());
+    mu_check(mf_ul_test_device->data_changed);
+    memcpy(&mf_ul_test_data->data[2 * 4], &write[2], 4);
+    mu_check(mf_ul_test_check_read(0));
+    mu_check(mf_ul_test_check_read(MF_UL_TEST_PACK_PAGE));
+
+    const uint8_t comp_write[] = {MF_UL_COMP_WRITE, 5};
+    const uint8_t comp_write_data[16] = {0x55, 0x66, 0x77, 0x88};
+    mf_ul_test_frame(comp_write, sizeof(comp_write));
+    mu_check(mf_ul_test_check_ack());
+    mf_ul_test_frame(comp_write_data, sizeof(comp_write_data));
+    mu_check(mf_ul_test_check_ack());
+    memcpy(&mf_ul_test_data->data[5 * 4], comp_write_data, 4);
+    mu_check(mf_ul_test_check_read(3));
+
+    // Password can't be overwritten
+    const uint8_t write_pwd[] = {MF_UL_WRITE, MF_UL_TEST_PWD_PAGE, 0x00, 0x00, 0x00, 0x00};
+    mf_ul_test_frame(write_pwd, sizeof(write_pwd));
+    mu_assert_int_eq(MF_UL_TEST_NACK, mf_ul_test_tx[0]);
+    mu_check(mf_ul_test_check_read(MF_UL_TEST_PWD_PAGE));
+}
+
+MU_TEST(mf_ul_emulation_counter_test) {
+    const uint8_t read_cnt[] = {MF_UL_READ_CNT, 0};
+    mf_ul_test_frame(read_cnt, sizeof(read_cnt));
+    mu_assert_int_eq(3 * 8, mf_ul_test_tx_bits);
+    mu_check(memcmp(mf_ul_test_tx, (uint8_t[]){0x00, 0x01, 0x02}, 3) == 0);
+
+    const uint8_t inc_cnt[] = {MF_UL_INC_CNT, 0, 0x00, 0x01, 0x00, 0x00};
+    mf_ul_test_frame(inc_cnt, sizeof(inc_cnt));
+    mu_check(mf_ul_test_check_ack());
+    mf_ul_test_frame(read_cnt, sizeof(read_cnt));
+    mu_check(memcmp(mf_ul_test_tx, (uint8_t[]){0x00, 0x02, 0x02}, 3) == 0);
+}
+
+MU_TEST(mf_ul_emulation_budget_test) {
+    FURI_LOG_I(
+        TAG,
+        "%lu frames, slowest %lu cycles, %lu over %dus budget",
+        mf_ul_test_frames,
+        mf_ul_test_cycles_max,
+        mf_ul_test_frames_over_budget,
+        MF_UL_TEST_RESPONSE_BUDGET_US);
+    mu_assert_int_eq(0, mf_ul_test_frames_over_budget);
+}
+
+MU_TEST_SUITE(mf_ul_emulation_suite) {
+    mf_ul_test_setup();
+    MU_RUN_TEST(mf_ul_emulation_read_test);
+    MU_RUN_TEST(mf_ul_emulation_write_test);
+    MU_RUN_TEST(mf_ul_emulation_counter_test);
+    MU_RUN_TEST(mf_ul_emulation_budget_test);
+    mf_ul_test_teardown();
+}
+
+int run_minunit_test_nfc_mf_ul_emulation() {
+    MU_RUN_SUITE(mf_ul_emulation_suite);
+    return MU_EXIT_CODE;
+}
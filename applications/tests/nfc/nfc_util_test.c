@@ -0,0 +1,172 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+#include <lib/nfc_protocols/nfc_util.h>
+#include <lib/nfc_protocols/crypto1.h>
+#include "../minunit.h"
+
+#define TAG "NfcUtilTest"
+
+#define NFC_TEST_LEN_MAX 24
+#define NFC_TEST_BENCH_LEN 64
+#define NFC_TEST_BENCH_RUNS 100
+
+/* Bit by bit packing, as it was done before, is the reference */
+static uint16_t nfc_test_merge_reference(
+    const uint8_t* data,
+    uint16_t len,
+    const uint8_t* parity,
+    uint8_t* out) {
+    uint16_t bits = len * 9;
+    memset(out, 0, (bits + 7) / 8);
+    for(uint16_t i = 0; i < bits; i++) {
+        uint16_t byte = i / 9;
+        uint8_t bit = i % 9;
+        uint8_t value = bit < 8 ? FURI_BIT(data[byte], bit) :
+                                  FURI_BIT(parity[byte / 8], 7 - byte % 8);
+        out[i / 8] |= value << (i % 8);
+    }
+    return bits;
+}
+
+static void nfc_test_fill(uint8_t* buffer, size_t size, uint32_t seed) {
+    for(size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        buffer[i] = seed >> 16;
+    }
+}
+
+static uint8_t nfc_test_parity_mask(uint16_t len) {
+    return len % 8 ? 0xFF << (8 - len % 8) : 0xFF;
+}
+
+MU_TEST(nfc_util_odd_parity_test) {
+    uint8_t data[NFC_TEST_LEN_MAX];
+    uint8_t parity[NFC_TEST_LEN_MAX / 8];
+    for(uint16_t value = 0; value < 256; value++) {
+        memset(data, value, sizeof(data));
+        nfc_util_odd_parity(data, parity, sizeof(data));
+        uint8_t expected = nfc_util_odd_parity8(value) ? 0xFF : 0x00;
+        for(size_t i = 0; i < sizeof(parity); i++) {
+            mu_assert_int_eq(expected, parity[i]);
+        }
+        mu_assert_int_eq(1, __builtin_parity(value | nfc_util_odd_parity8(value) << 8));
+    }
+}
+
+MU_TEST(nfc_util_merge_split_test) {
+    uint8_t data[NFC_TEST_LEN_MAX];
+    uint8_t parity[NFC_TEST_LEN_MAX / 8];
+    uint8_t bitstream[NFC_TEST_LEN_MAX * 9 / 8];
+    uint8_t reference[NFC_TEST_LEN_MAX * 9 / 8];
+    uint8_t split_data[NFC_TEST_LEN_MAX];
+    uint8_t split_parity[NFC_TEST_LEN_MAX / 8];
+
+    // Every 9-bit symbol at every position of every length, including tails
+    for(uint16_t len = 1; len <= NFC_TEST_LEN_MAX; len++) {
+        uint16_t bytes = (len * 9 + 7) / 8;
+        uint16_t parity_len = (len + 7) / 8;
+        for(uint16_t position = 0; position < len; position++) {
+            for(uint16_t symbol = 0; symbol < 512; symbol++) {
+                nfc_test_fill(data, len, symbol + position);
+                nfc_test_fill(parity, parity_len, ~symbol);
+                parity[parity_len - 1] &= nfc_test_parity_mask(len);
+                data[position] = symbol;
+                if(symbol & 0x100) {
+                    parity[position / 8] |= 0x80 >> (position % 8);
+                } else {
+                    parity[position / 8] &= ~(0x80 >> (position % 8));
+                }
+
+                mu_assert_int_eq(
+                    nfc_test_merge_reference(data, len, parity, reference),
+                    nfc_util_merge_data_and_parity(data, len, parity, bitstream));
+                mu_check(memcmp(bitstream, reference, bytes) == 0);
+
+                mu_assert_int_eq(
+                    len,
+                    nfc_util_split_data_and_parity(bitstream, len * 9, split_data, split_parity));
+                mu_check(memcmp(split_data, data, len) == 0);
+                mu_check(memcmp(split_parity, parity, parity_len) == 0);
+            }
+        }
+    }
+
+    // Bitstream of whole bytes only
+    mu_assert_int_eq(0, nfc_util_split_data_and_parity(bitstream, 8, split_data, split_parity));
+}
+
+MU_TEST(nfc_util_crypto1_encrypt_test) {
+    const uint64_t key = 0xA0A1A2A3A4A5;
+    uint8_t plain[18];
+    uint8_t keystream[18];
+    nfc_test_fill(plain, sizeof(plain), 1);
+    nfc_test_fill(keystream, sizeof(keystream), 2);
+
+    Crypto1 reference;
+    crypto1_init(&reference, key);
+    uint8_t reference_data[sizeof(plain)];
+    uint8_t reference_parity[3] = {};
+    for(uint8_t i = 0; i < sizeof(plain); i++) {
+        reference_data[i] = crypto1_byte(&reference, keystream[i], 0) ^ plain[i];
+        reference_parity[i / 8] |=
+            ((crypto1_filter(reference.odd) ^ nfc_util_odd_parity8(plain[i])) & 0x01)
+            << (7 - i % 8);
+    }
+
+    Crypto1 crypto;
+    crypto1_init(&crypto, key);
+    uint8_t data[sizeof(plain)];
+    uint8_t parity[3];
+    crypto1_encrypt(&crypto, keystream, plain, sizeof(plain), data, parity);
+    mu_check(memcmp(data, reference_data, sizeof(data)) == 0);
+    mu_check(memcmp(parity, reference_parity, sizeof(parity)) == 0);
+    mu_check(crypto.odd == reference.odd);
+    mu_check(crypto.even == reference.even);
+}
+
+MU_TEST(nfc_util_merge_split_bench) {
+    uint8_t data[NFC_TEST_BENCH_LEN];
+    uint8_t parity[NFC_TEST_BENCH_LEN / 8];
+    uint8_t bitstream[NFC_TEST_BENCH_LEN * 9 / 8];
+    nfc_test_fill(data, sizeof(data), 3);
+    nfc_util_odd_parity(data, parity, sizeof(data));
+
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_BENCH_RUNS; i++) {
+        nfc_test_merge_reference(data, sizeof(data), parity, bitstream);
+    }
+    uint32_t reference = (DWT->CYCCNT - start) / NFC_TEST_BENCH_RUNS;
+
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_BENCH_RUNS; i++) {
+        nfc_util_merge_data_and_parity(data, sizeof(data), parity, bitstream);
+    }
+    uint32_t merge = (DWT->CYCCNT - start) / NFC_TEST_BENCH_RUNS;
+
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_BENCH_RUNS; i++) {
+        nfc_util_split_data_and_parity(bitstream, sizeof(data) * 9, data, parity);
+    }
+    uint32_t split = (DWT->CYCCNT - start) / NFC_TEST_BENCH_RUNS;
+
+    FURI_LOG_I(
+        TAG,
+        "%d bytes: bitwise merge %lu cycles, merge %lu cycles, split %lu cycles",
+        NFC_TEST_BENCH_LEN,
+        reference,
+        merge,
+        split);
+}
+
+MU_TEST_SUITE(nfc_util_suite) {
+    MU_RUN_TEST(nfc_util_odd_parity_test);
+    MU_RUN_TEST(nfc_util_merge_split_test);
+    MU_RUN_TEST(nfc_util_crypto1_encrypt_test);
+    MU_RUN_TEST(nfc_util_merge_split_bench);
+}
+
+int run_minunit_test_nfc_util() {
+    MU_RUN_SUITE(nfc_util_suite);
+    return MU_EXIT_CODE;
+}
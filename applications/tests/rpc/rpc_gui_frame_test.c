@@ -0,0 +1,223 @@
+#include <furi.h>
+#include <pb.h>
+#include <pb_decode.h>
+#include <pb_encode.h>
+#include <flipper.pb.h>
+#include <rpc/rpc_gui_frame.h>
+#include "../minunit.h"
+
+#define TAG "RpcGuiFrameTest"
+
+/* 128x64 display, 8 pages of 128 columns */
+#define TEST_FRAME_WIDTH (128)
+#define TEST_FRAME_PAGES (8)
+#define TEST_FRAME_SIZE (TEST_FRAME_WIDTH * TEST_FRAME_PAGES)
+#define TEST_FRAME_COUNT (64)
+/* 30 fps stream with keyframe every second */
+#define TEST_KEYFRAME_FRAMES (30)
+
+typedef void (*TestFrameDraw)(uint8_t* frame, size_t index);
+
+typedef struct {
+    uint32_t bytes_raw;
+    uint32_t bytes_sent;
+    uint32_t frames_raw;
+} TestStreamStats;
+
+/* Menu with text rows and selection moving down every 4th frame */
+static void test_frame_draw_menu(uint8_t* frame, size_t index) {
+    size_t selected = 1 + (index / 4) % (TEST_FRAME_PAGES - 1);
+    memset(frame, 0, TEST_FRAME_SIZE);
+    for(size_t page = 0; page < TEST_FRAME_PAGES; page++) {
+        uint8_t* row = &frame[page * TEST_FRAME_WIDTH];
+        for(size_t x = 4; x < 100; x++) {
+            row[x] = ((x * 7 + page * 3) % 5) ? (x * 13 + page) & 0x7E : 0;
+        }
+        if(page == selected) {
+            for(size_t x = 0; x < TEST_FRAME_WIDTH; x++) row[x] ^= 0xFF;
+        }
+    }
+}
+
+/* Status bar and 16x16 sprite moving over blank background */
+static void test_frame_draw_animation(uint8_t* frame, size_t index) {
+    size_t sprite_x = (index * 3) % (TEST_FRAME_WIDTH - 16);
+    size_t sprite_page = 2 + (index / 8) % 4;
+    memset(frame, 0, TEST_FRAME_SIZE);
+    for(size_t x = 0; x < TEST_FRAME_WIDTH; x += 2) {
+        frame[x] = 0x81;
+    }
+    for(size_t x = 0; x < 16; x++) {
+        uint8_t column = (x + index) & 0xFF;
+        frame[sprite_page * TEST_FRAME_WIDTH + sprite_x + x] = column | 0x18;
+        frame[(sprite_page + 1) * TEST_FRAME_WIDTH + sprite_x + x] = ~column;
+    }
+}
+
+/* Same choice device makes: delta unless keyframe, RLE otherwise, raw if nothing is smaller */
+static void test_frame_pack(PB_Main* message, const uint8_t* frame, const uint8_t* sent) {
+    PB_Gui_ScreenFrame* screen_frame = &message->content.gui_screen_frame;
+    pb_bytes_array_t* data = screen_frame->data;
+    size_t size = 0;
+
+    screen_frame->encoding = PB_Gui_ScreenFrameEncoding_XOR_RLE;
+    if(sent) {
+        size = rpc_gui_frame_encode(
+            frame, sent, TEST_FRAME_SIZE, data->bytes, TEST_FRAME_SIZE - 1);
+    }
+    if(!size) {
+        screen_frame->encoding = PB_Gui_ScreenFrameEncoding_RLE;
+        size = rpc_gui_frame_encode(
+            frame, NULL, TEST_FRAME_SIZE, data->bytes, TEST_FRAME_SIZE - 1);
+    }
+    if(!size) {
+        screen_frame->encoding = PB_Gui_ScreenFrameEncoding_RAW;
+        memcpy(data->bytes, frame, TEST_FRAME_SIZE);
+        size = TEST_FRAME_SIZE;
+    }
+    data->size = size;
+}
+
+/* Client side */
+static bool test_frame_unpack(const PB_Gui_ScreenFrame* screen_frame, uint8_t* frame) {
+    const pb_bytes_array_t* data = screen_frame->data;
+    if(!data) return false;
+    if(screen_frame->encoding == PB_Gui_ScreenFrameEncoding_RAW) {
+        if(data->size != TEST_FRAME_SIZE) return false;
+        memcpy(frame, data->bytes, TEST_FRAME_SIZE);
+        return true;
+    }
+    return rpc_gui_frame_decode(
+        data->bytes,
+        data->size,
+        frame,
+        TEST_FRAME_SIZE,
+        screen_frame->encoding == PB_Gui_ScreenFrameEncoding_XOR_RLE);
+}
+
+static void test_frame_stream(TestFrameDraw draw, TestStreamStats* stats) {
+    uint8_t* frame = malloc(TEST_FRAME_SIZE);
+    uint8_t* sent = malloc(TEST_FRAME_SIZE);
+    uint8_t* client_frame = malloc(TEST_FRAME_SIZE);
+    uint8_t* buffer = malloc(TEST_FRAME_SIZE + 16);
+
+    PB_Main* message = malloc(sizeof(PB_Main));
+    message->which_content = PB_Main_gui_screen_frame_tag;
+    message->content.gui_screen_frame.data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(TEST_FRAME_SIZE));
+    memset(stats, 0, sizeof(TestStreamStats));
+
+    for(size_t i = 0; i < TEST_FRAME_COUNT; i++) {
+        draw(frame, i);
+        bool keyframe = (i % TEST_KEYFRAME_FRAMES) == 0;
+        test_frame_pack(message, frame, keyframe ? NULL : sent);
+        memcpy(sent, frame, TEST_FRAME_SIZE);
+        if(message->content.gui_screen_frame.encoding == PB_Gui_ScreenFrameEncoding_RAW) {
+            stats->frames_raw++;
+        }
+
+        pb_ostream_t ostream = pb_ostream_from_buffer(buffer, TEST_FRAME_SIZE + 16);
+        mu_assert(pb_encode(&ostream, &PB_Main_msg, message), "frame encode failed");
+
+        PB_Main decoded = PB_Main_init_default;
+        pb_istream_t istream = pb_istream_from_buffer(buffer, ostream.bytes_written);
+        mu_assert(pb_decode(&istream, &PB_Main_msg, &decoded), "frame decode failed");
+        mu_assert_int_eq(PB_Main_gui_screen_frame_tag, decoded.which_content);
+        mu_assert(
+            test_frame_unpack(&decoded.content.gui_screen_frame, client_frame),
+            "frame unpack failed");
+        mu_assert(memcmp(client_frame, frame, TEST_FRAME_SIZE) == 0, "frame mismatch");
+        pb_release(&PB_Main_msg, &decoded);
+
+        stats->bytes_raw += TEST_FRAME_SIZE;
+        stats->bytes_sent += ostream.bytes_written;
+    }
+
+    pb_release(&PB_Main_msg, message);
+    free(message);
+    free(buffer);
+    free(client_frame);
+    free(sent);
+    free(frame);
+}
+
+MU_TEST(rpc_gui_frame_menu_stream) {
+    TestStreamStats stats;
+    test_frame_stream(test_frame_draw_menu, &stats);
+    // Keyframes are RLE, only incompressible frames may go out raw
+    mu_assert_int_eq(0, stats.frames_raw);
+    mu_check(stats.bytes_sent < stats.bytes_raw / 8);
+    FURI_LOG_I(
+        TAG,
+        "Menu: %lu frames, %lu bytes, raw %lu bytes",
+        (uint32_t)TEST_FRAME_COUNT,
+        stats.bytes_sent,
+        stats.bytes_raw);
+}
+
+MU_TEST(rpc_gui_frame_animation_stream) {
+    TestStreamStats stats;
+    test_frame_stream(test_frame_draw_animation, &stats);
+    mu_assert_int_eq(0, stats.frames_raw);
+    mu_check(stats.bytes_sent < stats.bytes_raw / 8);
+    FURI_LOG_I(
+        TAG,
+        "Animation: %lu frames, %lu bytes, raw %lu bytes",
+        (uint32_t)TEST_FRAME_COUNT,
+        stats.bytes_sent,
+        stats.bytes_raw);
+}
+
+MU_TEST(rpc_gui_frame_incompressible) {
+    uint8_t* frame = malloc(TEST_FRAME_SIZE);
+    uint8_t* out = malloc(TEST_FRAME_SIZE);
+    for(size_t i = 0; i < TEST_FRAME_SIZE; i++) {
+        frame[i] = i * 37 + (i >> 3);
+    }
+    // Encoder gives up instead of growing frame, caller falls back to raw
+    mu_assert_int_eq(
+        0, rpc_gui_frame_encode(frame, NULL, TEST_FRAME_SIZE, out, TEST_FRAME_SIZE - 1));
+    free(out);
+    free(frame);
+}
+
+MU_TEST(rpc_gui_frame_broken) {
+    uint8_t* frame = malloc(TEST_FRAME_SIZE);
+    uint8_t* out = malloc(TEST_FRAME_SIZE);
+    test_frame_draw_menu(frame, 0);
+    size_t size = rpc_gui_frame_encode(frame, NULL, TEST_FRAME_SIZE, out, TEST_FRAME_SIZE);
+    mu_check(size > 0);
+    mu_check(rpc_gui_frame_decode(out, size, frame, TEST_FRAME_SIZE, false));
+    mu_check(!rpc_gui_frame_decode(out, size - 1, frame, TEST_FRAME_SIZE, false));
+    mu_check(!rpc_gui_frame_decode(out, size, frame, TEST_FRAME_SIZE - 1, false));
+    free(out);
+    free(frame);
+}
+
+MU_TEST(rpc_gui_frame_legacy_client) {
+    // Start request from client without encoding support is empty
+    uint8_t buffer[16];
+    PB_Main request = PB_Main_init_default;
+    request.which_content = PB_Main_gui_start_screen_stream_request_tag;
+    pb_ostream_t ostream = pb_ostream_from_buffer(buffer, sizeof(buffer));
+    mu_check(pb_encode(&ostream, &PB_Main_msg, &request));
+
+    PB_Main decoded = PB_Main_init_default;
+    pb_istream_t istream = pb_istream_from_buffer(buffer, ostream.bytes_written);
+    mu_check(pb_decode(&istream, &PB_Main_msg, &decoded));
+    mu_assert_int_eq(
+        PB_Gui_ScreenFrameEncoding_RAW, decoded.content.gui_start_screen_stream_request.encoding);
+    pb_release(&PB_Main_msg, &decoded);
+}
+
+MU_TEST_SUITE(test_rpc_gui_frame) {
+    MU_RUN_TEST(rpc_gui_frame_menu_stream);
+    MU_RUN_TEST(rpc_gui_frame_animation_stream);
+    MU_RUN_TEST(rpc_gui_frame_incompressible);
+    MU_RUN_TEST(rpc_gui_frame_broken);
+    MU_RUN_TEST(rpc_gui_frame_legacy_client);
+}
+
+int run_minunit_test_rpc_gui_frame() {
+    MU_RUN_SUITE(test_rpc_gui_frame);
+    return MU_EXIT_CODE;
+}
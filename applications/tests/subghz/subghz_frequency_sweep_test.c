@@ -0,0 +1,155 @@
+#include <furi.h>
+#include <math.h>
+#include <subghz/helpers/subghz_frequency_sweep.h>
+#include "../minunit.h"
+
+#define SWEEP_TEST_NOISE_FLOOR (-105.0f)
+#define SWEEP_TEST_FREQUENCY_STEP (26000000.0f / 65536.0f)
+#define SWEEP_TEST_SWEEPS 64
+#define SWEEP_TEST_TOLERANCE 10000
+
+#define TAG "SubGhzSweepTest"
+
+static const uint32_t sweep_test_frequencies[] = {
+    300000000,
+    303875000,
+    304250000,
+    315000000,
+    318000000,
+    390000000,
+    418000000,
+    433075000,
+    433420000,
+    433920000,
+    434420000,
+    434775000,
+    438900000,
+    868350000,
+    915000000,
+    925000000,
+};
+
+typedef struct {
+    uint32_t frequency;
+    float power;
+} SweepTestCarrier;
+
+typedef struct {
+    const SweepTestCarrier* carriers;
+    size_t carriers_count;
+    uint32_t noise_seed;
+    float noise;
+    SubGhzFrequencySweepFilter filter;
+    uint32_t filter_switches;
+} SweepTestModel;
+
+/* CC1101 RSSI model: synthesizer step, receive filter with gaussian-like
+ * roll-off, noise floor, 0.5 dB resolution of RSSI register */
+static bool sweep_test_measure(
+    void* context,
+    uint32_t* frequency,
+    SubGhzFrequencySweepFilter filter,
+    float* rssi) {
+    SweepTestModel* model = context;
+    if(model->filter != filter) {
+        model->filter = filter;
+        model->filter_switches++;
+    }
+
+    *frequency = roundf(*frequency / SWEEP_TEST_FREQUENCY_STEP) * SWEEP_TEST_FREQUENCY_STEP;
+    float half_bandwidth = (filter == SubGhzFrequencySweepFilterWide) ? 325000.0f : 29000.0f;
+
+    float power = powf(10.0f, SWEEP_TEST_NOISE_FLOOR / 10.0f);
+    for(size_t i = 0; i < model->carriers_count; i++) {
+        float offset = ((float)*frequency - (float)model->carriers[i].frequency) / half_bandwidth;
+        float attenuation = 6.0f * offset * offset;
+        power += powf(10.0f, (model->carriers[i].power - attenuation) / 10.0f);
+    }
+
+    model->noise_seed = model->noise_seed * 1103515245 + 12345;
+    float noise = ((float)((model->noise_seed >> 16) & 0x7FFF) / 0x7FFF - 0.5f) * model->noise;
+    *rssi = roundf((10.0f * log10f(power) + noise) * 2.0f) / 2.0f;
+    return true;
+}
+
+static void sweep_test_run(
+    const SweepTestCarrier* carriers,
+    size_t carriers_count,
+    SubGhzFrequencySweepRefine refine,
+    float noise) {
+    SweepTestModel model = {
+        .carriers = carriers,
+        .carriers_count = carriers_count,
+        .noise_seed = 1,
+        .noise = noise,
+    };
+    SubGhzFrequencySweep* sweep = subghz_frequency_sweep_alloc(
+        sweep_test_frequencies, COUNT_OF(sweep_test_frequencies), sweep_test_measure, &model);
+    subghz_frequency_sweep_set_refine(sweep, refine);
+
+    uint32_t frequency = 0;
+    float rssi = 0;
+    uint32_t found = 0;
+    for(size_t i = 0; i < SWEEP_TEST_SWEEPS; i++) {
+        if(subghz_frequency_sweep_run(sweep, &frequency, &rssi)) {
+            found++;
+            // Strongest carrier wins
+            int32_t error = (int32_t)(frequency - carriers[0].frequency);
+            mu_check(abs(error) < SWEEP_TEST_TOLERANCE);
+        }
+    }
+
+    SubGhzFrequencySweepStats stats;
+    subghz_frequency_sweep_get_stats(sweep, &stats);
+    mu_assert_int_eq(SWEEP_TEST_SWEEPS, stats.sweeps);
+    if(carriers_count) {
+        // Carrier is on cold channel until it's reached by rotation
+        mu_check(found >= SWEEP_TEST_SWEEPS - 2);
+    } else {
+        mu_assert_int_eq(0, found);
+    }
+    // Two filter switches per sweep at most
+    mu_check(model.filter_switches <= stats.sweeps * 2);
+
+    FURI_LOG_I(
+        TAG,
+        "%s, %d carriers: %lu measurements per sweep",
+        refine == SubGhzFrequencySweepRefineGolden ? "golden" : "binary",
+        carriers_count,
+        stats.measurements / stats.sweeps);
+
+    subghz_frequency_sweep_free(sweep);
+}
+
+MU_TEST(subghz_frequency_sweep_idle_test) {
+    sweep_test_run(NULL, 0, SubGhzFrequencySweepRefineGolden, 1.0f);
+}
+
+MU_TEST(subghz_frequency_sweep_single_test) {
+    // Carrier between channels, off the refinement grid
+    const SweepTestCarrier carriers[] = {{.frequency = 433957000, .power = -60.0f}};
+    sweep_test_run(carriers, COUNT_OF(carriers), SubGhzFrequencySweepRefineGolden, 0.0f);
+    sweep_test_run(carriers, COUNT_OF(carriers), SubGhzFrequencySweepRefineBinary, 0.0f);
+}
+
+MU_TEST(subghz_frequency_sweep_multiple_test) {
+    // Strongest first, weaker carriers on other bands and next to it
+    const SweepTestCarrier carriers[] = {
+        {.frequency = 314985000, .power = -55.0f},
+        {.frequency = 868400000, .power = -70.0f},
+        {.frequency = 315150000, .power = -80.0f},
+    };
+    sweep_test_run(carriers, COUNT_OF(carriers), SubGhzFrequencySweepRefineGolden, 1.0f);
+    sweep_test_run(carriers, COUNT_OF(carriers), SubGhzFrequencySweepRefineBinary, 1.0f);
+}
+
+MU_TEST_SUITE(subghz_frequency_sweep_suite) {
+    MU_RUN_TEST(subghz_frequency_sweep_idle_test);
+    MU_RUN_TEST(subghz_frequency_sweep_single_test);
+    MU_RUN_TEST(subghz_frequency_sweep_multiple_test);
+}
+
+int run_minunit_test_subghz_frequency_sweep() {
+    MU_RUN_SUITE(subghz_frequency_sweep_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,160 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/transmitter.h>
+#include <lib/toolbox/stream/stream.h>
+#include <subghz/subghz_history.h>
+#include <subghz/views/receiver.h>
+#include "../minunit.h"
+
+#define SUBGHZ_HISTORY_TEST_CAPTURES 500
+#define SUBGHZ_HISTORY_TEST_KEY 0x550000
+#define SUBGHZ_HISTORY_TEST_TE 400
+#define SUBGHZ_HISTORY_TEST_FREQUENCY 433920000
+
+#define TAG "SubGhzHistoryTest"
+
+typedef struct {
+    SubGhzEnvironment* environment;
+    SubGhzReceiver* receiver;
+    SubGhzTransmitter* transmitter;
+    FlipperFormat* flipper_format;
+    SubGhzHistory* history;
+    uint32_t added;
+    uint32_t add_cycles;
+} SubGhzHistoryTest;
+
+static void subghz_history_test_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzHistoryTest* test = context;
+    uint32_t start = DWT->CYCCNT;
+    if(subghz_history_add_to_history(
+           test->history,
+           decoder_base,
+           SUBGHZ_HISTORY_TEST_FREQUENCY,
+           FuriHalSubGhzPresetOok650Async)) {
+        test->added++;
+    }
+    test->add_cycles += DWT->CYCCNT - start;
+}
+
+// Encode key and feed it to receiver as it was received over the air
+static void subghz_history_test_capture(SubGhzHistoryTest* test, uint32_t key) {
+    Stream* stream = flipper_format_get_raw_stream(test->flipper_format);
+    stream_clean(stream);
+    uint32_t bits = 24;
+    uint32_t te = SUBGHZ_HISTORY_TEST_TE;
+    uint32_t repeat = 3;
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    for(size_t i = 0; i < sizeof(uint32_t); i++) {
+        key_data[sizeof(uint64_t) - i - 1] = (key >> i * 8) & 0xFF;
+    }
+    flipper_format_write_uint32(test->flipper_format, "Bit", &bits, 1);
+    flipper_format_write_hex(test->flipper_format, "Key", key_data, sizeof(uint64_t));
+    flipper_format_write_uint32(test->flipper_format, "TE", &te, 1);
+    flipper_format_write_uint32(test->flipper_format, "Repeat", &repeat, 1);
+
+    mu_check(subghz_transmitter_deserialize(test->transmitter, test->flipper_format));
+    LevelDuration level_duration;
+    while(!level_duration_is_reset(level_duration = subghz_transmitter_yield(test->transmitter))) {
+        subghz_receiver_decode(
+            test->receiver,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration));
+    }
+}
+
+MU_TEST(subghz_history_capacity_test) {
+    SubGhzHistoryTest* test = malloc(sizeof(SubGhzHistoryTest));
+    test->environment = subghz_environment_alloc();
+    test->receiver = subghz_receiver_alloc_init(test->environment);
+    subghz_receiver_set_filter(test->receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(test->receiver, subghz_history_test_rx_callback, test);
+    test->transmitter = subghz_transmitter_alloc_init(test->environment, "Princeton");
+    test->flipper_format = flipper_format_string_alloc();
+
+    size_t heap_before = memmgr_get_free_heap();
+    test->history = subghz_history_alloc();
+    size_t history_size = heap_before - memmgr_get_free_heap();
+    uint16_t capacity = subghz_history_get_capacity(test->history);
+    mu_check(capacity > 0);
+
+    // Consecutive keys have different hash, so none is taken for retransmission
+    for(uint32_t i = 0; i < SUBGHZ_HISTORY_TEST_CAPTURES; i++) {
+        subghz_history_test_capture(test, SUBGHZ_HISTORY_TEST_KEY + i);
+    }
+    uint16_t items = subghz_history_get_item(test->history);
+    mu_assert_int_eq(MIN(capacity, SUBGHZ_HISTORY_TEST_CAPTURES), items);
+    mu_assert_int_eq(items, test->added);
+
+    // Same key again is folded into existing record
+    if(items > 1) {
+        subghz_history_test_capture(test, SUBGHZ_HISTORY_TEST_KEY);
+        mu_assert_int_eq(items, subghz_history_get_item(test->history));
+        mu_assert_int_eq(2, subghz_history_get_repeat(test->history, 0));
+    }
+
+    // Menu text is generated for every record when receiver scene is entered
+    string_t text;
+    string_init(text);
+    uint32_t start = DWT->CYCCNT;
+    for(uint16_t i = 0; i < items; i++) {
+        subghz_history_get_text_item_menu(test->history, text, i);
+    }
+    uint32_t menu_cycles = DWT->CYCCNT - start;
+    subghz_history_get_text_item_menu(test->history, text, 1);
+    mu_assert_string_eq("Princeton 550001", string_get_cstr(text));
+
+    // Receiver menu keeps own copy of every text, history capacity accounts for it
+    SubGhzViewReceiver* receiver_view = subghz_view_receiver_alloc();
+    size_t heap_menu = memmgr_get_free_heap();
+    for(uint16_t i = 0; i < items; i++) {
+        subghz_history_get_text_item_menu(test->history, text, i);
+        subghz_view_receiver_add_item_to_menu(
+            receiver_view,
+            string_get_cstr(text),
+            subghz_history_get_type_protocol(test->history, i));
+    }
+    size_t menu_size = heap_menu - memmgr_get_free_heap();
+    mu_check(menu_size / items <= SUBGHZ_HISTORY_MENU_ITEM_SIZE);
+    subghz_view_receiver_free(receiver_view);
+
+    // Export restores protocol specific fields
+    FlipperFormat* raw = flipper_format_string_alloc();
+    mu_check(subghz_history_get_raw_data(test->history, 1, raw));
+    mu_check(flipper_format_read_string(raw, "Protocol", text));
+    mu_assert_string_eq("Princeton", string_get_cstr(text));
+    uint32_t te = 0;
+    mu_check(flipper_format_read_uint32(raw, "TE", &te, 1));
+    mu_check(te > SUBGHZ_HISTORY_TEST_TE / 2 && te < SUBGHZ_HISTORY_TEST_TE * 2);
+    flipper_format_free(raw);
+    string_clear(text);
+
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    FURI_LOG_I(
+        TAG,
+        "%d records, %d bytes per record, %d bytes per menu item, add %luus, menu text %luus",
+        capacity,
+        history_size / capacity,
+        menu_size / items,
+        test->add_cycles / items / cycles_per_us,
+        menu_cycles / items / cycles_per_us);
+
+    subghz_history_free(test->history);
+    flipper_format_free(test->flipper_format);
+    subghz_transmitter_free(test->transmitter);
+    subghz_receiver_free(test->receiver);
+    subghz_environment_free(test->environment);
+    free(test);
+}
+
+MU_TEST_SUITE(subghz_history_suite) {
+    MU_RUN_TEST(subghz_history_capacity_test);
+}
+
+int run_minunit_test_subghz_history() {
+    MU_RUN_SUITE(subghz_history_suite);
+    return MU_EXIT_CODE;
+}
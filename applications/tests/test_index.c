@@ -13,9 +13,23 @@
 int run_minunit();
 int run_minunit_test_infrared_decoder_encoder();
 int run_minunit_test_rpc();
+int run_minunit_test_rpc_gui_frame();
 int run_minunit_test_flipper_format();
 int run_minunit_test_flipper_format_string();
 int run_minunit_test_stream();
+int run_minunit_test_gui();
+int run_minunit_test_gui_view();
+int run_minunit_test_bt();
+int run_minunit_test_furi_hal_vcp();
+int run_minunit_test_furi_hal_subghz();
+int run_minunit_test_furi_hal_spi();
+int run_minunit_test_furi_hal_power();
+int run_minunit_test_nfc_util();
+int run_minunit_test_nfc_mf_ul_emulation();
+int run_minunit_test_nfc_device();
+int run_minunit_test_lfrfid_decoder();
+int run_minunit_test_subghz_history();
+int run_minunit_test_subghz_frequency_sweep();
 
 void minunit_print_progress(void) {
     static char progress[] = {'\\', '|', '/', '-'};
@@ -55,9 +69,23 @@ void unit_tests_cli(Cli* cli, string_t args, void* context) {
         test_result |= run_minunit();
         test_result |= run_minunit_test_infrared_decoder_encoder();
         test_result |= run_minunit_test_rpc();
+        test_result |= run_minunit_test_rpc_gui_frame();
         test_result |= run_minunit_test_stream();
         test_result |= run_minunit_test_flipper_format();
         test_result |= run_minunit_test_flipper_format_string();
+        test_result |= run_minunit_test_gui();
+        test_result |= run_minunit_test_gui_view();
+        test_result |= run_minunit_test_bt();
+        test_result |= run_minunit_test_furi_hal_vcp();
+        test_result |= run_minunit_test_furi_hal_subghz();
+        test_result |= run_minunit_test_furi_hal_spi();
+        test_result |= run_minunit_test_furi_hal_power();
+        test_result |= run_minunit_test_nfc_util();
+        test_result |= run_minunit_test_nfc_mf_ul_emulation();
+        test_result |= run_minunit_test_nfc_device();
+        test_result |= run_minunit_test_lfrfid_decoder();
+        test_result |= run_minunit_test_subghz_history();
+        test_result |= run_minunit_test_subghz_frequency_sweep();
         cycle_counter = (DWT->CYCCNT - cycle_counter);
 
         FURI_LOG_I(TAG, "Consumed: %0.2fs", (float)cycle_counter / (SystemCoreClock));
@@ -10,6 +10,10 @@ DOLPHIN_SOURCE_DIR			:= $(ASSETS_DIR)/dolphin
 DOLPHIN_INTERNAL_OUTPUT_DIR	:= $(ASSETS_COMPILED_DIR)
 DOLPHIN_EXTERNAL_OUTPUT_DIR	:= $(ASSETS_DIR)/resources/dolphin
 
+EMV_RESOURCES_DIR		:= $(ASSETS_DIR)/resources/nfc/assets
+EMV_RESOURCES_SOURCES	:= aid.nfc country_code.nfc currency_code.nfc
+EMV_RESOURCES			:= $(addprefix $(EMV_RESOURCES_DIR)/,$(EMV_RESOURCES_SOURCES:.nfc=.idx))
+
 PROTOBUF_SOURCE_DIR		:= $(ASSETS_DIR)/protobuf
 PROTOBUF_COMPILER		:= $(PROJECT_ROOT)/lib/nanopb/generator/nanopb_generator.py
 PROTOBUF_COMPILED_DIR	:= $(ASSETS_COMPILED_DIR)
@@ -27,13 +27,20 @@ typedef enum _PB_Gui_InputType {
     PB_Gui_InputType_REPEAT = 4 /* *< Repeat event, emmited with INPUT_REPEATE_PRESS period after InputTypeLong event */
 } PB_Gui_InputType;
 
+typedef enum _PB_Gui_ScreenFrameEncoding { 
+    PB_Gui_ScreenFrameEncoding_RAW = 0, /* *< Uncompressed framebuffer */
+    PB_Gui_ScreenFrameEncoding_RLE = 1, /* *< Run length encoded framebuffer */
+    PB_Gui_ScreenFrameEncoding_XOR_RLE = 2 /* *< Run length encoded XOR against previous frame */
+} PB_Gui_ScreenFrameEncoding;
+
 /* Struct definitions */
 typedef struct _PB_Gui_ScreenFrame { 
     pb_bytes_array_t *data; 
+    PB_Gui_ScreenFrameEncoding encoding; 
 } PB_Gui_ScreenFrame;
 
 typedef struct _PB_Gui_StartScreenStreamRequest { 
-    char dummy_field;
+    PB_Gui_ScreenFrameEncoding encoding; /* *< Best encoding client can decode */
 } PB_Gui_StartScreenStreamRequest;
 
 typedef struct _PB_Gui_StopScreenStreamRequest { 
@@ -64,20 +71,24 @@ typedef struct _PB_Gui_StartVirtualDisplayRequest {
 #define _PB_Gui_InputType_MAX PB_Gui_InputType_REPEAT
 #define _PB_Gui_InputType_ARRAYSIZE ((PB_Gui_InputType)(PB_Gui_InputType_REPEAT+1))
 
+#define _PB_Gui_ScreenFrameEncoding_MIN PB_Gui_ScreenFrameEncoding_RAW
+#define _PB_Gui_ScreenFrameEncoding_MAX PB_Gui_ScreenFrameEncoding_XOR_RLE
+#define _PB_Gui_ScreenFrameEncoding_ARRAYSIZE ((PB_Gui_ScreenFrameEncoding)(PB_Gui_ScreenFrameEncoding_XOR_RLE+1))
+
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /* Initializer values for message structs */
-#define PB_Gui_ScreenFrame_init_default          {NULL}
-#define PB_Gui_StartScreenStreamRequest_init_default {0}
+#define PB_Gui_ScreenFrame_init_default          {NULL, _PB_Gui_ScreenFrameEncoding_MIN}
+#define PB_Gui_StartScreenStreamRequest_init_default {_PB_Gui_ScreenFrameEncoding_MIN}
 #define PB_Gui_StopScreenStreamRequest_init_default {0}
 #define PB_Gui_SendInputEventRequest_init_default {_PB_Gui_InputKey_MIN, _PB_Gui_InputType_MIN}
 #define PB_Gui_StartVirtualDisplayRequest_init_default {false, PB_Gui_ScreenFrame_init_default}
 #define PB_Gui_StopVirtualDisplayRequest_init_default {0}
-#define PB_Gui_ScreenFrame_init_zero             {NULL}
-#define PB_Gui_StartScreenStreamRequest_init_zero {0}
+#define PB_Gui_ScreenFrame_init_zero             {NULL, _PB_Gui_ScreenFrameEncoding_MIN}
+#define PB_Gui_StartScreenStreamRequest_init_zero {_PB_Gui_ScreenFrameEncoding_MIN}
 #define PB_Gui_StopScreenStreamRequest_init_zero {0}
 #define PB_Gui_SendInputEventRequest_init_zero   {_PB_Gui_InputKey_MIN, _PB_Gui_InputType_MIN}
 #define PB_Gui_StartVirtualDisplayRequest_init_zero {false, PB_Gui_ScreenFrame_init_zero}
@@ -85,18 +96,21 @@ extern "C" {
 
 /* Field tags (for use in manual encoding/decoding) */
 #define PB_Gui_ScreenFrame_data_tag              1
+#define PB_Gui_ScreenFrame_encoding_tag          2
+#define PB_Gui_StartScreenStreamRequest_encoding_tag 1
 #define PB_Gui_SendInputEventRequest_key_tag     1
 #define PB_Gui_SendInputEventRequest_type_tag    2
 #define PB_Gui_StartVirtualDisplayRequest_first_frame_tag 1
 
 /* Struct field encoding specification for nanopb */
 #define PB_Gui_ScreenFrame_FIELDLIST(X, a) \
-X(a, POINTER,  SINGULAR, BYTES,    data,              1)
+X(a, POINTER,  SINGULAR, BYTES,    data,              1) \
+X(a, STATIC,   SINGULAR, UENUM,    encoding,          2)
 #define PB_Gui_ScreenFrame_CALLBACK NULL
 #define PB_Gui_ScreenFrame_DEFAULT NULL
 
 #define PB_Gui_StartScreenStreamRequest_FIELDLIST(X, a) \
-
+X(a, STATIC,   SINGULAR, UENUM,    encoding,          1)
 #define PB_Gui_StartScreenStreamRequest_CALLBACK NULL
 #define PB_Gui_StartScreenStreamRequest_DEFAULT NULL
 
@@ -141,7 +155,7 @@ extern const pb_msgdesc_t PB_Gui_StopVirtualDisplayRequest_msg;
 /* PB_Gui_ScreenFrame_size depends on runtime parameters */
 /* PB_Gui_StartVirtualDisplayRequest_size depends on runtime parameters */
 #define PB_Gui_SendInputEventRequest_size        4
-#define PB_Gui_StartScreenStreamRequest_size     0
+#define PB_Gui_StartScreenStreamRequest_size     2
 #define PB_Gui_StopScreenStreamRequest_size      0
 #define PB_Gui_StopVirtualDisplayRequest_size    0
 
@@ -1,3 +1,3 @@
 #pragma once
 #define PROTOBUF_MAJOR_VERSION 0
-#define PROTOBUF_MINOR_VERSION 2
+#define PROTOBUF_MINOR_VERSION 3
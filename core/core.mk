@@ -6,3 +6,8 @@ C_SOURCES		+= $(wildcard $(CORE_DIR)/*.c)
 C_SOURCES		+= $(wildcard $(CORE_DIR)/furi/*.c)
 C_SOURCES		+= $(wildcard $(CORE_DIR)/furi_hal/*.c)
 CPP_SOURCES		+= $(wildcard $(CORE_DIR)/*.cpp)
+
+FURI_TRACE ?= 0
+ifeq ($(FURI_TRACE), 1)
+CFLAGS			+= -DFURI_TRACE
+endif
@@ -3,5 +3,6 @@
 void furi_init() {
     furi_log_init();
     furi_record_init();
+    furi_pubsub_init();
     furi_stdglue_init();
 }
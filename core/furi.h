@@ -10,10 +10,12 @@
 #include <furi/check.h>
 #include <furi/memmgr.h>
 #include <furi/memmgr_heap.h>
+#include <furi/pool.h>
 #include <furi/pubsub.h>
 #include <furi/record.h>
 #include <furi/stdglue.h>
 #include <furi/thread.h>
+#include <furi/trace.h>
 #include <furi/valuemutex.h>
 #include <furi/log.h>
 
@@ -1,4 +1,5 @@
 #include "check.h"
+#include "log.h"
 #include "furi_hal_task.h"
 #include <furi_hal_console.h>
 #include <furi_hal_rtc.h>
@@ -39,6 +40,9 @@ void furi_crash(const char* message) {
         message = "Fatal Error";
     }
 
+    // Lines queued before the failure explain it
+    furi_log_flush();
+
     furi_hal_console_puts("\r\n\033[0;31m[CRASH]");
     __furi_print_name();
     furi_hal_console_puts(message);
@@ -61,6 +65,8 @@ void furi_halt(const char* message) {
         message = "System halt requested.";
     }
 
+    furi_log_flush();
+
     furi_hal_console_puts("\r\n\033[0;31m[HALT]");
     __furi_print_name();
     furi_hal_console_puts(message);
@@ -2,47 +2,188 @@
 #include "check.h"
 #include <cmsis_os2.h>
 #include <furi_hal.h>
+#include <string.h>
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
+/* Queue length, power of 2 */
+#define FURI_LOG_QUEUE_SIZE 32
+#define FURI_LOG_ENTRY_SIZE 128
+#define FURI_LOG_TEXT_SIZE (FURI_LOG_ENTRY_SIZE - sizeof(uint32_t) * 2)
+#define FURI_LOG_TRUNCATED_MARK "~\r\n"
+#define FURI_LOG_TIMESTAMP_SIZE 16
+
+#define FURI_LOG_THREAD_STACK_SIZE 1024
+#define FURI_LOG_FLAG_PENDING (1 << 0)
+
+_Static_assert(
+    (FURI_LOG_QUEUE_SIZE & (FURI_LOG_QUEUE_SIZE - 1)) == 0,
+    "FURI_LOG_QUEUE_SIZE must be power of 2");
+
+/* Entry is free for writer at position N when sequence == N,
+ * and ready for reader when sequence == N + 1 */
+typedef struct {
+    uint32_t sequence;
+    uint32_t timestamp;
+    char text[FURI_LOG_TEXT_SIZE];
+} FuriLogEntry;
 
 typedef struct {
     FuriLogLevel log_level;
     FuriLogPuts puts;
     FuriLogTimestamp timetamp;
-    osMutexId_t mutex;
+    osThreadId_t thread;
+    bool wakeup_pending;
+
+    uint32_t head;
+    uint32_t tail;
+    FuriLogEntry queue[FURI_LOG_QUEUE_SIZE];
+
+    uint32_t written;
+    uint32_t dropped;
+    uint32_t dropped_reported;
 } FuriLogParams;
 
 static FuriLogParams furi_log;
 
+static bool furi_log_entry_print(void) {
+    FuriLogEntry* entry = &furi_log.queue[furi_log.tail % FURI_LOG_QUEUE_SIZE];
+    if(__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != furi_log.tail + 1) {
+        return false;
+    }
+
+    char timestamp[FURI_LOG_TIMESTAMP_SIZE];
+    snprintf(timestamp, FURI_LOG_TIMESTAMP_SIZE, "%lu ", entry->timestamp);
+    furi_log.puts(timestamp);
+    furi_log.puts(entry->text);
+
+    // Return entry to writers
+    __atomic_store_n(&entry->sequence, furi_log.tail + FURI_LOG_QUEUE_SIZE, __ATOMIC_RELEASE);
+    __atomic_store_n(&furi_log.tail, furi_log.tail + 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+static void furi_log_drain(void) {
+    while(furi_log_entry_print()) {
+        __atomic_add_fetch(&furi_log.written, 1, __ATOMIC_RELAXED);
+    }
+
+    uint32_t dropped = __atomic_load_n(&furi_log.dropped, __ATOMIC_RELAXED);
+    if(dropped != furi_log.dropped_reported) {
+        char line[FURI_LOG_TIMESTAMP_SIZE * 2];
+        snprintf(
+            line,
+            sizeof(line),
+            "[log] %lu dropped\r\n",
+            dropped - furi_log.dropped_reported);
+        furi_log.puts(line);
+        furi_log.dropped_reported = dropped;
+    }
+}
+
+static void furi_log_thread(void* context) {
+    while(1) {
+        osThreadFlagsWait(FURI_LOG_FLAG_PENDING, osFlagsWaitAny, osWaitForever);
+        // Clear before draining, so entry pushed in between wakes us again
+        __atomic_store_n(&furi_log.wakeup_pending, false, __ATOMIC_SEQ_CST);
+        furi_log_drain();
+    }
+}
+
 void furi_log_init() {
     // Set default logging parameters
     furi_log.log_level = FURI_LOG_LEVEL_DEFAULT;
     furi_log.puts = furi_hal_console_puts;
     furi_log.timetamp = HAL_GetTick;
-    furi_log.mutex = osMutexNew(NULL);
+
+    for(uint32_t i = 0; i < FURI_LOG_QUEUE_SIZE; i++) {
+        furi_log.queue[i].sequence = i;
+    }
+
+    const osThreadAttr_t attr = {
+        .name = "LogSrv",
+        .stack_size = FURI_LOG_THREAD_STACK_SIZE,
+        .priority = osPriorityLow,
+    };
+    furi_log.thread = osThreadNew(furi_log_thread, NULL, &attr);
+    furi_check(furi_log.thread);
 }
 
-void furi_log_print(FuriLogLevel level, const char* format, ...) {
-    if(level <= furi_log.log_level && osMutexAcquire(furi_log.mutex, osWaitForever) == osOK) {
-        string_t string;
+static FuriLogEntry* furi_log_entry_acquire(uint32_t* position) {
+    uint32_t head = __atomic_load_n(&furi_log.head, __ATOMIC_RELAXED);
+    while(1) {
+        FuriLogEntry* entry = &furi_log.queue[head % FURI_LOG_QUEUE_SIZE];
+        int32_t diff = (int32_t)(__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) - head);
+        if(diff == 0) {
+            // Entry is free, try to take it before other writers
+            if(__atomic_compare_exchange_n(
+                   &furi_log.head, &head, head + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *position = head;
+                return entry;
+            }
+        } else if(diff < 0) {
+            // Reader is one lap behind
+            return NULL;
+        } else {
+            head = __atomic_load_n(&furi_log.head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void furi_log_vprint(FuriLogLevel level, const char* format, va_list args) {
+    if(level > furi_log.log_level) {
+        return;
+    }
 
-        // Timestamp
-        string_init_printf(string, "%lu ", furi_log.timetamp());
-        furi_log.puts(string_get_cstr(string));
-        string_clear(string);
+    if(osKernelGetState() != osKernelRunning) {
+        // Nobody to drain queue yet, print straight away
+        char line[FURI_LOG_TEXT_SIZE];
+        snprintf(line, FURI_LOG_TEXT_SIZE, "%lu ", furi_log.timetamp());
+        furi_log.puts(line);
+        vsnprintf(line, FURI_LOG_TEXT_SIZE, format, args);
+        furi_log.puts(line);
+        return;
+    }
 
-        va_list args;
-        va_start(args, format);
-        string_init_vprintf(string, format, args);
-        va_end(args);
+    uint32_t position;
+    FuriLogEntry* entry = furi_log_entry_acquire(&position);
+    if(!entry) {
+        __atomic_add_fetch(&furi_log.dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
 
-        furi_log.puts(string_get_cstr(string));
-        string_clear(string);
+    entry->timestamp = furi_log.timetamp();
+    int length = vsnprintf(entry->text, FURI_LOG_TEXT_SIZE, format, args);
+    if(length >= (int)FURI_LOG_TEXT_SIZE) {
+        strcpy(
+            &entry->text[FURI_LOG_TEXT_SIZE - sizeof(FURI_LOG_TRUNCATED_MARK)],
+            FURI_LOG_TRUNCATED_MARK);
+    }
+    __atomic_store_n(&entry->sequence, position + 1, __ATOMIC_RELEASE);
 
-        osMutexRelease(furi_log.mutex);
+    if(!__atomic_exchange_n(&furi_log.wakeup_pending, true, __ATOMIC_SEQ_CST)) {
+        osThreadFlagsSet(furi_log.thread, FURI_LOG_FLAG_PENDING);
     }
 }
 
+void furi_log_print(FuriLogLevel level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    furi_log_vprint(level, format, args);
+    va_end(args);
+}
+
+void furi_log_flush() {
+    furi_log_drain();
+}
+
+void furi_log_get_stats(FuriLogStats* stats) {
+    furi_assert(stats);
+    stats->written = __atomic_load_n(&furi_log.written, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&furi_log.dropped, __ATOMIC_RELAXED);
+    stats->pending = __atomic_load_n(&furi_log.head, __ATOMIC_RELAXED) -
+                     __atomic_load_n(&furi_log.tail, __ATOMIC_RELAXED);
+}
+
 void furi_log_set_level(FuriLogLevel level) {
     if(level == FuriLogLevelDefault) {
         level = FURI_LOG_LEVEL_DEFAULT;
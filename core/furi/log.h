@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdarg.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,8 +38,28 @@ typedef enum {
 typedef void (*FuriLogPuts)(const char* data);
 typedef uint32_t (*FuriLogTimestamp)(void);
 
+typedef struct {
+    uint32_t written; /**< lines printed */
+    uint32_t dropped; /**< lines lost because queue was full */
+    uint32_t pending; /**< lines waiting in queue */
+} FuriLogStats;
+
 void furi_log_init();
+
+/** Print log line
+ *
+ * Line is formatted into lock-free queue and printed later by low priority
+ * log thread, caller never waits for output or other callers. Safe to use
+ * from interrupts as long as format has no floating point conversions.
+ * Lines longer than queue entry are truncated, lines which don't fit into
+ * queue are dropped and counted.
+ */
 void furi_log_print(FuriLogLevel level, const char* format, ...);
+
+/** Print queued lines from caller context, used before crash */
+void furi_log_flush();
+
+void furi_log_get_stats(FuriLogStats* stats);
 void furi_log_set_level(FuriLogLevel level);
 FuriLogLevel furi_log_get_level();
 void furi_log_set_puts(FuriLogPuts puts);
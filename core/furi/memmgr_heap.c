@@ -37,6 +37,7 @@
 #include "memmgr_heap.h"
 #include "check.h"
 #include <stdlib.h>
+#include <string.h>
 #include <cmsis_os2.h>
 #include <stm32wbxx.h>
 #include <furi_hal_console.h>
@@ -113,36 +114,93 @@ space. */
 static size_t xBlockAllocatedBit = 0;
 
 /* Furi heap extension */
-#include <m-dict.h>
-
-/* Allocation tracking types */
-DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t)
-DICT_DEF2(
-    MemmgrHeapThreadDict,
-    uint32_t,
-    M_DEFAULT_OPLIST,
-    MemmgrHeapAllocDict_t,
-    DICT_OPLIST(MemmgrHeapAllocDict))
-
-/* Thread allocation tracing storage */
-static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
-static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
-
-/* Initialize tracing storage on start */
-void memmgr_heap_init() {
-    MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+
+/* Allocated blocks of traced threads carry trace slot number in the otherwise
+unused high bits of xBlockSize, so free can be accounted to the owner without
+any lookup structure. Slot 0 means that block is not traced. */
+#define MEMMGR_HEAP_TRACE_TAG_SHIFT (27U)
+#define MEMMGR_HEAP_TRACE_TAG_MASK ((size_t)0xF << MEMMGR_HEAP_TRACE_TAG_SHIFT)
+#define MEMMGR_HEAP_TRACE_EVENTS_MASK (MEMMGR_HEAP_TRACE_EVENTS_COUNT - 1)
+
+#if(MEMMGR_HEAP_THREAD_TRACE_MAX > 15)
+#error MEMMGR_HEAP_THREAD_TRACE_MAX must fit into trace tag
+#endif
+
+#if((MEMMGR_HEAP_TRACE_EVENTS_COUNT & MEMMGR_HEAP_TRACE_EVENTS_MASK) != 0)
+#error MEMMGR_HEAP_TRACE_EVENTS_COUNT must be power of 2
+#endif
+
+typedef struct {
+    osThreadId_t thread_id;
+    MemmgrHeapThreadStats stats;
+} MemmgrHeapThreadTrace;
+
+/* Packed trace event: size in lower 24 bits, slot and type in upper byte */
+typedef struct {
+    uint32_t tick;
+    uint32_t pointer;
+    uint32_t size_slot_type;
+} MemmgrHeapTraceRecord;
+
+/* Thread allocation tracing storage, fixed size and never allocated */
+static MemmgrHeapThreadTrace memmgr_heap_thread_trace[MEMMGR_HEAP_THREAD_TRACE_MAX] = {0};
+static MemmgrHeapTraceRecord memmgr_heap_trace_ring[MEMMGR_HEAP_TRACE_EVENTS_COUNT] = {0};
+static volatile uint32_t memmgr_heap_trace_ring_head = 0;
+static volatile uint32_t memmgr_heap_alloc_count = 0;
+
+static inline size_t memmgr_heap_size_class(size_t size) {
+    size_t size_class = 0;
+    if(size > MEMMGR_HEAP_SIZE_CLASS_MIN) {
+        size_class = __builtin_clz(MEMMGR_HEAP_SIZE_CLASS_MIN - 1) - __builtin_clz(size - 1);
+    }
+    if(size_class >= MEMMGR_HEAP_SIZE_CLASS_COUNT) {
+        size_class = MEMMGR_HEAP_SIZE_CLASS_COUNT - 1;
+    }
+    return size_class;
+}
+
+static inline size_t memmgr_heap_find_thread_slot(osThreadId_t thread_id) {
+    for(size_t i = 0; i < MEMMGR_HEAP_THREAD_TRACE_MAX; i++) {
+        if(memmgr_heap_thread_trace[i].thread_id == thread_id) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/* Must be called with scheduler suspended: there is only one writer at a time,
+readers are never blocking and detect overwritten events by head position */
+static inline void memmgr_heap_trace_push(
+    void* pointer,
+    size_t size,
+    size_t slot,
+    MemmgrHeapTraceEventType type) {
+    uint32_t head = memmgr_heap_trace_ring_head;
+    MemmgrHeapTraceRecord* record = &memmgr_heap_trace_ring[head & MEMMGR_HEAP_TRACE_EVENTS_MASK];
+    record->tick = xTaskGetTickCount();
+    record->pointer = (uint32_t)pointer;
+    record->size_slot_type = (size & 0xFFFFFF) | (slot << 24) | ((uint32_t)type << 28);
+    __DMB();
+    memmgr_heap_trace_ring_head = head + 1;
 }
 
 void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
-        MemmgrHeapAllocDict_t alloc_dict;
-        MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
-        MemmgrHeapAllocDict_clear(alloc_dict);
-        memmgr_heap_thread_trace_depth--;
+        furi_check(memmgr_heap_find_thread_slot(thread_id) == 0);
+        /* Prefer slot without live allocations: frees of leaked blocks are
+        still accounted to the slot they were allocated from */
+        MemmgrHeapThreadTrace* trace = NULL;
+        for(size_t i = 0; i < MEMMGR_HEAP_THREAD_TRACE_MAX; i++) {
+            MemmgrHeapThreadTrace* candidate = &memmgr_heap_thread_trace[i];
+            if(candidate->thread_id != NULL) continue;
+            if(trace == NULL || candidate->stats.live < trace->stats.live) {
+                trace = candidate;
+            }
+        }
+        furi_check(trace);
+        memset(&trace->stats, 0, sizeof(MemmgrHeapThreadStats));
+        trace->thread_id = thread_id;
     }
     (void)xTaskResumeAll();
 }
@@ -150,62 +208,123 @@ void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
 void memmgr_heap_disable_thread_trace(osThreadId_t thread_id) {
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) != NULL);
-        MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        memmgr_heap_thread_trace_depth--;
+        size_t slot = memmgr_heap_find_thread_slot(thread_id);
+        furi_check(slot);
+        memmgr_heap_thread_trace[slot - 1].thread_id = NULL;
     }
     (void)xTaskResumeAll();
 }
 
 size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id) {
-    size_t leftovers = MEMMGR_HEAP_UNKNOWN;
+    MemmgrHeapThreadStats stats;
+    if(memmgr_heap_get_thread_stats(thread_id, &stats)) {
+        return stats.live;
+    } else {
+        return MEMMGR_HEAP_UNKNOWN;
+    }
+}
+
+bool memmgr_heap_get_thread_stats(osThreadId_t thread_id, MemmgrHeapThreadStats* stats) {
+    furi_assert(stats);
+    bool result = false;
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            leftovers = 0;
-            MemmgrHeapAllocDict_it_t alloc_dict_it;
-            for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
-                !MemmgrHeapAllocDict_end_p(alloc_dict_it);
-                MemmgrHeapAllocDict_next(alloc_dict_it)) {
-                MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
-                leftovers += data->value;
-            }
+        size_t slot = thread_id ? memmgr_heap_find_thread_slot(thread_id) : 0;
+        if(slot) {
+            *stats = memmgr_heap_thread_trace[slot - 1].stats;
+            result = true;
         }
-        memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
-    return leftovers;
+    return result;
+}
+
+uint32_t memmgr_heap_get_alloc_count() {
+    return memmgr_heap_alloc_count;
+}
+
+size_t memmgr_heap_get_size_class_limit(size_t size_class) {
+    furi_assert(size_class < MEMMGR_HEAP_SIZE_CLASS_COUNT);
+    if(size_class == MEMMGR_HEAP_SIZE_CLASS_COUNT - 1) {
+        return SIZE_MAX;
+    } else {
+        return MEMMGR_HEAP_SIZE_CLASS_MIN << size_class;
+    }
+}
+
+size_t memmgr_heap_trace_read_events(
+    uint32_t* cursor,
+    MemmgrHeapTraceEvent* events,
+    size_t events_count,
+    uint32_t* dropped) {
+    furi_assert(cursor);
+    furi_assert(events);
+
+    uint32_t head = memmgr_heap_trace_ring_head;
+    __DMB();
+    uint32_t lost = 0;
+    if(head - *cursor > MEMMGR_HEAP_TRACE_EVENTS_COUNT) {
+        lost = head - *cursor - MEMMGR_HEAP_TRACE_EVENTS_COUNT;
+        *cursor = head - MEMMGR_HEAP_TRACE_EVENTS_COUNT;
+    }
+
+    size_t read = 0;
+    while(read < events_count && *cursor != head) {
+        MemmgrHeapTraceRecord record =
+            memmgr_heap_trace_ring[*cursor & MEMMGR_HEAP_TRACE_EVENTS_MASK];
+        __DMB();
+        // Writer may have lapped us while we were copying
+        if(memmgr_heap_trace_ring_head - *cursor > MEMMGR_HEAP_TRACE_EVENTS_COUNT) {
+            uint32_t new_head = memmgr_heap_trace_ring_head;
+            lost += new_head - *cursor - MEMMGR_HEAP_TRACE_EVENTS_COUNT;
+            *cursor = new_head - MEMMGR_HEAP_TRACE_EVENTS_COUNT;
+            head = new_head;
+            continue;
+        }
+
+        size_t slot = (record.size_slot_type >> 24) & 0xF;
+        events[read].tick = record.tick;
+        events[read].pointer = record.pointer;
+        events[read].size = record.size_slot_type & 0xFFFFFF;
+        events[read].type = (record.size_slot_type >> 28) & 0x1;
+        events[read].thread_id = memmgr_heap_thread_trace[slot - 1].thread_id;
+        read++;
+        (*cursor)++;
+    }
+
+    if(dropped) *dropped = lost;
+    return read;
 }
 
 #undef traceMALLOC
-static inline void traceMALLOC(void* pointer, size_t size) {
+static inline void traceMALLOC(BlockLink_t* block) {
     osThreadId_t thread_id = osThreadGetId();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
-        }
-        memmgr_heap_thread_trace_depth--;
+    if(!thread_id) return;
+
+    size_t slot = memmgr_heap_find_thread_slot(thread_id);
+    if(slot) {
+        // Payload only: block header is not part of what thread asked for
+        size_t size = (block->xBlockSize & ~(xBlockAllocatedBit | MEMMGR_HEAP_TRACE_TAG_MASK)) -
+                      xHeapStructSize;
+        MemmgrHeapThreadStats* stats = &memmgr_heap_thread_trace[slot - 1].stats;
+        stats->live += size;
+        if(stats->live > stats->peak) stats->peak = stats->live;
+        stats->alloc_count++;
+        stats->size_histogram[memmgr_heap_size_class(size)]++;
+        block->xBlockSize |= slot << MEMMGR_HEAP_TRACE_TAG_SHIFT;
+        memmgr_heap_trace_push(
+            ((uint8_t*)block) + xHeapStructSize, size, slot, MemmgrHeapTraceEventTypeAlloc);
     }
 }
 
 #undef traceFREE
-static inline void traceFREE(void* pointer, size_t size) {
-    osThreadId_t thread_id = osThreadGetId();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
-        }
-        memmgr_heap_thread_trace_depth--;
+static inline void traceFREE(void* pointer, size_t size, size_t slot) {
+    if(slot) {
+        MemmgrHeapThreadStats* stats = &memmgr_heap_thread_trace[slot - 1].stats;
+        // Slot may be reused by another thread after owner disabled tracing
+        stats->live = (stats->live > size) ? (stats->live - size) : 0;
+        stats->free_count++;
+        memmgr_heap_trace_push(pointer, size, slot, MemmgrHeapTraceEventTypeFree);
     }
 }
 
@@ -345,7 +464,6 @@ void* pvPortMalloc(size_t xWantedSize) {
         vTaskSuspendAll();
         {
             prvHeapInit();
-            memmgr_heap_init();
         }
         (void)xTaskResumeAll();
     } else {
@@ -433,6 +551,9 @@ void* pvPortMalloc(size_t xWantedSize) {
                     pxBlock->xBlockSize |= xBlockAllocatedBit;
                     pxBlock->pxNextFreeBlock = NULL;
 
+                    memmgr_heap_alloc_count++;
+                    traceMALLOC(pxBlock);
+
 #ifdef HEAP_PRINT_DEBUG
                     print_heap_block = pxBlock;
 #endif
@@ -445,13 +566,13 @@ void* pvPortMalloc(size_t xWantedSize) {
         } else {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        traceMALLOC(pvReturn, xWantedSize);
     }
     (void)xTaskResumeAll();
 
 #ifdef HEAP_PRINT_DEBUG
-    print_heap_malloc(print_heap_block, print_heap_block->xBlockSize & ~xBlockAllocatedBit);
+    print_heap_malloc(
+        print_heap_block,
+        print_heap_block->xBlockSize & ~(xBlockAllocatedBit | MEMMGR_HEAP_TRACE_TAG_MASK));
 #endif
 
 #if(configUSE_MALLOC_FAILED_HOOK == 1)
@@ -476,6 +597,7 @@ void* pvPortMalloc(size_t xWantedSize) {
 void vPortFree(void* pv) {
     uint8_t* puc = (uint8_t*)pv;
     BlockLink_t* pxLink;
+    size_t trace_slot;
 
     if(pv != NULL) {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -494,6 +616,9 @@ void vPortFree(void* pv) {
                 /* The block is being returned to the heap - it is no longer
                 allocated. */
                 pxLink->xBlockSize &= ~xBlockAllocatedBit;
+                trace_slot = (pxLink->xBlockSize & MEMMGR_HEAP_TRACE_TAG_MASK) >>
+                             MEMMGR_HEAP_TRACE_TAG_SHIFT;
+                pxLink->xBlockSize &= ~MEMMGR_HEAP_TRACE_TAG_MASK;
 
 #ifdef HEAP_PRINT_DEBUG
                 print_heap_free(pxLink);
@@ -508,7 +633,7 @@ void vPortFree(void* pv) {
 
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE(pv, pxLink->xBlockSize);
+                    traceFREE(pv, pxLink->xBlockSize - xHeapStructSize, trace_slot);
                     memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
                     prvInsertBlockIntoFreeList(((BlockLink_t*)pxLink));
                 }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <cmsis_os2.h>
 
 #ifdef __cplusplus
@@ -14,13 +16,51 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Maximum amount of simultaneously traced threads */
+#define MEMMGR_HEAP_THREAD_TRACE_MAX 15
+
+/** Allocation size histogram: power of 2 classes starting from MIN, last one is unbounded */
+#define MEMMGR_HEAP_SIZE_CLASS_MIN 16
+#define MEMMGR_HEAP_SIZE_CLASS_COUNT 8
+
+/** Allocation event ring size, must be power of 2 */
+#define MEMMGR_HEAP_TRACE_EVENTS_COUNT 128
+
+/** Per thread allocation statistics, sizes are block payload: header excluded,
+ * alignment padding included */
+typedef struct {
+    size_t live; /**< bytes allocated right now */
+    size_t peak; /**< maximum of live bytes since tracing started */
+    uint32_t alloc_count; /**< total amount of allocations */
+    uint32_t free_count; /**< total amount of frees */
+    uint32_t size_histogram[MEMMGR_HEAP_SIZE_CLASS_COUNT]; /**< allocations per size class */
+} MemmgrHeapThreadStats;
+
+typedef enum {
+    MemmgrHeapTraceEventTypeAlloc,
+    MemmgrHeapTraceEventTypeFree,
+} MemmgrHeapTraceEventType;
+
+/** Allocation event of traced thread */
+typedef struct {
+    uint32_t tick; /**< system tick when event happened */
+    uint32_t pointer; /**< allocated or freed pointer */
+    uint32_t size; /**< heap block payload size */
+    osThreadId_t thread_id; /**< owner thread, NULL if it is not traced anymore */
+    MemmgrHeapTraceEventType type;
+} MemmgrHeapTraceEvent;
+
 /** Memmgr heap enable thread allocation tracking
+ *
+ * Crashes if thread is already traced or all MEMMGR_HEAP_THREAD_TRACE_MAX slots are taken
  *
  * @param      thread_id  - thread id to track
  */
 void memmgr_heap_enable_thread_trace(osThreadId_t thread_id);
 
 /** Memmgr heap disable thread allocation tracking
+ *
+ * Crashes if thread is not traced
  *
  * @param      thread_id  - thread id to track
  */
@@ -34,6 +74,47 @@ void memmgr_heap_disable_thread_trace(osThreadId_t thread_id);
  */
 size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id);
 
+/** Memmgr heap get allocation statistics of traced thread
+ *
+ * @param      thread_id  - thread id to track
+ * @param      stats      - pointer to MemmgrHeapThreadStats to fill
+ *
+ * @return     true if thread is traced and stats are filled
+ */
+bool memmgr_heap_get_thread_stats(osThreadId_t thread_id, MemmgrHeapThreadStats* stats);
+
+/** Memmgr heap get total amount of allocations since boot
+ *
+ * @return     allocations count, wraps around
+ */
+uint32_t memmgr_heap_get_alloc_count();
+
+/** Memmgr heap get upper bound of size histogram class
+ *
+ * @param      size_class  - size class index, less than MEMMGR_HEAP_SIZE_CLASS_COUNT
+ *
+ * @return     maximum block size in class, SIZE_MAX for the last one
+ */
+size_t memmgr_heap_get_size_class_limit(size_t size_class);
+
+/** Memmgr heap read allocation events of traced threads
+ *
+ * Lock free, never blocks allocations. Events overwritten by writer before
+ * they were read are skipped and reported in dropped.
+ *
+ * @param      cursor        - reader position, initialize with 0
+ * @param      events        - output events array
+ * @param      events_count  - output events array size
+ * @param      dropped       - amount of lost events, can be NULL
+ *
+ * @return     amount of events read
+ */
+size_t memmgr_heap_trace_read_events(
+    uint32_t* cursor,
+    MemmgrHeapTraceEvent* events,
+    size_t events_count,
+    uint32_t* dropped);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
@@ -0,0 +1,132 @@
+#include "pool.h"
+#include "memmgr.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <stm32wbxx.h>
+
+#define FURI_POOL_ALIGNMENT (8U)
+
+struct FuriPool {
+    FuriPool* next;
+    FuriPoolStats stats;
+    uint8_t* storage;
+    uint16_t* free_stack;
+    size_t free_count;
+};
+
+static FuriPool* furi_pool_list = NULL;
+
+FuriPool* furi_pool_alloc(const char* name, size_t block_size, size_t capacity) {
+    furi_assert(block_size);
+    furi_assert(capacity && capacity <= UINT16_MAX);
+
+    FuriPool* pool = malloc(sizeof(FuriPool));
+    pool->stats.name = name;
+    pool->stats.block_size =
+        (block_size + FURI_POOL_ALIGNMENT - 1) & ~(size_t)(FURI_POOL_ALIGNMENT - 1);
+    pool->stats.capacity = capacity;
+
+    pool->storage = malloc(pool->stats.block_size * capacity);
+    pool->free_stack = malloc(sizeof(uint16_t) * capacity);
+    for(size_t i = 0; i < capacity; i++) {
+        pool->free_stack[i] = capacity - i - 1;
+    }
+    pool->free_count = capacity;
+
+    FURI_CRITICAL_ENTER();
+    pool->next = furi_pool_list;
+    furi_pool_list = pool;
+    FURI_CRITICAL_EXIT();
+
+    return pool;
+}
+
+void furi_pool_free(FuriPool* pool) {
+    furi_assert(pool);
+    furi_check(pool->stats.used == 0);
+
+    FURI_CRITICAL_ENTER();
+    FuriPool** item = &furi_pool_list;
+    while(*item != pool) {
+        furi_check(*item);
+        item = &(*item)->next;
+    }
+    *item = pool->next;
+    FURI_CRITICAL_EXIT();
+
+    free(pool->free_stack);
+    free(pool->storage);
+    free(pool);
+}
+
+void* furi_pool_acquire(FuriPool* pool) {
+    furi_assert(pool);
+    void* block = NULL;
+
+    FURI_CRITICAL_ENTER();
+    if(pool->free_count) {
+        pool->free_count--;
+        block = pool->storage + pool->free_stack[pool->free_count] * pool->stats.block_size;
+        pool->stats.used++;
+        if(pool->stats.used > pool->stats.peak) pool->stats.peak = pool->stats.used;
+        pool->stats.hits++;
+    } else {
+        pool->stats.misses++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!block) {
+        block = malloc(pool->stats.block_size);
+    }
+
+    return block;
+}
+
+void furi_pool_release(FuriPool* pool, void* block) {
+    furi_assert(pool);
+    furi_assert(block);
+
+    if(furi_pool_contains(pool, block)) {
+        size_t index = ((uint8_t*)block - pool->storage) / pool->stats.block_size;
+        furi_assert(((uint8_t*)block - pool->storage) % pool->stats.block_size == 0);
+
+        FURI_CRITICAL_ENTER();
+        furi_assert(pool->free_count < pool->stats.capacity);
+        pool->free_stack[pool->free_count] = index;
+        pool->free_count++;
+        pool->stats.used--;
+        FURI_CRITICAL_EXIT();
+    } else {
+        free(block);
+    }
+}
+
+bool furi_pool_contains(FuriPool* pool, const void* block) {
+    furi_assert(pool);
+    const uint8_t* storage_end = pool->storage + pool->stats.block_size * pool->stats.capacity;
+    return ((const uint8_t*)block >= pool->storage) && ((const uint8_t*)block < storage_end);
+}
+
+void furi_pool_get_stats(FuriPool* pool, FuriPoolStats* stats) {
+    furi_assert(pool);
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = pool->stats;
+    FURI_CRITICAL_EXIT();
+}
+
+size_t furi_pool_get_stats_all(FuriPoolStats* stats, size_t stats_count) {
+    furi_assert(stats);
+    size_t count = 0;
+
+    FURI_CRITICAL_ENTER();
+    for(FuriPool* pool = furi_pool_list; pool && count < stats_count; pool = pool->next) {
+        stats[count] = pool->stats;
+        count++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return count;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file pool.h
+ * Furi: fixed block object pool
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** FuriPool type */
+typedef struct FuriPool FuriPool;
+
+/** FuriPool statistics */
+typedef struct {
+    const char* name; /**< pool name */
+    size_t block_size; /**< block size in bytes */
+    size_t capacity; /**< amount of blocks in pool */
+    size_t used; /**< blocks taken from pool right now */
+    size_t peak; /**< maximum of used blocks */
+    uint32_t hits; /**< acquires served from pool */
+    uint32_t misses; /**< acquires served from heap because pool was exhausted */
+} FuriPoolStats;
+
+/** Allocate FuriPool
+ *
+ * All blocks are allocated at once and zeroed. Block content is preserved
+ * between release and next acquire, so blocks can hold reusable objects.
+ *
+ * @param      name        pool name, must be valid while pool exists
+ * @param      block_size  block size in bytes
+ * @param      capacity    amount of blocks
+ *
+ * @return     pointer to FuriPool instance
+ */
+FuriPool* furi_pool_alloc(const char* name, size_t block_size, size_t capacity);
+
+/** Allocate FuriPool of blocks fitting given type */
+#define furi_pool_alloc_typed(name, type, capacity) furi_pool_alloc(name, sizeof(type), capacity)
+
+/** Free FuriPool
+ *
+ * All blocks must be released before call
+ *
+ * @param      pool  FuriPool instance
+ */
+void furi_pool_free(FuriPool* pool);
+
+/** Acquire block from FuriPool
+ *
+ * Threadsafe, ISR safe when pool is not exhausted.
+ * If pool is exhausted zeroed block is allocated from heap.
+ *
+ * @param      pool  FuriPool instance
+ *
+ * @return     pointer to block
+ */
+void* furi_pool_acquire(FuriPool* pool);
+
+/** Release block to FuriPool
+ *
+ * Threadsafe. Blocks allocated from heap are freed.
+ *
+ * @param      pool   FuriPool instance
+ * @param      block  block acquired from this pool
+ */
+void furi_pool_release(FuriPool* pool, void* block);
+
+/** Check if block belongs to FuriPool storage
+ *
+ * @param      pool   FuriPool instance
+ * @param      block  block acquired from this pool
+ *
+ * @return     true if block is pool block, false if it came from heap
+ */
+bool furi_pool_contains(FuriPool* pool, const void* block);
+
+/** Get FuriPool statistics
+ *
+ * @param      pool   FuriPool instance
+ * @param      stats  pointer to FuriPoolStats to fill
+ */
+void furi_pool_get_stats(FuriPool* pool, FuriPoolStats* stats);
+
+/** Get statistics of all existing pools
+ *
+ * @param      stats        output array
+ * @param      stats_count  output array size
+ *
+ * @return     amount of pools written to stats
+ */
+size_t furi_pool_get_stats_all(FuriPoolStats* stats, size_t stats_count);
+
+#ifdef __cplusplus
+}
+#endif
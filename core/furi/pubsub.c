@@ -1,55 +1,116 @@
 #include "pubsub.h"
 #include "memmgr.h"
 #include "check.h"
+#include "pool.h"
 
-#include <m-list.h>
 #include <cmsis_os2.h>
+#include <string.h>
+
+#define FURI_PUBSUB_SUBSCRIPTION_POOL_SIZE 48
+#define FURI_PUBSUB_SNAPSHOT_GROW_STEP 8
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
 };
 
-LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
+typedef struct {
+    size_t count;
+    size_t capacity;
+    FuriPubSubSubscription** items;
+} FuriPubSubSnapshot;
 
+/* Publishers read current snapshot without locking. Writers prepare the
+ * other snapshot, switch to it and wait until publishers leave the old one,
+ * so subscription is not used after unsubscribe returns. */
 struct FuriPubSub {
-    FuriPubSubSubscriptionList_t items;
+    FuriPubSubSnapshot snapshots[2];
+    uint32_t readers[2];
+    uint32_t current;
     osMutexId_t mutex;
 };
 
+/* Subscriptions of all pubsubs share one pool */
+static FuriPool* furi_pubsub_subscription_pool = NULL;
+
+void furi_pubsub_init() {
+    furi_assert(furi_pubsub_subscription_pool == NULL);
+    furi_pubsub_subscription_pool = furi_pool_alloc_typed(
+        "pubsub", FuriPubSubSubscription, FURI_PUBSUB_SUBSCRIPTION_POOL_SIZE);
+}
+
 FuriPubSub* furi_pubsub_alloc() {
     FuriPubSub* pubsub = malloc(sizeof(FuriPubSub));
 
     pubsub->mutex = osMutexNew(NULL);
     furi_assert(pubsub->mutex);
 
-    FuriPubSubSubscriptionList_init(pubsub->items);
-
     return pubsub;
 }
 
 void furi_pubsub_free(FuriPubSub* pubsub) {
     furi_assert(pubsub);
 
-    furi_check(FuriPubSubSubscriptionList_size(pubsub->items) == 0);
-
-    FuriPubSubSubscriptionList_clear(pubsub->items);
+    furi_check(pubsub->snapshots[pubsub->current].count == 0);
 
     furi_check(osMutexDelete(pubsub->mutex) == osOK);
 
+    free(pubsub->snapshots[0].items);
+    free(pubsub->snapshots[1].items);
     free(pubsub);
 }
 
+static void furi_pubsub_wait_readers(FuriPubSub* pubsub, uint32_t index) {
+    while(__atomic_load_n(&pubsub->readers[index], __ATOMIC_SEQ_CST)) {
+        osDelay(1);
+    }
+}
+
+/* Called with mutex taken, returns snapshot to be modified with room for
+ * at least `capacity` subscriptions */
+static FuriPubSubSnapshot* furi_pubsub_update_begin(FuriPubSub* pubsub, size_t capacity) {
+    uint32_t current = pubsub->current;
+    uint32_t next = current ^ 1;
+    // Publishers which failed to enter it may still count on it
+    furi_pubsub_wait_readers(pubsub, next);
+    FuriPubSubSnapshot* snapshot = &pubsub->snapshots[next];
+    // Nobody reads this snapshot, so its storage can be moved
+    if(snapshot->capacity < capacity) {
+        snapshot->capacity = capacity + FURI_PUBSUB_SNAPSHOT_GROW_STEP;
+        snapshot->items =
+            realloc(snapshot->items, snapshot->capacity * sizeof(*snapshot->items));
+    }
+    snapshot->count = pubsub->snapshots[current].count;
+    memcpy(
+        snapshot->items,
+        pubsub->snapshots[current].items,
+        snapshot->count * sizeof(*snapshot->items));
+    return snapshot;
+}
+
+static void furi_pubsub_update_end(FuriPubSub* pubsub) {
+    uint32_t previous = pubsub->current;
+    __atomic_store_n(&pubsub->current, previous ^ 1, __ATOMIC_SEQ_CST);
+    furi_pubsub_wait_readers(pubsub, previous);
+}
+
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context) {
-    furi_check(osMutexAcquire(pubsub->mutex, osWaitForever) == osOK);
-    // put uninitialized item to the list
-    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
+    furi_assert(furi_pubsub_subscription_pool);
+    FuriPubSubSubscription* item = furi_pool_acquire(furi_pubsub_subscription_pool);
 
     // initialize item
     item->callback = callback;
     item->callback_context = callback_context;
 
+    // put item to the array head, so newest subscriber is called first
+    furi_check(osMutexAcquire(pubsub->mutex, osWaitForever) == osOK);
+    FuriPubSubSnapshot* snapshot =
+        furi_pubsub_update_begin(pubsub, pubsub->snapshots[pubsub->current].count + 1);
+    memmove(&snapshot->items[1], &snapshot->items[0], snapshot->count * sizeof(item));
+    snapshot->items[0] = item;
+    snapshot->count++;
+    furi_pubsub_update_end(pubsub);
     furi_check(osMutexRelease(pubsub->mutex) == osOK);
 
     return item;
@@ -62,34 +123,71 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
     furi_check(osMutexAcquire(pubsub->mutex, osWaitForever) == osOK);
     bool result = false;
 
-    // iterate over items
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-
-        // if the iterator is equal to our element
-        if(item == pubsub_subscription) {
-            FuriPubSubSubscriptionList_remove(pubsub->items, it);
+    FuriPubSubSnapshot* snapshot =
+        furi_pubsub_update_begin(pubsub, pubsub->snapshots[pubsub->current].count);
+    for(size_t i = 0; i < snapshot->count; i++) {
+        if(snapshot->items[i] == pubsub_subscription) {
+            snapshot->count--;
+            memmove(
+                &snapshot->items[i],
+                &snapshot->items[i + 1],
+                (snapshot->count - i) * sizeof(pubsub_subscription));
             result = true;
             break;
         }
     }
+    // Nobody uses subscription after this point
+    furi_pubsub_update_end(pubsub);
 
     furi_check(osMutexRelease(pubsub->mutex) == osOK);
     furi_check(result);
+
+    furi_pool_release(furi_pubsub_subscription_pool, pubsub_subscription);
+}
+
+static const FuriPubSubSnapshot* furi_pubsub_read_begin(FuriPubSub* pubsub, uint32_t* index) {
+    while(1) {
+        *index = __atomic_load_n(&pubsub->current, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&pubsub->readers[*index], 1, __ATOMIC_SEQ_CST);
+        // Writer could switch snapshot before we were counted
+        if(__atomic_load_n(&pubsub->current, __ATOMIC_SEQ_CST) == *index) {
+            return &pubsub->snapshots[*index];
+        }
+        __atomic_sub_fetch(&pubsub->readers[*index], 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+static void furi_pubsub_read_end(FuriPubSub* pubsub, uint32_t index) {
+    __atomic_sub_fetch(&pubsub->readers[index], 1, __ATOMIC_SEQ_CST);
 }
 
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
-    furi_check(osMutexAcquire(pubsub->mutex, osWaitForever) == osOK);
+    uint32_t index;
+    const FuriPubSubSnapshot* snapshot = furi_pubsub_read_begin(pubsub, &index);
 
     // iterate over subscribers
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-        item->callback(message, item->callback_context);
+    for(size_t i = 0; i < snapshot->count; i++) {
+        snapshot->items[i]->callback(message, snapshot->items[i]->callback_context);
     }
 
-    furi_check(osMutexRelease(pubsub->mutex) == osOK);
+    furi_pubsub_read_end(pubsub, index);
+}
+
+void furi_pubsub_publish_batch(
+    FuriPubSub* pubsub,
+    void* messages,
+    size_t message_size,
+    size_t count) {
+    uint32_t index;
+    const FuriPubSubSnapshot* snapshot = furi_pubsub_read_begin(pubsub, &index);
+
+    uint8_t* message = messages;
+    for(size_t j = 0; j < count; j++) {
+        for(size_t i = 0; i < snapshot->count; i++) {
+            snapshot->items[i]->callback(message, snapshot->items[i]->callback_context);
+        }
+        message += message_size;
+    }
+
+    furi_pubsub_read_end(pubsub, index);
 }
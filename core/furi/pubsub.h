@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -13,6 +15,12 @@ typedef struct FuriPubSub FuriPubSub;
 /** FuriPubSubSubscription type */
 typedef struct FuriPubSubSubscription FuriPubSubSubscription;
 
+/** Initialize FuriPubSub subscription storage
+ *
+ * Must be called once on system start
+ */
+void furi_pubsub_init();
+
 /** Allocate FuriPubSub
  *
  * Reentrable, Not threadsafe, one owner
@@ -29,7 +37,9 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 
 /** Subscribe to FuriPubSub
  * 
- * Threadsafe, Reentrable
+ * Threadsafe, Reentrable. Waits until running publishers are done,
+ * must not be called from subscription callback. Amount of subscribers
+ * is not limited, subscriber storage grows on demand.
  * 
  * @param      pubsub            pointer to FuriPubSub instance
  * @param[in]  callback          The callback
@@ -43,7 +53,8 @@ FuriPubSubSubscription*
 /** Unsubscribe from FuriPubSub
  * 
  * No use of `pubsub_subscription` allowed after call of this method
- * Threadsafe, Reentrable.
+ * Threadsafe, Reentrable. Returns when callback is not running anymore,
+ * must not be called from subscription callback.
  *
  * @param      pubsub               pointer to FuriPubSub instance
  * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
@@ -52,13 +63,30 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
 /** Publish message to FuriPubSub
  *
- * Threadsafe, Reentrable.
+ * Threadsafe, Reentrable. Lock-free, publishers never wait for each other
+ * or for subscribe and unsubscribe.
  * 
  * @param      pubsub   pointer to FuriPubSub instance
  * @param      message  message pointer to publish
  */
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message);
 
+/** Publish array of messages to FuriPubSub
+ *
+ * Same as publishing messages one by one, but subscribers are looked up
+ * once. Use for high rate topics.
+ *
+ * @param      pubsub        pointer to FuriPubSub instance
+ * @param      messages      pointer to first message
+ * @param      message_size  size of one message
+ * @param      count         amount of messages
+ */
+void furi_pubsub_publish_batch(
+    FuriPubSub* pubsub,
+    void* messages,
+    size_t message_size,
+    size_t count);
+
 #ifdef __cplusplus
 }
 #endif
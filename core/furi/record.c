@@ -3,22 +3,31 @@
 #include "memmgr.h"
 
 #include <cmsis_os2.h>
-#include <m-string.h>
-#include <m-dict.h>
+#include <string.h>
+#include <fnv1a-hash.h>
 
 #define FURI_RECORD_FLAG_READY (0x1)
-
-typedef struct {
+/* Hash table size, power of 2 */
+#define FURI_RECORD_TABLE_SIZE 64
+
+_Static_assert(
+    (FURI_RECORD_TABLE_SIZE & (FURI_RECORD_TABLE_SIZE - 1)) == 0,
+    "FURI_RECORD_TABLE_SIZE must be power of 2");
+
+/* Entry is never removed from table once name is set, destroyed record
+ * keeps its entry, so handles and lock-free lookups stay valid. */
+struct FuriRecordHandle {
+    const char* name;
+    uint32_t hash;
     osEventFlagsId_t flags;
     void* data;
-    size_t holders_count;
-} FuriRecordData;
-
-DICT_DEF2(FuriRecordDataDict, string_t, STRING_OPLIST, FuriRecordData, M_POD_OPLIST)
+    bool ready;
+    uint32_t holders_count;
+};
 
 typedef struct {
     osMutexId_t mutex;
-    FuriRecordDataDict_t records;
+    FuriRecordHandle table[FURI_RECORD_TABLE_SIZE];
 } FuriRecord;
 
 static FuriRecord* furi_record = NULL;
@@ -27,21 +36,6 @@ void furi_record_init() {
     furi_record = malloc(sizeof(FuriRecord));
     furi_record->mutex = osMutexNew(NULL);
     furi_check(furi_record->mutex);
-    FuriRecordDataDict_init(furi_record->records);
-}
-
-static FuriRecordData* furi_record_data_get_or_create(string_t name_str) {
-    furi_assert(furi_record);
-    FuriRecordData* record_data = FuriRecordDataDict_get(furi_record->records, name_str);
-    if(!record_data) {
-        FuriRecordData new_record;
-        new_record.flags = osEventFlagsNew(NULL);
-        new_record.data = NULL;
-        new_record.holders_count = 0;
-        FuriRecordDataDict_set_at(furi_record->records, name_str, new_record);
-        record_data = FuriRecordDataDict_get(furi_record->records, name_str);
-    }
-    return record_data;
 }
 
 static void furi_record_lock() {
@@ -52,41 +46,80 @@ static void furi_record_unlock() {
     furi_check(osMutexRelease(furi_record->mutex) == osOK);
 }
 
-bool furi_record_exists(const char* name) {
+/* Lock-free, returns entry with this name or empty entry where it belongs */
+static FuriRecordHandle* furi_record_find(const char* name, uint32_t hash) {
+    for(size_t i = 0; i < FURI_RECORD_TABLE_SIZE; i++) {
+        FuriRecordHandle* handle = &furi_record->table[(hash + i) % FURI_RECORD_TABLE_SIZE];
+        const char* handle_name = __atomic_load_n(&handle->name, __ATOMIC_ACQUIRE);
+        if(!handle_name || (handle->hash == hash && strcmp(handle_name, name) == 0)) {
+            return handle;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t furi_record_hash(const char* name) {
+    return fnv1a_buffer_hash((const uint8_t*)name, strlen(name), FNV_1A_INIT);
+}
+
+static FuriRecordHandle* furi_record_lookup(const char* name) {
+    FuriRecordHandle* handle = furi_record_find(name, furi_record_hash(name));
+    if(handle && __atomic_load_n(&handle->name, __ATOMIC_ACQUIRE)) {
+        return handle;
+    }
+    return NULL;
+}
+
+FuriRecordHandle* furi_record_get_handle(const char* name) {
     furi_assert(furi_record);
     furi_assert(name);
 
-    bool ret = false;
-
-    string_t name_str;
-    string_init_set_str(name_str, name);
+    uint32_t hash = furi_record_hash(name);
+    FuriRecordHandle* handle = furi_record_find(name, hash);
+    furi_check(handle);
+    if(__atomic_load_n(&handle->name, __ATOMIC_ACQUIRE)) {
+        return handle;
+    }
 
     furi_record_lock();
-    ret = (FuriRecordDataDict_get(furi_record->records, name_str) != NULL);
+    // Other thread may have added it or taken this entry in between
+    handle = furi_record_find(name, hash);
+    furi_check(handle);
+    if(!handle->name) {
+        char* name_copy = malloc(strlen(name) + 1);
+        strcpy(name_copy, name);
+        handle->hash = hash;
+        handle->flags = osEventFlagsNew(NULL);
+        furi_check(handle->flags);
+        // Entry becomes visible to readers with the name
+        __atomic_store_n(&handle->name, name_copy, __ATOMIC_RELEASE);
+    }
     furi_record_unlock();
 
-    string_clear(name_str);
+    return handle;
+}
 
-    return ret;
+bool furi_record_exists(const char* name) {
+    furi_assert(furi_record);
+    furi_assert(name);
+
+    FuriRecordHandle* handle = furi_record_lookup(name);
+    return handle && __atomic_load_n(&handle->ready, __ATOMIC_ACQUIRE);
 }
 
 void furi_record_create(const char* name, void* data) {
     furi_assert(furi_record);
 
-    string_t name_str;
-    string_init_set_str(name_str, name);
+    FuriRecordHandle* handle = furi_record_get_handle(name);
 
     furi_record_lock();
 
-    // Get record data and fill it
-    FuriRecordData* record_data = furi_record_data_get_or_create(name_str);
-    furi_assert(record_data->data == NULL);
-    record_data->data = data;
-    osEventFlagsSet(record_data->flags, FURI_RECORD_FLAG_READY);
+    furi_assert(handle->data == NULL);
+    handle->data = data;
+    __atomic_store_n(&handle->ready, true, __ATOMIC_SEQ_CST);
+    osEventFlagsSet(handle->flags, FURI_RECORD_FLAG_READY);
 
     furi_record_unlock();
-
-    string_clear(name_str);
 }
 
 bool furi_record_destroy(const char* name) {
@@ -94,65 +127,61 @@ bool furi_record_destroy(const char* name) {
 
     bool ret = false;
 
-    string_t name_str;
-    string_init_set_str(name_str, name);
+    FuriRecordHandle* handle = furi_record_lookup(name);
+    furi_assert(handle);
 
     furi_record_lock();
 
-    FuriRecordData* record_data = FuriRecordDataDict_get(furi_record->records, name_str);
-    furi_assert(record_data);
-    if(record_data->holders_count == 0) {
-        furi_check(osOK == osEventFlagsDelete(record_data->flags));
-        FuriRecordDataDict_erase(furi_record->records, name_str);
+    // Openers count themselves before checking ready, one of us sees the other
+    __atomic_store_n(&handle->ready, false, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&handle->holders_count, __ATOMIC_SEQ_CST) == 0) {
+        osEventFlagsClear(handle->flags, FURI_RECORD_FLAG_READY);
+        handle->data = NULL;
         ret = true;
+    } else {
+        __atomic_store_n(&handle->ready, true, __ATOMIC_SEQ_CST);
     }
 
     furi_record_unlock();
 
-    string_clear(name_str);
-
     return ret;
 }
 
-void* furi_record_open(const char* name) {
-    furi_assert(furi_record);
-
-    string_t name_str;
-    string_init_set_str(name_str, name);
-
-    furi_record_lock();
-
-    FuriRecordData* record_data = furi_record_data_get_or_create(name_str);
-    record_data->holders_count++;
+void* furi_record_open_handle(FuriRecordHandle* handle) {
+    furi_assert(handle);
 
-    furi_record_unlock();
+    __atomic_add_fetch(&handle->holders_count, 1, __ATOMIC_SEQ_CST);
 
     // Wait for record to become ready
-    furi_check(
-        osEventFlagsWait(
-            record_data->flags,
-            FURI_RECORD_FLAG_READY,
-            osFlagsWaitAny | osFlagsNoClear,
-            osWaitForever) == FURI_RECORD_FLAG_READY);
-
-    string_clear(name_str);
+    while(!__atomic_load_n(&handle->ready, __ATOMIC_SEQ_CST)) {
+        furi_check(
+            osEventFlagsWait(
+                handle->flags,
+                FURI_RECORD_FLAG_READY,
+                osFlagsWaitAny | osFlagsNoClear,
+                osWaitForever) == FURI_RECORD_FLAG_READY);
+        if(!__atomic_load_n(&handle->ready, __ATOMIC_SEQ_CST)) {
+            // Record is being destroyed, let destroy clear the flag
+            osDelay(1);
+        }
+    }
 
-    return record_data->data;
+    return handle->data;
 }
 
-void furi_record_close(const char* name) {
-    furi_assert(furi_record);
-
-    string_t name_str;
-    string_init_set_str(name_str, name);
-
-    furi_record_lock();
+void furi_record_close_handle(FuriRecordHandle* handle) {
+    furi_assert(handle);
+    furi_assert(__atomic_load_n(&handle->holders_count, __ATOMIC_RELAXED) > 0);
 
-    FuriRecordData* record_data = FuriRecordDataDict_get(furi_record->records, name_str);
-    furi_assert(record_data);
-    record_data->holders_count--;
+    __atomic_sub_fetch(&handle->holders_count, 1, __ATOMIC_SEQ_CST);
+}
 
-    furi_record_unlock();
+void* furi_record_open(const char* name) {
+    return furi_record_open_handle(furi_record_get_handle(name));
+}
 
-    string_clear(name_str);
+void furi_record_close(const char* name) {
+    FuriRecordHandle* handle = furi_record_lookup(name);
+    furi_assert(handle);
+    furi_record_close_handle(handle);
 }
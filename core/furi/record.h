@@ -11,10 +11,33 @@
 extern "C" {
 #endif
 
+/** Record handle, resolved once and valid until reboot */
+typedef struct FuriRecordHandle FuriRecordHandle;
+
 /** Initialize record storage For internal use only.
  */
 void furi_record_init();
 
+/** Get record handle
+ *
+ * Record doesn't need to exist yet. Lock-free when record name is known.
+ *
+ * @param      name  record name
+ *
+ * @return     record handle
+ */
+FuriRecordHandle* furi_record_get_handle(const char* name);
+
+/** Record handle resolved on first use at call site, name must be constant */
+#define FURI_RECORD_HANDLE(name)                           \
+    ({                                                     \
+        static FuriRecordHandle* furi_record_handle = NULL; \
+        if(!furi_record_handle) {                          \
+            furi_record_handle = furi_record_get_handle(name); \
+        }                                                  \
+        furi_record_handle;                                \
+    })
+
 /** Check if record exists
  *
  * @param      name  record name
@@ -61,6 +84,23 @@ void* furi_record_open(const char* name);
  */
 void furi_record_close(const char* name);
 
+/** Open record by handle
+ *
+ * @param      handle  record handle
+ *
+ * @return     pointer to the record
+ * @note       Thread safe, lock-free if record exists. Suspends caller thread
+ *             till record appear
+ */
+void* furi_record_open_handle(FuriRecordHandle* handle);
+
+/** Close record by handle
+ *
+ * @param      handle  record handle
+ * @note       Thread safe, lock-free.
+ */
+void furi_record_close_handle(FuriRecordHandle* handle);
+
 #ifdef __cplusplus
 }
 #endif
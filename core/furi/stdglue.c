@@ -15,10 +15,22 @@ DICT_DEF2(
     FuriStdglueWriteCallback,
     M_PTR_OPLIST)
 
+typedef struct {
+    FuriStdglueWriteCallback callback;
+    void* context;
+} FuriStdglueThreadOutput;
+
+DICT_DEF2(
+    FuriStdglueThreadOutputDict,
+    uint32_t,
+    M_DEFAULT_OPLIST,
+    FuriStdglueThreadOutput,
+    M_POD_OPLIST)
+
 typedef struct {
     osMutexId_t mutex;
     FuriStdglueCallbackDict_t global_outputs;
-    FuriStdglueCallbackDict_t thread_outputs;
+    FuriStdglueThreadOutputDict_t thread_outputs;
 } FuriStdglue;
 
 static FuriStdglue* furi_stdglue = NULL;
@@ -43,10 +55,10 @@ static ssize_t stdout_write(void* _cookie, const char* data, size_t size) {
             }
         }
         // Handle thread callbacks
-        FuriStdglueWriteCallback* callback_ptr =
-            FuriStdglueCallbackDict_get(furi_stdglue->thread_outputs, (uint32_t)thread_id);
-        if(callback_ptr) {
-            (*callback_ptr)(_cookie, data, size);
+        FuriStdglueThreadOutput* output =
+            FuriStdglueThreadOutputDict_get(furi_stdglue->thread_outputs, (uint32_t)thread_id);
+        if(output) {
+            output->callback(output->context, data, size);
             consumed = true;
         }
         furi_check(osMutexRelease(furi_stdglue->mutex) == osOK);
@@ -72,7 +84,7 @@ void furi_stdglue_init() {
     furi_stdglue->mutex = osMutexNew(NULL);
     furi_check(furi_stdglue->mutex);
     FuriStdglueCallbackDict_init(furi_stdglue->global_outputs);
-    FuriStdglueCallbackDict_init(furi_stdglue->thread_outputs);
+    FuriStdglueThreadOutputDict_init(furi_stdglue->thread_outputs);
     // Prepare and set stdout descriptor
     FILE* fp = fopencookie(
         NULL,
@@ -105,16 +117,17 @@ bool furi_stdglue_set_global_stdout_callback(FuriStdglueWriteCallback callback)
     }
 }
 
-bool furi_stdglue_set_thread_stdout_callback(FuriStdglueWriteCallback callback) {
+bool furi_stdglue_set_thread_stdout_callback(FuriStdglueWriteCallback callback, void* context) {
     furi_assert(furi_stdglue);
     osThreadId_t thread_id = osThreadGetId();
     if(thread_id) {
         furi_check(osMutexAcquire(furi_stdglue->mutex, osWaitForever) == osOK);
         if(callback) {
-            FuriStdglueCallbackDict_set_at(
-                furi_stdglue->thread_outputs, (uint32_t)thread_id, callback);
+            FuriStdglueThreadOutput output = {.callback = callback, .context = context};
+            FuriStdglueThreadOutputDict_set_at(
+                furi_stdglue->thread_outputs, (uint32_t)thread_id, output);
         } else {
-            FuriStdglueCallbackDict_erase(furi_stdglue->thread_outputs, (uint32_t)thread_id);
+            FuriStdglueThreadOutputDict_erase(furi_stdglue->thread_outputs, (uint32_t)thread_id);
         }
         furi_check(osMutexRelease(furi_stdglue->mutex) == osOK);
         return true;
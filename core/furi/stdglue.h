@@ -34,11 +34,12 @@ bool furi_stdglue_set_global_stdout_callback(FuriStdglueWriteCallback callback);
 /** Set STDOUT callback for your thread
  *
  * @param      callback  callback or NULL to clear
+ * @param      context   passed to callback instead of _cookie
  *
  * @return     true on success, otherwise fail
  * @warning    function is thread aware, use this API from the same thread
  */
-bool furi_stdglue_set_thread_stdout_callback(FuriStdglueWriteCallback callback);
+bool furi_stdglue_set_thread_stdout_callback(FuriStdglueWriteCallback callback, void* context);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,118 @@
+#include "trace.h"
+#include "check.h"
+#include "common_defines.h"
+#include <cmsis_os2.h>
+#include <furi_hal.h>
+#include <string.h>
+
+/* Records in ring buffer, power of 2 */
+#ifndef FURI_TRACE_BUFFER_SIZE
+#define FURI_TRACE_BUFFER_SIZE 256
+#endif
+
+#define FURI_TRACE_THREADS_MAX 32
+
+_Static_assert(sizeof(FuriTraceRecord) == 16, "FuriTraceRecord is part of dump format");
+_Static_assert(
+    (FURI_TRACE_BUFFER_SIZE & (FURI_TRACE_BUFFER_SIZE - 1)) == 0,
+    "FURI_TRACE_BUFFER_SIZE must be power of 2");
+
+#ifdef FURI_TRACE
+static FuriTraceRecord furi_trace_buffer[FURI_TRACE_BUFFER_SIZE];
+static uint32_t furi_trace_head = 0;
+static bool furi_trace_enabled = true;
+#endif
+
+bool furi_trace_is_available() {
+#ifdef FURI_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void furi_trace_set_enabled(bool enabled) {
+#ifdef FURI_TRACE
+    __atomic_store_n(&furi_trace_enabled, enabled, __ATOMIC_RELEASE);
+#endif
+}
+
+bool furi_trace_is_enabled() {
+#ifdef FURI_TRACE
+    return __atomic_load_n(&furi_trace_enabled, __ATOMIC_ACQUIRE);
+#else
+    return false;
+#endif
+}
+
+void furi_trace_clear() {
+#ifdef FURI_TRACE
+    __atomic_store_n(&furi_trace_head, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+void furi_trace_record(FuriTraceEvent event, FuriTracePhase phase, uint32_t arg) {
+#ifdef FURI_TRACE
+    if(!__atomic_load_n(&furi_trace_enabled, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    uint32_t timestamp = DWT->CYCCNT;
+    // Every writer, including interrupts, gets own record
+    uint32_t index = __atomic_fetch_add(&furi_trace_head, 1, __ATOMIC_RELAXED);
+    FuriTraceRecord* record = &furi_trace_buffer[index % FURI_TRACE_BUFFER_SIZE];
+
+    uint32_t exception = __get_IPSR();
+    record->timestamp = timestamp;
+    record->thread = exception ? exception : (uint32_t)osThreadGetId();
+    record->event = event;
+    record->phase = phase;
+    record->isr = exception != 0;
+    record->arg = arg;
+#endif
+}
+
+size_t furi_trace_dump(FuriTraceWriteCallback callback, void* context) {
+    furi_assert(callback);
+
+    FuriTraceHeader header = {
+        .magic = FURI_TRACE_MAGIC,
+        .version = FURI_TRACE_VERSION,
+        .record_size = sizeof(FuriTraceRecord),
+        .frequency = SystemCoreClock,
+    };
+
+    uint32_t head = 0;
+#ifdef FURI_TRACE
+    head = __atomic_load_n(&furi_trace_head, __ATOMIC_ACQUIRE);
+    header.records = MIN(head, (uint32_t)FURI_TRACE_BUFFER_SIZE);
+#endif
+
+    osThreadId_t threads_id[FURI_TRACE_THREADS_MAX];
+    header.threads = osThreadEnumerate(threads_id, FURI_TRACE_THREADS_MAX);
+
+    callback((const uint8_t*)&header, sizeof(header), context);
+
+#ifdef FURI_TRACE
+    // Oldest record first, ring may be split in two parts
+    uint32_t start = (head - header.records) % FURI_TRACE_BUFFER_SIZE;
+    uint32_t first = MIN(header.records, FURI_TRACE_BUFFER_SIZE - start);
+    callback((const uint8_t*)&furi_trace_buffer[start], first * sizeof(FuriTraceRecord), context);
+    callback(
+        (const uint8_t*)furi_trace_buffer,
+        (header.records - first) * sizeof(FuriTraceRecord),
+        context);
+#endif
+
+    for(uint32_t i = 0; i < header.threads; i++) {
+        FuriTraceThread thread = {.thread = (uint32_t)threads_id[i]};
+        const char* name = osThreadGetName(threads_id[i]);
+        if(name) {
+            strncpy(thread.name, name, FURI_TRACE_THREAD_NAME_SIZE - 1);
+        }
+        callback((const uint8_t*)&thread, sizeof(thread), context);
+    }
+
+    return sizeof(header) + header.records * sizeof(FuriTraceRecord) +
+           header.threads * sizeof(FuriTraceThread);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file trace.h
+ * Furi: binary trace buffer for hot path timing
+ *
+ * Trace points are compiled in only with FURI_TRACE defined (make
+ * FURI_TRACE=1). Records go to ring buffer, oldest are overwritten.
+ * Dump is decoded on host by scripts/trace.py into Chrome trace JSON.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FURI_TRACE_MAGIC 0x43525446 /* "FTRC" */
+#define FURI_TRACE_VERSION 1
+#define FURI_TRACE_THREAD_NAME_SIZE 16
+
+/** Traced events, keep in sync with scripts/trace.py */
+typedef enum {
+    FuriTraceEventStorageCommand, /**< arg: StorageCommand */
+    FuriTraceEventGuiRedraw, /**< arg: bytes sent to display at end */
+    FuriTraceEventSubGhzDecode, /**< arg: duration */
+    FuriTraceEventInfraredDecode, /**< arg: duration */
+    FuriTraceEventNfcWorker, /**< arg: NfcWorkerState */
+    FuriTraceEventNfcDetect, /**< arg: device found at end */
+    FuriTraceEventCount,
+} FuriTraceEvent;
+
+typedef enum {
+    FuriTracePhaseBegin,
+    FuriTracePhaseEnd,
+    FuriTracePhaseInstant,
+} FuriTracePhase;
+
+/** Trace record */
+typedef struct {
+    uint32_t timestamp; /**< DWT cycle counter */
+    uint32_t thread; /**< thread id, or exception number in interrupt */
+    uint16_t event; /**< FuriTraceEvent */
+    uint8_t phase; /**< FuriTracePhase */
+    uint8_t isr; /**< recorded in interrupt */
+    uint32_t arg; /**< event argument */
+} FuriTraceRecord;
+
+/** Dump header, followed by records from oldest to newest and thread names */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t frequency; /**< timestamp frequency in Hz */
+    uint32_t records; /**< amount of records */
+    uint32_t threads; /**< amount of FuriTraceThread */
+} FuriTraceHeader;
+
+/** Thread name for dump */
+typedef struct {
+    uint32_t thread;
+    char name[FURI_TRACE_THREAD_NAME_SIZE];
+} FuriTraceThread;
+
+/** Dump write callback
+ *
+ * @param      data     data to write
+ * @param      size     data size
+ * @param      context  pointer to whatever was passed to furi_trace_dump
+ */
+typedef void (*FuriTraceWriteCallback)(const uint8_t* data, size_t size, void* context);
+
+/** Check if trace points are compiled in */
+bool furi_trace_is_available();
+
+/** Start or stop recording */
+void furi_trace_set_enabled(bool enabled);
+
+bool furi_trace_is_enabled();
+
+/** Drop recorded data */
+void furi_trace_clear();
+
+/** Add record
+ *
+ * Lock-free, ISR safe. Use FURI_TRACE_* macros instead.
+ *
+ * @param      event  FuriTraceEvent
+ * @param      phase  FuriTracePhase
+ * @param      arg    event argument
+ */
+void furi_trace_record(FuriTraceEvent event, FuriTracePhase phase, uint32_t arg);
+
+/** Write binary dump
+ *
+ * Recording must be stopped, so records are not overwritten while dumping.
+ * Reader gets dump size from FuriTraceHeader.
+ *
+ * @param      callback  write callback
+ * @param      context   callback context
+ *
+ * @return     dump size in bytes
+ */
+size_t furi_trace_dump(FuriTraceWriteCallback callback, void* context);
+
+#ifdef FURI_TRACE
+#define FURI_TRACE_BEGIN(event, arg) furi_trace_record(event, FuriTracePhaseBegin, arg)
+#define FURI_TRACE_END(event, arg) furi_trace_record(event, FuriTracePhaseEnd, arg)
+#define FURI_TRACE_INSTANT(event, arg) furi_trace_record(event, FuriTracePhaseInstant, arg)
+#else
+#define FURI_TRACE_BEGIN(event, arg)
+#define FURI_TRACE_END(event, arg)
+#define FURI_TRACE_INSTANT(event, arg)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -103,6 +103,10 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* pckt) {
                 event->Conn_Interval,
                 event->Conn_Latency,
                 event->Supervision_Timeout);
+            GapEvent gap_event = {
+                .type = GapEventTypeUpdateConnectionInterval,
+                .data.connection_interval = event->Conn_Interval};
+            gap->on_event_cb(gap_event, gap->context);
             break;
         }
 
@@ -137,6 +141,10 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* pckt) {
             // Update connection status and handle
             gap->state = GapStateConnected;
             gap->service.connection_handle = connection_complete_event->Connection_Handle;
+            GapEvent event = {
+                .type = GapEventTypeUpdateConnectionInterval,
+                .data.connection_interval = connection_complete_event->Conn_Interval};
+            gap->on_event_cb(event, gap->context);
             GapConnectionParams* params = &gap->config->conn_param;
             if(aci_l2cap_connection_parameter_update_req(
                    gap->service.connection_handle,
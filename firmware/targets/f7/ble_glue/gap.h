@@ -19,11 +19,13 @@ typedef enum {
     GapEventTypePinCodeShow,
     GapEventTypePinCodeVerify,
     GapEventTypeUpdateMTU,
+    GapEventTypeUpdateConnectionInterval,
 } GapEventType;
 
 typedef union {
     uint32_t pin_code;
     uint16_t max_packet_size;
+    uint16_t connection_interval; /**< In 1.25 ms units */
 } GapEventData;
 
 typedef struct {
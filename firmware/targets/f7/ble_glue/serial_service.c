@@ -14,6 +14,7 @@ typedef struct {
     osMutexId_t buff_size_mtx;
     uint32_t buff_size;
     uint16_t bytes_ready_to_receive;
+    bool tx_notify;
     SerialServiceEventCallback callback;
     void* context;
 } SerialSvc;
@@ -37,7 +38,12 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
     if(event_pckt->evt == HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE) {
         if(blecore_evt->ecode == ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE) {
             attribute_modified = (aci_gatt_attribute_modified_event_rp0*)blecore_evt->data;
-            if(attribute_modified->Attr_Handle == serial_svc->rx_char_handle + 2) {
+            if(attribute_modified->Attr_Handle == serial_svc->tx_char_handle + 2) {
+                // Client configuration descriptor: notifications take precedence over indications
+                serial_svc->tx_notify = attribute_modified->Attr_Data[0] & 0x01;
+                FURI_LOG_D(TAG, "TX notifications %s", serial_svc->tx_notify ? "on" : "off");
+                ret = SVCCTL_EvtAckFlowEnable;
+            } else if(attribute_modified->Attr_Handle == serial_svc->rx_char_handle + 2) {
                 // Descriptor handle
                 ret = SVCCTL_EvtAckFlowEnable;
                 FURI_LOG_D(TAG, "RX descriptor event");
@@ -75,6 +81,15 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
                 serial_svc->callback(event, serial_svc->context);
             }
             ret = SVCCTL_EvtAckFlowEnable;
+        } else if(blecore_evt->ecode == ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE) {
+            FURI_LOG_T(TAG, "TX pool available");
+            if(serial_svc->callback) {
+                SerialServiceEvent event = {
+                    .event = SerialServiceEventTypeDataSent,
+                };
+                serial_svc->callback(event, serial_svc->context);
+            }
+            ret = SVCCTL_EvtAckFlowEnable;
         }
     }
     return ret;
@@ -115,7 +130,7 @@ void serial_svc_start() {
         UUID_TYPE_128,
         (const Char_UUID_t*)char_tx_uuid,
         SERIAL_SVC_DATA_LEN_MAX,
-        CHAR_PROP_READ | CHAR_PROP_INDICATE,
+        CHAR_PROP_READ | CHAR_PROP_INDICATE | CHAR_PROP_NOTIFY,
         ATTR_PERMISSION_AUTHEN_READ,
         GATT_DONT_NOTIFY_EVENTS,
         10,
@@ -143,11 +158,31 @@ void serial_svc_start() {
     serial_svc->buff_size_mtx = osMutexNew(NULL);
 }
 
+static void serial_svc_update_tx_notify(bool connected) {
+    serial_svc->tx_notify = false;
+    if(connected) {
+        // Bonded peers get their client configuration restored by the stack without
+        // an attribute modified event, so read it back instead of trusting the last link
+        uint8_t cccd[2] = {};
+        uint16_t length = 0;
+        uint16_t value_length = 0;
+        tBleStatus status = aci_gatt_read_handle_value(
+            serial_svc->tx_char_handle + 2, 0, sizeof(cccd), &length, &value_length, cccd);
+        if(status) {
+            FURI_LOG_E(TAG, "Failed to read TX client configuration: %d", status);
+        } else if(value_length > 0) {
+            serial_svc->tx_notify = cccd[0] & 0x01;
+        }
+    }
+    FURI_LOG_D(TAG, "TX notifications %s", serial_svc->tx_notify ? "on" : "off");
+}
+
 void serial_svc_set_callbacks(
     uint16_t buff_size,
     SerialServiceEventCallback callback,
     void* context) {
     furi_assert(serial_svc);
+    serial_svc_update_tx_notify(callback != NULL);
     serial_svc->callback = callback;
     serial_svc->context = context;
     serial_svc->buff_size = buff_size;
@@ -212,10 +247,16 @@ bool serial_svc_is_started() {
     return serial_svc != NULL;
 }
 
-bool serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
+bool serial_svc_is_tx_notify_enabled() {
+    furi_assert(serial_svc);
+    return serial_svc->tx_notify;
+}
+
+SerialServiceTxStatus serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
     if(data_len > SERIAL_SVC_DATA_LEN_MAX) {
-        return false;
+        return SerialServiceTxStatusError;
     }
+    uint8_t update_type = serial_svc->tx_notify ? 0x01 : 0x02;
 
     for(uint16_t remained = data_len; remained > 0;) {
         uint8_t value_len = MIN(SERIAL_SVC_CHAR_VALUE_LEN_MAX, remained);
@@ -226,17 +267,19 @@ bool serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
             0,
             serial_svc->svc_handle,
             serial_svc->tx_char_handle,
-            remained ? 0x00 : 0x02,
+            remained ? 0x00 : update_type,
             data_len,
             value_offset,
             value_len,
             data + value_offset);
 
-        if(result) {
+        if(result == BLE_STATUS_INSUFFICIENT_RESOURCES) {
+            return SerialServiceTxStatusBusy;
+        } else if(result) {
             FURI_LOG_E(TAG, "Failed updating TX characteristic: %d", result);
-            return false;
+            return SerialServiceTxStatusError;
         }
     }
 
-    return true;
+    return SerialServiceTxStatusOk;
 }
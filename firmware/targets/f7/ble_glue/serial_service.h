@@ -25,6 +25,12 @@ typedef struct {
     SerialServiceData data;
 } SerialServiceEvent;
 
+typedef enum {
+    SerialServiceTxStatusOk, /**< Packet queued */
+    SerialServiceTxStatusBusy, /**< No free TX buffers, retry after DataSent event */
+    SerialServiceTxStatusError,
+} SerialServiceTxStatus;
+
 typedef uint16_t (*SerialServiceEventCallback)(SerialServiceEvent event, void* context);
 
 void serial_svc_start();
@@ -40,7 +46,9 @@ void serial_svc_stop();
 
 bool serial_svc_is_started();
 
-bool serial_svc_update_tx(uint8_t* data, uint16_t data_len);
+bool serial_svc_is_tx_notify_enabled();
+
+SerialServiceTxStatus serial_svc_update_tx(uint8_t* data, uint16_t data_len);
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,8 @@
 #include <furi.h>
 
 #define SD_DUMMY_BYTE 0xFF
+/* Data blocks and longer go with DMA, commands and tokens are polled */
+#define SD_DMA_THRESHOLD 64
 
 const uint32_t SpiTimeout = 1000;
 uint8_t SD_IO_WriteByte(uint8_t Data);
@@ -19,8 +21,13 @@ uint8_t SD_IO_WriteByte(uint8_t Data);
  * @retval None
  */
 static void SPIx_WriteReadData(const uint8_t* DataIn, uint8_t* DataOut, uint16_t DataLength) {
-    furi_check(furi_hal_spi_bus_trx(
-        furi_hal_sd_spi_handle, (uint8_t*)DataIn, DataOut, DataLength, SpiTimeout));
+    if(DataLength >= SD_DMA_THRESHOLD && osKernelGetState() == osKernelRunning) {
+        furi_check(furi_hal_spi_bus_trx_dma(
+            furi_hal_sd_spi_handle, DataIn, DataOut, DataLength, SpiTimeout));
+    } else {
+        furi_check(furi_hal_spi_bus_trx(
+            furi_hal_sd_spi_handle, (uint8_t*)DataIn, DataOut, DataLength, SpiTimeout));
+    }
 }
 
 /**
@@ -1,4 +1,5 @@
 #include <furi_hal_compress.h>
+#include <furi_hal_flash.h>
 
 #include <furi.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
@@ -9,6 +10,9 @@
 #define FURI_HAL_COMPRESS_ICON_ENCODED_BUFF_SIZE (2 * 512)
 #define FURI_HAL_COMPRESS_ICON_DECODED_BUFF_SIZE (1024)
 
+#define FURI_HAL_COMPRESS_ICON_CACHE_ENTRIES (32)
+#define FURI_HAL_COMPRESS_ICON_CACHE_PINNED_MAX (FURI_HAL_COMPRESS_ICON_CACHE_SIZE / 4)
+
 #define FURI_HAL_COMPRESS_EXP_BUFF_SIZE (1 << FURI_HAL_COMPRESS_EXP_BUFF_SIZE_LOG)
 
 typedef struct {
@@ -17,13 +21,31 @@ typedef struct {
     uint16_t compressed_buff_size;
 } FuriHalCompressHeader;
 
+typedef struct {
+    const uint8_t* icon_data;
+    uint16_t offset;
+    uint16_t size;
+    uint32_t last_used;
+    bool pinned;
+} FuriHalCompressIconCacheEntry;
+
 typedef struct {
     heatshrink_decoder* decoder;
+    osMutexId_t mutex;
     uint8_t
         compress_buff[FURI_HAL_COMPRESS_EXP_BUFF_SIZE + FURI_HAL_COMPRESS_ICON_ENCODED_BUFF_SIZE];
     uint8_t decoded_buff[FURI_HAL_COMPRESS_ICON_DECODED_BUFF_SIZE];
+    // Decoded frames, stored back to back in cache buffer in entries order
+    uint8_t cache[FURI_HAL_COMPRESS_ICON_CACHE_SIZE];
+    FuriHalCompressIconCacheEntry entries[FURI_HAL_COMPRESS_ICON_CACHE_ENTRIES];
+    size_t entries_count;
+    uint32_t clock;
+    const uint8_t* firmware_end;
+    FuriHalCompressIconStats stats;
 } FuriHalCompressIcon;
 
+_Static_assert(FURI_HAL_COMPRESS_ICON_CACHE_SIZE <= UINT16_MAX, "Icon cache offsets overflow");
+
 struct FuriHalCompress {
     heatshrink_encoder* encoder;
     heatshrink_decoder* decoder;
@@ -49,40 +71,216 @@ void furi_hal_compress_icon_init() {
         FURI_HAL_COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
     heatshrink_decoder_reset(icon_decoder->decoder);
     memset(icon_decoder->decoded_buff, 0, sizeof(icon_decoder->decoded_buff));
+    icon_decoder->mutex = osMutexNew(NULL);
+    furi_check(icon_decoder->mutex);
+    icon_decoder->stats.cache_size = FURI_HAL_COMPRESS_ICON_CACHE_SIZE;
+    icon_decoder->firmware_end = furi_hal_flash_get_free_start_address();
     FURI_LOG_I(TAG, "Init OK");
 }
 
+/* Decode compressed icon to out buffer, returns decoded size or 0 if it doesn't fit */
+static size_t furi_hal_compress_icon_decode_raw(
+    FuriHalCompressHeader* header,
+    uint8_t* decoded_buff,
+    size_t decoded_buff_size) {
+    size_t decoded = 0;
+    size_t data_processed = 0;
+    heatshrink_decoder_sink(
+        icon_decoder->decoder,
+        (uint8_t*)header + sizeof(FuriHalCompressHeader),
+        header->compressed_buff_size,
+        &data_processed);
+    while(decoded < decoded_buff_size) {
+        HSD_poll_res res = heatshrink_decoder_poll(
+            icon_decoder->decoder,
+            &decoded_buff[decoded],
+            decoded_buff_size - decoded,
+            &data_processed);
+        furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
+        decoded += data_processed;
+        if(res != HSDR_POLL_MORE) {
+            break;
+        }
+    }
+    bool overflow = (decoded == decoded_buff_size) &&
+                    (heatshrink_decoder_finish(icon_decoder->decoder) == HSDR_FINISH_MORE);
+    heatshrink_decoder_reset(icon_decoder->decoder);
+    memset(icon_decoder->compress_buff, 0, sizeof(icon_decoder->compress_buff));
+    return overflow ? 0 : decoded;
+}
+
+/* Only icons from firmware image are cached: RAM buffers can be reused for other data */
+static bool furi_hal_compress_icon_is_cacheable(const uint8_t* icon_data) {
+    return ((size_t)icon_data >= furi_hal_flash_get_base()) &&
+           (icon_data < icon_decoder->firmware_end);
+}
+
+static FuriHalCompressIconCacheEntry* furi_hal_compress_icon_cache_find(const uint8_t* icon_data) {
+    for(size_t i = 0; i < icon_decoder->entries_count; i++) {
+        if(icon_decoder->entries[i].icon_data == icon_data) {
+            return &icon_decoder->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void furi_hal_compress_icon_cache_remove(size_t index) {
+    FuriHalCompressIconCacheEntry* entry = &icon_decoder->entries[index];
+    size_t tail_offset = entry->offset + entry->size;
+    uint16_t size = entry->size;
+    // Compact cache buffer: nobody keeps pointers to cached data between decode calls
+    memmove(
+        &icon_decoder->cache[entry->offset],
+        &icon_decoder->cache[tail_offset],
+        icon_decoder->stats.cache_used - tail_offset);
+    icon_decoder->stats.cache_used -= size;
+    icon_decoder->entries_count--;
+    for(size_t i = index; i < icon_decoder->entries_count; i++) {
+        icon_decoder->entries[i] = icon_decoder->entries[i + 1];
+        icon_decoder->entries[i].offset -= size;
+    }
+}
+
+/* Evict least recently used entries until size bytes and one entry are available */
+static bool furi_hal_compress_icon_cache_reserve(size_t size) {
+    while((icon_decoder->entries_count == FURI_HAL_COMPRESS_ICON_CACHE_ENTRIES) ||
+          (FURI_HAL_COMPRESS_ICON_CACHE_SIZE - icon_decoder->stats.cache_used < size)) {
+        size_t lru = icon_decoder->entries_count;
+        for(size_t i = 0; i < icon_decoder->entries_count; i++) {
+            FuriHalCompressIconCacheEntry* entry = &icon_decoder->entries[i];
+            if(!entry->pinned &&
+               (lru == icon_decoder->entries_count ||
+                entry->last_used < icon_decoder->entries[lru].last_used)) {
+                lru = i;
+            }
+        }
+        if(lru == icon_decoder->entries_count) {
+            return false;
+        }
+        furi_hal_compress_icon_cache_remove(lru);
+        icon_decoder->stats.evictions++;
+    }
+    return true;
+}
+
+static FuriHalCompressIconCacheEntry*
+    furi_hal_compress_icon_cache_add(const uint8_t* icon_data, size_t size) {
+    FuriHalCompressIconCacheEntry* entry = &icon_decoder->entries[icon_decoder->entries_count++];
+    entry->icon_data = icon_data;
+    entry->offset = icon_decoder->stats.cache_used;
+    entry->size = size;
+    entry->last_used = ++icon_decoder->clock;
+    entry->pinned = false;
+    icon_decoder->stats.cache_used += size;
+    return entry;
+}
+
 void furi_hal_compress_icon_decode(const uint8_t* icon_data, uint8_t** decoded_buff) {
     furi_assert(icon_data);
     furi_assert(decoded_buff);
 
     FuriHalCompressHeader* header = (FuriHalCompressHeader*)icon_data;
     if(header->is_compressed) {
-        size_t data_processed = 0;
-        heatshrink_decoder_sink(
-            icon_decoder->decoder,
-            (uint8_t*)&icon_data[4],
-            header->compressed_buff_size,
-            &data_processed);
-        while(1) {
-            HSD_poll_res res = heatshrink_decoder_poll(
-                icon_decoder->decoder,
-                icon_decoder->decoded_buff,
-                sizeof(icon_decoder->decoded_buff),
-                &data_processed);
-            furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
-            if(res != HSDR_POLL_MORE) {
-                break;
+        furi_check(osMutexAcquire(icon_decoder->mutex, osWaitForever) == osOK);
+        FuriHalCompressIconCacheEntry* entry = furi_hal_compress_icon_cache_find(icon_data);
+        if(entry) {
+            icon_decoder->stats.hits++;
+            entry->last_used = ++icon_decoder->clock;
+            *decoded_buff = &icon_decoder->cache[entry->offset];
+        } else {
+            icon_decoder->stats.misses++;
+            size_t size = furi_hal_compress_icon_decode_raw(
+                header, icon_decoder->decoded_buff, sizeof(icon_decoder->decoded_buff));
+            furi_assert(size);
+            *decoded_buff = icon_decoder->decoded_buff;
+            if(furi_hal_compress_icon_is_cacheable(icon_data) &&
+               furi_hal_compress_icon_cache_reserve(size)) {
+                entry = furi_hal_compress_icon_cache_add(icon_data, size);
+                memcpy(&icon_decoder->cache[entry->offset], icon_decoder->decoded_buff, size);
             }
         }
-        heatshrink_decoder_reset(icon_decoder->decoder);
-        memset(icon_decoder->compress_buff, 0, sizeof(icon_decoder->compress_buff));
-        *decoded_buff = icon_decoder->decoded_buff;
+        furi_check(osMutexRelease(icon_decoder->mutex) == osOK);
     } else {
         *decoded_buff = (uint8_t*)&icon_data[1];
     }
 }
 
+bool furi_hal_compress_icon_decode_buffer(
+    const uint8_t* icon_data,
+    size_t icon_data_size,
+    uint8_t* decoded_buff,
+    size_t decoded_buff_size) {
+    furi_assert(icon_data);
+    furi_assert(decoded_buff);
+
+    if(icon_data_size < 1) {
+        return false;
+    }
+
+    bool result = false;
+    FuriHalCompressHeader* header = (FuriHalCompressHeader*)icon_data;
+    if(header->is_compressed) {
+        // Compressed payload must fill the data exactly and fit decoder input buffer
+        if((icon_data_size > sizeof(FuriHalCompressHeader)) &&
+           (header->compressed_buff_size == icon_data_size - sizeof(FuriHalCompressHeader)) &&
+           (header->compressed_buff_size <= FURI_HAL_COMPRESS_ICON_ENCODED_BUFF_SIZE)) {
+            furi_check(osMutexAcquire(icon_decoder->mutex, osWaitForever) == osOK);
+            result = furi_hal_compress_icon_decode_raw(header, decoded_buff, decoded_buff_size) ==
+                     decoded_buff_size;
+            furi_check(osMutexRelease(icon_decoder->mutex) == osOK);
+        }
+    } else if(icon_data_size == decoded_buff_size + 1) {
+        memcpy(decoded_buff, &icon_data[1], decoded_buff_size);
+        result = true;
+    }
+
+    return result;
+}
+
+bool furi_hal_compress_icon_pin(const uint8_t* icon_data) {
+    furi_assert(icon_data);
+
+    FuriHalCompressHeader* header = (FuriHalCompressHeader*)icon_data;
+    if(!header->is_compressed) {
+        return true;
+    } else if(!furi_hal_compress_icon_is_cacheable(icon_data)) {
+        return false;
+    }
+
+    bool result = false;
+    furi_check(osMutexAcquire(icon_decoder->mutex, osWaitForever) == osOK);
+    size_t pinned_left = FURI_HAL_COMPRESS_ICON_CACHE_PINNED_MAX - icon_decoder->stats.cache_pinned;
+    FuriHalCompressIconCacheEntry* entry = furi_hal_compress_icon_cache_find(icon_data);
+    if(entry) {
+        result = entry->pinned || (entry->size <= pinned_left);
+    } else if(icon_decoder->entries_count < FURI_HAL_COMPRESS_ICON_CACHE_ENTRIES) {
+        // Decode straight into free space: cached data in use by other thread must not move
+        size_t space_left = FURI_HAL_COMPRESS_ICON_CACHE_SIZE - icon_decoder->stats.cache_used;
+        size_t size = furi_hal_compress_icon_decode_raw(
+            header,
+            &icon_decoder->cache[icon_decoder->stats.cache_used],
+            MIN(pinned_left, space_left));
+        if(size) {
+            entry = furi_hal_compress_icon_cache_add(icon_data, size);
+            result = true;
+        }
+    }
+    if(result && !entry->pinned) {
+        entry->pinned = true;
+        icon_decoder->stats.cache_pinned += entry->size;
+    }
+    furi_check(osMutexRelease(icon_decoder->mutex) == osOK);
+
+    return result;
+}
+
+void furi_hal_compress_icon_get_stats(FuriHalCompressIconStats* stats) {
+    furi_assert(stats);
+    furi_check(osMutexAcquire(icon_decoder->mutex, osWaitForever) == osOK);
+    *stats = icon_decoder->stats;
+    furi_check(osMutexRelease(icon_decoder->mutex) == osOK);
+}
+
 FuriHalCompress* furi_hal_compress_alloc(uint16_t compress_buff_size) {
     FuriHalCompress* compress = malloc(sizeof(FuriHalCompress));
     compress->compress_buff = malloc(compress_buff_size + FURI_HAL_COMPRESS_EXP_BUFF_SIZE);
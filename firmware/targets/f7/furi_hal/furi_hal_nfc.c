@@ -4,6 +4,7 @@
 #include <furi.h>
 #include <m-string.h>
 #include <lib/nfc_protocols/nfca.h>
+#include <lib/nfc_protocols/nfc_util.h>
 
 #define TAG "FuriHalNfc"
 
@@ -370,56 +371,6 @@ ReturnCode furi_hal_nfc_data_exchange(
     return ret;
 }
 
-static uint16_t furi_hal_nfc_data_and_parity_to_bitstream(
-    uint8_t* data,
-    uint16_t len,
-    uint8_t* parity,
-    uint8_t* out) {
-    furi_assert(data);
-    furi_assert(out);
-
-    uint8_t next_par_bit = 0;
-    uint16_t curr_bit_pos = 0;
-    for(uint16_t i = 0; i < len; i++) {
-        next_par_bit = FURI_BIT(parity[i / 8], 7 - (i % 8));
-        if(curr_bit_pos % 8 == 0) {
-            out[curr_bit_pos / 8] = data[i];
-            curr_bit_pos += 8;
-            out[curr_bit_pos / 8] = next_par_bit;
-            curr_bit_pos++;
-        } else {
-            out[curr_bit_pos / 8] |= data[i] << curr_bit_pos % 8;
-            out[curr_bit_pos / 8 + 1] = data[i] >> (8 - curr_bit_pos % 8);
-            out[curr_bit_pos / 8 + 1] |= next_par_bit << curr_bit_pos % 8;
-            curr_bit_pos += 9;
-        }
-    }
-    return curr_bit_pos;
-}
-
-uint16_t furi_hal_nfc_bitstream_to_data_and_parity(
-    uint8_t* in_buff,
-    uint16_t in_buff_bits,
-    uint8_t* out_data,
-    uint8_t* out_parity) {
-    if(in_buff_bits % 9 != 0) {
-        return 0;
-    }
-
-    uint8_t curr_byte = 0;
-    uint16_t bit_processed = 0;
-    memset(out_parity, 0, in_buff_bits / 9);
-    while(bit_processed < in_buff_bits) {
-        out_data[curr_byte] = in_buff[bit_processed / 8] >> bit_processed % 8;
-        out_data[curr_byte] |= in_buff[bit_processed / 8 + 1] << (8 - bit_processed % 8);
-        out_parity[curr_byte / 8] |= FURI_BIT(in_buff[bit_processed / 8 + 1], bit_processed % 8)
-                                     << (7 - curr_byte % 8);
-        bit_processed += 9;
-        curr_byte++;
-    }
-    return curr_byte;
-}
-
 bool furi_hal_nfc_tx_rx(FuriHalNfcTxRxContext* tx_rx_ctx) {
     furi_assert(tx_rx_ctx);
 
@@ -432,7 +383,7 @@ bool furi_hal_nfc_tx_rx(FuriHalNfcTxRxContext* tx_rx_ctx) {
 
     // Prepare data for FIFO if necessary
     if(tx_rx_ctx->tx_rx_type == FURI_HAL_NFC_TXRX_RAW) {
-        temp_tx_bits = furi_hal_nfc_data_and_parity_to_bitstream(
+        temp_tx_bits = nfc_util_merge_data_and_parity(
             tx_rx_ctx->tx_data, tx_rx_ctx->tx_bits / 8, tx_rx_ctx->tx_parity, temp_tx_buff);
         ret = rfalNfcDataExchangeCustomStart(
             temp_tx_buff,
@@ -471,7 +422,7 @@ bool furi_hal_nfc_tx_rx(FuriHalNfcTxRxContext* tx_rx_ctx) {
 
     if(tx_rx_ctx->tx_rx_type == FURI_HAL_NFC_TXRX_RAW) {
         tx_rx_ctx->rx_bits =
-            8 * furi_hal_nfc_bitstream_to_data_and_parity(
+            8 * nfc_util_split_data_and_parity(
                     temp_rx_buff, *temp_rx_bits, tx_rx_ctx->rx_data, tx_rx_ctx->rx_parity);
     } else {
         memcpy(tx_rx_ctx->rx_data, temp_rx_buff, *temp_rx_bits / 8);
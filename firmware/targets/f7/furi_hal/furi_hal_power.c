@@ -295,6 +295,35 @@ float furi_hal_power_get_usb_voltage() {
     return ret;
 }
 
+bool furi_hal_power_get_telemetry(FuriHalPowerTelemetry* telemetry) {
+    furi_assert(telemetry);
+    ChargerTelemetry charger;
+    BatteryTelemetry gauge;
+
+    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+    bool ret = bq25896_get_telemetry(&furi_hal_i2c_handle_power, &charger) &&
+               bq27220_get_telemetry(&furi_hal_i2c_handle_power, &gauge);
+    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+
+    if(ret) {
+        telemetry->charging = charger.charging;
+        telemetry->voltage_charger = (float)charger.vbat_voltage / 1000.0f;
+        telemetry->voltage_gauge = (float)gauge.voltage / 1000.0f;
+        telemetry->voltage_vbus = (float)charger.vbus_voltage / 1000.0f;
+        telemetry->current_charger = (float)charger.vbat_current / 1000.0f;
+        telemetry->current_gauge = (float)gauge.current / 1000.0f;
+        // Same conversions as in furi_hal_power_get_battery_temperature_internal
+        telemetry->temperature_charger = (71.0f - (float)charger.ntc_mpct / 1000) / 0.6f;
+        telemetry->temperature_gauge = ((float)gauge.temperature - 2731.0f) / 10.0f;
+        telemetry->capacity_remaining = gauge.remaining_capacity;
+        telemetry->capacity_full = gauge.full_charge_capacity;
+        telemetry->charge = gauge.state_of_charge;
+        telemetry->health = gauge.state_of_health;
+    }
+
+    return ret;
+}
+
 void furi_hal_power_dump_state() {
     BatteryStatus battery_status;
     OperationStatus operation_status;
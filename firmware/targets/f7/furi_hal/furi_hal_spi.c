@@ -1,5 +1,6 @@
 #include "furi_hal_spi.h"
 #include "furi_hal_resources.h"
+#include "furi_hal_power.h"
 
 #include <stdbool.h>
 #include <string.h>
@@ -26,12 +27,22 @@ void furi_hal_spi_init() {
 
 void furi_hal_spi_bus_init(FuriHalSpiBus* bus) {
     furi_assert(bus);
+    bus->queue = NULL;
+    bus->queue_active = NULL;
+    bus->held = false;
+    bus->idle_waiting = false;
+    bus->idle = osSemaphoreNew(1, 0, NULL);
+    bus->dma_done = osSemaphoreNew(1, 0, NULL);
     bus->callback(bus, FuriHalSpiBusEventInit);
 }
 
 void furi_hal_spi_bus_deinit(FuriHalSpiBus* bus) {
     furi_assert(bus);
+    furi_assert(bus->queue == NULL);
+    furi_assert(bus->queue_active == NULL);
     bus->callback(bus, FuriHalSpiBusEventDeinit);
+    osSemaphoreDelete(bus->idle);
+    osSemaphoreDelete(bus->dma_done);
 }
 
 void furi_hal_spi_bus_handle_init(FuriHalSpiBusHandle* handle) {
@@ -44,10 +55,169 @@ void furi_hal_spi_bus_handle_deinit(FuriHalSpiBusHandle* handle) {
     handle->callback(handle, FuriHalSpiBusHandleEventDeinit);
 }
 
+static void furi_hal_spi_queue_start_transfer(FuriHalSpiBus* bus, FuriHalSpiJob* job) {
+    const FuriHalSpiTransfer* transfer = &job->transfers[job->index];
+    if(transfer->setup) {
+        transfer->setup(transfer);
+    }
+    bus->dma->start(bus, transfer);
+}
+
+/* Start first pending job if bus is free, must be called in critical section */
+static void furi_hal_spi_queue_next(FuriHalSpiBus* bus) {
+    if(bus->held || bus->queue_active || !bus->queue) {
+        return;
+    }
+
+    FuriHalSpiJob* job = bus->queue;
+    bus->queue = job->next;
+    bus->queue_active = job;
+    job->state = FuriHalSpiJobStateActive;
+
+    // Deep sleep stops DMA
+    furi_hal_power_insomnia_enter();
+    bus->callback(bus, FuriHalSpiBusEventActivate);
+    bus->current_handle = job->handle;
+    job->handle->callback(job->handle, FuriHalSpiBusHandleEventActivate);
+
+    furi_hal_spi_queue_start_transfer(bus, job);
+}
+
+/* Release CS and bus after active job, must be called in critical section */
+static void furi_hal_spi_queue_finish(FuriHalSpiBus* bus, FuriHalSpiJobState state) {
+    FuriHalSpiJob* job = bus->queue_active;
+
+    job->handle->callback(job->handle, FuriHalSpiBusHandleEventDeactivate);
+    bus->current_handle = NULL;
+    bus->callback(bus, FuriHalSpiBusEventDeactivate);
+    furi_hal_power_insomnia_exit();
+
+    bus->queue_active = NULL;
+    job->state = state;
+}
+
+/* Check if waiting holder must be woken up, must be called in critical section after
+ * `furi_hal_spi_queue_next`. Another job may have been started in the meantime. */
+static bool furi_hal_spi_queue_idle_wake(FuriHalSpiBus* bus) {
+    if(bus->idle_waiting && !bus->queue_active) {
+        bus->idle_waiting = false;
+        return true;
+    }
+    return false;
+}
+
+void furi_hal_spi_job_submit(FuriHalSpiJob* job) {
+    furi_assert(job);
+    furi_assert(job->handle);
+    furi_assert(job->handle->bus->dma);
+    furi_assert(job->transfers);
+    furi_assert(job->transfers_count > 0);
+    furi_assert(job->state != FuriHalSpiJobStatePending);
+    furi_assert(job->state != FuriHalSpiJobStateActive);
+
+    FuriHalSpiBus* bus = job->handle->bus;
+    job->next = NULL;
+    job->index = 0;
+    job->state = FuriHalSpiJobStatePending;
+
+    FURI_CRITICAL_ENTER();
+    // Behind all jobs of same or higher priority
+    FuriHalSpiJob** position = &bus->queue;
+    while(*position && (*position)->handle->priority >= job->handle->priority) {
+        position = &(*position)->next;
+    }
+    job->next = *position;
+    *position = job;
+    furi_hal_spi_queue_next(bus);
+    FURI_CRITICAL_EXIT();
+}
+
+bool furi_hal_spi_job_cancel(FuriHalSpiJob* job) {
+    furi_assert(job);
+    FuriHalSpiBus* bus = job->handle->bus;
+    bool canceled = false;
+    bool wake = false;
+
+    FURI_CRITICAL_ENTER();
+    if(job->state == FuriHalSpiJobStatePending) {
+        FuriHalSpiJob** position = &bus->queue;
+        while(*position != job) {
+            position = &(*position)->next;
+        }
+        *position = job->next;
+        job->state = FuriHalSpiJobStateCanceled;
+        canceled = true;
+    } else if(job->state == FuriHalSpiJobStateActive) {
+        bus->dma->stop(bus);
+        furi_hal_spi_queue_finish(bus, FuriHalSpiJobStateCanceled);
+        furi_hal_spi_queue_next(bus);
+        canceled = true;
+        wake = furi_hal_spi_queue_idle_wake(bus);
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(wake) {
+        osSemaphoreRelease(bus->idle);
+    }
+    if(canceled && job->callback) {
+        job->callback(job, job->context);
+    }
+
+    return canceled;
+}
+
+void furi_hal_spi_bus_dma_complete(FuriHalSpiBus* bus) {
+    furi_assert(bus);
+    FuriHalSpiJob* finished = NULL;
+    bool wake = false;
+
+    FURI_CRITICAL_ENTER();
+    FuriHalSpiJob* job = bus->queue_active;
+    if(job) {
+        job->index++;
+        if(job->index < job->transfers_count) {
+            furi_hal_spi_queue_start_transfer(bus, job);
+        } else {
+            furi_hal_spi_queue_finish(bus, FuriHalSpiJobStateDone);
+            furi_hal_spi_queue_next(bus);
+            finished = job;
+            wake = furi_hal_spi_queue_idle_wake(bus);
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    // Semaphores are released from interrupt directly, event flags would go through timer task
+    if(!job) {
+        // Blocking transfer of bus holder
+        osSemaphoreRelease(bus->dma_done);
+    } else if(finished) {
+        if(wake) {
+            osSemaphoreRelease(bus->idle);
+        }
+        if(finished->callback) {
+            finished->callback(finished, finished->context);
+        }
+    }
+}
+
 void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle) {
     furi_assert(handle);
 
     handle->bus->callback(handle->bus, FuriHalSpiBusEventLock);
+
+    // Stop queue and let active job finish, recheck after every wake up
+    bool busy = true;
+    while(busy) {
+        FURI_CRITICAL_ENTER();
+        handle->bus->held = true;
+        busy = handle->bus->queue_active != NULL;
+        handle->bus->idle_waiting = busy;
+        FURI_CRITICAL_EXIT();
+        if(busy) {
+            osSemaphoreAcquire(handle->bus->idle, osWaitForever);
+        }
+    }
+
     handle->bus->callback(handle->bus, FuriHalSpiBusEventActivate);
 
     furi_assert(handle->bus->current_handle == NULL);
@@ -66,6 +236,13 @@ void furi_hal_spi_release(FuriHalSpiBusHandle* handle) {
 
     // Bus events
     handle->bus->callback(handle->bus, FuriHalSpiBusEventDeactivate);
+
+    // Resume queue
+    FURI_CRITICAL_ENTER();
+    handle->bus->held = false;
+    furi_hal_spi_queue_next(handle->bus);
+    FURI_CRITICAL_EXIT();
+
     handle->bus->callback(handle->bus, FuriHalSpiBusEventUnlock);
 }
 
@@ -153,3 +330,35 @@ bool furi_hal_spi_bus_trx(
 
     return ret;
 }
+
+bool furi_hal_spi_bus_trx_dma(
+    FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout) {
+    furi_assert(handle);
+    furi_assert(handle->bus->current_handle == handle);
+    furi_assert(handle->bus->held);
+    furi_assert(handle->bus->dma);
+    furi_assert(size > 0);
+
+    const FuriHalSpiTransfer transfer = {
+        .tx_buffer = tx_buffer,
+        .rx_buffer = rx_buffer,
+        .size = size,
+    };
+
+    bool ret = true;
+    furi_hal_power_insomnia_enter();
+    handle->bus->dma->start(handle->bus, &transfer);
+    if(osSemaphoreAcquire(handle->bus->dma_done, timeout) != osOK) {
+        handle->bus->dma->stop(handle->bus);
+        // Completion may have slipped in before stop
+        osSemaphoreAcquire(handle->bus->dma_done, 0);
+        ret = false;
+    }
+    furi_hal_power_insomnia_exit();
+
+    return ret;
+}
@@ -1,5 +1,9 @@
 #include <furi_hal_spi_config.h>
 #include <furi_hal_resources.h>
+#include <furi_hal_interrupt.h>
+#include <furi_hal_spi.h>
+
+#include <stm32wbxx_ll_dma.h>
 
 /* SPI Presets */
 
@@ -68,6 +72,135 @@ const LL_SPI_InitTypeDef furi_hal_spi_preset_1edge_low_2m = {
     .CRCPoly = 7,
 };
 
+/* SPI DMA, on DMA2 which is not used by others */
+
+static const uint8_t furi_hal_spi_dma_fill = 0xFF;
+static uint8_t furi_hal_spi_dma_sink;
+
+static void furi_hal_spi_dma_start(
+    FuriHalSpiBus* bus,
+    uint32_t rx_channel,
+    uint32_t tx_channel,
+    uint32_t rx_request,
+    uint32_t tx_request,
+    const FuriHalSpiTransfer* transfer) {
+    furi_assert(transfer->size > 0);
+    furi_assert(transfer->size <= UINT16_MAX);
+
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress = LL_SPI_DMA_GetRegAddr(bus->spi);
+    dma_config.Mode = LL_DMA_MODE_NORMAL;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
+    dma_config.NbData = transfer->size;
+
+    // Receive into buffer or into single byte sink
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    if(transfer->rx_buffer) {
+        dma_config.MemoryOrM2MDstAddress = (uint32_t)transfer->rx_buffer;
+        dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    } else {
+        dma_config.MemoryOrM2MDstAddress = (uint32_t)&furi_hal_spi_dma_sink;
+        dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_NOINCREMENT;
+    }
+    dma_config.PeriphRequest = rx_request;
+    dma_config.Priority = LL_DMA_PRIORITY_HIGH;
+    LL_DMA_Init(DMA2, rx_channel, &dma_config);
+    LL_DMA_EnableIT_TC(DMA2, rx_channel);
+
+    // Transmit buffer or 0xFF
+    dma_config.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    if(transfer->tx_buffer) {
+        dma_config.MemoryOrM2MDstAddress = (uint32_t)transfer->tx_buffer;
+        dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    } else {
+        dma_config.MemoryOrM2MDstAddress = (uint32_t)&furi_hal_spi_dma_fill;
+        dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_NOINCREMENT;
+    }
+    dma_config.PeriphRequest = tx_request;
+    dma_config.Priority = LL_DMA_PRIORITY_MEDIUM;
+    LL_DMA_Init(DMA2, tx_channel, &dma_config);
+
+    // RX first, so no byte is lost
+    LL_SPI_EnableDMAReq_RX(bus->spi);
+    LL_DMA_EnableChannel(DMA2, rx_channel);
+    LL_DMA_EnableChannel(DMA2, tx_channel);
+    LL_SPI_EnableDMAReq_TX(bus->spi);
+}
+
+static void furi_hal_spi_dma_stop(FuriHalSpiBus* bus, uint32_t rx_channel, uint32_t tx_channel) {
+    LL_SPI_DisableDMAReq_TX(bus->spi);
+    LL_DMA_DisableChannel(DMA2, tx_channel);
+    while(LL_SPI_GetTxFIFOLevel(bus->spi) != LL_SPI_TX_FIFO_EMPTY)
+        ;
+    while(LL_SPI_IsActiveFlag_BSY(bus->spi))
+        ;
+    LL_DMA_DisableIT_TC(DMA2, rx_channel);
+    LL_DMA_DisableChannel(DMA2, rx_channel);
+    LL_SPI_DisableDMAReq_RX(bus->spi);
+    while(LL_SPI_GetRxFIFOLevel(bus->spi) != LL_SPI_RX_FIFO_EMPTY) {
+        LL_SPI_ReceiveData8(bus->spi);
+    }
+    LL_SPI_ClearFlag_OVR(bus->spi);
+}
+
+static void furi_hal_spi_bus_r_dma_start(FuriHalSpiBus* bus, const FuriHalSpiTransfer* transfer) {
+    furi_hal_spi_dma_start(
+        bus,
+        LL_DMA_CHANNEL_1,
+        LL_DMA_CHANNEL_2,
+        LL_DMAMUX_REQ_SPI1_RX,
+        LL_DMAMUX_REQ_SPI1_TX,
+        transfer);
+}
+
+static void furi_hal_spi_bus_r_dma_stop(FuriHalSpiBus* bus) {
+    furi_hal_spi_dma_stop(bus, LL_DMA_CHANNEL_1, LL_DMA_CHANNEL_2);
+    LL_DMA_ClearFlag_GI1(DMA2);
+    LL_DMA_ClearFlag_GI2(DMA2);
+}
+
+static void furi_hal_spi_bus_r_dma_isr() {
+    if(LL_DMA_IsActiveFlag_TC1(DMA2)) {
+        furi_hal_spi_bus_r_dma_stop(&furi_hal_spi_bus_r);
+        furi_hal_spi_bus_dma_complete(&furi_hal_spi_bus_r);
+    }
+}
+
+static const FuriHalSpiBusDma furi_hal_spi_bus_r_dma = {
+    .start = furi_hal_spi_bus_r_dma_start,
+    .stop = furi_hal_spi_bus_r_dma_stop,
+};
+
+static void furi_hal_spi_bus_d_dma_start(FuriHalSpiBus* bus, const FuriHalSpiTransfer* transfer) {
+    furi_hal_spi_dma_start(
+        bus,
+        LL_DMA_CHANNEL_6,
+        LL_DMA_CHANNEL_7,
+        LL_DMAMUX_REQ_SPI2_RX,
+        LL_DMAMUX_REQ_SPI2_TX,
+        transfer);
+}
+
+static void furi_hal_spi_bus_d_dma_stop(FuriHalSpiBus* bus) {
+    furi_hal_spi_dma_stop(bus, LL_DMA_CHANNEL_6, LL_DMA_CHANNEL_7);
+    LL_DMA_ClearFlag_GI6(DMA2);
+    LL_DMA_ClearFlag_GI7(DMA2);
+}
+
+static void furi_hal_spi_bus_d_dma_isr() {
+    if(LL_DMA_IsActiveFlag_TC6(DMA2)) {
+        furi_hal_spi_bus_d_dma_stop(&furi_hal_spi_bus_d);
+        furi_hal_spi_bus_dma_complete(&furi_hal_spi_bus_d);
+    }
+}
+
+static const FuriHalSpiBusDma furi_hal_spi_bus_d_dma = {
+    .start = furi_hal_spi_bus_d_dma_start,
+    .stop = furi_hal_spi_bus_d_dma_stop,
+};
+
 /* SPI Buses */
 
 osMutexId_t furi_hal_spi_bus_r_mutex = NULL;
@@ -79,7 +212,14 @@ static void furi_hal_spi_bus_r_event_callback(FuriHalSpiBus* bus, FuriHalSpiBusE
         LL_APB2_GRP1_ForceReset(LL_APB2_GRP1_PERIPH_SPI1);
         FURI_CRITICAL_EXIT();
         bus->current_handle = NULL;
+
+        furi_hal_interrupt_set_dma_channel_isr(DMA2, LL_DMA_CHANNEL_1, furi_hal_spi_bus_r_dma_isr);
+        NVIC_SetPriority(
+            DMA2_Channel1_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 5, 0));
+        NVIC_EnableIRQ(DMA2_Channel1_IRQn);
     } else if(event == FuriHalSpiBusEventDeinit) {
+        NVIC_DisableIRQ(DMA2_Channel1_IRQn);
+        furi_hal_interrupt_set_dma_channel_isr(DMA2, LL_DMA_CHANNEL_1, NULL);
         furi_check(osMutexDelete(furi_hal_spi_bus_r_mutex));
     } else if(event == FuriHalSpiBusEventLock) {
         furi_check(osMutexAcquire(furi_hal_spi_bus_r_mutex, osWaitForever) == osOK);
@@ -99,6 +239,7 @@ static void furi_hal_spi_bus_r_event_callback(FuriHalSpiBus* bus, FuriHalSpiBusE
 FuriHalSpiBus furi_hal_spi_bus_r = {
     .spi = SPI1,
     .callback = furi_hal_spi_bus_r_event_callback,
+    .dma = &furi_hal_spi_bus_r_dma,
 };
 
 osMutexId_t furi_hal_spi_bus_d_mutex = NULL;
@@ -110,7 +251,14 @@ static void furi_hal_spi_bus_d_event_callback(FuriHalSpiBus* bus, FuriHalSpiBusE
         LL_APB1_GRP1_ForceReset(LL_APB1_GRP1_PERIPH_SPI2);
         FURI_CRITICAL_EXIT();
         bus->current_handle = NULL;
+
+        furi_hal_interrupt_set_dma_channel_isr(DMA2, LL_DMA_CHANNEL_6, furi_hal_spi_bus_d_dma_isr);
+        NVIC_SetPriority(
+            DMA2_Channel6_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 5, 0));
+        NVIC_EnableIRQ(DMA2_Channel6_IRQn);
     } else if(event == FuriHalSpiBusEventDeinit) {
+        NVIC_DisableIRQ(DMA2_Channel6_IRQn);
+        furi_hal_interrupt_set_dma_channel_isr(DMA2, LL_DMA_CHANNEL_6, NULL);
         furi_check(osMutexDelete(furi_hal_spi_bus_d_mutex));
     } else if(event == FuriHalSpiBusEventLock) {
         furi_check(osMutexAcquire(furi_hal_spi_bus_d_mutex, osWaitForever) == osOK);
@@ -130,6 +278,7 @@ static void furi_hal_spi_bus_d_event_callback(FuriHalSpiBus* bus, FuriHalSpiBusE
 FuriHalSpiBus furi_hal_spi_bus_d = {
     .spi = SPI2,
     .callback = furi_hal_spi_bus_d_event_callback,
+    .dma = &furi_hal_spi_bus_d_dma,
 };
 
 /* SPI Bus Handles */
@@ -189,6 +338,7 @@ static void furi_hal_spi_bus_handle_subghz_event_callback(
 FuriHalSpiBusHandle furi_hal_spi_bus_handle_subghz = {
     .bus = &furi_hal_spi_bus_r,
     .callback = furi_hal_spi_bus_handle_subghz_event_callback,
+    .priority = FuriHalSpiPriorityHigh,
     .miso = &gpio_spi_r_miso,
     .mosi = &gpio_spi_r_mosi,
     .sck = &gpio_spi_r_sck,
@@ -204,6 +354,7 @@ static void furi_hal_spi_bus_handle_nfc_event_callback(
 FuriHalSpiBusHandle furi_hal_spi_bus_handle_nfc = {
     .bus = &furi_hal_spi_bus_r,
     .callback = furi_hal_spi_bus_handle_nfc_event_callback,
+    .priority = FuriHalSpiPriorityHigh,
     .miso = &gpio_spi_r_miso,
     .mosi = &gpio_spi_r_mosi,
     .sck = &gpio_spi_r_sck,
@@ -219,6 +370,7 @@ static void furi_hal_spi_bus_handle_external_event_callback(
 FuriHalSpiBusHandle furi_hal_spi_bus_handle_external = {
     .bus = &furi_hal_spi_bus_r,
     .callback = furi_hal_spi_bus_handle_external_event_callback,
+    .priority = FuriHalSpiPriorityNormal,
     .miso = &gpio_ext_pa6,
     .mosi = &gpio_ext_pa7,
     .sck = &gpio_ext_pb3,
@@ -275,6 +427,7 @@ static void furi_hal_spi_bus_handle_display_event_callback(
 FuriHalSpiBusHandle furi_hal_spi_bus_handle_display = {
     .bus = &furi_hal_spi_bus_d,
     .callback = furi_hal_spi_bus_handle_display_event_callback,
+    .priority = FuriHalSpiPriorityNormal,
     .miso = &gpio_spi_d_miso,
     .mosi = &gpio_spi_d_mosi,
     .sck = &gpio_spi_d_sck,
@@ -290,6 +443,7 @@ static void furi_hal_spi_bus_handle_sd_fast_event_callback(
 FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_fast = {
     .bus = &furi_hal_spi_bus_d,
     .callback = furi_hal_spi_bus_handle_sd_fast_event_callback,
+    .priority = FuriHalSpiPriorityLow,
     .miso = &gpio_spi_d_miso,
     .mosi = &gpio_spi_d_mosi,
     .sck = &gpio_spi_d_sck,
@@ -305,6 +459,7 @@ static void furi_hal_spi_bus_handle_sd_slow_event_callback(
 FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_slow = {
     .bus = &furi_hal_spi_bus_d,
     .callback = furi_hal_spi_bus_handle_sd_slow_event_callback,
+    .priority = FuriHalSpiPriorityLow,
     .miso = &gpio_spi_d_miso,
     .mosi = &gpio_spi_d_mosi,
     .sck = &gpio_spi_d_sck,
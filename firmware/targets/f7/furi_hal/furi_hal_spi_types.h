@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include <furi_hal_gpio.h>
 
@@ -9,12 +10,16 @@
 #include <stm32wbxx_ll_rcc.h>
 #include <stm32wbxx_ll_bus.h>
 
+#include <cmsis_os2.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct FuriHalSpiBus FuriHalSpiBus;
 typedef struct FuriHalSpiBusHandle FuriHalSpiBusHandle;
+typedef struct FuriHalSpiTransfer FuriHalSpiTransfer;
+typedef struct FuriHalSpiJob FuriHalSpiJob;
 
 /** FuriHal spi bus states */
 typedef enum {
@@ -29,11 +34,26 @@ typedef enum {
 /** FuriHal spi bus event callback */
 typedef void (*FuriHalSpiBusEventCallback)(FuriHalSpiBus* bus, FuriHalSpiBusEvent event);
 
+/** FuriHal spi bus DMA, moves one transfer and reports it with `furi_hal_spi_bus_dma_complete` */
+typedef struct {
+    void (*start)(FuriHalSpiBus* bus, const FuriHalSpiTransfer* transfer);
+    void (*stop)(FuriHalSpiBus* bus); /**< abort transfer in progress, no completion reported */
+} FuriHalSpiBusDma;
+
 /** FuriHal spi bus */
 struct FuriHalSpiBus {
     SPI_TypeDef* spi;
     FuriHalSpiBusEventCallback callback;
     FuriHalSpiBusHandle* current_handle;
+    const FuriHalSpiBusDma* dma; /**< NULL if bus can't do asynchronous transfers */
+
+    /* Job queue, modified in critical sections only */
+    FuriHalSpiJob* queue; /**< pending jobs, by handle priority */
+    FuriHalSpiJob* queue_active;
+    bool held; /**< acquired with `furi_hal_spi_acquire`, jobs wait */
+    bool idle_waiting; /**< holder waits for active job, released once queue is idle */
+    osSemaphoreId_t idle; /**< binary, released from DMA interrupt directly */
+    osSemaphoreId_t dma_done; /**< binary, blocking DMA transfer of holder finished */
 };
 
 /** FuriHal spi handle states */
@@ -49,16 +69,65 @@ typedef void (*FuriHalSpiBusHandleEventCallback)(
     FuriHalSpiBusHandle* handle,
     FuriHalSpiBusHandleEvent event);
 
+/** FuriHal spi handle priority, higher priority jobs are started first */
+typedef enum {
+    FuriHalSpiPriorityLow,
+    FuriHalSpiPriorityNormal,
+    FuriHalSpiPriorityHigh,
+} FuriHalSpiPriority;
+
 /** FuriHal spi handle */
 struct FuriHalSpiBusHandle {
     FuriHalSpiBus* bus;
     FuriHalSpiBusHandleEventCallback callback;
+    FuriHalSpiPriority priority;
     const GpioPin* miso;
     const GpioPin* mosi;
     const GpioPin* sck;
     const GpioPin* cs;
 };
 
+/** FuriHal spi transfer setup callback, called from interrupt before transfer starts */
+typedef void (*FuriHalSpiTransferSetupCallback)(const FuriHalSpiTransfer* transfer);
+
+/** FuriHal spi transfer */
+struct FuriHalSpiTransfer {
+    const uint8_t* tx_buffer; /**< data to send, NULL sends 0xFF */
+    uint8_t* rx_buffer; /**< received data, NULL discards it */
+    size_t size;
+    FuriHalSpiTransferSetupCallback setup; /**< optional, e.g. to switch D/C line */
+    void* context; /**< setup callback context */
+};
+
+/** FuriHal spi job states */
+typedef enum {
+    FuriHalSpiJobStateIdle, /**< never submitted */
+    FuriHalSpiJobStatePending, /**< waiting in queue */
+    FuriHalSpiJobStateActive, /**< transfers in progress */
+    FuriHalSpiJobStateDone, /**< all transfers completed */
+    FuriHalSpiJobStateCanceled, /**< removed from queue or aborted */
+} FuriHalSpiJobState;
+
+/** FuriHal spi job callback, called from interrupt or from canceling thread */
+typedef void (*FuriHalSpiJobCallback)(FuriHalSpiJob* job, void* context);
+
+/** FuriHal spi job: transfers done in one CS assertion
+ *
+ * Job, transfers and buffers are owned by caller and must stay intact until callback.
+ */
+struct FuriHalSpiJob {
+    FuriHalSpiBusHandle* handle;
+    const FuriHalSpiTransfer* transfers;
+    size_t transfers_count;
+    FuriHalSpiJobCallback callback;
+    void* context;
+
+    /* Private, maintained by queue */
+    FuriHalSpiJob* next;
+    size_t index;
+    volatile FuriHalSpiJobState state;
+};
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
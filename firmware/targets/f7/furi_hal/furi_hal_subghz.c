@@ -10,6 +10,7 @@
 #include <furi.h>
 #include <cc1101.h>
 #include <stdio.h>
+#include <string.h>
 
 #define TAG "FuriHalSubGhz"
 
@@ -17,6 +18,10 @@ static volatile SubGhzState furi_hal_subghz_state = SubGhzStateInit;
 static volatile SubGhzRegulation furi_hal_subghz_regulation = SubGhzRegulationTxRx;
 static volatile FuriHalSubGhzPreset furi_hal_subghz_preset = FuriHalSubGhzPresetIDLE;
 
+/* Copy of CC1101 common registers, test registers are lost in sleep */
+static uint8_t furi_hal_subghz_shadow[CC1101_CONFIG_SIZE];
+static bool furi_hal_subghz_shadow_valid = false;
+
 static const uint8_t furi_hal_subghz_preset_ook_270khz_async_regs[][2] = {
     // https://e2e.ti.com/support/wireless-connectivity/sub-1-ghz-group/sub-1-ghz/f/sub-1-ghz-forum/382066/cc1101---don-t-know-the-correct-registers-configuration
 
@@ -320,6 +325,23 @@ static const uint8_t furi_hal_subghz_preset_gfsk_async_patable[8] = {
     0x00,
     0x00};
 
+/* Chip access helpers keep shadow in sync, bus must be acquired */
+static void furi_hal_subghz_chip_reset() {
+    cc1101_reset(&furi_hal_spi_bus_handle_subghz);
+    memcpy(furi_hal_subghz_shadow, cc1101_reset_values, CC1101_CONFIG_SIZE);
+    furi_hal_subghz_shadow_valid = true;
+}
+
+static void furi_hal_subghz_chip_shutdown() {
+    cc1101_shutdown(&furi_hal_spi_bus_handle_subghz);
+    furi_hal_subghz_shadow_valid = false;
+}
+
+static void furi_hal_subghz_chip_write_reg(uint8_t reg, uint8_t data) {
+    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, reg, data);
+    furi_hal_subghz_shadow[reg] = data;
+}
+
 void furi_hal_subghz_init() {
     furi_assert(furi_hal_subghz_state == SubGhzStateInit);
     furi_hal_subghz_state = SubGhzStateIdle;
@@ -333,33 +355,32 @@ void furi_hal_subghz_init() {
 
     // Reset
     hal_gpio_init(&gpio_cc1101_g0, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
-    cc1101_reset(&furi_hal_spi_bus_handle_subghz);
-    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG0, CC1101IocfgHighImpedance);
+    furi_hal_subghz_chip_reset();
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG0, CC1101IocfgHighImpedance);
 
     // Prepare GD0 for power on self test
     hal_gpio_init(&gpio_cc1101_g0, GpioModeInput, GpioPullNo, GpioSpeedLow);
 
     // GD0 low
-    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG0, CC1101IocfgHW);
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG0, CC1101IocfgHW);
     while(hal_gpio_read(&gpio_cc1101_g0) != false)
         ;
 
     // GD0 high
-    cc1101_write_reg(
-        &furi_hal_spi_bus_handle_subghz, CC1101_IOCFG0, CC1101IocfgHW | CC1101_IOCFG_INV);
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG0, CC1101IocfgHW | CC1101_IOCFG_INV);
     while(hal_gpio_read(&gpio_cc1101_g0) != true)
         ;
 
     // Reset GD0 to floating state
-    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG0, CC1101IocfgHighImpedance);
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG0, CC1101IocfgHighImpedance);
     hal_gpio_init(&gpio_cc1101_g0, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
 
     // RF switches
     hal_gpio_init(&gpio_rf_sw_0, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
-    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG2, CC1101IocfgHW);
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG2, CC1101IocfgHW);
 
     // Go to sleep
-    cc1101_shutdown(&furi_hal_spi_bus_handle_subghz);
+    furi_hal_subghz_chip_shutdown();
 
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
     FURI_LOG_I(TAG, "Init OK");
@@ -371,10 +392,10 @@ void furi_hal_subghz_sleep() {
 
     cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
 
-    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG0, CC1101IocfgHighImpedance);
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG0, CC1101IocfgHighImpedance);
     hal_gpio_init(&gpio_cc1101_g0, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
 
-    cc1101_shutdown(&furi_hal_spi_bus_handle_subghz);
+    furi_hal_subghz_chip_shutdown();
 
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
 
@@ -416,13 +437,25 @@ void furi_hal_subghz_load_preset(FuriHalSubGhzPreset preset) {
 }
 
 void furi_hal_subghz_load_registers(const uint8_t data[][2]) {
+    // Registers missing in preset get reset values, same as after chip reset
+    uint8_t image[CC1101_CONFIG_SIZE];
+    memcpy(image, cc1101_reset_values, CC1101_CONFIG_SIZE);
+    for(size_t i = 0; data[i][0]; i++) {
+        furi_check(data[i][0] < CC1101_CONFIG_SIZE);
+        image[data[i][0]] = data[i][1];
+    }
+
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-    cc1101_reset(&furi_hal_spi_bus_handle_subghz);
-    uint32_t i = 0;
-    while(data[i][0]) {
-        cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, data[i][0], data[i][1]);
-        i++;
+    if(furi_hal_subghz_shadow_valid) {
+        cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+        // Calibration results are written by chip, shadow doesn't know them
+        for(uint8_t reg = CC1101_FSCAL3; reg <= CC1101_FSCAL1; reg++) {
+            furi_hal_subghz_shadow[reg] = ~image[reg];
+        }
+    } else {
+        furi_hal_subghz_chip_reset();
     }
+    cc1101_write_changed(&furi_hal_spi_bus_handle_subghz, furi_hal_subghz_shadow, image);
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
 }
 
@@ -487,7 +520,7 @@ void furi_hal_subghz_read_packet(uint8_t* data, uint8_t* size) {
 void furi_hal_subghz_shutdown() {
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
     // Reset and shutdown
-    cc1101_shutdown(&furi_hal_spi_bus_handle_subghz);
+    furi_hal_subghz_chip_shutdown();
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
 }
 
@@ -495,8 +528,8 @@ void furi_hal_subghz_reset() {
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
     hal_gpio_init(&gpio_cc1101_g0, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
     cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-    cc1101_reset(&furi_hal_spi_bus_handle_subghz);
-    cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG0, CC1101IocfgHighImpedance);
+    furi_hal_subghz_chip_reset();
+    furi_hal_subghz_chip_write_reg(CC1101_IOCFG0, CC1101IocfgHighImpedance);
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
 }
 
@@ -611,6 +644,14 @@ bool furi_hal_subghz_is_tx_allowed(uint32_t value) {
     return is_allowed;
 }
 
+/* Same control word as cc1101_set_frequency writes */
+static void furi_hal_subghz_shadow_frequency(uint32_t value) {
+    uint64_t real_value = (uint64_t)value * CC1101_FDIV / CC1101_QUARTZ;
+    furi_hal_subghz_shadow[CC1101_FREQ2] = (real_value >> 16) & 0xFF;
+    furi_hal_subghz_shadow[CC1101_FREQ1] = (real_value >> 8) & 0xFF;
+    furi_hal_subghz_shadow[CC1101_FREQ0] = (real_value >> 0) & 0xFF;
+}
+
 uint32_t furi_hal_subghz_set_frequency(uint32_t value) {
     if(furi_hal_subghz_is_tx_allowed(value)) {
         furi_hal_subghz_regulation = SubGhzRegulationTxRx;
@@ -620,6 +661,7 @@ uint32_t furi_hal_subghz_set_frequency(uint32_t value) {
 
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
     uint32_t real_frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, value);
+    furi_hal_subghz_shadow_frequency(value);
     cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
 
     while(true) {
@@ -631,22 +673,52 @@ uint32_t furi_hal_subghz_set_frequency(uint32_t value) {
     return real_frequency;
 }
 
+uint32_t furi_hal_subghz_hop_prepare(FuriHalSubGhzHop* hop, uint32_t value) {
+    furi_assert(hop);
+    hop->frequency = furi_hal_subghz_set_frequency(value);
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    cc1101_read_burst(&furi_hal_spi_bus_handle_subghz, CC1101_FREQ2, hop->freq, sizeof(hop->freq));
+    cc1101_read_burst(
+        &furi_hal_spi_bus_handle_subghz, CC1101_FSCAL3, hop->fscal, sizeof(hop->fscal));
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+    return hop->frequency;
+}
+
+uint32_t furi_hal_subghz_hop(const FuriHalSubGhzHop* hop) {
+    furi_assert(hop);
+    if(furi_hal_subghz_is_tx_allowed(hop->frequency)) {
+        furi_hal_subghz_regulation = SubGhzRegulationTxRx;
+    } else {
+        furi_hal_subghz_regulation = SubGhzRegulationOnlyRx;
+    }
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    cc1101_write_burst(
+        &furi_hal_spi_bus_handle_subghz, CC1101_FREQ2, hop->freq, sizeof(hop->freq));
+    cc1101_write_burst(
+        &furi_hal_spi_bus_handle_subghz, CC1101_FSCAL3, hop->fscal, sizeof(hop->fscal));
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+    memcpy(&furi_hal_subghz_shadow[CC1101_FREQ2], hop->freq, sizeof(hop->freq));
+    return hop->frequency;
+}
+
 void furi_hal_subghz_set_path(FuriHalSubGhzPath path) {
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
     if(path == FuriHalSubGhzPath433) {
         hal_gpio_write(&gpio_rf_sw_0, 0);
-        cc1101_write_reg(
-            &furi_hal_spi_bus_handle_subghz, CC1101_IOCFG2, CC1101IocfgHW | CC1101_IOCFG_INV);
+        furi_hal_subghz_chip_write_reg(CC1101_IOCFG2, CC1101IocfgHW | CC1101_IOCFG_INV);
     } else if(path == FuriHalSubGhzPath315) {
         hal_gpio_write(&gpio_rf_sw_0, 1);
-        cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG2, CC1101IocfgHW);
+        furi_hal_subghz_chip_write_reg(CC1101_IOCFG2, CC1101IocfgHW);
     } else if(path == FuriHalSubGhzPath868) {
         hal_gpio_write(&gpio_rf_sw_0, 1);
-        cc1101_write_reg(
-            &furi_hal_spi_bus_handle_subghz, CC1101_IOCFG2, CC1101IocfgHW | CC1101_IOCFG_INV);
+        furi_hal_subghz_chip_write_reg(CC1101_IOCFG2, CC1101IocfgHW | CC1101_IOCFG_INV);
     } else if(path == FuriHalSubGhzPathIsolate) {
         hal_gpio_write(&gpio_rf_sw_0, 0);
-        cc1101_write_reg(&furi_hal_spi_bus_handle_subghz, CC1101_IOCFG2, CC1101IocfgHW);
+        furi_hal_subghz_chip_write_reg(CC1101_IOCFG2, CC1101IocfgHW);
     } else {
         furi_crash(NULL);
     }
@@ -1,41 +1,49 @@
 #include <furi_hal_usb_cdc_i.h>
+#include <furi_hal_vcp_buffer.h>
 #include <furi_hal.h>
 #include <furi.h>
-#include <stream_buffer.h>
 
 #define TAG "FuriHalVcp"
 
 #define USB_CDC_PKT_LEN CDC_DATA_SZ
-#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
-#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
 
 #define VCP_IF_NUM 0
 
+_Static_assert(USB_CDC_PKT_LEN == VCP_BUFFER_PKT_LEN, "VCP buffer packet size mismatch");
+
 typedef enum {
-    VcpEvtReserved = (1 << 0), // Reserved for StreamBuffer internal event
-    VcpEvtEnable = (1 << 1),
-    VcpEvtDisable = (1 << 2),
-    VcpEvtConnect = (1 << 3),
-    VcpEvtDisconnect = (1 << 4),
-    VcpEvtStreamRx = (1 << 5),
-    VcpEvtRx = (1 << 6),
-    VcpEvtStreamTx = (1 << 7),
-    VcpEvtTx = (1 << 8),
+    VcpEvtEnable = (1 << 0),
+    VcpEvtDisable = (1 << 1),
+    VcpEvtConnect = (1 << 2),
+    VcpEvtDisconnect = (1 << 3),
+    VcpEvtStreamRx = (1 << 4),
 } WorkerEvtFlags;
 
-#define VCP_THREAD_FLAG_ALL                                                                  \
-    (VcpEvtEnable | VcpEvtDisable | VcpEvtConnect | VcpEvtDisconnect | VcpEvtRx | VcpEvtTx | \
-     VcpEvtStreamRx | VcpEvtStreamTx)
+#define VCP_THREAD_FLAG_ALL \
+    (VcpEvtEnable | VcpEvtDisable | VcpEvtConnect | VcpEvtDisconnect | VcpEvtStreamRx)
+
+typedef enum {
+    VcpDataRx = (1 << 0),
+    VcpDataTx = (1 << 1),
+} VcpDataFlags;
 
 typedef struct {
     FuriThread* thread;
+    osEventFlagsId_t data_event;
 
-    StreamBufferHandle_t tx_stream;
-    StreamBufferHandle_t rx_stream;
+    VcpRxBuffer rx;
+    VcpTxBuffer tx;
 
     volatile bool connected;
-
-    uint8_t data_buffer[USB_CDC_PKT_LEN];
+    volatile bool enabled;
+    // Packets left in endpoint until reader frees receive buffer
+    volatile uint8_t rx_missed;
+    // Worker waits for receive buffer space to put control character
+    volatile bool rx_control_pending;
+    volatile bool tx_busy;
+
+    FuriHalVcpStats stats;
+    uint32_t connect_tick;
 } FuriHalVcp;
 
 static int32_t vcp_worker(void* context);
@@ -60,9 +68,11 @@ static const uint8_t ascii_eot = 0x04;
 void furi_hal_vcp_init() {
     vcp = malloc(sizeof(FuriHalVcp));
     vcp->connected = false;
+    vcp->enabled = true;
 
-    vcp->tx_stream = xStreamBufferCreate(VCP_TX_BUF_SIZE, 1);
-    vcp->rx_stream = xStreamBufferCreate(VCP_RX_BUF_SIZE, 1);
+    vcp_rx_buffer_reset(&vcp->rx);
+    vcp_tx_buffer_reset(&vcp->tx);
+    vcp->data_event = osEventFlagsNew(NULL);
 
     vcp->thread = furi_thread_alloc();
     furi_thread_set_name(vcp->thread, "VcpDriver");
@@ -73,11 +83,106 @@ void furi_hal_vcp_init() {
     FURI_LOG_I(TAG, "Init OK");
 }
 
+// Called from USB interrupt or with interrupts disabled
+static bool vcp_rx_receive() {
+    bool received = false;
+    while(vcp->rx_missed > 0) {
+        // Read straight into receive buffer
+        uint8_t* slot = vcp_rx_buffer_get_slot(&vcp->rx);
+        if(slot == NULL) {
+            break;
+        }
+        int32_t len = furi_hal_cdc_receive(VCP_IF_NUM, slot, USB_CDC_PKT_LEN);
+        vcp_rx_buffer_commit(&vcp->rx, len);
+        vcp->stats.rx_bytes += len;
+        vcp->rx_missed--;
+        received = true;
+    }
+    if(vcp->rx_missed > 0) {
+        vcp->stats.rx_stalls++;
+    }
+    return received;
+}
+
+// Called from USB interrupt or with interrupts disabled
+static bool vcp_tx_next() {
+    const uint8_t* data;
+    size_t len;
+    if(!vcp_tx_buffer_get_packet(&vcp->tx, &data, &len)) {
+        vcp->tx_busy = false;
+        return false;
+    }
+    vcp->tx_busy = true;
+    // Endpoint write copies packet to USB memory, so buffer space can be reused right away
+    furi_hal_cdc_send(VCP_IF_NUM, (uint8_t*)data, len);
+    vcp_tx_buffer_release(&vcp->tx, len);
+    vcp->stats.tx_bytes += len;
+    if(len == 0) {
+        vcp->stats.tx_zlps++;
+    }
+    return len > 0;
+}
+
+static void vcp_tx_start() {
+    bool sent = false;
+    FURI_CRITICAL_ENTER();
+    if(vcp->enabled && !vcp->tx_busy) {
+        sent = vcp_tx_next();
+    }
+    FURI_CRITICAL_EXIT();
+    if(sent) {
+        osEventFlagsSet(vcp->data_event, VcpDataTx);
+    }
+}
+
+static void vcp_tx_flush() {
+    FURI_CRITICAL_ENTER();
+    vcp_tx_buffer_flush(&vcp->tx);
+    FURI_CRITICAL_EXIT();
+    // Wake up writers to let them notice disconnect
+    osEventFlagsSet(vcp->data_event, VcpDataTx);
+}
+
+static void vcp_rx_put_control(uint8_t character) {
+    while(1) {
+        vcp->rx_control_pending = true;
+        bool done = false;
+        FURI_CRITICAL_ENTER();
+        uint8_t* slot = vcp_rx_buffer_get_slot(&vcp->rx);
+        if(slot) {
+            slot[0] = character;
+            vcp_rx_buffer_commit(&vcp->rx, 1);
+            done = true;
+        }
+        FURI_CRITICAL_EXIT();
+        if(done) break;
+        osThreadFlagsWait(VcpEvtStreamRx, osFlagsWaitAny, osWaitForever);
+    }
+    vcp->rx_control_pending = false;
+    osEventFlagsSet(vcp->data_event, VcpDataRx);
+}
+
+static void vcp_stats_reset() {
+    memset(&vcp->stats, 0, sizeof(FuriHalVcpStats));
+    vcp->connect_tick = osKernelGetTickCount();
+}
+
+static void vcp_stats_log() {
+    FuriHalVcpStats stats;
+    furi_hal_vcp_get_stats(&stats);
+    FURI_LOG_I(
+        TAG,
+        "Rx %lu bytes, %lu B/s, %lu stalls. Tx %lu bytes, %lu B/s, %lu ZLPs",
+        stats.rx_bytes,
+        stats.rx_rate,
+        stats.rx_stalls,
+        stats.tx_bytes,
+        stats.tx_rate,
+        stats.tx_zlps);
+}
+
 static int32_t vcp_worker(void* context) {
-    bool enabled = true;
-    bool tx_idle = false;
-    size_t missed_rx = 0;
-    uint8_t last_tx_pkt_len = 0;
+    uint8_t flush_buffer[USB_CDC_PKT_LEN];
 
     furi_hal_usb_set_config(&usb_cdc_single, NULL);
     furi_hal_cdc_set_callbacks(VCP_IF_NUM, &cdc_cb, NULL);
@@ -87,115 +192,58 @@ static int32_t vcp_worker(void* context) {
         furi_assert((flags & osFlagsError) == 0);
 
         // VCP enabled
-        if((flags & VcpEvtEnable) && !enabled) {
+        if((flags & VcpEvtEnable) && !vcp->enabled) {
 #ifdef FURI_HAL_USB_VCP_DEBUG
             FURI_LOG_D(TAG, "Enable");
 #endif
-            flags |= VcpEvtTx;
             furi_hal_cdc_set_callbacks(VCP_IF_NUM, &cdc_cb, NULL);
-            enabled = true;
-            furi_hal_cdc_receive(VCP_IF_NUM, vcp->data_buffer, USB_CDC_PKT_LEN); // flush Rx buffer
+            vcp->enabled = true;
+            FURI_CRITICAL_ENTER();
+            furi_hal_cdc_receive(VCP_IF_NUM, flush_buffer, USB_CDC_PKT_LEN); // flush Rx buffer
+            vcp->rx_missed = 0;
+            FURI_CRITICAL_EXIT();
             if(furi_hal_cdc_get_ctrl_line_state(VCP_IF_NUM) & (1 << 0)) {
                 vcp->connected = true;
-                xStreamBufferSend(vcp->rx_stream, &ascii_soh, 1, osWaitForever);
+                vcp_stats_reset();
+                vcp_rx_put_control(ascii_soh);
             }
+            vcp_tx_start();
         }
 
         // VCP disabled
-        if((flags & VcpEvtDisable) && enabled) {
+        if((flags & VcpEvtDisable) && vcp->enabled) {
 #ifdef FURI_HAL_USB_VCP_DEBUG
             FURI_LOG_D(TAG, "Disable");
 #endif
-            enabled = false;
+            vcp->enabled = false;
             vcp->connected = false;
-            xStreamBufferReceive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
-            xStreamBufferSend(vcp->rx_stream, &ascii_eot, 1, osWaitForever);
+            vcp->tx_busy = false;
+            vcp_tx_flush();
+            vcp_rx_put_control(ascii_eot);
         }
 
         // VCP session opened
-        if((flags & VcpEvtConnect) && enabled) {
+        if((flags & VcpEvtConnect) && vcp->enabled) {
 #ifdef FURI_HAL_USB_VCP_DEBUG
             FURI_LOG_D(TAG, "Connect");
 #endif
             if(vcp->connected == false) {
                 vcp->connected = true;
-                xStreamBufferSend(vcp->rx_stream, &ascii_soh, 1, osWaitForever);
+                vcp_stats_reset();
+                vcp_rx_put_control(ascii_soh);
             }
         }
 
         // VCP session closed
-        if((flags & VcpEvtDisconnect) && enabled) {
+        if((flags & VcpEvtDisconnect) && vcp->enabled) {
 #ifdef FURI_HAL_USB_VCP_DEBUG
             FURI_LOG_D(TAG, "Disconnect");
 #endif
             if(vcp->connected == true) {
                 vcp->connected = false;
-                xStreamBufferReceive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
-                xStreamBufferSend(vcp->rx_stream, &ascii_eot, 1, osWaitForever);
-            }
-        }
-
-        // Rx buffer was read, maybe there is enough space for new data?
-        if((flags & VcpEvtStreamRx) && enabled && missed_rx > 0) {
-#ifdef FURI_HAL_USB_VCP_DEBUG
-            FURI_LOG_D(TAG, "StreamRx");
-#endif
-            if(xStreamBufferSpacesAvailable(vcp->rx_stream) >= USB_CDC_PKT_LEN) {
-                flags |= VcpEvtRx;
-                missed_rx--;
-            }
-        }
-
-        // New data received
-        if((flags & VcpEvtRx)) {
-            if(xStreamBufferSpacesAvailable(vcp->rx_stream) >= USB_CDC_PKT_LEN) {
-                int32_t len = furi_hal_cdc_receive(VCP_IF_NUM, vcp->data_buffer, USB_CDC_PKT_LEN);
-#ifdef FURI_HAL_USB_VCP_DEBUG
-                FURI_LOG_D(TAG, "Rx %d", len);
-#endif
-                if(len > 0) {
-                    furi_check(
-                        xStreamBufferSend(vcp->rx_stream, vcp->data_buffer, len, osWaitForever) ==
-                        len);
-                }
-            } else {
-#ifdef FURI_HAL_USB_VCP_DEBUG
-                FURI_LOG_D(TAG, "Rx missed");
-#endif
-                missed_rx++;
-            }
-        }
-
-        // New data in Tx buffer
-        if((flags & VcpEvtStreamTx) && enabled) {
-#ifdef FURI_HAL_USB_VCP_DEBUG
-            FURI_LOG_D(TAG, "StreamTx");
-#endif
-            if(tx_idle) {
-                flags |= VcpEvtTx;
-            }
-        }
-
-        // CDC write transfer done
-        if((flags & VcpEvtTx) && enabled) {
-            size_t len =
-                xStreamBufferReceive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
-#ifdef FURI_HAL_USB_VCP_DEBUG
-            FURI_LOG_D(TAG, "Tx %d", len);
-#endif
-            if(len > 0) { // Some data left in Tx buffer. Sending it now
-                tx_idle = false;
-                furi_hal_cdc_send(VCP_IF_NUM, vcp->data_buffer, len);
-                last_tx_pkt_len = len;
-            } else { // There is nothing to send.
-                if(last_tx_pkt_len == 64) {
-                    // Send extra zero-length packet if last packet len is 64 to indicate transfer end
-                    furi_hal_cdc_send(VCP_IF_NUM, NULL, 0);
-                } else {
-                    // Set flag to start next transfer instantly
-                    tx_idle = true;
-                }
-                last_tx_pkt_len = 0;
+                vcp_stats_log();
+                vcp_tx_flush();
+                vcp_rx_put_control(ascii_eot);
             }
         }
     }
@@ -221,15 +269,31 @@ size_t furi_hal_vcp_rx_with_timeout(uint8_t* buffer, size_t size, uint32_t timeo
     size_t rx_cnt = 0;
 
     while(size > 0) {
-        size_t batch_size = size;
-        if(batch_size > VCP_RX_BUF_SIZE) batch_size = VCP_RX_BUF_SIZE;
-
-        size_t len = xStreamBufferReceive(vcp->rx_stream, buffer, batch_size, timeout);
+        size_t len = vcp_rx_buffer_read(&vcp->rx, buffer, size);
+        if(len == 0) {
+            // Clear before checking again, so packet received in between is not missed
+            osEventFlagsClear(vcp->data_event, VcpDataRx);
+            if(vcp_rx_buffer_is_empty(&vcp->rx)) {
+                uint32_t flags =
+                    osEventFlagsWait(vcp->data_event, VcpDataRx, osFlagsWaitAny, timeout);
+                if(flags & osFlagsError) break;
+            }
+            continue;
+        }
 #ifdef FURI_HAL_USB_VCP_DEBUG
-        FURI_LOG_D(TAG, "rx %u ", batch_size);
+        FURI_LOG_D(TAG, "rx %u ", len);
 #endif
-        if(len == 0) break;
-        osThreadFlagsSet(furi_thread_get_thread_id(vcp->thread), VcpEvtStreamRx);
+        // Slot is free now, take packets left in endpoint
+        if(vcp->rx_missed > 0) {
+            FURI_CRITICAL_ENTER();
+            if(vcp->enabled) {
+                vcp_rx_receive();
+            }
+            FURI_CRITICAL_EXIT();
+        }
+        if(vcp->rx_control_pending) {
+            osThreadFlagsSet(furi_thread_get_thread_id(vcp->thread), VcpEvtStreamRx);
+        }
         size -= len;
         buffer += len;
         rx_cnt += len;
@@ -255,17 +319,20 @@ void furi_hal_vcp_tx(const uint8_t* buffer, size_t size) {
 #endif
 
     while(size > 0 && vcp->connected) {
-        size_t batch_size = size;
-        if(batch_size > USB_CDC_PKT_LEN) batch_size = USB_CDC_PKT_LEN;
-
-        xStreamBufferSend(vcp->tx_stream, buffer, batch_size, osWaitForever);
-        osThreadFlagsSet(furi_thread_get_thread_id(vcp->thread), VcpEvtStreamTx);
+        // Clear before writing, so space released in between is not missed
+        osEventFlagsClear(vcp->data_event, VcpDataTx);
+        size_t len = vcp_tx_buffer_write(&vcp->tx, buffer, size);
+        if(len == 0) {
+            osEventFlagsWait(vcp->data_event, VcpDataTx, osFlagsWaitAny, osWaitForever);
+            continue;
+        }
+        vcp_tx_start();
 #ifdef FURI_HAL_USB_VCP_DEBUG
-        FURI_LOG_D(TAG, "tx %u", batch_size);
+        FURI_LOG_D(TAG, "tx %u", len);
 #endif
 
-        size -= batch_size;
-        buffer += batch_size;
+        size -= len;
+        buffer += len;
     }
 
 #ifdef FURI_HAL_USB_VCP_DEBUG
@@ -273,6 +340,19 @@ void furi_hal_vcp_tx(const uint8_t* buffer, size_t size) {
 #endif
 }
 
+void furi_hal_vcp_get_stats(FuriHalVcpStats* stats) {
+    furi_assert(vcp);
+    furi_assert(stats);
+
+    *stats = vcp->stats;
+    uint32_t time_ms = (uint64_t)(osKernelGetTickCount() - vcp->connect_tick) * 1000 /
+                       osKernelGetTickFreq();
+    if(time_ms) {
+        stats->rx_rate = (uint64_t)stats->rx_bytes * 1000 / time_ms;
+        stats->tx_rate = (uint64_t)stats->tx_bytes * 1000 / time_ms;
+    }
+}
+
 static void vcp_state_callback(void* context, uint8_t state) {
     if(state == 0) {
         osThreadFlagsSet(furi_thread_get_thread_id(vcp->thread), VcpEvtDisconnect);
@@ -291,12 +371,17 @@ static void vcp_on_cdc_control_line(void* context, uint8_t state) {
 }
 
 static void vcp_on_cdc_rx(void* context) {
-    uint32_t ret = osThreadFlagsSet(furi_thread_get_thread_id(vcp->thread), VcpEvtRx);
-    furi_check((ret & osFlagsError) == 0);
+    vcp->rx_missed++;
+    if(vcp_rx_receive()) {
+        uint32_t ret = osEventFlagsSet(vcp->data_event, VcpDataRx);
+        furi_check((ret & osFlagsError) == 0);
+    }
 }
 
 static void vcp_on_cdc_tx_complete(void* context) {
-    osThreadFlagsSet(furi_thread_get_thread_id(vcp->thread), VcpEvtTx);
+    if(vcp_tx_next()) {
+        osEventFlagsSet(vcp->data_event, VcpDataTx);
+    }
 }
 
 bool furi_hal_vcp_is_connected(void) {
@@ -0,0 +1,119 @@
+#include "furi_hal_vcp_buffer.h"
+
+#include <string.h>
+
+_Static_assert(
+    (FURI_HAL_VCP_RX_BUF_SIZE % VCP_BUFFER_PKT_LEN) == 0 &&
+        (VCP_RX_BUFFER_SLOTS & (VCP_RX_BUFFER_SLOTS - 1)) == 0,
+    "FURI_HAL_VCP_RX_BUF_SIZE must be power of 2 packets");
+_Static_assert(
+    (FURI_HAL_VCP_TX_BUF_SIZE & (FURI_HAL_VCP_TX_BUF_SIZE - 1)) == 0 &&
+        (FURI_HAL_VCP_TX_BUF_SIZE >= VCP_BUFFER_PKT_LEN),
+    "FURI_HAL_VCP_TX_BUF_SIZE must be power of 2");
+
+void vcp_rx_buffer_reset(VcpRxBuffer* buffer) {
+    buffer->head = 0;
+    buffer->tail = 0;
+    buffer->offset = 0;
+}
+
+uint8_t* vcp_rx_buffer_get_slot(VcpRxBuffer* buffer) {
+    uint32_t tail = __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+    if(buffer->head - tail == VCP_RX_BUFFER_SLOTS) {
+        return NULL;
+    }
+    return buffer->slots[buffer->head % VCP_RX_BUFFER_SLOTS];
+}
+
+void vcp_rx_buffer_commit(VcpRxBuffer* buffer, size_t len) {
+    if(len == 0) {
+        return;
+    }
+    buffer->lengths[buffer->head % VCP_RX_BUFFER_SLOTS] = len;
+    __atomic_store_n(&buffer->head, buffer->head + 1, __ATOMIC_RELEASE);
+}
+
+size_t vcp_rx_buffer_read(VcpRxBuffer* buffer, uint8_t* data, size_t size) {
+    size_t read = 0;
+    uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    while(read < size && buffer->tail != head) {
+        uint32_t slot = buffer->tail % VCP_RX_BUFFER_SLOTS;
+        size_t len = buffer->lengths[slot] - buffer->offset;
+        if(len > size - read) {
+            len = size - read;
+        }
+        memcpy(&data[read], &buffer->slots[slot][buffer->offset], len);
+        read += len;
+        buffer->offset += len;
+        if(buffer->offset == buffer->lengths[slot]) {
+            buffer->offset = 0;
+            __atomic_store_n(&buffer->tail, buffer->tail + 1, __ATOMIC_RELEASE);
+        }
+    }
+    return read;
+}
+
+bool vcp_rx_buffer_is_empty(VcpRxBuffer* buffer) {
+    return __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE) == buffer->tail;
+}
+
+void vcp_tx_buffer_reset(VcpTxBuffer* buffer) {
+    buffer->head = 0;
+    buffer->tail = 0;
+    buffer->last_pkt_len = 0;
+}
+
+size_t vcp_tx_buffer_write(VcpTxBuffer* buffer, const uint8_t* data, size_t size) {
+    uint32_t tail = __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+    size_t space = FURI_HAL_VCP_TX_BUF_SIZE - (buffer->head - tail);
+    if(size > space) {
+        size = space;
+    }
+
+    size_t offset = buffer->head % FURI_HAL_VCP_TX_BUF_SIZE;
+    size_t first = FURI_HAL_VCP_TX_BUF_SIZE - offset;
+    if(first > size) {
+        first = size;
+    }
+    memcpy(&buffer->data[offset], data, first);
+    memcpy(buffer->data, &data[first], size - first);
+
+    __atomic_store_n(&buffer->head, buffer->head + size, __ATOMIC_RELEASE);
+    return size;
+}
+
+bool vcp_tx_buffer_get_packet(VcpTxBuffer* buffer, const uint8_t** data, size_t* len) {
+    uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    size_t used = head - buffer->tail;
+    if(used == 0) {
+        // Host waits for short packet to complete transfer
+        bool zlp = (buffer->last_pkt_len == VCP_BUFFER_PKT_LEN);
+        buffer->last_pkt_len = 0;
+        *data = NULL;
+        *len = 0;
+        return zlp;
+    }
+
+    // Packet is contiguous part of buffer, may be shorter at buffer wrap
+    size_t offset = buffer->tail % FURI_HAL_VCP_TX_BUF_SIZE;
+    size_t pkt_len = FURI_HAL_VCP_TX_BUF_SIZE - offset;
+    if(pkt_len > used) {
+        pkt_len = used;
+    }
+    if(pkt_len > VCP_BUFFER_PKT_LEN) {
+        pkt_len = VCP_BUFFER_PKT_LEN;
+    }
+    buffer->last_pkt_len = pkt_len;
+    *data = &buffer->data[offset];
+    *len = pkt_len;
+    return true;
+}
+
+void vcp_tx_buffer_release(VcpTxBuffer* buffer, size_t len) {
+    __atomic_store_n(&buffer->tail, buffer->tail + len, __ATOMIC_RELEASE);
+}
+
+void vcp_tx_buffer_flush(VcpTxBuffer* buffer) {
+    __atomic_store_n(
+        &buffer->tail, __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
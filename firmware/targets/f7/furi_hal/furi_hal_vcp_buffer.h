@@ -0,0 +1,131 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** USB full speed bulk packet size */
+#define VCP_BUFFER_PKT_LEN 64
+
+/** Receive buffer size, power of 2 packets */
+#ifndef FURI_HAL_VCP_RX_BUF_SIZE
+#define FURI_HAL_VCP_RX_BUF_SIZE (VCP_BUFFER_PKT_LEN * 16)
+#endif
+
+/** Transmit buffer size, power of 2 */
+#ifndef FURI_HAL_VCP_TX_BUF_SIZE
+#define FURI_HAL_VCP_TX_BUF_SIZE 1024
+#endif
+
+#define VCP_RX_BUFFER_SLOTS (FURI_HAL_VCP_RX_BUF_SIZE / VCP_BUFFER_PKT_LEN)
+
+/** Receive buffer, endpoint interrupt (single producer) reads packets
+ * straight into free slots, thread (single consumer) copies data out
+ * of them. Slot is returned once all its data is consumed.
+ */
+typedef struct {
+    uint8_t slots[VCP_RX_BUFFER_SLOTS][VCP_BUFFER_PKT_LEN];
+    uint8_t lengths[VCP_RX_BUFFER_SLOTS];
+    uint32_t head;
+    uint32_t tail;
+    uint8_t offset;
+} VcpRxBuffer;
+
+/** Transmit ring buffer, thread (single producer) copies data in,
+ * endpoint interrupt (single consumer) writes packets straight from it.
+ */
+typedef struct {
+    uint8_t data[FURI_HAL_VCP_TX_BUF_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint8_t last_pkt_len;
+} VcpTxBuffer;
+
+/** Reset receive buffer, both sides have to be stopped
+ *
+ * @param buffer    VcpRxBuffer instance
+ */
+void vcp_rx_buffer_reset(VcpRxBuffer* buffer);
+
+/** Get free slot for next packet, called by producer
+ *
+ * @param buffer    VcpRxBuffer instance
+ *
+ * @return          pointer to VCP_BUFFER_PKT_LEN bytes or NULL if buffer is full
+ */
+uint8_t* vcp_rx_buffer_get_slot(VcpRxBuffer* buffer);
+
+/** Commit packet written to slot, zero length packets are dropped
+ *
+ * @param buffer    VcpRxBuffer instance
+ * @param len       packet length
+ */
+void vcp_rx_buffer_commit(VcpRxBuffer* buffer, size_t len);
+
+/** Copy received data, called by consumer
+ *
+ * @param buffer    VcpRxBuffer instance
+ * @param data      destination
+ * @param size      destination size
+ *
+ * @return          bytes copied
+ */
+size_t vcp_rx_buffer_read(VcpRxBuffer* buffer, uint8_t* data, size_t size);
+
+/** Check if there is nothing to read
+ *
+ * @param buffer    VcpRxBuffer instance
+ *
+ * @return          true if buffer is empty
+ */
+bool vcp_rx_buffer_is_empty(VcpRxBuffer* buffer);
+
+/** Reset transmit buffer, both sides have to be stopped
+ *
+ * @param buffer    VcpTxBuffer instance
+ */
+void vcp_tx_buffer_reset(VcpTxBuffer* buffer);
+
+/** Copy data for transmission, called by producer
+ *
+ * @param buffer    VcpTxBuffer instance
+ * @param data      source
+ * @param size      source size
+ *
+ * @return          bytes copied, less than size if buffer is full
+ */
+size_t vcp_tx_buffer_write(VcpTxBuffer* buffer, const uint8_t* data, size_t size);
+
+/** Get next packet of bulk transfer, called by consumer on transfer complete
+ *
+ * Packets are taken from the buffer until it's empty. Transfer which ends
+ * with full size packet is terminated with zero length packet.
+ *
+ * @param buffer    VcpTxBuffer instance
+ * @param data      pointer to packet data
+ * @param len       packet length, 0 for zero length packet
+ *
+ * @return          true if packet has to be sent, false if transfer is finished
+ */
+bool vcp_tx_buffer_get_packet(VcpTxBuffer* buffer, const uint8_t** data, size_t* len);
+
+/** Return space of packet which was written to endpoint
+ *
+ * @param buffer    VcpTxBuffer instance
+ * @param len       packet length
+ */
+void vcp_tx_buffer_release(VcpTxBuffer* buffer, size_t len);
+
+/** Drop data which wasn't sent yet, called on consumer side
+ *
+ * @param buffer    VcpTxBuffer instance
+ */
+void vcp_tx_buffer_flush(VcpTxBuffer* buffer);
+
+#ifdef __cplusplus
+}
+#endif
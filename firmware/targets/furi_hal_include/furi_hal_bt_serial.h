@@ -7,6 +7,9 @@
 /** Serial service callback type */
 typedef SerialServiceEventCallback FuriHalBtSerialCallback;
 
+/** Serial service transmission status */
+typedef SerialServiceTxStatus FuriHalBtSerialTxStatus;
+
 /** Start Serial Profile
  */
 void furi_hal_bt_serial_start();
@@ -16,6 +19,9 @@ void furi_hal_bt_serial_start();
 void furi_hal_bt_serial_stop();
 
 /** Set Serial service events callback
+ *
+ * Set on connection and cleared (NULL callback) on disconnection: TX notify
+ * state is re-read from the stack or reset accordingly.
  *
  * @param buffer_size   Applicaition buffer size
  * @param calback       FuriHalBtSerialCallback instance
@@ -31,10 +37,20 @@ void furi_hal_bt_serial_set_event_callback(
 void furi_hal_bt_serial_notify_buffer_is_empty();
 
 /** Send data through BLE
+ *
+ * Data is sent with notification if client subscribed to them, otherwise
+ * with indication. Several notifications can be queued, next indication
+ * can be sent only after DataSent event.
  *
  * @param data  data buffer
  * @param size  data buffer size
  *
- * @return      true on success
+ * @return      FuriHalBtSerialTxStatus, retry after DataSent event if busy
+ */
+FuriHalBtSerialTxStatus furi_hal_bt_serial_tx(uint8_t* data, uint16_t size);
+
+/** Check if client subscribed to TX notifications
+ *
+ * @return      true if notifications are enabled
  */
-bool furi_hal_bt_serial_tx(uint8_t* data, uint16_t size);
+bool furi_hal_bt_serial_is_tx_notify_enabled();
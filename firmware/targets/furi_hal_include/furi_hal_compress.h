@@ -14,6 +14,21 @@
 /** Defines encoder and decoder lookahead buffer size */
 #define FURI_HAL_COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG (4)
 
+/** Decoded icon cache size in bytes */
+#ifndef FURI_HAL_COMPRESS_ICON_CACHE_SIZE
+#define FURI_HAL_COMPRESS_ICON_CACHE_SIZE (4 * 1024)
+#endif
+
+/** Icon decoder cache statistics */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    size_t cache_size;
+    size_t cache_used;
+    size_t cache_pinned;
+} FuriHalCompressIconStats;
+
 /** FuriHalCompress control structure */
 typedef struct FuriHalCompress FuriHalCompress;
 
@@ -22,12 +37,53 @@ typedef struct FuriHalCompress FuriHalCompress;
 void furi_hal_compress_icon_init();
 
 /** Icon decoder
+ *
+ * Decoded frames of icons from firmware image are kept in LRU cache keyed by
+ * icon data pointer. Decoded buffer is valid until next
+ * furi_hal_compress_icon_decode call.
  *
  * @param   icon_data    pointer to icon data
  * @param   decoded_buff pointer to decoded buffer
  */
 void furi_hal_compress_icon_decode(const uint8_t* icon_data, uint8_t** decoded_buff);
 
+/** Decode icon to caller provided buffer, bypassing cache
+ *
+ * Icon header is checked against icon_data_size, so data loaded from
+ * external storage can be passed as is.
+ *
+ * @param   icon_data          pointer to icon data
+ * @param   icon_data_size     icon data size in bytes, including header
+ * @param   decoded_buff       buffer for decoded bitmap
+ * @param   decoded_buff_size  decoded bitmap size
+ *
+ * @return  true if icon decoded to exactly decoded_buff_size bytes, false if
+ *          header doesn't match data size or data is malformed
+ */
+bool furi_hal_compress_icon_decode_buffer(
+    const uint8_t* icon_data,
+    size_t icon_data_size,
+    uint8_t* decoded_buff,
+    size_t decoded_buff_size);
+
+/** Decode icon in advance and keep it in cache permanently
+ *
+ * Intended for small icons drawn on every frame. Pinned icons may take up to
+ * quarter of cache.
+ *
+ * @param   icon_data    pointer to icon data
+ *
+ * @return  true if icon is pinned or doesn't need decoding, false if cache is
+ *          full or icon is not in firmware image
+ */
+bool furi_hal_compress_icon_pin(const uint8_t* icon_data);
+
+/** Get icon decoder cache statistics
+ *
+ * @param   stats        pointer to FuriHalCompressIconStats to fill
+ */
+void furi_hal_compress_icon_get_stats(FuriHalCompressIconStats* stats);
+
 /** Allocate encoder and decoder
  *
  * @param   compress_buff_size  size of decoder and encoder buffer to allocate
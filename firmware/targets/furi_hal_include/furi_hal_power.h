@@ -19,6 +19,22 @@ typedef enum {
     FuriHalPowerICFuelGauge,
 } FuriHalPowerIC;
 
+/** Power telemetry snapshot */
+typedef struct {
+    bool charging;
+    float voltage_charger; /**< battery voltage by charger, V */
+    float voltage_gauge; /**< battery voltage by fuel gauge, V */
+    float voltage_vbus; /**< USB voltage, V */
+    float current_charger; /**< charge current by charger, A */
+    float current_gauge; /**< battery current by fuel gauge, A */
+    float temperature_charger; /**< NTC temperature by charger, C */
+    float temperature_gauge; /**< battery temperature by fuel gauge, C */
+    uint32_t capacity_remaining; /**< mAh */
+    uint32_t capacity_full; /**< mAh */
+    uint8_t charge; /**< state of charge, % */
+    uint8_t health; /**< state of health, % */
+} FuriHalPowerTelemetry;
+
 /** Initialize drivers
  */
 void furi_hal_power_init();
@@ -149,6 +165,17 @@ float furi_hal_power_get_system_voltage();
  */
 float furi_hal_power_get_usb_voltage();
 
+/** Get all power telemetry at once
+ *
+ * Reads charger and fuel gauge registers in block transfers under single bus
+ * acquisition, much cheaper than calling individual getters one by one.
+ *
+ * @param      telemetry  pointer to FuriHalPowerTelemetry to fill
+ *
+ * @return     true on success, telemetry is undefined otherwise
+ */
+bool furi_hal_power_get_telemetry(FuriHalPowerTelemetry* telemetry);
+
 /** Get power system component state
  */
 void furi_hal_power_dump_state();
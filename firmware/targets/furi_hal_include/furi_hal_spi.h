@@ -37,6 +37,7 @@ void furi_hal_spi_bus_handle_deinit(FuriHalSpiBusHandle* handle);
 /** Acquire SPI bus
  *
  * @warning blocking, calls `furi_crash` on programming error, CS transition is up to handler event routine
+ * Waits for active job to finish, queued jobs are held until release
  *
  * @param      handle  pointer to FuriHalSpiBusHandle instance
  */
@@ -97,6 +98,52 @@ bool furi_hal_spi_bus_trx(
     size_t size,
     uint32_t timeout);
 
+/** SPI Transmit and Receive with DMA, CPU is free while waiting
+ *
+ * @warning bus must be acquired, can't be called from interrupt
+ *
+ * @param      handle     pointer to FuriHalSpiBusHandle instance
+ * @param      tx_buffer  pointer to tx buffer, NULL to send 0xFF
+ * @param      rx_buffer  pointer to rx buffer, NULL to discard received data
+ * @param      size       transaction size (buffer size)
+ * @param      timeout    operation timeout in ms
+ *
+ * @return     true on success
+ */
+bool furi_hal_spi_bus_trx_dma(
+    FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout);
+
+/** Submit SPI job
+ *
+ * Job is queued by handle priority and started with DMA when bus is not
+ * acquired. Bus and CS are activated for job duration, transfers go one by
+ * one, then callback is called from interrupt. Can be called from interrupt.
+ *
+ * @param      job   pointer to FuriHalSpiJob, not pending or active
+ */
+void furi_hal_spi_job_submit(FuriHalSpiJob* job);
+
+/** Cancel SPI job
+ *
+ * Pending job is removed from queue, active job is aborted and CS released.
+ * Callback is called with FuriHalSpiJobStateCanceled state.
+ *
+ * @param      job   pointer to FuriHalSpiJob
+ *
+ * @return     true if job was canceled, false if it is already done
+ */
+bool furi_hal_spi_job_cancel(FuriHalSpiJob* job);
+
+/** Report DMA transfer completion, called by bus DMA from interrupt
+ *
+ * @param      bus   pointer to FuriHalSpiBus instance
+ */
+void furi_hal_spi_bus_dma_complete(FuriHalSpiBus* bus);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
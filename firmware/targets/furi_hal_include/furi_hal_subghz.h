@@ -75,6 +75,9 @@ void furi_hal_subghz_dump_state();
 void furi_hal_subghz_load_preset(FuriHalSubGhzPreset preset);
 
 /** Load registers
+ *
+ * Registers missing in data get reset values. Only registers that differ
+ * from what chip already has are written, chip is reset only after sleep.
  *
  * @param      data  Registers data
  */
@@ -189,6 +192,35 @@ bool furi_hal_subghz_is_tx_allowed(uint32_t value);
  */
 uint32_t furi_hal_subghz_set_frequency(uint32_t value);
 
+/** Synthesizer state for fast frequency hopping */
+typedef struct {
+    uint32_t frequency; /**< real frequency, Hz */
+    uint8_t freq[3]; /**< FREQ2..FREQ0 */
+    uint8_t fscal[3]; /**< FSCAL3..FSCAL1, calibration result */
+} FuriHalSubGhzHop;
+
+/** Set frequency, calibrate and keep result for furi_hal_subghz_hop
+ *
+ * Calibration stays valid while temperature and supply voltage are stable.
+ *
+ * @param      hop    FuriHalSubGhzHop to fill
+ * @param      value  frequency in Hz
+ *
+ * @return     real frequency in herz
+ */
+uint32_t furi_hal_subghz_hop_prepare(FuriHalSubGhzHop* hop, uint32_t value);
+
+/** Switch to prepared frequency without calibration
+ *
+ * Chip must be idle. Preset should have autocalibration disabled, otherwise
+ * chip calibrates again on RX/TX start.
+ *
+ * @param      hop    FuriHalSubGhzHop from furi_hal_subghz_hop_prepare
+ *
+ * @return     real frequency in herz
+ */
+uint32_t furi_hal_subghz_hop(const FuriHalSubGhzHop* hop);
+
 /** Set path
  *
  * @param      path  path to use
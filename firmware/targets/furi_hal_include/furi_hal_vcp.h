@@ -13,6 +13,16 @@
 extern "C" {
 #endif
 
+/** VCP transfer statistics, reset on every connection */
+typedef struct {
+    uint32_t rx_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_stalls; /**< Packets left in endpoint because receive buffer was full */
+    uint32_t tx_zlps; /**< Zero length packets sent to terminate transfer */
+    uint32_t rx_rate; /**< Average receive rate since connection, bytes/s */
+    uint32_t tx_rate; /**< Average transmit rate since connection, bytes/s */
+} FuriHalVcpStats;
+
 /** Init VCP HAL Allocates ring buffer and initializes state
  */
 void furi_hal_vcp_init();
@@ -58,6 +68,12 @@ void furi_hal_vcp_tx(const uint8_t* buffer, size_t size);
  */
 bool furi_hal_vcp_is_connected(void);
 
+/** Get transfer statistics of current or last connection
+ *
+ * @param      stats  pointer to FuriHalVcpStats
+ */
+void furi_hal_vcp_get_stats(FuriHalVcpStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
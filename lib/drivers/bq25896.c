@@ -130,9 +130,9 @@ bool bq25896_check_otg_fault(FuriHalI2cBusHandle* handle) {
     return bq25896_regs.r0C.BOOST_FAULT;
 }
 
-uint16_t bq25896_get_vbus_voltage(FuriHalI2cBusHandle* handle) {
-    furi_hal_i2c_read_reg_8(
-        handle, BQ25896_ADDRESS, 0x11, (uint8_t*)&bq25896_regs.r11, BQ25896_I2C_TIMEOUT);
+/* Conversions of cached ADC registers */
+
+static uint16_t bq25896_vbus_voltage() {
     if(bq25896_regs.r11.VBUS_GD) {
         return (uint16_t)bq25896_regs.r11.VBUSV * 100 + 2600;
     } else {
@@ -140,26 +140,70 @@ uint16_t bq25896_get_vbus_voltage(FuriHalI2cBusHandle* handle) {
     }
 }
 
+static uint16_t bq25896_vsys_voltage() {
+    return (uint16_t)bq25896_regs.r0F.SYSV * 20 + 2304;
+}
+
+static uint16_t bq25896_vbat_voltage() {
+    return (uint16_t)bq25896_regs.r0E.BATV * 20 + 2304;
+}
+
+static uint16_t bq25896_vbat_current() {
+    return (uint16_t)bq25896_regs.r12.ICHGR * 50;
+}
+
+static uint32_t bq25896_ntc_mpct() {
+    return (uint32_t)bq25896_regs.r10.TSPCT * 465 + 21000;
+}
+
+uint16_t bq25896_get_vbus_voltage(FuriHalI2cBusHandle* handle) {
+    furi_hal_i2c_read_reg_8(
+        handle, BQ25896_ADDRESS, 0x11, (uint8_t*)&bq25896_regs.r11, BQ25896_I2C_TIMEOUT);
+    return bq25896_vbus_voltage();
+}
+
 uint16_t bq25896_get_vsys_voltage(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x0F, (uint8_t*)&bq25896_regs.r0F, BQ25896_I2C_TIMEOUT);
-    return (uint16_t)bq25896_regs.r0F.SYSV * 20 + 2304;
+    return bq25896_vsys_voltage();
 }
 
 uint16_t bq25896_get_vbat_voltage(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x0E, (uint8_t*)&bq25896_regs.r0E, BQ25896_I2C_TIMEOUT);
-    return (uint16_t)bq25896_regs.r0E.BATV * 20 + 2304;
+    return bq25896_vbat_voltage();
 }
 
 uint16_t bq25896_get_vbat_current(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x12, (uint8_t*)&bq25896_regs.r12, BQ25896_I2C_TIMEOUT);
-    return (uint16_t)bq25896_regs.r12.ICHGR * 50;
+    return bq25896_vbat_current();
 }
 
 uint32_t bq25896_get_ntc_mpct(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x10, (uint8_t*)&bq25896_regs.r10, BQ25896_I2C_TIMEOUT);
-    return (uint32_t)bq25896_regs.r10.TSPCT * 465 + 21000;
+    return bq25896_ntc_mpct();
+}
+
+bool bq25896_get_telemetry(FuriHalI2cBusHandle* handle, ChargerTelemetry* telemetry) {
+    // Status REG0B, fault REG0C, then ADC REG0D..REG12
+    if(!furi_hal_i2c_read_mem(
+           handle,
+           BQ25896_ADDRESS,
+           0x0B,
+           (uint8_t*)&bq25896_regs.r0B,
+           offsetof(bq25896_regs_t, r13) - offsetof(bq25896_regs_t, r0B),
+           BQ25896_I2C_TIMEOUT)) {
+        return false;
+    }
+
+    telemetry->charging = bq25896_regs.r0B.CHRG_STAT != ChrgStatNo;
+    telemetry->vbus_voltage = bq25896_vbus_voltage();
+    telemetry->vsys_voltage = bq25896_vsys_voltage();
+    telemetry->vbat_voltage = bq25896_vbat_voltage();
+    telemetry->vbat_current = bq25896_vbat_current();
+    telemetry->ntc_mpct = bq25896_ntc_mpct();
+
+    return true;
 }
@@ -4,6 +4,16 @@
 #include <stdint.h>
 #include <furi_hal_i2c.h>
 
+/** Charger telemetry, read in one block transfer */
+typedef struct {
+    bool charging;
+    uint16_t vbus_voltage; // mV, 0 if VBUS is not good
+    uint16_t vsys_voltage; // mV
+    uint16_t vbat_voltage; // mV
+    uint16_t vbat_current; // mA
+    uint32_t ntc_mpct; // NTC voltage in mpct of REGN
+} ChargerTelemetry;
+
 /** Initialize Driver */
 void bq25896_init(FuriHalI2cBusHandle* handle);
 
@@ -45,3 +55,6 @@ uint16_t bq25896_get_vbat_current(FuriHalI2cBusHandle* handle);
 
 /** Get NTC voltage in mpct of REGN */
 uint32_t bq25896_get_ntc_mpct(FuriHalI2cBusHandle* handle);
+
+/** Get status and ADC registers at once, true on success */
+bool bq25896_get_telemetry(FuriHalI2cBusHandle* handle, ChargerTelemetry* telemetry);
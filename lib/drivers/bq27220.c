@@ -159,3 +159,39 @@ uint16_t bq27220_get_state_of_charge(FuriHalI2cBusHandle* handle) {
 uint16_t bq27220_get_state_of_health(FuriHalI2cBusHandle* handle) {
     return bq27220_read_word(handle, CommandStateOfHealth);
 }
+
+bool bq27220_get_telemetry(FuriHalI2cBusHandle* handle, BatteryTelemetry* telemetry) {
+    // CommandTemperature..CommandFullChargeCapacity, word at 0x0E is not used
+    uint16_t block[(CommandFullChargeCapacity - CommandTemperature) / 2 + 1];
+    // CommandStateOfCharge..CommandStateOfHealth
+    uint16_t block_state[2];
+
+    if(!furi_hal_i2c_read_mem(
+           handle,
+           BQ27220_ADDRESS,
+           CommandTemperature,
+           (uint8_t*)block,
+           sizeof(block),
+           BQ27220_I2C_TIMEOUT) ||
+       !furi_hal_i2c_read_mem(
+           handle,
+           BQ27220_ADDRESS,
+           CommandStateOfCharge,
+           (uint8_t*)block_state,
+           sizeof(block_state),
+           BQ27220_I2C_TIMEOUT)) {
+        return false;
+    }
+
+    telemetry->temperature = block[(CommandTemperature - CommandTemperature) / 2];
+    telemetry->voltage = block[(CommandVoltage - CommandTemperature) / 2];
+    *(uint16_t*)&telemetry->battery_status =
+        block[(CommandBatteryStatus - CommandTemperature) / 2];
+    telemetry->current = block[(CommandCurrent - CommandTemperature) / 2];
+    telemetry->remaining_capacity = block[(CommandRemainingCapacity - CommandTemperature) / 2];
+    telemetry->full_charge_capacity = block[(CommandFullChargeCapacity - CommandTemperature) / 2];
+    telemetry->state_of_charge = block_state[0];
+    telemetry->state_of_health = block_state[1];
+
+    return true;
+}
@@ -92,6 +92,18 @@ typedef struct {
     uint16_t DOD100;
 } ParamCEDV;
 
+/** Gauge telemetry, read in two block transfers */
+typedef struct {
+    uint16_t temperature; // 0.1°K
+    uint16_t voltage; // mV
+    BatteryStatus battery_status;
+    int16_t current; // mA
+    uint16_t remaining_capacity; // mAh
+    uint16_t full_charge_capacity; // mAh
+    uint16_t state_of_charge; // %
+    uint16_t state_of_health; // %
+} BatteryTelemetry;
+
 /** Initialize Driver
  * @return true on success, false otherwise
  */
@@ -128,4 +140,9 @@ uint16_t bq27220_get_state_of_charge(FuriHalI2cBusHandle* handle);
 /** Get ratio of full charge capacity over design capacity in percents */
 uint16_t bq27220_get_state_of_health(FuriHalI2cBusHandle* handle);
 
+/** Get all telemetry registers at once
+ * @return true on success, false otherwise
+ */
+bool bq27220_get_telemetry(FuriHalI2cBusHandle* handle, BatteryTelemetry* telemetry);
+
 void bq27220_change_design_capacity(FuriHalI2cBusHandle* handle, uint16_t capacity);
@@ -4,6 +4,9 @@
 #include <assert.h>
 #include <string.h>
 
+/* Unchanged registers in between are cheaper to rewrite than to start new transaction */
+#define CC1101_WRITE_CHANGED_GAP 2
+
 CC1101Status cc1101_strobe(FuriHalSpiBusHandle* handle, uint8_t strobe) {
     uint8_t tx[1] = {strobe};
     CC1101Status rx[1] = {0};
@@ -42,6 +45,122 @@ CC1101Status cc1101_read_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t*
     return rx[0];
 }
 
+CC1101Status cc1101_write_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size) {
+    assert(size <= CC1101_CONFIG_SIZE);
+    uint8_t tx[CC1101_CONFIG_SIZE + 1] = {reg | CC1101_BURST};
+    CC1101Status rx[CC1101_CONFIG_SIZE + 1] = {0};
+
+    memcpy(&tx[1], data, size);
+
+    while(hal_gpio_read(handle->miso))
+        ;
+    furi_hal_spi_bus_trx(handle, tx, (uint8_t*)rx, size + 1, CC1101_TIMEOUT);
+
+    assert((rx[0].CHIP_RDYn | rx[size].CHIP_RDYn) == 0);
+    return rx[size];
+}
+
+CC1101Status cc1101_read_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    uint8_t* data,
+    uint8_t size) {
+    assert(size <= CC1101_CONFIG_SIZE);
+    uint8_t tx[CC1101_CONFIG_SIZE + 1] = {reg | CC1101_READ | CC1101_BURST};
+    uint8_t rx[CC1101_CONFIG_SIZE + 1] = {0};
+
+    while(hal_gpio_read(handle->miso))
+        ;
+    furi_hal_spi_bus_trx(handle, tx, rx, size + 1, CC1101_TIMEOUT);
+
+    CC1101Status status = *(CC1101Status*)&rx[0];
+    assert(status.CHIP_RDYn == 0);
+    memcpy(data, &rx[1], size);
+    return status;
+}
+
+uint8_t cc1101_write_changed(FuriHalSpiBusHandle* handle, uint8_t* shadow, const uint8_t* image) {
+    uint8_t transactions = 0;
+    uint8_t reg = 0;
+    while(reg < CC1101_CONFIG_SIZE) {
+        if(shadow[reg] == image[reg]) {
+            reg++;
+            continue;
+        }
+
+        // Extend run while next change is close enough
+        uint8_t start = reg;
+        uint8_t end = reg + 1;
+        for(uint8_t i = end; i < CC1101_CONFIG_SIZE && i <= end + CC1101_WRITE_CHANGED_GAP; i++) {
+            if(shadow[i] != image[i]) end = i + 1;
+        }
+
+        if(end - start == 1) {
+            cc1101_write_reg(handle, start, image[start]);
+        } else {
+            cc1101_write_burst(handle, start, &image[start], end - start);
+        }
+        memcpy(&shadow[start], &image[start], end - start);
+        transactions++;
+        reg = end;
+    }
+    return transactions;
+}
+
+const uint8_t cc1101_reset_values[CC1101_CONFIG_SIZE] = {
+    0x29, // IOCFG2
+    0x2E, // IOCFG1
+    0x3F, // IOCFG0
+    0x07, // FIFOTHR
+    0xD3, // SYNC1
+    0x91, // SYNC0
+    0xFF, // PKTLEN
+    0x04, // PKTCTRL1
+    0x45, // PKTCTRL0
+    0x00, // ADDR
+    0x00, // CHANNR
+    0x0F, // FSCTRL1
+    0x00, // FSCTRL0
+    0x1E, // FREQ2
+    0xC4, // FREQ1
+    0xEC, // FREQ0
+    0x8C, // MDMCFG4
+    0x22, // MDMCFG3
+    0x02, // MDMCFG2
+    0x22, // MDMCFG1
+    0xF8, // MDMCFG0
+    0x47, // DEVIATN
+    0x07, // MCSM2
+    0x30, // MCSM1
+    0x04, // MCSM0
+    0x36, // FOCCFG
+    0x6C, // BSCFG
+    0x03, // AGCCTRL2
+    0x40, // AGCCTRL1
+    0x91, // AGCCTRL0
+    0x87, // WOREVT1
+    0x6B, // WOREVT0
+    0xF8, // WORCTRL
+    0x56, // FREND1
+    0x10, // FREND0
+    0xA9, // FSCAL3
+    0x0A, // FSCAL2
+    0x20, // FSCAL1
+    0x0D, // FSCAL0
+    0x41, // RCCTRL1
+    0x00, // RCCTRL0
+    0x59, // FSTEST
+    0x7F, // PTEST
+    0x3F, // AGCTEST
+    0x88, // TEST2
+    0x31, // TEST1
+    0x0B, // TEST0
+};
+
 uint8_t cc1101_get_partnumber(FuriHalSpiBusHandle* handle) {
     uint8_t partnumber = 0;
     cc1101_read_reg(handle, CC1101_STATUS_PARTNUM | CC1101_BURST, &partnumber);
@@ -102,9 +221,12 @@ uint32_t cc1101_set_frequency(FuriHalSpiBusHandle* handle, uint32_t value) {
     // Sanity check
     assert((real_value & CC1101_FMASK) == real_value);
 
-    cc1101_write_reg(handle, CC1101_FREQ2, (real_value >> 16) & 0xFF);
-    cc1101_write_reg(handle, CC1101_FREQ1, (real_value >> 8) & 0xFF);
-    cc1101_write_reg(handle, CC1101_FREQ0, (real_value >> 0) & 0xFF);
+    uint8_t freq[3] = {
+        (real_value >> 16) & 0xFF,
+        (real_value >> 8) & 0xFF,
+        (real_value >> 0) & 0xFF,
+    };
+    cc1101_write_burst(handle, CC1101_FREQ2, freq, sizeof(freq));
 
     uint64_t real_frequency = real_value * CC1101_QUARTZ / CC1101_FDIV;
 
@@ -41,8 +41,53 @@ CC1101Status cc1101_write_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t
  */
 CC1101Status cc1101_read_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t* data);
 
+/** Write consecutive device registers in one transaction
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      reg     - first register
+ * @param      data    - data to write
+ * @param      size    - amount of registers, up to CC1101_CONFIG_SIZE
+ *
+ * @return     device status
+ */
+CC1101Status cc1101_write_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size);
+
+/** Read consecutive device registers in one transaction
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      reg     - first register
+ * @param[out] data    - pointer to data
+ * @param      size    - amount of registers, up to CC1101_CONFIG_SIZE
+ *
+ * @return     device status
+ */
+CC1101Status cc1101_read_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    uint8_t* data,
+    uint8_t size);
+
+/** Register values after reset, CC1101_CONFIG_SIZE common registers */
+extern const uint8_t cc1101_reset_values[CC1101_CONFIG_SIZE];
+
 /* High level API */
 
+/** Write only registers that differ from shadow copy
+ *
+ * Changed registers close to each other are written in one burst.
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      shadow  - CC1101_CONFIG_SIZE current register values, updated
+ * @param      image   - CC1101_CONFIG_SIZE register values to write
+ *
+ * @return     amount of SPI transactions
+ */
+uint8_t cc1101_write_changed(FuriHalSpiBusHandle* handle, uint8_t* shadow, const uint8_t* image);
+
 /** Reset
  *
  * @param      handle  - pointer to FuriHalSpiHandle
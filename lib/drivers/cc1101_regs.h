@@ -68,6 +68,7 @@ extern "C" {
 #define CC1101_TEST2 0x2C /** Various test settings */
 #define CC1101_TEST1 0x2D /** Various test settings */
 #define CC1101_TEST0 0x2E /** Various test settings */
+#define CC1101_CONFIG_SIZE 0x2F /** Amount of common registers */
 
 /* Strobe registers, CC1101_BURST is not available, CC1101_WRITE ignored */
 #define CC1101_STROBE_SRES 0x30 /** Reset chip. */
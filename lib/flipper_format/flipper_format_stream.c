@@ -267,27 +267,27 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
                 switch(write_data->type) {
                 case FlipperStreamValueStr: {
                     const char* data = write_data->data;
-                    string_printf(value, "%s", data);
+                    string_cat_str(value, data);
                 }; break;
                 case FlipperStreamValueHex: {
                     const uint8_t* data = write_data->data;
-                    string_printf(value, "%02X", data[i]);
+                    string_cat_printf(value, "%02X", data[i]);
                 }; break;
                 case FlipperStreamValueFloat: {
                     const float* data = write_data->data;
-                    string_printf(value, "%f", data[i]);
+                    string_cat_printf(value, "%f", data[i]);
                 }; break;
                 case FlipperStreamValueInt32: {
                     const int32_t* data = write_data->data;
-                    string_printf(value, "%" PRIi32, data[i]);
+                    string_cat_printf(value, "%" PRIi32, data[i]);
                 }; break;
                 case FlipperStreamValueUint32: {
                     const uint32_t* data = write_data->data;
-                    string_printf(value, "%" PRId32, data[i]);
+                    string_cat_printf(value, "%" PRId32, data[i]);
                 }; break;
                 case FlipperStreamValueBool: {
                     const bool* data = write_data->data;
-                    string_printf(value, data[i] ? "true" : "false");
+                    string_cat_str(value, data[i] ? "true" : "false");
                 }; break;
                 default:
                     furi_crash("Unknown FF type");
@@ -297,10 +297,15 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
                     string_cat(value, " ");
                 }
 
-                if(!flipper_format_stream_write(
-                       stream, string_get_cstr(value), string_size(value))) {
-                    cycle_error = true;
-                    break;
+                // Values are written in chunks: every stream write is a storage call
+                if((string_size(value) >= flipper_format_write_chunk_size) ||
+                   ((i + 1) == write_data->data_size)) {
+                    if(!flipper_format_stream_write(
+                           stream, string_get_cstr(value), string_size(value))) {
+                        cycle_error = true;
+                        break;
+                    }
+                    string_reset(value);
                 }
             }
             if(cycle_error) break;
@@ -315,6 +320,61 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
     return result;
 }
 
+/* Parses hex values straight from the read buffer: one stream read per
+ * buffer instead of read and seek back for every value. Stops right after
+ * the last requested value, like reading value by value does. */
+static bool flipper_format_stream_read_hex(Stream* stream, uint8_t* data, size_t data_size) {
+    const size_t buffer_size = 64;
+    uint8_t buffer[buffer_size];
+    size_t index = 0;
+    char value[2];
+    size_t value_size = 0;
+    bool done = false;
+    bool error = false;
+
+    if(data_size == 0) return true;
+
+    while(!done && !error) {
+        size_t was_read = stream_read(stream, buffer, buffer_size);
+        // Line may end with EOF instead of EOL
+        bool eof = was_read == 0;
+        if(eof) {
+            buffer[0] = flipper_format_eoln;
+            was_read = 1;
+        }
+
+        for(size_t i = 0; i < was_read; i++) {
+            uint8_t symbol = buffer[i];
+            if(symbol == flipper_format_eoln || symbol == ' ') {
+                if(value_size > 0) {
+                    // Only first two chars of a value matter, as in value by value parsing
+                    if(value_size < 2 || !hex_chars_to_uint8(value[0], value[1], &data[index])) {
+                        error = true;
+                    } else {
+                        index++;
+                        value_size = 0;
+                    }
+                }
+                // Leave the rest of buffer to the next reader
+                if(error || index == data_size || symbol == flipper_format_eoln) {
+                    if(!eof && !stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
+                        error = true;
+                    }
+                    done = true;
+                    break;
+                }
+            } else if(symbol == flipper_format_eolr) {
+                // Ignore
+            } else {
+                if(value_size < 2) value[value_size] = symbol;
+                value_size++;
+            }
+        }
+    }
+
+    return !error && (index == data_size);
+}
+
 bool flipper_format_stream_read_value_line(
     Stream* stream,
     const char* key,
@@ -333,6 +393,8 @@ bool flipper_format_stream_read_value_line(
                 result = true;
                 break;
             }
+        } else if(type == FlipperStreamValueHex) {
+            result = flipper_format_stream_read_hex(stream, _data, data_size);
         } else {
             result = true;
             string_t value;
@@ -345,18 +407,6 @@ bool flipper_format_stream_read_value_line(
                     int scan_values = 0;
 
                     switch(type) {
-                    case FlipperStreamValueHex: {
-                        uint8_t* data = _data;
-                        if(string_size(value) >= 2) {
-                            // sscanf "%02X" does not work here
-                            if(hex_chars_to_uint8(
-                                   string_get_char(value, 0),
-                                   string_get_char(value, 1),
-                                   &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
                     case FlipperStreamValueFloat: {
                         float* data = _data;
                         // newlib-nano does not have sscanf for floats
@@ -5,6 +5,7 @@ static const char flipper_format_delimiter = ':';
 static const char flipper_format_comment = '#';
 static const char flipper_format_eoln = '\n';
 static const char flipper_format_eolr = '\r';
+static const size_t flipper_format_write_chunk_size = 64;
 
 #ifdef __cplusplus
 extern "C" {
@@ -123,6 +123,7 @@ const InfraredMessage*
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    FURI_TRACE_BEGIN(FuriTraceEventInfraredDecode, duration);
     for(int i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         if(infrared_encoder_decoder[i].decoder.decode) {
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
@@ -131,6 +132,7 @@ const InfraredMessage*
             }
         }
     }
+    FURI_TRACE_END(FuriTraceEventInfraredDecode, duration);
 
     return result;
 }
@@ -0,0 +1,79 @@
+#include "infrared_capture_buffer.h"
+
+#include <string.h>
+
+_Static_assert(
+    (INFRARED_CAPTURE_BLOCKS & (INFRARED_CAPTURE_BLOCKS - 1)) == 0,
+    "INFRARED_CAPTURE_BLOCKS must be power of 2");
+_Static_assert(INFRARED_CAPTURE_BLOCK_SIZE <= UINT8_MAX, "INFRARED_CAPTURE_BLOCK_SIZE too big");
+
+void infrared_capture_buffer_reset(InfraredCaptureBuffer* buffer) {
+    memset(buffer, 0, sizeof(InfraredCaptureBuffer));
+}
+
+static void infrared_capture_buffer_commit(InfraredCaptureBuffer* buffer) {
+    uint32_t block = buffer->committed % INFRARED_CAPTURE_BLOCKS;
+    buffer->sizes[block] = buffer->fill;
+    buffer->fill = 0;
+    ++buffer->stats.blocks;
+    /* block content has to be visible before consumer sees it committed */
+    __atomic_store_n(&buffer->committed, buffer->committed + 1, __ATOMIC_RELEASE);
+}
+
+InfraredCaptureBufferPushResult infrared_capture_buffer_push(
+    InfraredCaptureBuffer* buffer,
+    LevelDuration level_duration,
+    uint32_t timestamp) {
+    uint32_t consumed = __atomic_load_n(&buffer->consumed, __ATOMIC_ACQUIRE);
+    if(buffer->committed - consumed >= INFRARED_CAPTURE_BLOCKS) {
+        ++buffer->stats.overruns;
+        return InfraredCaptureBufferPushOverrun;
+    }
+
+    uint32_t block = buffer->committed % INFRARED_CAPTURE_BLOCKS;
+    if(buffer->fill == 0) {
+        buffer->timestamps[block] = timestamp;
+    }
+    buffer->edges[block][buffer->fill++] = level_duration;
+    ++buffer->stats.edges;
+
+    if(buffer->fill == INFRARED_CAPTURE_BLOCK_SIZE) {
+        infrared_capture_buffer_commit(buffer);
+        return InfraredCaptureBufferPushBlockReady;
+    }
+
+    return InfraredCaptureBufferPushOk;
+}
+
+bool infrared_capture_buffer_flush(InfraredCaptureBuffer* buffer) {
+    if(buffer->fill == 0) {
+        return false;
+    }
+
+    infrared_capture_buffer_commit(buffer);
+    return true;
+}
+
+size_t infrared_capture_buffer_read(
+    InfraredCaptureBuffer* buffer,
+    const LevelDuration** edges,
+    uint32_t timestamp) {
+    uint32_t committed = __atomic_load_n(&buffer->committed, __ATOMIC_ACQUIRE);
+    if(buffer->consumed == committed) {
+        return 0;
+    }
+
+    uint32_t block = buffer->consumed % INFRARED_CAPTURE_BLOCKS;
+    uint32_t latency = timestamp - buffer->timestamps[block];
+    if(latency > buffer->stats.latency_max) {
+        buffer->stats.latency_max = latency;
+    }
+
+    *edges = buffer->edges[block];
+    return buffer->sizes[block];
+}
+
+void infrared_capture_buffer_release(InfraredCaptureBuffer* buffer) {
+    /* block has to be processed before producer reuses it */
+    __atomic_store_n(&buffer->consumed, buffer->consumed + 1, __ATOMIC_RELEASE);
+}
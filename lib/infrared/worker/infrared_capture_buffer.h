@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <toolbox/level_duration.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Edges in single block, worker is woken up once per block */
+#define INFRARED_CAPTURE_BLOCK_SIZE 32
+/** Blocks in capture buffer, should be power of 2 */
+#define INFRARED_CAPTURE_BLOCKS 4
+
+typedef enum {
+    InfraredCaptureBufferPushOk, /** Edge stored in current block */
+    InfraredCaptureBufferPushBlockReady, /** Edge stored and block is ready to be read */
+    InfraredCaptureBufferPushOverrun, /** No free block, edge dropped */
+} InfraredCaptureBufferPushResult;
+
+typedef struct {
+    uint32_t edges; /** Edges stored */
+    uint32_t blocks; /** Blocks committed */
+    uint32_t overruns; /** Edges dropped because worker was late */
+    uint32_t latency_max; /** Max time from first edge in block to reading block */
+} InfraredCaptureBufferStats;
+
+/** Block buffer between capture interrupt (single producer)
+ * and worker thread (single consumer).
+ *
+ * Producer fills block edge by edge and commits it once it's full or
+ * on idle timeout. Consumer processes committed blocks as a whole.
+ * Timestamps are provided by caller in any monotonic units.
+ */
+typedef struct {
+    LevelDuration edges[INFRARED_CAPTURE_BLOCKS][INFRARED_CAPTURE_BLOCK_SIZE];
+    uint8_t sizes[INFRARED_CAPTURE_BLOCKS];
+    uint32_t timestamps[INFRARED_CAPTURE_BLOCKS];
+    /* Producer side */
+    uint32_t committed;
+    uint8_t fill;
+    /* Consumer side */
+    uint32_t consumed;
+    InfraredCaptureBufferStats stats;
+} InfraredCaptureBuffer;
+
+/** Reset buffer, both sides have to be stopped
+ *
+ * @param[in]   buffer - InfraredCaptureBuffer instance
+ */
+void infrared_capture_buffer_reset(InfraredCaptureBuffer* buffer);
+
+/** Store edge, called by producer
+ *
+ * @param[in]   buffer - InfraredCaptureBuffer instance
+ * @param[in]   level_duration - captured edge
+ * @param[in]   timestamp - current time
+ *
+ * @return      push result, consumer should be notified on block ready or overrun
+ */
+InfraredCaptureBufferPushResult infrared_capture_buffer_push(
+    InfraredCaptureBuffer* buffer,
+    LevelDuration level_duration,
+    uint32_t timestamp);
+
+/** Commit partially filled block, called by producer on idle timeout
+ *
+ * @param[in]   buffer - InfraredCaptureBuffer instance
+ *
+ * @return      true if block was committed
+ */
+bool infrared_capture_buffer_flush(InfraredCaptureBuffer* buffer);
+
+/** Get oldest committed block, called by consumer
+ *
+ * @param[in]   buffer - InfraredCaptureBuffer instance
+ * @param[out]  edges - pointer to block edges
+ * @param[in]   timestamp - current time, used for latency statistics
+ *
+ * @return      edges in block, 0 if no blocks committed
+ */
+size_t infrared_capture_buffer_read(
+    InfraredCaptureBuffer* buffer,
+    const LevelDuration** edges,
+    uint32_t timestamp);
+
+/** Return block obtained with infrared_capture_buffer_read to producer
+ *
+ * @param[in]   buffer - InfraredCaptureBuffer instance
+ */
+void infrared_capture_buffer_release(InfraredCaptureBuffer* buffer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,6 +2,7 @@
 #include "furi/common_defines.h"
 #include "sys/_stdint.h"
 #include "infrared_worker.h"
+#include "infrared_capture_buffer.h"
 #include <infrared.h>
 #include <furi_hal_infrared.h>
 #include <limits.h>
@@ -76,6 +77,8 @@ struct InfraredWorker {
             InfraredWorkerReceivedSignalCallback received_signal_callback;
             void* received_signal_context;
             bool overrun;
+            TickType_t last_blink_time;
+            InfraredCaptureBuffer capture;
         } rx;
     };
 };
@@ -93,6 +96,8 @@ static void infrared_worker_furi_hal_message_sent_isr_callback(void* context);
 
 static void infrared_worker_rx_timeout_callback(void* context) {
     InfraredWorker* instance = context;
+    /* signal is over, pass the rest of edges to worker */
+    infrared_capture_buffer_flush(&instance->rx.capture);
     uint32_t flags_set = osEventFlagsSet(instance->events, INFRARED_WORKER_RX_TIMEOUT_RECEIVED);
     furi_check(flags_set & INFRARED_WORKER_RX_TIMEOUT_RECEIVED);
 }
@@ -100,18 +105,23 @@ static void infrared_worker_rx_timeout_callback(void* context) {
 static void infrared_worker_rx_callback(void* context, bool level, uint32_t duration) {
     InfraredWorker* instance = context;
 
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     furi_assert(duration != 0);
     LevelDuration level_duration = level_duration_make(level, duration);
 
-    size_t ret = xStreamBufferSendFromISR(
-        instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    uint32_t events = (ret == sizeof(LevelDuration)) ? INFRARED_WORKER_RX_RECEIVED :
-                                                       INFRARED_WORKER_OVERRUN;
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    /* worker is woken up once per block, not per edge */
+    InfraredCaptureBufferPushResult result =
+        infrared_capture_buffer_push(&instance->rx.capture, level_duration, DWT->CYCCNT);
+    uint32_t events = 0;
+    if(result == InfraredCaptureBufferPushBlockReady) {
+        events = INFRARED_WORKER_RX_RECEIVED;
+    } else if(result == InfraredCaptureBufferPushOverrun) {
+        events = INFRARED_WORKER_OVERRUN;
+    }
 
-    uint32_t flags_set = osEventFlagsSet(instance->events, events);
-    furi_check(flags_set & events);
+    if(events) {
+        uint32_t flags_set = osEventFlagsSet(instance->events, events);
+        furi_check(flags_set & events);
+    }
 }
 
 static void infrared_worker_process_timeout(InfraredWorker* instance) {
@@ -159,34 +169,40 @@ static void
     }
 }
 
+static void infrared_worker_process_blocks(InfraredWorker* instance) {
+    const LevelDuration* edges = NULL;
+    size_t edges_cnt = 0;
+
+    while((edges_cnt =
+               infrared_capture_buffer_read(&instance->rx.capture, &edges, DWT->CYCCNT))) {
+        if(!instance->rx.overrun && instance->blink_enable &&
+           ((xTaskGetTickCount() - instance->rx.last_blink_time) > 80)) {
+            instance->rx.last_blink_time = xTaskGetTickCount();
+            notification_message(instance->notification, &sequence_blink_blue_10);
+        }
+        if(instance->signal.timings_cnt == 0)
+            notification_message(instance->notification, &sequence_display_on);
+
+        for(size_t i = 0; (i < edges_cnt) && !instance->rx.overrun; ++i) {
+            bool level = level_duration_get_level(edges[i]);
+            uint32_t duration = level_duration_get_duration(edges[i]);
+            infrared_worker_process_timings(instance, duration, level);
+        }
+        infrared_capture_buffer_release(&instance->rx.capture);
+    }
+}
+
 static int32_t infrared_worker_rx_thread(void* thread_context) {
     InfraredWorker* instance = thread_context;
     uint32_t events = 0;
-    LevelDuration level_duration;
-    TickType_t last_blink_time = 0;
 
     while(1) {
         events =
             osEventFlagsWait(instance->events, INFRARED_WORKER_ALL_RX_EVENTS, 0, osWaitForever);
         furi_check(events & INFRARED_WORKER_ALL_RX_EVENTS); /* at least one caught */
 
-        if(events & INFRARED_WORKER_RX_RECEIVED) {
-            if(!instance->rx.overrun && instance->blink_enable &&
-               ((xTaskGetTickCount() - last_blink_time) > 80)) {
-                last_blink_time = xTaskGetTickCount();
-                notification_message(instance->notification, &sequence_blink_blue_10);
-            }
-            if(instance->signal.timings_cnt == 0)
-                notification_message(instance->notification, &sequence_display_on);
-            while(sizeof(LevelDuration) ==
-                  xStreamBufferReceive(
-                      instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
-                if(!instance->rx.overrun) {
-                    bool level = level_duration_get_level(level_duration);
-                    uint32_t duration = level_duration_get_duration(level_duration);
-                    infrared_worker_process_timings(instance, duration, level);
-                }
-            }
+        if(events & (INFRARED_WORKER_RX_RECEIVED | INFRARED_WORKER_RX_TIMEOUT_RECEIVED)) {
+            infrared_worker_process_blocks(instance);
         }
         if(events & INFRARED_WORKER_OVERRUN) {
             printf("#");
@@ -229,9 +245,8 @@ InfraredWorker* infrared_worker_alloc() {
     furi_thread_set_stack_size(instance->thread, 2048);
     furi_thread_set_context(instance->thread, instance);
 
-    size_t buffer_size =
-        MAX(sizeof(InfraredWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1),
-            sizeof(LevelDuration) * MAX_TIMINGS_AMOUNT);
+    /* stream is used by TX only, RX edges go through capture buffer */
+    size_t buffer_size = sizeof(InfraredWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1);
     instance->stream = xStreamBufferCreate(buffer_size, sizeof(InfraredWorkerTiming));
     instance->infrared_decoder = infrared_alloc_decoder();
     instance->infrared_encoder = infrared_alloc_encoder();
@@ -261,7 +276,8 @@ void infrared_worker_rx_start(InfraredWorker* instance) {
     furi_assert(instance);
     furi_assert(instance->state == InfraredWorkerStateIdle);
 
-    xStreamBufferSetTriggerLevel(instance->stream, sizeof(LevelDuration));
+    infrared_capture_buffer_reset(&instance->rx.capture);
+    instance->rx.last_blink_time = 0;
 
     osEventFlagsClear(instance->events, INFRARED_WORKER_ALL_EVENTS);
     furi_thread_set_callback(instance->thread, infrared_worker_rx_thread);
@@ -288,13 +304,21 @@ void infrared_worker_rx_stop(InfraredWorker* instance) {
     osEventFlagsSet(instance->events, INFRARED_WORKER_EXIT);
     furi_thread_join(instance->thread);
 
-    BaseType_t xReturn = xStreamBufferReset(instance->stream);
-    furi_assert(xReturn == pdPASS);
-    (void)xReturn;
-
     instance->state = InfraredWorkerStateIdle;
 }
 
+void infrared_worker_rx_get_stats(InfraredWorker* instance, InfraredWorkerRxStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    furi_assert(instance->state == InfraredWorkerStateRunRx);
+
+    const InfraredCaptureBufferStats* capture_stats = &instance->rx.capture.stats;
+    stats->edges = capture_stats->edges;
+    stats->blocks = capture_stats->blocks;
+    stats->overruns = capture_stats->overruns;
+    stats->latency_max_us = capture_stats->latency_max / (SystemCoreClock / 1000000);
+}
+
 bool infrared_worker_signal_is_decoded(const InfraredWorkerSignal* signal) {
     furi_assert(signal);
     return signal->decoded;
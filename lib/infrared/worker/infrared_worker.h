@@ -20,6 +20,14 @@ typedef enum {
     InfraredWorkerGetSignalResponseStop, /** No more signals available. */
 } InfraredWorkerGetSignalResponse;
 
+/** Receiver statistics */
+typedef struct {
+    uint32_t edges; /** Edges captured */
+    uint32_t blocks; /** Edge blocks passed to worker thread */
+    uint32_t overruns; /** Edges dropped because worker thread didn't keep up */
+    uint32_t latency_max_us; /** Max delay between first edge in block and its processing */
+} InfraredWorkerRxStats;
+
 /** Callback type for providing next signal to send. Should be used with
  * infrared_worker_make_decoded_signal() or infrared_worker_make_raw_signal()
  */
@@ -57,6 +65,13 @@ void infrared_worker_rx_start(InfraredWorker* instance);
  */
 void infrared_worker_rx_stop(InfraredWorker* instance);
 
+/** Get receiver statistics, accumulated since infrared_worker_rx_start()
+ *
+ * @param[in]   instance - InfraredWorker instance
+ * @param[out]  stats - statistics
+ */
+void infrared_worker_rx_get_stats(InfraredWorker* instance, InfraredWorkerRxStats* stats);
+
 /** Set received data callback InfraredWorker
  *
  * @param[in]   instance - InfraredWorker instance
@@ -10,6 +10,7 @@ CFLAGS			+= -I$(LIB_DIR)/mlib
 U8G2_DIR		= $(LIB_DIR)/u8g2
 CFLAGS			+= -I$(U8G2_DIR)
 C_SOURCES		+= $(U8G2_DIR)/u8g2_glue.c
+C_SOURCES		+= $(U8G2_DIR)/u8g2_glue_async.c
 C_SOURCES		+= $(U8G2_DIR)/u8g2_intersection.c
 C_SOURCES		+= $(U8G2_DIR)/u8g2_setup.c
 C_SOURCES		+= $(U8G2_DIR)/u8g2_d_memory.c
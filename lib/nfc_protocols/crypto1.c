@@ -67,6 +67,27 @@ uint8_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     return out;
 }
 
+void crypto1_encrypt(
+    Crypto1* crypto1,
+    const uint8_t* keystream,
+    const uint8_t* plain,
+    uint16_t len,
+    uint8_t* out,
+    uint8_t* out_parity) {
+    furi_assert(crypto1);
+    furi_assert(plain);
+    furi_assert(out);
+    furi_assert(out_parity);
+
+    // Parity of plain byte is encrypted with filter output after the byte
+    nfc_util_odd_parity(plain, out_parity, len);
+    for(uint16_t i = 0; i < len; i++) {
+        uint8_t in = keystream ? keystream[i] : 0;
+        out[i] = crypto1_byte(crypto1, in, 0) ^ plain[i];
+        out_parity[i / 8] ^= crypto1_filter(crypto1->odd) << (7 - (i % 8));
+    }
+}
+
 uint32_t prng_successor(uint32_t x, uint32_t n) {
     SWAPENDIAN(x);
     while(n--) x = x >> 1 | (x >> 16 ^ x >> 18 ^ x >> 19 ^ x >> 21) << 31;
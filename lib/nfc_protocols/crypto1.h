@@ -20,4 +20,20 @@ uint8_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
 
 uint32_t crypto1_filter(uint32_t in);
 
+/** Encrypt bytes and their parity bits for raw ISO14443-A transfer
+ * @param crypto1 - cipher state
+ * @param keystream - bytes fed into cipher while encrypting, NULL to feed zeros
+ * @param plain - plain bytes
+ * @param len - length in bytes
+ * @param out - encrypted bytes
+ * @param out_parity - encrypted parity bits packed like nfc_util_odd_parity does
+ */
+void crypto1_encrypt(
+    Crypto1* crypto1,
+    const uint8_t* keystream,
+    const uint8_t* plain,
+    uint16_t len,
+    uint8_t* out,
+    uint8_t* out_parity);
+
 uint32_t prng_successor(uint32_t x, uint32_t n);
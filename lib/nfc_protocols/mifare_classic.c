@@ -123,23 +123,18 @@ static bool mf_classic_auth(
         uint32_t nt = (uint32_t)nfc_util_bytes2num(tx_rx->rx_data, 4);
         crypto1_init(crypto, key);
         crypto1_word(crypto, nt ^ cuid, 0);
-        uint8_t nr[4] = {};
-        // uint8_t parity = 0;
-        nfc_util_num2bytes(prng_successor(DWT->CYCCNT, 32), 4, nr);
-        // uint8_t nr_ar[8] = {};
-        for(uint8_t i = 0; i < 4; i++) {
-            tx_rx->tx_data[i] = crypto1_byte(crypto, nr[i], 0) ^ nr[i];
-            tx_rx->tx_parity[0] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nr[i])) & 0x01) << (7 - i));
-        }
+        // Reader nonce is fed into cipher, answer is encrypted with zeros fed
+        uint8_t nr_ar[8] = {};
+        uint8_t keystream[8] = {};
+        nfc_util_num2bytes(prng_successor(DWT->CYCCNT, 32), 4, nr_ar);
+        memcpy(keystream, nr_ar, 4);
         nt = prng_successor(nt, 32);
         for(uint8_t i = 4; i < 8; i++) {
             nt = prng_successor(nt, 8);
-            tx_rx->tx_data[i] = crypto1_byte(crypto, 0x00, 0) ^ (nt & 0xff);
-            tx_rx->tx_parity[0] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nt & 0xff)) & 0x01)
-                 << (7 - i));
+            nr_ar[i] = nt & 0xff;
         }
+        crypto1_encrypt(
+            crypto, keystream, nr_ar, sizeof(nr_ar), tx_rx->tx_data, tx_rx->tx_parity);
         tx_rx->tx_rx_type = FURI_HAL_NFC_TXRX_RAW;
         tx_rx->tx_bits = 8 * 8;
         if(!furi_hal_nfc_tx_rx(tx_rx)) break;
@@ -214,11 +209,7 @@ bool mf_classic_read_block(
     nfca_append_crc16(plain_cmd, 2);
     memset(tx_rx, 0, sizeof(FuriHalNfcTxRxContext));
 
-    for(uint8_t i = 0; i < 4; i++) {
-        tx_rx->tx_data[i] = crypto1_byte(crypto, 0x00, 0) ^ plain_cmd[i];
-        tx_rx->tx_parity[0] |=
-            ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_cmd[i])) & 0x01) << (7 - i);
-    }
+    crypto1_encrypt(crypto, NULL, plain_cmd, sizeof(plain_cmd), tx_rx->tx_data, tx_rx->tx_parity);
     tx_rx->tx_bits = 4 * 9;
     tx_rx->tx_rx_type = FURI_HAL_NFC_TXRX_RAW;
 
@@ -152,6 +152,39 @@ uint16_t mf_ul_prepare_write(uint8_t* dest, uint16_t page_addr, uint32_t data) {
     return 6;
 }
 
+static void mf_ul_update_read_image(MifareUlDevice* mf_ul_emulate, uint16_t page) {
+    uint16_t page_num = mf_ul_emulate->data.data_size / 4;
+    memcpy(&mf_ul_emulate->read_image[page * 4], &mf_ul_emulate->data.data[page * 4], 4);
+    for(uint16_t i = page; i < MF_UL_ROLLOVER_PAGES; i += page_num) {
+        memcpy(
+            &mf_ul_emulate->read_image[(page_num + i) * 4],
+            &mf_ul_emulate->data.data[page * 4],
+            4);
+    }
+}
+
+static void mf_ul_prepare_read_image(MifareUlDevice* mf_ul_emulate) {
+    uint16_t page_num = mf_ul_emulate->data.data_size / 4;
+    memset(mf_ul_emulate->read_image, 0, sizeof(mf_ul_emulate->read_image));
+    for(uint16_t page = 0; page < page_num; page++) {
+        mf_ul_update_read_image(mf_ul_emulate, page);
+    }
+    // Password and PACK are never read back, they are not writable either
+    if(mf_ul_emulate->data.type >= MfUltralightTypeNTAG213) {
+        uint16_t pwd_page = page_num - 2;
+        uint16_t pack_page = pwd_page + 1;
+        memset(&mf_ul_emulate->read_image[pwd_page * 4], 0, 4);
+        memset(&mf_ul_emulate->read_image[pack_page * 4], 0, 2);
+    }
+}
+
+static void mf_ul_prepare_counter_response(MifareUlDevice* mf_ul_emulate, uint8_t cnt_num) {
+    uint32_t counter = mf_ul_emulate->data.counter[cnt_num];
+    mf_ul_emulate->counter_response[cnt_num][0] = counter >> 16;
+    mf_ul_emulate->counter_response[cnt_num][1] = counter >> 8;
+    mf_ul_emulate->counter_response[cnt_num][2] = counter;
+}
+
 void mf_ul_prepare_emulation(MifareUlDevice* mf_ul_emulate, MifareUlData* data) {
     mf_ul_emulate->data = *data;
     mf_ul_emulate->auth_data = NULL;
@@ -181,22 +214,10 @@ void mf_ul_prepare_emulation(MifareUlDevice* mf_ul_emulate, MifareUlData* data)
         uint16_t pwd_page = (data->data_size / 4) - 2;
         mf_ul_emulate->auth_data = (MifareUlAuthData*)&data->data[pwd_page * 4];
     }
-}
 
-void mf_ul_protect_auth_data_on_read_command(
-    uint8_t* tx_buff,
-    uint8_t start_page,
-    uint8_t end_page,
-    MifareUlDevice* mf_ul_emulate) {
-    if(mf_ul_emulate->data.type >= MfUltralightTypeNTAG213) {
-        uint8_t pwd_page = (mf_ul_emulate->data.data_size / 4) - 2;
-        uint8_t pack_page = pwd_page + 1;
-        if((start_page <= pwd_page) && (end_page >= pwd_page)) {
-            memset(&tx_buff[(pwd_page - start_page) * 4], 0, 4);
-        }
-        if((start_page <= pack_page) && (end_page >= pack_page)) {
-            memset(&tx_buff[(pack_page - start_page) * 4], 0, 2);
-        }
+    mf_ul_prepare_read_image(mf_ul_emulate);
+    for(uint8_t i = 0; i < 3; i++) {
+        mf_ul_prepare_counter_response(mf_ul_emulate, i);
     }
 }
 
@@ -220,6 +241,7 @@ bool mf_ul_prepare_emulation_response(
         // Compatibility write is the only one composit command
         if(buff_rx_len == 16) {
             memcpy(&mf_ul_emulate->data.data[mf_ul_emulate->comp_write_page_addr * 4], buff_rx, 4);
+            mf_ul_update_read_image(mf_ul_emulate, mf_ul_emulate->comp_write_page_addr);
             mf_ul_emulate->data_changed = true;
             // Send ACK message
             buff_tx[0] = 0x0A;
@@ -238,20 +260,8 @@ bool mf_ul_prepare_emulation_response(
     } else if(cmd == MF_UL_READ_CMD) {
         uint8_t start_page = buff_rx[1];
         if(start_page < page_num) {
-            tx_bytes = 16;
-            if(start_page + 4 > page_num) {
-                // Handle roll-over mechanism
-                uint8_t end_pages_num = page_num - start_page;
-                memcpy(buff_tx, &mf_ul_emulate->data.data[start_page * 4], end_pages_num * 4);
-                memcpy(
-                    &buff_tx[end_pages_num * 4],
-                    mf_ul_emulate->data.data,
-                    (4 - end_pages_num) * 4);
-            } else {
-                memcpy(buff_tx, &mf_ul_emulate->data.data[start_page * 4], tx_bytes);
-            }
-            mf_ul_protect_auth_data_on_read_command(
-                buff_tx, start_page, (start_page + 4), mf_ul_emulate);
+            tx_bytes = MF_UL_READ_PAGES * 4;
+            memcpy(buff_tx, &mf_ul_emulate->read_image[start_page * 4], tx_bytes);
             *data_type = FURI_HAL_NFC_TXRX_DEFAULT;
             command_parsed = true;
         }
@@ -261,9 +271,7 @@ bool mf_ul_prepare_emulation_response(
             uint8_t end_page = buff_rx[2];
             if((start_page < page_num) && (end_page < page_num) && (start_page < (end_page + 1))) {
                 tx_bytes = ((end_page + 1) - start_page) * 4;
-                memcpy(buff_tx, &mf_ul_emulate->data.data[start_page * 4], tx_bytes);
-                mf_ul_protect_auth_data_on_read_command(
-                    buff_tx, start_page, end_page, mf_ul_emulate);
+                memcpy(buff_tx, &mf_ul_emulate->read_image[start_page * 4], tx_bytes);
                 *data_type = FURI_HAL_NFC_TXRX_DEFAULT;
                 command_parsed = true;
             }
@@ -272,6 +280,7 @@ bool mf_ul_prepare_emulation_response(
         uint8_t write_page = buff_rx[1];
         if((write_page > 1) && (write_page < page_num - 2)) {
             memcpy(&mf_ul_emulate->data.data[write_page * 4], &buff_rx[2], 4);
+            mf_ul_update_read_image(mf_ul_emulate, write_page);
             mf_ul_emulate->data_changed = true;
             // ACK
             buff_tx[0] = 0x0A;
@@ -293,10 +302,8 @@ bool mf_ul_prepare_emulation_response(
     } else if(cmd == MF_UL_READ_CNT) {
         uint8_t cnt_num = buff_rx[1];
         if(cnt_num < 3) {
-            buff_tx[0] = mf_ul_emulate->data.counter[cnt_num] >> 16;
-            buff_tx[1] = mf_ul_emulate->data.counter[cnt_num] >> 8;
-            buff_tx[2] = mf_ul_emulate->data.counter[cnt_num];
-            tx_bytes = 3;
+            tx_bytes = sizeof(mf_ul_emulate->counter_response[cnt_num]);
+            memcpy(buff_tx, mf_ul_emulate->counter_response[cnt_num], tx_bytes);
             *data_type = FURI_HAL_NFC_TXRX_DEFAULT;
             command_parsed = true;
         }
@@ -305,6 +312,7 @@ bool mf_ul_prepare_emulation_response(
         uint32_t inc = (buff_rx[2] | (buff_rx[3] << 8) | (buff_rx[4] << 16));
         if((cnt_num < 3) && (mf_ul_emulate->data.counter[cnt_num] + inc < 0x00FFFFFF)) {
             mf_ul_emulate->data.counter[cnt_num] += inc;
+            mf_ul_prepare_counter_response(mf_ul_emulate, cnt_num);
             mf_ul_emulate->data_changed = true;
             // ACK
             buff_tx[0] = 0x0A;
@@ -8,6 +8,9 @@
 
 #define MF_UL_TEARING_FLAG_DEFAULT (0xBD)
 
+#define MF_UL_READ_PAGES (4)
+#define MF_UL_ROLLOVER_PAGES (MF_UL_READ_PAGES - 1)
+
 #define MF_UL_HALT_START (0x50)
 #define MF_UL_GET_VERSION_CMD (0x60)
 #define MF_UL_READ_CMD (0x30)
@@ -81,6 +84,10 @@ typedef struct {
     MifareUlAuthData* auth_data;
     bool comp_write_cmd_started;
     uint8_t comp_write_page_addr;
+    // Emulation responses prepared ahead of frames and updated on data change:
+    // pages as reader sees them with first pages repeated for READ roll-over
+    uint8_t read_image[MF_UL_MAX_DUMP_SIZE + MF_UL_ROLLOVER_PAGES * 4];
+    uint8_t counter_response[3][3];
 } MifareUlDevice;
 
 bool mf_ul_check_card_type(uint8_t ATQA0, uint8_t ATQA1, uint8_t SAK);
@@ -1,6 +1,7 @@
 #include "nfc_util.h"
 
 #include <furi.h>
+#include <string.h>
 
 static const uint8_t nfc_util_odd_byte_parity[256] = {
     1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0,
@@ -46,18 +47,110 @@ uint8_t nfc_util_odd_parity8(uint8_t data) {
     return nfc_util_odd_byte_parity[data];
 }
 
-void nfc_util_merge_data_and_parity(
-    uint8_t* data,
-    uint16_t data_len,
-    uint8_t* parity,
-    uint16_t parity_len,
-    uint8_t* res,
-    uint16_t* res_len);
+void nfc_util_odd_parity(const uint8_t* src, uint8_t* dst, uint16_t len) {
+    furi_assert(src);
+    furi_assert(dst);
+
+    while(len >= 8) {
+        *dst++ = nfc_util_odd_byte_parity[src[0]] << 7 | nfc_util_odd_byte_parity[src[1]] << 6 |
+                 nfc_util_odd_byte_parity[src[2]] << 5 | nfc_util_odd_byte_parity[src[3]] << 4 |
+                 nfc_util_odd_byte_parity[src[4]] << 3 | nfc_util_odd_byte_parity[src[5]] << 2 |
+                 nfc_util_odd_byte_parity[src[6]] << 1 | nfc_util_odd_byte_parity[src[7]];
+        src += 8;
+        len -= 8;
+    }
+    if(len) {
+        uint8_t parity = 0;
+        for(uint8_t i = 0; i < len; i++) {
+            parity |= nfc_util_odd_byte_parity[src[i]] << (7 - i);
+        }
+        *dst = parity;
+    }
+}
+
+/* Bitstream is handled in groups of eight bytes and their parity byte, which
+ * take exactly nine bytes. Byte k of a group starts at bit 9 * k, so the first
+ * seven bytes with parity fit in one 64-bit word and the eighth one straddles
+ * the word end. Word is copied as is, target is little endian. */
+static inline void nfc_util_merge_group(const uint8_t* data, uint8_t parity, uint8_t* res) {
+    uint64_t word = 0;
+    for(uint8_t k = 0; k < 7; k++) {
+        word |= (uint64_t)(data[k] | ((parity >> (7 - k)) & 0x01) << 8) << (9 * k);
+    }
+    word |= (uint64_t)data[7] << 63;
+    memcpy(res, &word, sizeof(word));
+    res[8] = data[7] >> 1 | (parity & 0x01) << 7;
+}
 
-void nfc_util_split_data_and_parity(
-    uint8_t* data,
+static inline uint8_t nfc_util_split_group(const uint8_t* data, uint8_t* res) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    uint8_t parity = 0;
+    for(uint8_t k = 0; k < 7; k++) {
+        res[k] = word >> (9 * k);
+        parity |= ((word >> (9 * k + 8)) & 0x01) << (7 - k);
+    }
+    res[7] = word >> 63 | data[8] << 1;
+    return parity | data[8] >> 7;
+}
+
+uint16_t nfc_util_merge_data_and_parity(
+    const uint8_t* data,
     uint16_t data_len,
-    uint8_t* parity,
-    uint16_t parity_len,
+    const uint8_t* parity,
+    uint8_t* res) {
+    furi_assert(data);
+    furi_assert(parity);
+    furi_assert(res);
+
+    const uint16_t res_bits = data_len * 9;
+    while(data_len >= 8) {
+        nfc_util_merge_group(data, *parity, res);
+        data += 8;
+        parity++;
+        res += 9;
+        data_len -= 8;
+    }
+    // Tail of n bytes takes n + 1 bytes of bitstream
+    if(data_len) {
+        res[0] = data[0];
+        for(uint8_t j = 1; j <= data_len; j++) {
+            res[j] = data[j - 1] >> (9 - j) | ((*parity >> (8 - j)) & 0x01) << (j - 1);
+            if(j < data_len) {
+                res[j] |= data[j] << j;
+            }
+        }
+    }
+    return res_bits;
+}
+
+uint16_t nfc_util_split_data_and_parity(
+    const uint8_t* data,
+    uint16_t data_bits,
     uint8_t* res,
-    uint16_t* res_len);
\ No newline at end of file
+    uint8_t* res_parity) {
+    furi_assert(data);
+    furi_assert(res);
+    furi_assert(res_parity);
+
+    if(data_bits % 9 != 0) {
+        return 0;
+    }
+    uint16_t res_len = data_bits / 9;
+    uint16_t len = res_len;
+    while(len >= 8) {
+        *res_parity++ = nfc_util_split_group(data, res);
+        data += 9;
+        res += 8;
+        len -= 8;
+    }
+    if(len) {
+        uint8_t parity = 0;
+        for(uint8_t j = 0; j < len; j++) {
+            res[j] = data[j] >> j | data[j + 1] << (8 - j);
+            parity |= ((data[j + 1] >> j) & 0x01) << (7 - j);
+        }
+        *res_parity = parity;
+    }
+    return res_len;
+}
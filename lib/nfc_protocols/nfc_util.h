@@ -10,18 +10,35 @@ uint8_t nfc_util_even_parity32(uint32_t data);
 
 uint8_t nfc_util_odd_parity8(uint8_t data);
 
-void nfc_util_merge_data_and_parity(
-    uint8_t* data,
-    uint16_t data_len,
-    uint8_t* parity,
-    uint16_t parity_len,
-    uint8_t* res,
-    uint16_t* res_len);
+/** Pack odd parity bits of bytes, MSB first: parity of src[i] goes to
+ * bit 7 - i % 8 of dst[i / 8]
+ */
+void nfc_util_odd_parity(const uint8_t* src, uint8_t* dst, uint16_t len);
 
-void nfc_util_split_data_and_parity(
-    uint8_t* data,
+/** Merge bytes and their parity bits into ISO14443-A bitstream: every byte LSB
+ * first followed by its parity bit. Eight bytes with one parity byte become nine
+ * bytes of bitstream, so res must hold (9 * data_len + 7) / 8 bytes
+ * @param data - data bytes
+ * @param data_len - data length in bytes
+ * @param parity - parity bits packed like nfc_util_odd_parity does
+ * @param res - bitstream
+ * @return bitstream length in bits
+ */
+uint16_t nfc_util_merge_data_and_parity(
+    const uint8_t* data,
     uint16_t data_len,
-    uint8_t* parity,
-    uint16_t parity_len,
+    const uint8_t* parity,
+    uint8_t* res);
+
+/** Split ISO14443-A bitstream into bytes and parity bits
+ * @param data - bitstream
+ * @param data_bits - bitstream length in bits, must be a multiple of 9
+ * @param res - data bytes
+ * @param res_parity - parity bits packed like nfc_util_odd_parity does
+ * @return data length in bytes, 0 if bitstream length is not a multiple of 9
+ */
+uint16_t nfc_util_split_data_and_parity(
+    const uint8_t* data,
+    uint16_t data_bits,
     uint8_t* res,
-    uint16_t* res_len);
+    uint8_t* res_parity);
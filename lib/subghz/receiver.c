@@ -59,12 +59,14 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
     furi_assert(instance);
     furi_assert(instance->slots);
 
+    FURI_TRACE_BEGIN(FuriTraceEventSubGhzDecode, duration);
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             if((slot->base->protocol->flag & instance->filter) == instance->filter) {
                 slot->base->protocol->decoder->feed(slot->base, level, duration);
             }
         }
+    FURI_TRACE_END(FuriTraceEventSubGhzDecode, duration);
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
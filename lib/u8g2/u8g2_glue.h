@@ -7,6 +7,16 @@ uint8_t u8g2_gpio_and_delay_stm32(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, vo
 
 uint8_t u8x8_hw_spi_stm32(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
 
+/* Same as u8x8_hw_spi_stm32, but transfers are queued to SPI DMA, firmware only */
+uint8_t u8x8_hw_spi_stm32_async(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+
+/* Same as u8g2_gpio_and_delay_stm32, but waits for queued transfers first, use with
+ * u8x8_hw_spi_stm32_async */
+uint8_t u8g2_gpio_and_delay_stm32_async(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+
+/* Wait for queued display transfers */
+void u8x8_hw_spi_stm32_async_flush();
+
 void u8g2_Setup_st756x_flipper(
     u8g2_t* u8g2,
     const u8g2_cb_t* rotation,
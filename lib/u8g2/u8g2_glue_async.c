@@ -0,0 +1,165 @@
+#include "u8g2_glue.h"
+
+#include <furi_hal.h>
+#include <string.h>
+
+/* Every transfer start..end is copied into a slot and sent as SPI job, so
+ * u8g2 can go on with next page while previous ones are on the bus. Slots
+ * are taken in turn and display jobs complete in order, so counting free
+ * slots is enough. */
+#define U8X8_ASYNC_SLOTS 8
+#define U8X8_ASYNC_BUFFER_SIZE 136 /**< page address commands and 132 columns */
+#define U8X8_ASYNC_TRANSFERS 4 /**< D/C line changes per slot */
+
+typedef struct {
+    FuriHalSpiJob job;
+    FuriHalSpiTransfer transfers[U8X8_ASYNC_TRANSFERS];
+    uint8_t buffer[U8X8_ASYNC_BUFFER_SIZE];
+    size_t size;
+} U8x8AsyncSlot;
+
+typedef struct {
+    U8x8AsyncSlot slots[U8X8_ASYNC_SLOTS];
+    size_t slot_next;
+    U8x8AsyncSlot* slot; /**< slot being filled, NULL outside of transfer */
+    bool dc;
+    osSemaphoreId_t free;
+} U8x8Async;
+
+static U8x8Async u8x8_async = {0};
+
+static void u8x8_async_command_setup(const FuriHalSpiTransfer* transfer) {
+    hal_gpio_write(&gpio_display_di, false);
+}
+
+static void u8x8_async_data_setup(const FuriHalSpiTransfer* transfer) {
+    hal_gpio_write(&gpio_display_di, true);
+}
+
+static void u8x8_async_job_callback(FuriHalSpiJob* job, void* context) {
+    osSemaphoreRelease(u8x8_async.free);
+}
+
+static void u8x8_async_slot_take() {
+    furi_check(osSemaphoreAcquire(u8x8_async.free, osWaitForever) == osOK);
+    U8x8AsyncSlot* slot = &u8x8_async.slots[u8x8_async.slot_next];
+    u8x8_async.slot_next = (u8x8_async.slot_next + 1) % U8X8_ASYNC_SLOTS;
+
+    slot->job.handle = &furi_hal_spi_bus_handle_display;
+    slot->job.transfers = slot->transfers;
+    slot->job.transfers_count = 0;
+    slot->job.callback = u8x8_async_job_callback;
+    slot->size = 0;
+    u8x8_async.slot = slot;
+}
+
+static void u8x8_async_slot_submit() {
+    U8x8AsyncSlot* slot = u8x8_async.slot;
+    u8x8_async.slot = NULL;
+    if(slot->job.transfers_count) {
+        furi_hal_spi_job_submit(&slot->job);
+    } else {
+        osSemaphoreRelease(u8x8_async.free);
+    }
+}
+
+static void u8x8_async_send(const uint8_t* data, size_t size) {
+    while(size) {
+        U8x8AsyncSlot* slot = u8x8_async.slot;
+        FuriHalSpiTransfer* transfer = NULL;
+        if(slot->job.transfers_count) {
+            transfer = &slot->transfers[slot->job.transfers_count - 1];
+        }
+
+        // New transfer on D/C change, new slot when full: controller doesn't mind CS toggle
+        bool dc_changed = !transfer ||
+                          (transfer->setup == u8x8_async_data_setup) != u8x8_async.dc;
+        if(slot->size == U8X8_ASYNC_BUFFER_SIZE ||
+           (dc_changed && slot->job.transfers_count == U8X8_ASYNC_TRANSFERS)) {
+            u8x8_async_slot_submit();
+            u8x8_async_slot_take();
+            continue;
+        }
+        if(dc_changed) {
+            transfer = &slot->transfers[slot->job.transfers_count++];
+            transfer->tx_buffer = &slot->buffer[slot->size];
+            transfer->rx_buffer = NULL;
+            transfer->size = 0;
+            transfer->setup = u8x8_async.dc ? u8x8_async_data_setup : u8x8_async_command_setup;
+        }
+
+        size_t chunk = MIN(size, U8X8_ASYNC_BUFFER_SIZE - slot->size);
+        memcpy(&slot->buffer[slot->size], data, chunk);
+        slot->size += chunk;
+        transfer->size += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+void u8x8_hw_spi_stm32_async_flush() {
+    if(!u8x8_async.free) return;
+    for(size_t i = 0; i < U8X8_ASYNC_SLOTS; i++) {
+        furi_check(osSemaphoreAcquire(u8x8_async.free, osWaitForever) == osOK);
+    }
+    for(size_t i = 0; i < U8X8_ASYNC_SLOTS; i++) {
+        osSemaphoreRelease(u8x8_async.free);
+    }
+}
+
+/* Delays and reset line act right away, so queued bytes must reach display first.
+ * Slot being filled is sent as is: controller doesn't mind CS toggle. */
+static void u8x8_async_barrier() {
+    bool in_transfer = u8x8_async.slot;
+    if(in_transfer) {
+        u8x8_async_slot_submit();
+    }
+    u8x8_hw_spi_stm32_async_flush();
+    if(in_transfer) {
+        u8x8_async_slot_take();
+    }
+}
+
+uint8_t
+    u8g2_gpio_and_delay_stm32_async(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    switch(msg) {
+    case U8X8_MSG_DELAY_MILLI:
+    case U8X8_MSG_DELAY_10MICRO:
+    case U8X8_MSG_DELAY_100NANO:
+    case U8X8_MSG_GPIO_RESET:
+        u8x8_async_barrier();
+        break;
+    default:
+        break;
+    }
+
+    return u8g2_gpio_and_delay_stm32(u8x8, msg, arg_int, arg_ptr);
+}
+
+uint8_t u8x8_hw_spi_stm32_async(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+        furi_assert(u8x8_async.slot);
+        u8x8_async_send((uint8_t*)arg_ptr, arg_int);
+        break;
+    case U8X8_MSG_BYTE_SET_DC:
+        u8x8_async.dc = arg_int;
+        break;
+    case U8X8_MSG_BYTE_INIT:
+        if(!u8x8_async.free) {
+            u8x8_async.free = osSemaphoreNew(U8X8_ASYNC_SLOTS, U8X8_ASYNC_SLOTS, NULL);
+        }
+        break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+        furi_assert(!u8x8_async.slot);
+        u8x8_async_slot_take();
+        break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+        u8x8_async_slot_submit();
+        break;
+    default:
+        return 0;
+    }
+
+    return 1;
+}
@@ -69,6 +69,15 @@ class Main(App):
         )
         self.parser_dolphin.set_defaults(func=self.dolphin)
 
+        self.parser_emv = self.subparsers.add_parser(
+            "emv", help="Build EMV resources lookup indexes"
+        )
+        self.parser_emv.add_argument("directory", help="EMV resources directory")
+        self.parser_emv.add_argument(
+            "files", nargs="+", help="EMV resource files in directory"
+        )
+        self.parser_emv.set_defaults(func=self.emv)
+
     def _icon2header(self, file):
         output = subprocess.check_output(["convert", file, "xbm:-"])
         assert output
@@ -250,6 +259,16 @@ class Main(App):
 
         return 0
 
+    def emv(self):
+        from flipper.assets.emv import EmvResources
+
+        self.logger.info(f"Processing EMV resources")
+        resources = EmvResources()
+        resources.compile(self.args.directory, self.args.files)
+        self.logger.info(f"Complete")
+
+        return 0
+
 
 if __name__ == "__main__":
     Main()()
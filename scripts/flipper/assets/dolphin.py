@@ -3,6 +3,7 @@ import logging
 import os
 import sys
 import shutil
+import struct
 from collections import Counter
 
 from flipper.utils.fff import *
@@ -10,12 +11,6 @@ from flipper.utils.templite import *
 from .icon import *
 
 
-def _convert_image_to_bm(pair: set):
-    source_filename, destination_filename = pair
-    image = file2image(source_filename)
-    image.write(destination_filename)
-
-
 def _convert_image(source_filename: str):
     image = file2image(source_filename)
     return image.data
@@ -26,6 +21,14 @@ class DolphinBubbleAnimation:
     FILE_TYPE = "Flipper Animation"
     FILE_VERSION = 1
 
+    # Packed animation: header, frames order, bubbles, frame offsets, frames
+    BUNDLE_FILENAME = "animation.bnd"
+    BUNDLE_MAGIC = b"FBAN"
+    BUNDLE_VERSION = 1
+    BUNDLE_HEADER_FORMAT = "<4sBBBBBBBBHHBB"
+    BUNDLE_BUBBLE_FORMAT = "<BBBBBBBB"
+    BUNDLE_ALIGN = ["Left", "Right", "Top", "Bottom", "Center"]
+
     def __init__(
         self,
         name: str,
@@ -221,14 +224,59 @@ class DolphinBubbleAnimation:
 
         file.save(meta_filename)
 
-        to_pack = []
-        for index, frame in enumerate(self.frames):
-            to_pack.append(
-                (frame, os.path.join(animation_directory, f"frame_{index}.bm"))
-            )
+        frames = self.frames
+        if frames and isinstance(frames[0], str):
+            pool = multiprocessing.Pool()
+            frames = pool.map(_convert_image, frames)
+
+        self._save_bundle(os.path.join(animation_directory, self.BUNDLE_FILENAME), frames)
+
+    def _save_bundle(self, bundle_filename: str, frames: list):
+        data = struct.pack(
+            self.BUNDLE_HEADER_FORMAT,
+            self.BUNDLE_MAGIC,
+            self.BUNDLE_VERSION,
+            self.meta["Width"],
+            self.meta["Height"],
+            len(frames),
+            self.meta["Passive frames"],
+            self.meta["Active frames"],
+            self.meta["Active cycles"],
+            self.meta["Frame rate"],
+            self.meta["Duration"],
+            self.meta["Active cooldown"],
+            self.bubble_slots,
+            len(self.bubbles),
+        )
+        data += bytes(self.meta["Frames order"])
 
-        pool = multiprocessing.Pool()
-        pool.map(_convert_image_to_bm, to_pack)
+        for bubble in self.bubbles:
+            text = bubble["Text"].replace("\\n", "\n").encode()
+            assert len(text) <= 100
+            data += struct.pack(
+                self.BUNDLE_BUBBLE_FORMAT,
+                bubble["Slot"],
+                bubble["X"],
+                bubble["Y"],
+                self.BUNDLE_ALIGN.index(bubble["AlignH"]),
+                self.BUNDLE_ALIGN.index(bubble["AlignV"]),
+                bubble["StartFrame"],
+                bubble["EndFrame"],
+                len(text),
+            )
+            data += text
+
+        # Frames are stored in the same format as firmware icons: optionally compressed
+        offset = len(data) + 4 * (len(frames) + 1)
+        for frame in frames:
+            data += struct.pack("<I", offset)
+            offset += len(frame)
+        data += struct.pack("<I", offset)
+        for frame in frames:
+            data += frame
+
+        with open(bundle_filename, "wb") as file:
+            file.write(data)
 
     def process(self):
         pool = multiprocessing.Pool()
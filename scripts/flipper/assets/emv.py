@@ -0,0 +1,151 @@
+import logging
+import math
+import os
+import struct
+
+from flipper.utils.fff import *
+
+
+class EmvResource:
+
+    FILE_TYPE = "Flipper EMV resources"
+    FILE_VERSION = 1
+
+    # Index: header, entries sorted by key, names
+    # Entry key is key length followed by key bytes padded to key size,
+    # so entries can be compared with memcmp
+    INDEX_EXTENSION = ".idx"
+    INDEX_MAGIC = b"FEMV"
+    INDEX_VERSION = 1
+    INDEX_HEADER_FORMAT = "<4sBBH"
+    INDEX_ENTRY_FORMAT = "<B{key_size}sHB"
+    INDEX_KEY_SIZE_MAX = 16
+
+    def __init__(self, name: str):
+        self.name = name
+        self.records = {}
+        self.lines = 0
+        self.logger = logging.getLogger("EmvResource")
+
+    def load(self, filename: str):
+        file = FlipperFormatFile()
+        file.load(filename)
+
+        filetype, version = file.getHeader()
+        if filetype != self.FILE_TYPE or version != self.FILE_VERSION:
+            raise Exception(f"Unsupported file {filename}: {filetype} {version}")
+
+        while True:
+            try:
+                key, value = file.readKeyValue()
+            except EOFError:
+                break
+            self.lines += 1
+            key = bytes.fromhex(key)
+            if len(key) > self.INDEX_KEY_SIZE_MAX:
+                raise Exception(f"Key is too long in {filename}: {key.hex()}")
+            # Firmware text lookup stops on the first match
+            if key in self.records:
+                self.logger.warning(
+                    f"Duplicate key {key.hex().upper()} in {self.name}"
+                )
+                continue
+            self.records[key] = value.encode("utf-8")
+
+    def _entry_key(self, key: bytes, key_size: int):
+        return bytes([len(key)]) + key.ljust(key_size, b"\0")
+
+    def pack(self):
+        key_size = max(len(key) for key in self.records)
+        entry_format = self.INDEX_ENTRY_FORMAT.format(key_size=key_size)
+        keys = sorted(self.records, key=lambda key: self._entry_key(key, key_size))
+
+        data = struct.pack(
+            self.INDEX_HEADER_FORMAT,
+            self.INDEX_MAGIC,
+            self.INDEX_VERSION,
+            key_size,
+            len(keys),
+        )
+        names = b""
+        for key in keys:
+            name = self.records[key]
+            if len(name) > 0xFF:
+                raise Exception(f"Name is too long in {self.name}: {name}")
+            data += struct.pack(
+                entry_format,
+                len(key),
+                key.ljust(key_size, b"\0"),
+                len(names),
+                len(name),
+            )
+            names += name
+        if len(names) > 0xFFFF:
+            raise Exception(f"Names don't fit in {self.name}")
+
+        return data + names
+
+    def verify(self, data: bytes):
+        # Same binary search as firmware does, counting entry reads
+        magic, version, key_size, count = struct.unpack_from(
+            self.INDEX_HEADER_FORMAT, data
+        )
+        entry_format = self.INDEX_ENTRY_FORMAT.format(key_size=key_size)
+        entry_size = struct.calcsize(entry_format)
+        table = struct.calcsize(self.INDEX_HEADER_FORMAT)
+        names = table + count * entry_size
+
+        reads_max = 0
+        reads_total = 0
+        for key, name in self.records.items():
+            probe = self._entry_key(key, key_size)
+            low, high = 0, count
+            reads = 0
+            found = None
+            while low < high:
+                middle = (low + high) // 2
+                reads += 1
+                offset = table + middle * entry_size
+                entry = data[offset : offset + 1 + key_size]
+                if entry == probe:
+                    _, _, name_offset, name_size = struct.unpack_from(
+                        entry_format, data, offset
+                    )
+                    found = data[names + name_offset : names + name_offset + name_size]
+                    break
+                elif entry < probe:
+                    low = middle + 1
+                else:
+                    high = middle
+            if found != name:
+                raise Exception(f"Index lookup failed in {self.name}: {key.hex()}")
+            reads_max = max(reads_max, reads)
+            reads_total += reads
+
+        self.logger.info(
+            f"{self.name}: {count} keys, {len(data)} bytes, "
+            f"index reads avg {reads_total / count:.1f} max {reads_max} "
+            f"(limit {math.ceil(math.log2(count + 1))}), "
+            f"text scan lines avg {(self.lines + 1) / 2:.1f} max {self.lines}"
+        )
+
+    def save(self, filename: str):
+        data = self.pack()
+        self.verify(data)
+        with open(filename, "wb") as file:
+            file.write(data)
+
+
+class EmvResources:
+    def __init__(self):
+        self.logger = logging.getLogger("EmvResources")
+
+    def compile(self, directory: str, names: list):
+        assert os.path.isdir(directory)
+        for name in names:
+            resource = EmvResource(name)
+            source = os.path.join(directory, name)
+            self.logger.info(f"Compiling {source}")
+            resource.load(source)
+            index = os.path.splitext(source)[0] + EmvResource.INDEX_EXTENSION
+            resource.save(index)
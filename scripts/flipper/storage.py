@@ -48,6 +48,16 @@ class BufferedRead:
             data = self.stream.read(i)
             self.buffer.extend(data)
 
+    def exactly(self, size):
+        while len(self.buffer) < size:
+            data = self.stream.read(max(1, self.stream.in_waiting))
+            if not data:
+                raise TimeoutError("Read timeout")
+            self.buffer.extend(data)
+        read = self.buffer[:size]
+        self.buffer = self.buffer[size:]
+        return read
+
 
 class FlipperStorage:
     CLI_PROMPT = ">: "
@@ -250,6 +260,19 @@ class FlipperStorage:
         self.read.until(self.CLI_PROMPT)
         return filedata
 
+    def read_file_stream(self, filename):
+        """Receive file from Flipper in one piece, without chunk handshake"""
+        self.send_and_wait_eol('storage read "' + filename + '"\r')
+        answer = self.read.until(self.CLI_EOL)
+        if self.has_error(answer):
+            self.last_error = self.get_error(answer)
+            self.read.until(self.CLI_PROMPT)
+            return bytearray()
+        size = int(answer.split(b": ")[1])
+        filedata = self.read.exactly(size)
+        self.read.until(self.CLI_PROMPT)
+        return filedata
+
     def receive_file(self, filename_from, filename_to):
         """Receive file from Flipper to local storage"""
         with open(filename_to, "wb") as file:
@@ -10,6 +10,7 @@ import binascii
 import posixpath
 import filecmp
 import tempfile
+import time
 
 
 class Main:
@@ -69,6 +70,19 @@ class Main:
         )
         self.parser_stress.set_defaults(func=self.stress)
 
+        self.parser_benchmark = self.subparsers.add_parser(
+            "benchmark", help="Measure file read throughput over CLI"
+        )
+        self.parser_benchmark.add_argument("flipper_path", help="Flipper path")
+        self.parser_benchmark.add_argument(
+            "-s",
+            "--file-size",
+            type=int,
+            default=1024 * 1024,
+            help="Test file size in bytes",
+        )
+        self.parser_benchmark.set_defaults(func=self.benchmark)
+
         # logging
         self.logger = logging.getLogger()
 
@@ -310,6 +324,35 @@ class Main:
                 self.args.count -= 1
             storage.stop()
 
+    def benchmark(self):
+        with tempfile.TemporaryDirectory() as tmpdirname:
+            send_file_name = os.path.join(tmpdirname, "send")
+            open(send_file_name, "wb").write(os.urandom(self.args.file_size))
+            storage = FlipperStorage(self.args.port)
+            storage.start()
+            if storage.exist_file(self.args.flipper_path):
+                self.logger.error("File exists, remove it first")
+                storage.stop()
+                return
+            self.logger.info(f"Sending {self.args.file_size} bytes")
+            if not storage.send_file(send_file_name, self.args.flipper_path):
+                self.logger.error(f"Error: {storage.last_error}")
+                storage.stop()
+                return
+
+            time_start = time.monotonic()
+            data = storage.read_file_stream(self.args.flipper_path)
+            time_spent = time.monotonic() - time_start
+            storage.remove(self.args.flipper_path)
+            storage.stop()
+
+            if data != open(send_file_name, "rb").read():
+                self.logger.error("Files mismatch")
+                return
+            self.logger.info(
+                f"Read {len(data)} bytes in {time_spent:.2f}s, {len(data) / time_spent:.0f} B/s"
+            )
+
 
 if __name__ == "__main__":
     Main()()
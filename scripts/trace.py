@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+
+from flipper.storage import FlipperStorage
+
+import logging
+import argparse
+import json
+import struct
+import sys
+
+# Same order as FuriTraceEvent in core/furi/trace.h
+EVENTS = [
+    "StorageCommand",
+    "GuiRedraw",
+    "SubGhzDecode",
+    "InfraredDecode",
+    "NfcWorker",
+    "NfcDetect",
+]
+
+PHASES = ["B", "E", "i"]
+
+TRACE_MAGIC = 0x43525446
+TRACE_VERSION = 1
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IIHBBI")
+THREAD = struct.Struct("<I16s")
+
+
+class Main:
+    def __init__(self):
+        # command args
+        self.parser = argparse.ArgumentParser()
+        self.parser.add_argument("-d", "--debug", action="store_true", help="Debug")
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_dump = self.subparsers.add_parser(
+            "dump", help="Read trace from device and convert it"
+        )
+        self.parser_dump.add_argument("-p", "--port", help="CDC Port", required=True)
+        self.parser_dump.add_argument("output", help="Chrome trace JSON file")
+        self.parser_dump.add_argument(
+            "-b", "--binary", help="Also save binary dump to file"
+        )
+        self.parser_dump.set_defaults(func=self.dump)
+
+        self.parser_decode = self.subparsers.add_parser(
+            "decode", help="Convert binary dump to Chrome trace JSON"
+        )
+        self.parser_decode.add_argument("input", help="Binary dump file")
+        self.parser_decode.add_argument("output", help="Chrome trace JSON file")
+        self.parser_decode.set_defaults(func=self.decode)
+
+        # logging
+        self.logger = logging.getLogger()
+
+    def __call__(self):
+        self.args = self.parser.parse_args()
+        if "func" not in self.args:
+            self.parser.error("Choose something to do")
+        # configure log output
+        self.log_level = logging.DEBUG if self.args.debug else logging.INFO
+        self.logger.setLevel(self.log_level)
+        self.handler = logging.StreamHandler(sys.stdout)
+        self.handler.setLevel(self.log_level)
+        self.formatter = logging.Formatter("%(asctime)s [%(levelname)s] %(message)s")
+        self.handler.setFormatter(self.formatter)
+        self.logger.addHandler(self.handler)
+        # execute requested function
+        self.args.func()
+
+    def dump(self):
+        flipper = FlipperStorage(self.args.port)
+        flipper.start()
+        flipper.send_and_wait_eol("trace dump\r")
+        # Either binary dump or text error right after echo
+        header = flipper.read.exactly(HEADER.size)
+        magic, _, _, _, records, threads = HEADER.unpack(header)
+        if magic != TRACE_MAGIC:
+            text = header + flipper.read.until(flipper.CLI_PROMPT)
+            self.logger.error(f"Dump failed: {text.decode('ascii', 'replace').strip()}")
+            flipper.stop()
+            return
+        data = header + flipper.read.exactly(
+            records * RECORD.size + threads * THREAD.size
+        )
+        flipper.read.until(flipper.CLI_PROMPT)
+        flipper.stop()
+
+        if self.args.binary:
+            with open(self.args.binary, "wb") as file:
+                file.write(data)
+        self.convert(data, self.args.output)
+
+    def decode(self):
+        with open(self.args.input, "rb") as file:
+            self.convert(file.read(), self.args.output)
+
+    def convert(self, data, output):
+        magic, version, record_size, frequency, records, threads = HEADER.unpack_from(
+            data
+        )
+        if magic != TRACE_MAGIC or version != TRACE_VERSION:
+            self.logger.error("Unsupported dump format")
+            return
+        if record_size != RECORD.size:
+            self.logger.error(f"Unexpected record size {record_size}")
+            return
+
+        events = []
+        offset = HEADER.size
+        thread_ids = set()
+        isr_ids = set()
+        # Time from first record, cycle counter wraps every 2^32 cycles
+        last_timestamp = None
+        base = 0
+        for _ in range(records):
+            timestamp, thread, event, phase, isr, arg = RECORD.unpack_from(
+                data, offset
+            )
+            offset += RECORD.size
+            if last_timestamp is None:
+                base = -timestamp
+            elif timestamp < last_timestamp:
+                base += 1 << 32
+            last_timestamp = timestamp
+
+            # Exception numbers don't overlap with thread addresses
+            tid = thread
+            (isr_ids if isr else thread_ids).add(tid)
+            entry = {
+                "name": EVENTS[event] if event < len(EVENTS) else f"Event{event}",
+                "ph": PHASES[phase] if phase < len(PHASES) else "i",
+                "ts": (base + timestamp) * 1000000 / frequency,
+                "pid": 0,
+                "tid": tid,
+                "args": {"arg": arg},
+            }
+            if entry["ph"] == "i":
+                entry["s"] = "t"
+            events.append(entry)
+
+        names = {}
+        for _ in range(threads):
+            thread, name = THREAD.unpack_from(data, offset)
+            offset += THREAD.size
+            names[thread] = name.split(b"\0", 1)[0].decode("ascii", "replace")
+        for tid in sorted(thread_ids | isr_ids):
+            if tid in isr_ids:
+                name = f"ISR {tid}"
+            else:
+                name = names.get(tid, f"0x{tid:08X}")
+            events.append(
+                {
+                    "name": "thread_name",
+                    "ph": "M",
+                    "pid": 0,
+                    "tid": tid,
+                    "args": {"name": name},
+                }
+            )
+
+        with open(output, "w") as file:
+            json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, file)
+        self.logger.info(
+            f"{records} records from {len(thread_ids)} threads and {len(isr_ids)} interrupts saved"
+        )
+
+
+if __name__ == "__main__":
+    Main()()